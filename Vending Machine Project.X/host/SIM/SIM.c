@@ -0,0 +1,1597 @@
+/**********************************************************************************************************************
+ * Filename:    SIM.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the implementation of the host simulator core: virtual clock, register file, pins,
+ *              Timer0/1/2, ADC, interrupt-on-change, sleep mode, clock switching and interrupt dispatch to myISR().
+ * NOTE:        The simulator is synchronized on every SFR access and every __delay, so the firmware runs unmodified.
+ *              Polling loops on a flag register are detected and fast-forwarded to the next peripheral event. An
+ *              access with no write to observe and no event before its end only moves the virtual time on, the
+ *              peripherals run for it at the next synchronization.
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "SIM_prv.h"
+
+/**********************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* INTCON bits */
+#define     INTCON_RBIF         0x01
+#define     INTCON_INTF         0x02
+#define     INTCON_T0IF         0x04
+#define     INTCON_RBIE         0x08
+#define     INTCON_INTE         0x10
+#define     INTCON_T0IE         0x20
+#define     INTCON_PEIE         0x40
+#define     INTCON_GIE          0x80
+
+/* PIR1 bits */
+#define     PIR1_TMR1IF         0x01
+#define     PIR1_TMR2IF         0x02
+#define     PIR1_TXIF           0x10
+#define     PIR1_ADIF           0x40
+
+/* PIR2 bits */
+#define     PIR2_EEIF           0x10
+
+/* EECON1 bits */
+#define     EECON1_RD           0x01
+#define     EECON1_WR           0x02
+#define     EECON1_WREN         0x04
+#define     EECON1_EEPGD        0x80
+
+/* ADCON0 bits */
+#define     ADCON0_ADON         0x01
+#define     ADCON0_GO           0x02
+
+/* WDTCON bits */
+#define     WDTCON_SWDTEN       0x01
+
+/* STATUS bits */
+#define     STATUS_NPD          0x08
+#define     STATUS_NTO          0x10
+
+/* OSCCON bits */
+#define     OSCCON_SCS          0x01
+#define     OSCCON_LTS          0x02
+#define     OSCCON_HTS          0x04
+#define     OSCCON_OSTS         0x08
+#define     OSCCON_IRCF         0x70
+
+/* TXSTA bits */
+#define     TXSTA_TRMT          0x02
+#define     TXSTA_BRGH          0x04
+#define     TXSTA_SYNC          0x10
+#define     TXSTA_TXEN          0x20
+#define     TXSTA_TX9           0x40
+
+/* RCSTA bits */
+#define     RCSTA_SPEN          0x80
+
+/* BAUDCTL bits */
+#define     BAUDCTL_BRG16       0x08
+
+/* Interrupt latency (cycles) */
+#define     SIM_ISR_LATENCY     4
+
+/* Cycles charged for a main loop pass that did not touch any SFR */
+#define     SIM_LOOP_CYCLES     2
+
+/* Register file bits (offsets) of the timers and of the timer and clock configuration (SIM_Timing) */
+#define     SIM_REG_BIT(name)   (1ULL << offsetof(SIM_regfile_t, name))
+#define     SIM_TIMING_REGS     (SIM_REG_BIT(tmr0) | SIM_REG_BIT(option_reg) | SIM_REG_BIT(tmr1) |               \
+                                 (SIM_REG_BIT(tmr1) << 1) | SIM_REG_BIT(t1con) | SIM_REG_BIT(tmr2) |           \
+                                 SIM_REG_BIT(pr2) | SIM_REG_BIT(t2con) | SIM_REG_BIT(osccon))
+
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+static SIM_cpu_t sim_default;
+
+SIM_cpu_t *SIM_cpu = &sim_default;
+SIM_regfile_t *SIM_regs = &sim_default.regs;
+
+/* Data EEPROM image programmed by SIM_Reset() (__EEPROM_DATA) */
+static unsigned char sim_eeprom_image[SIM_EEPROM_SIZE];
+static unsigned int sim_eeprom_image_size = 0;
+
+/* Interrupt service routine of the firmware */
+extern void myISR(void);
+
+/* Timers, ADC, EEPROM and EUSART for a number of cycles (run late by SIM_CatchUp()) */
+static void SIM_Peripherals(unsigned long long cycles);
+
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : static unsigned char *SIM_Port( unsigned char port )
+* \Description     : Returns the PORTx register of a port.
+*******************************************************************************/
+static unsigned char *SIM_Port(unsigned char port)
+{
+    switch(port)
+    {
+        case SIM_PORTA:
+            return &SIM_cpu->regs.porta;
+        case SIM_PORTB:
+            return &SIM_cpu->regs.portb;
+        case SIM_PORTC:
+        default:
+            break;
+    }
+    return &SIM_cpu->regs.portc;
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned char SIM_Tris( unsigned char port )
+* \Description     : Returns the TRISx register of a port.
+*******************************************************************************/
+static unsigned char SIM_Tris(unsigned char port)
+{
+    switch(port)
+    {
+        case SIM_PORTA:
+            return SIM_cpu->regs.trisa;
+        case SIM_PORTB:
+            return SIM_cpu->regs.trisb;
+        case SIM_PORTC:
+        default:
+            break;
+    }
+    return SIM_cpu->regs.trisc;
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_SyncPorts( void )
+* \Description     : Reflects the external input levels into PORTx and logs
+                     output edges of PORTA and PORTB.
+*******************************************************************************/
+static void SIM_SyncPorts(void)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+
+    for(unsigned char port = SIM_PORTA; port <= SIM_PORTC; port++)
+    {
+        unsigned char *reg = SIM_Port(port);
+        unsigned char tris = SIM_Tris(port);
+        unsigned char out;
+        unsigned char diff;
+
+        *reg = (unsigned char)((*reg & ~tris) | (cpu->pin_in[port] & tris));
+
+        /* Output edges (the LCD port is not logged) */
+        out = (unsigned char)(*reg & ~tris);
+        diff = (unsigned char)(out ^ cpu->out_prev[port]);
+        cpu->out_prev[port] = out;
+        if((diff == 0) || (port == SIM_PORTC))
+            continue;
+        for(unsigned char pin = 0; pin < 8; pin++)
+        {
+            if(((diff >> pin) & 1) && (cpu->edge_count < SIM_EDGE_LOG_SIZE))
+            {
+                SIM_edge_t *edge = &cpu->edges[cpu->edge_count++];
+                edge->time = cpu->now;
+                edge->port = port;
+                edge->pin = pin;
+                edge->level = (out >> pin) & 1;
+            }
+        }
+    }
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_EepromSync( void )
+* \Description     : Observes the data EEPROM registers: read (RD), unlock
+                     sequence (0x55, 0xAA written to EECON2 by two
+                     consecutive accesses) and start of a write (WR).
+*******************************************************************************/
+static void SIM_EepromSync(void)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+    SIM_regfile_t *r = &cpu->regs;
+    unsigned char unlock = r->eecon2;
+
+    r->eecon2 = 0;                              /* Not a physical register */
+
+    if(r->eecon1 & EECON1_RD)
+    {
+        if(!(r->eecon1 & EECON1_EEPGD))
+        {
+            r->eedat = cpu->eeprom[r->eeadr % SIM_EEPROM_SIZE];
+            cpu->stats.eeprom_reads++;
+        }
+        r->eecon1 &= (unsigned char)~EECON1_RD;
+    }
+
+    if(unlock == 0x55)
+    {
+        cpu->ee_unlock = 1;
+    }
+    else if((unlock == 0xAA) && (cpu->ee_unlock == 1))
+    {
+        cpu->ee_unlock = 2;
+    }
+    else if((r->eecon1 & EECON1_WR) && !cpu->ee_busy)
+    {
+        if((cpu->ee_unlock == 2) && (r->eecon1 & EECON1_WREN))
+        {
+            cpu->ee_busy = 1;
+            cpu->ee_done = cpu->now + SIM_EEPROM_WRITE_CYCLES;
+            cpu->ee_address = r->eeadr % SIM_EEPROM_SIZE;
+            cpu->ee_data = r->eedat;
+        }
+        else
+        {
+            r->eecon1 &= (unsigned char)~EECON1_WR;     /* Not unlocked: ignored */
+        }
+        cpu->ee_unlock = 0;
+    }
+    else
+    {
+        cpu->ee_unlock = 0;
+    }
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_SetClockDiv( unsigned int div )
+* \Description     : Changes the cycles per instruction, the timer prescaler
+                     counts (instructions) are kept.
+*******************************************************************************/
+static void SIM_SetClockDiv(unsigned int div)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+
+    cpu->t0_prescaler = cpu->t0_prescaler / cpu->clock_div * div;
+    cpu->t1_prescaler = cpu->t1_prescaler / cpu->clock_div * div;
+    cpu->t2_prescaler = cpu->t2_prescaler / cpu->clock_div * div;
+    cpu->clock_div = div;
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_OscStatus( void )
+* \Description     : Updates the read-only OSCCON bits: OSTS while the crystal
+                     runs the device, HTS/LTS while the internal oscillator
+                     does (switch requested or crystal starting up).
+*******************************************************************************/
+static void SIM_OscStatus(void)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+    unsigned char status;
+
+    if((cpu->osc_seen & OSCCON_SCS) || cpu->ost_busy)
+        status = (cpu->osc_seen & OSCCON_IRCF) ? OSCCON_HTS : OSCCON_LTS;
+    else
+        status = OSCCON_OSTS;
+    cpu->regs.osccon = (unsigned char)(cpu->osc_seen | status);
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_OscSync( void )
+* \Description     : Observes OSCCON: SCS set runs the device on the internal
+                     oscillator at once (IRCF, the crystal stops), SCS cleared
+                     starts the crystal, which takes over after its start-up
+                     timer (the internal oscillator runs meanwhile).
+*******************************************************************************/
+static void SIM_OscSync(void)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+    unsigned char osc = cpu->regs.osccon & (OSCCON_SCS | OSCCON_IRCF);
+    unsigned char ircf = (osc & OSCCON_IRCF) >> 4;
+    unsigned long hz = (ircf == 0) ? SIM_LFINTOSC_HZ : (62500UL << ircf);
+
+    if(osc != cpu->osc_seen)
+    {
+        if((osc & OSCCON_SCS) && !(cpu->osc_seen & OSCCON_SCS))
+        {
+            cpu->ost_busy = 0;
+            cpu->stats.clock_switches++;
+        }
+        else if(!(osc & OSCCON_SCS) && (cpu->osc_seen & OSCCON_SCS))
+        {
+            cpu->ost_busy = 1;
+            cpu->ost_done = cpu->now + SIM_OST_CYCLES;
+            cpu->stats.clock_switches++;
+        }
+        cpu->osc_seen = osc;
+
+        /* Internal oscillator (rounded, 8 MHz is not modelled faster than the crystal) */
+        if((osc & OSCCON_SCS) || cpu->ost_busy)
+            SIM_SetClockDiv((hz >= SIM_FOSC_HZ) ? 1 : (unsigned int)((SIM_FOSC_HZ + hz / 2) / hz));
+    }
+    SIM_OscStatus();
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned long long SIM_UartByteCycles( void )
+* \Description     : Returns the cycles of one asynchronous character (start
+                     bit, 8 or 9 data bits, stop bit) at the current baud rate
+                     generator settings and system clock.
+*******************************************************************************/
+static unsigned long long SIM_UartByteCycles(void)
+{
+    SIM_regfile_t *r = &SIM_cpu->regs;
+    unsigned char brg16 = (r->baudctl & BAUDCTL_BRG16) != 0;
+    unsigned char brgh = (r->txsta & TXSTA_BRGH) != 0;
+    unsigned int n = brg16 ? (((unsigned int)r->spbrgh << 8) | r->spbrg) : r->spbrg;
+    unsigned int tosc = (brg16 && brgh) ? 4 : ((brg16 || brgh) ? 16 : 64);     /* Tosc per bit / (n + 1) */
+    unsigned int bits = (r->txsta & TXSTA_TX9) ? 11 : 10;
+    unsigned long long cycles = (unsigned long long)bits * tosc * (n + 1ULL) * SIM_cpu->clock_div / 4;
+
+    return cycles ? cycles : 1;
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_UartStatus( void )
+* \Description     : Updates TRMT (TSR empty) and TXIF (transmitter enabled
+                     and TXREG empty).
+*******************************************************************************/
+static void SIM_UartStatus(void)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+    SIM_regfile_t *r = &cpu->regs;
+
+    if(cpu->tx_busy)
+        r->txsta &= (unsigned char)~TXSTA_TRMT;
+    else
+        r->txsta |= TXSTA_TRMT;
+
+    if((r->rcsta & RCSTA_SPEN) && (r->txsta & TXSTA_TXEN) && !cpu->tx_full)
+        r->pir1 |= PIR1_TXIF;
+    else
+        r->pir1 &= (unsigned char)~PIR1_TXIF;
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_UartSync( void )
+* \Description     : Observes the EUSART transmitter: a byte written to TXREG
+                     goes to the TSR at once when it is empty, else it waits
+                     in TXREG (TXIF cleared). Clearing TXEN or SPEN resets the
+                     transmitter. Only the asynchronous mode is modelled.
+*******************************************************************************/
+static void SIM_UartSync(void)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+    SIM_regfile_t *r = &cpu->regs;
+
+    if(!(r->rcsta & RCSTA_SPEN) || !(r->txsta & TXSTA_TXEN) || (r->txsta & TXSTA_SYNC))
+    {
+        cpu->tx_busy = 0;
+        cpu->tx_full = 0;
+        cpu->tx_written = 0;
+    }
+    else if(cpu->tx_written)
+    {
+        cpu->tx_written = 0;
+        if(!cpu->tx_busy)
+        {
+            cpu->tx_shift = r->txreg;
+            cpu->tx_busy = 1;
+            cpu->tx_done = cpu->now + SIM_UartByteCycles();
+            cpu->stats.uart_cycles += SIM_UartByteCycles();
+        }
+        else if(!cpu->tx_full)
+        {
+            cpu->tx_next = r->txreg;
+            cpu->tx_full = 1;
+        }
+        else
+        {
+            cpu->stats.uart_overruns++;
+        }
+    }
+    SIM_UartStatus();
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_UartSent( unsigned char value )
+* \Description     : Logs a byte whose stop bit ended and copies it to the
+                     output stream.
+*******************************************************************************/
+static void SIM_UartSent(unsigned char value)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+
+    cpu->stats.uart_bytes++;
+    if(cpu->uart_count < SIM_UART_LOG_SIZE)
+    {
+        cpu->uart_log[cpu->uart_count].time = cpu->tx_done;
+        cpu->uart_log[cpu->uart_count].value = value;
+        cpu->uart_count++;
+    }
+    if(cpu->uart_out)
+        fputc(value, cpu->uart_out);
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_Written( void )
+* \Description     : Counts a write if the register returned by the last
+                     access changed before the next simulator call (only the
+                     firmware ran in between, a write of the same value is not
+                     seen). An interrupt flag, enable or watchdog write does
+                     not move the next event (quiet_until) and SIM_Sync() has
+                     nothing to observe: only the pending interrupts are
+                     checked again.
+*******************************************************************************/
+static void SIM_Written(void)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+    SIM_regfile_t *r = &cpu->regs;
+    const volatile unsigned char *p = (const volatile unsigned char *)cpu->write_reg;
+
+    if(p && (*p != cpu->write_value))
+    {
+        cpu->stats.sfr_writes++;
+        if((p == &r->intcon) || (p == &r->pir1) || (p == &r->pir2) || (p == &r->pie1) || (p == &r->pie2) ||
+           (p == &r->wdtcon))
+        {
+            cpu->irq_check = 1;
+        }
+        else
+        {
+            cpu->sync_due = 1;
+            cpu->quiet_until = 0;       /* May start a peripheral */
+        }
+    }
+    cpu->write_reg = 0;
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_Returned( volatile void *reg )
+* \Description     : Remembers the register returned to the firmware and its
+                     value, checked by SIM_Written().
+*******************************************************************************/
+static void SIM_Returned(volatile void *reg)
+{
+    SIM_cpu->write_reg = reg;
+    SIM_cpu->write_value = *(volatile unsigned char *)reg;
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_CatchUp( void )
+* \Description     : Runs the peripherals for the cycles of the accesses that
+                     took the fast path (no event in between, so one step
+                     gives the same timers as one step per access).
+*******************************************************************************/
+static void SIM_CatchUp(void)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+    unsigned long long cycles = cpu->lazy_cycles;
+
+    if(cycles == 0)
+        return;
+    cpu->lazy_cycles = 0;
+    cpu->now -= cycles;
+    SIM_Peripherals(cycles);
+    cpu->now += cycles;
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_Sync( void )
+* \Description     : Observes the effect of the firmware since the previous
+                     synchronization (pins, LCD, ADC start).
+*******************************************************************************/
+static void SIM_Sync(void)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+
+    SIM_CatchUp();
+    SIM_Written();
+
+    /* Nothing written since the previous synchronization (an EEPROM unlock sequence breaks on any access) */
+    if(!cpu->sync_due && !cpu->tx_written && !cpu->ee_unlock)
+        return;
+    cpu->sync_due = 0;
+    cpu->quiet_until = 0;               /* A peripheral may start */
+
+    SIM_SyncPorts();
+    SIM_LCD_Sync(0);
+    SIM_EepromSync();
+    SIM_OscSync();
+    SIM_UartSync();
+
+    /* TMR2 or T2CON written: the prescaler and the postscaler are cleared */
+    if((cpu->regs.tmr2 != cpu->tmr2_seen) || (cpu->regs.t2con != cpu->t2con_seen))
+    {
+        cpu->tmr2_seen = cpu->regs.tmr2;
+        cpu->t2con_seen = cpu->regs.t2con;
+        cpu->t2_prescaler = 0;
+        cpu->t2_postscaler = 0;
+    }
+
+    /* ADC channel switch: the hold capacitor starts charging */
+    if(((cpu->regs.adcon0 >> 2) & 0x0F) != cpu->adc_chs)
+    {
+        cpu->adc_chs = (cpu->regs.adcon0 >> 2) & 0x0F;
+        cpu->adc_switch = cpu->now;
+    }
+
+    /* ADC conversion started (GO set while the module is on) */
+    if((cpu->regs.adcon0 & ADCON0_GO) && (cpu->regs.adcon0 & ADCON0_ADON))
+    {
+        if(!cpu->adc_busy)
+        {
+            cpu->stats.adc_conversions++;
+            if(cpu->now - cpu->adc_switch < SIM_ADC_TACQ_CYCLES)
+                cpu->stats.adc_short_acq++;
+
+            unsigned char adcs = cpu->regs.adcon0 >> 6;
+            unsigned long long conversion;
+
+            if(adcs == 3)                                   /* Frc: TAD = 4 us */
+                conversion = (unsigned long long)(11 * 4 * SIM_CYCLES_PER_US);
+            else                                            /* Fosc/2, /8, /32 */
+                conversion = (11ULL * (2U << (2 * adcs)) * cpu->clock_div) / 4 + 1;
+            cpu->adc_busy = 1;
+            cpu->adc_done = cpu->now + conversion;
+        }
+    }
+    else
+    {
+        cpu->adc_busy = 0;      /* Conversion aborted */
+    }
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned char SIM_Pollable( volatile void *reg )
+* \Description     : Returns 1 if a peripheral event can change the register
+                     (flags, timers, ADC, ports with input pins), writes to
+                     output ports or configuration registers are not polling.
+*******************************************************************************/
+static unsigned char SIM_Pollable(volatile void *reg)
+{
+    SIM_regfile_t *r = &SIM_cpu->regs;
+    const volatile unsigned char *p = (const volatile unsigned char *)reg;
+
+    for(unsigned char port = SIM_PORTA; port <= SIM_PORTC; port++)
+    {
+        if(p == SIM_Port(port))
+            return SIM_Tris(port) != 0x00;
+    }
+    return (p == &r->intcon) || (p == &r->pir1) || (p == &r->pir2) || (p == &r->adcon0) || (p == &r->eecon1) ||
+           (p == &r->txsta) || (p == &r->tmr0) || (p == &r->tmr2) ||
+           ((p >= (const volatile unsigned char *)&r->tmr1) && (p < (const volatile unsigned char *)(&r->tmr1 + 1)));
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned int SIM_T0Prescale( void ) ...
+* \Description     : Timer prescalers in cycles (0 if the timer is not counting,
+                     the oscillator is stopped in sleep mode).
+*******************************************************************************/
+static unsigned int SIM_T0Prescale(void)
+{
+    unsigned char option = SIM_cpu->regs.option_reg;
+
+    if(SIM_cpu->sleeping)
+        return 0;
+    if(option & 0x20)                       /* T0CS: T0CKI pin, not driven */
+        return 0;
+    if(option & 0x08)                       /* PSA: prescaler assigned to WDT */
+        return SIM_cpu->clock_div;
+    return (2U << (option & 0x07)) * SIM_cpu->clock_div;
+}
+
+static unsigned int SIM_T1Prescale(void)
+{
+    unsigned char t1con = SIM_cpu->regs.t1con;
+
+    if(SIM_cpu->sleeping)
+        return 0;
+    if(!(t1con & 0x01) || (t1con & 0x02))   /* Off or external clock */
+        return 0;
+    return (1U << ((t1con >> 4) & 0x03)) * SIM_cpu->clock_div;
+}
+
+static unsigned int SIM_T2Prescale(void)
+{
+    unsigned char t2con = SIM_cpu->regs.t2con;
+
+    if(SIM_cpu->sleeping || !(t2con & 0x04))
+        return 0;
+    switch(t2con & 0x03)
+    {
+        case 0:
+            return SIM_cpu->clock_div;
+        case 1:
+            return 4 * SIM_cpu->clock_div;
+        default:
+            return 16 * SIM_cpu->clock_div;
+    }
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned long long SIM_NextEvent( unsigned char polling )
+* \Description     : Returns the virtual time of the next peripheral event
+                     (timer interrupt, ADC completion, crystal start-up, end
+                     of an EUSART character, scheduled input or stop time of
+                     SIM_StopAt). A timer overflow with its interrupt disabled
+                     is an event only for a polling loop (polling = 1): code
+                     that touches no SFR cannot see its flag.
+*******************************************************************************/
+static unsigned long long SIM_NextEvent(unsigned char polling)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+    SIM_regfile_t *r = &cpu->regs;
+    unsigned long long next = SIM_NEVER;
+    unsigned long long t;
+    unsigned int ps;
+
+    if((polling || (r->intcon & INTCON_T0IE)) && ((ps = SIM_T0Prescale()) != 0))
+    {
+        t = cpu->now + (256ULL - r->tmr0) * ps - cpu->t0_prescaler;
+        if(t < next)
+            next = t;
+    }
+    if((polling || (r->pie1 & PIR1_TMR1IF)) && ((ps = SIM_T1Prescale()) != 0))
+    {
+        t = cpu->now + (65536ULL - r->tmr1) * ps - cpu->t1_prescaler;
+        if(t < next)
+            next = t;
+    }
+    if((polling || (r->pie1 & PIR1_TMR2IF)) && ((ps = SIM_T2Prescale()) != 0))
+    {
+        unsigned int postscale = ((r->t2con >> 3) & 0x0F) + 1U;
+        unsigned long long counts = ((unsigned char)(r->pr2 - r->tmr2)) + 1ULL
+                                  + (unsigned long long)(postscale - 1U - cpu->t2_postscaler) * (r->pr2 + 1ULL);
+        t = cpu->now + counts * ps - cpu->t2_prescaler;
+        if(t < next)
+            next = t;
+    }
+    if(cpu->adc_busy && (cpu->adc_done < next))
+        next = cpu->adc_done;
+    if(cpu->ee_busy && (cpu->ee_done < next))
+        next = cpu->ee_done;
+    if(cpu->ost_busy && (cpu->ost_done < next))
+        next = cpu->ost_done;
+    if(cpu->tx_busy && !cpu->sleeping && (cpu->tx_done < next))
+        next = cpu->tx_done;
+    if(cpu->input_count && (cpu->inputs[0].time < next))
+        next = cpu->inputs[0].time;
+    if((cpu->stop > cpu->now) && (cpu->stop < next))
+        next = cpu->stop;
+    return next;
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_Peripherals( unsigned long long cycles )
+* \Description     : Runs the timers, the ADC, the EEPROM, the oscillator
+                     start-up and the EUSART for a number of cycles.
+*******************************************************************************/
+static void SIM_Peripherals(unsigned long long cycles)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+    SIM_regfile_t *r = &cpu->regs;
+    unsigned long long counts;
+    unsigned int ps;
+
+    if(!cpu->sleeping && ((cpu->osc_seen & OSCCON_SCS) || cpu->ost_busy))
+        cpu->stats.intosc_cycles += cycles;
+
+    /* Timer0 */
+    if((ps = SIM_T0Prescale()) != 0)
+    {
+        counts = (cpu->t0_prescaler + cycles) / ps;
+        cpu->t0_prescaler = (unsigned int)((cpu->t0_prescaler + cycles) % ps);
+        if(r->tmr0 + counts > 0xFF)
+            r->intcon |= INTCON_T0IF;
+        r->tmr0 = (unsigned char)(r->tmr0 + counts);
+    }
+
+    /* Timer1 */
+    if((ps = SIM_T1Prescale()) != 0)
+    {
+        counts = (cpu->t1_prescaler + cycles) / ps;
+        cpu->t1_prescaler = (unsigned int)((cpu->t1_prescaler + cycles) % ps);
+        if(r->tmr1 + counts > 0xFFFF)
+            r->pir1 |= PIR1_TMR1IF;
+        r->tmr1 = (unsigned short)(r->tmr1 + counts);
+    }
+
+    /* Timer2 (match with PR2 resets the timer and clocks the postscaler) */
+    if((ps = SIM_T2Prescale()) != 0)
+    {
+        unsigned int postscale = ((r->t2con >> 3) & 0x0F) + 1U;
+
+        counts = (cpu->t2_prescaler + cycles) / ps;
+        cpu->t2_prescaler = (unsigned int)((cpu->t2_prescaler + cycles) % ps);
+        while(counts)
+        {
+            unsigned char distance = (unsigned char)(r->pr2 - r->tmr2);
+
+            if(distance == 0)
+            {
+                r->tmr2 = 0;
+                counts--;
+                if(++cpu->t2_postscaler >= postscale)
+                {
+                    cpu->t2_postscaler = 0;
+                    r->pir1 |= PIR1_TMR2IF;
+                }
+            }
+            else if(counts < distance)
+            {
+                r->tmr2 = (unsigned char)(r->tmr2 + counts);
+                counts = 0;
+            }
+            else
+            {
+                r->tmr2 = r->pr2;
+                counts -= distance;
+            }
+        }
+        cpu->tmr2_seen = r->tmr2;
+    }
+
+    /* ADC conversion complete */
+    if(cpu->adc_busy && (cpu->now + cycles >= cpu->adc_done))
+    {
+        unsigned char channel = (r->adcon0 >> 2) & 0x0F;
+        unsigned int value = (channel < SIM_ADC_CHANNELS) ? cpu->analog[channel] : 0;
+
+        if(r->adcon1 & 0x80)            /* Right justified */
+        {
+            r->adresh = (unsigned char)(value >> 8);
+            r->adresl = (unsigned char)value;
+        }
+        else                            /* Left justified */
+        {
+            r->adresh = (unsigned char)(value >> 2);
+            r->adresl = (unsigned char)(value << 6);
+        }
+        r->adcon0 &= (unsigned char)~ADCON0_GO;
+        r->pir1 |= PIR1_ADIF;
+        cpu->adc_busy = 0;
+    }
+
+    /* Data EEPROM write complete */
+    if(cpu->ee_busy && (cpu->now + cycles >= cpu->ee_done))
+    {
+        cpu->eeprom[cpu->ee_address] = cpu->ee_data;
+        r->eecon1 &= (unsigned char)~EECON1_WR;
+        r->pir2 |= PIR2_EEIF;
+        cpu->ee_busy = 0;
+        cpu->ee_wear[cpu->ee_address]++;
+        cpu->stats.eeprom_writes++;
+    }
+
+    /* EUSART: character sent, the next one (TXREG) goes to the TSR. The baud rate generator stops in sleep mode. */
+    if(cpu->tx_busy)
+    {
+        if(cpu->sleeping)
+        {
+            cpu->tx_done += cycles;
+        }
+        else
+        {
+            while(cpu->tx_busy && (cpu->now + cycles >= cpu->tx_done))
+            {
+                SIM_UartSent(cpu->tx_shift);
+                if(cpu->tx_full)
+                {
+                    cpu->tx_shift = cpu->tx_next;
+                    cpu->tx_full = 0;
+                    cpu->tx_done += SIM_UartByteCycles();
+                    cpu->stats.uart_cycles += SIM_UartByteCycles();
+                }
+                else
+                {
+                    cpu->tx_busy = 0;
+                    if(cpu->uart_out)
+                        fflush(cpu->uart_out);      /* End of a burst */
+                }
+            }
+        }
+        SIM_UartStatus();
+    }
+
+    /* Crystal started up: it runs the device from now on */
+    if(cpu->ost_busy && (cpu->now + cycles >= cpu->ost_done))
+    {
+        cpu->ost_busy = 0;
+        SIM_SetClockDiv(1);
+        SIM_OscStatus();
+    }
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_ApplyInput( port, pin, level )
+* \Description     : Changes the external level of a pin (interrupt-on-change).
+*******************************************************************************/
+static void SIM_ApplyInput(unsigned char port, unsigned char pin, unsigned char level)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+    unsigned char mask = (unsigned char)(1 << pin);
+    unsigned char old = cpu->pin_in[port];
+
+    if(level)
+        cpu->pin_in[port] |= mask;
+    else
+        cpu->pin_in[port] &= (unsigned char)~mask;
+
+    if((port == SIM_PORTB) && ((old ^ cpu->pin_in[port]) & mask & cpu->regs.iocb & cpu->regs.trisb))
+        cpu->regs.intcon |= INTCON_RBIF;
+
+    SIM_SyncPorts();
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_ApplyInputs( void )
+* \Description     : Applies the scheduled input changes that are due.
+*******************************************************************************/
+static void SIM_ApplyInputs(void)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+
+    while(cpu->input_count && (cpu->inputs[0].time <= cpu->now))
+    {
+        SIM_input_t input = cpu->inputs[0];
+        cpu->input_count--;
+        memmove(&cpu->inputs[0], &cpu->inputs[1], cpu->input_count * sizeof(SIM_input_t));
+        if(input.port == SIM_ANALOG)
+            SIM_SetAnalog(input.pin, input.level);
+        else
+            SIM_ApplyInput(input.port, input.pin, (unsigned char)input.level);
+    }
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_Schedule( time, port, pin, level )
+* \Description     : Inserts an input change in the queue (sorted by time,
+                     stable for equal times), dropped if the queue is full.
+*******************************************************************************/
+static void SIM_Schedule(unsigned long long time, unsigned char port, unsigned char pin, unsigned int level)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+    unsigned int i;
+
+    if(cpu->input_count >= SIM_INPUT_QUEUE_SIZE)
+        return;
+
+    /* Keep the queue sorted by time (stable for equal times) */
+    i = cpu->input_count;
+    while((i > 0) && (cpu->inputs[i - 1].time > time))
+    {
+        cpu->inputs[i] = cpu->inputs[i - 1];
+        i--;
+    }
+    cpu->inputs[i].time = time;
+    cpu->inputs[i].port = port;
+    cpu->inputs[i].pin = pin;
+    cpu->inputs[i].level = level;
+    cpu->input_count++;
+    cpu->quiet_until = 0;
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned char SIM_WakePending( void )
+* \Description     : Returns 1 if an interrupt flag is set with its enable bit
+                     (wakes the device up whatever GIE is).
+*******************************************************************************/
+static unsigned char SIM_WakePending(void)
+{
+    SIM_regfile_t *r = &SIM_cpu->regs;
+
+    if((r->intcon & INTCON_RBIF) && (r->intcon & INTCON_RBIE))
+        return 1;
+    if((r->intcon & INTCON_T0IF) && (r->intcon & INTCON_T0IE))
+        return 1;
+    if((r->intcon & INTCON_INTF) && (r->intcon & INTCON_INTE))
+        return 1;
+    if((r->intcon & INTCON_PEIE) && ((r->pir1 & r->pie1) || (r->pir2 & r->pie2)))
+        return 1;
+    return 0;
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned char SIM_IrqPending( void )
+* \Description     : Returns 1 if an enabled interrupt is pending.
+*******************************************************************************/
+static unsigned char SIM_IrqPending(void)
+{
+    return (SIM_cpu->regs.intcon & INTCON_GIE) && SIM_WakePending();
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned long long SIM_WdtPeriod( void )
+* \Description     : Returns the watchdog time-out (cycles): WDTPS prescaler
+                     and the OPTION_REG prescaler when it is assigned to the
+                     watchdog (PSA).
+*******************************************************************************/
+static unsigned long long SIM_WdtPeriod(void)
+{
+    SIM_regfile_t *r = &SIM_cpu->regs;
+    unsigned long long counts = 32ULL << ((r->wdtcon >> 1) & 0x0F);
+
+    if(r->option_reg & 0x08)
+        counts <<= (r->option_reg & 0x07);
+    return counts * (SIM_FOSC_HZ / 4) / SIM_LFINTOSC_HZ;
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_Interrupts( void )
+* \Description     : Dispatches myISR() if an interrupt is pending (GIE is
+                     cleared during the ISR like the hardware does).
+*******************************************************************************/
+static void SIM_Interrupts(void)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+    unsigned long long start;
+
+    if(cpu->in_isr || !SIM_IrqPending())
+        return;
+
+    start = cpu->now;
+    cpu->in_isr = 1;
+    cpu->regs.intcon &= (unsigned char)~INTCON_GIE;
+    cpu->stats.isr_calls++;
+    cpu->now += SIM_ISR_LATENCY * cpu->clock_div;
+    cpu->last_reg = 0;
+    myISR();
+    SIM_Sync();                             /* The last writes of the ISR (e.g. TXREG) take effect now */
+    cpu->regs.intcon |= INTCON_GIE;        /* RETFIE */
+    cpu->last_reg = 0;
+    cpu->in_isr = 0;
+    cpu->quiet_until = 0;                   /* Set in the ISR: another interrupt may be pending */
+
+    cpu->stats.isr_cycles += cpu->now - start;
+    if(cpu->now - start > cpu->stats.isr_max_cycles)
+        cpu->stats.isr_max_cycles = cpu->now - start;
+}
+
+
+/**********************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void SIM_Reset( void )
+* \Description     : Power-on reset of the register file, the peripherals,
+                     the LCD model, the statistics and the virtual clock.
+*******************************************************************************/
+void SIM_Reset(void)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+    SIM_lcd_t lcd = cpu->lcd;           /* The wiring and the callback survive a reset */
+    FILE *uart_out = cpu->uart_out;
+
+    memset(cpu, 0, sizeof(*cpu));
+    cpu->regs.trisa = 0xFF;
+    cpu->regs.trisb = 0xFF;
+    cpu->regs.trisc = 0xFF;
+    cpu->regs.ansel = 0xFF;
+    cpu->regs.anselh = 0x3F;
+    cpu->regs.wpub = 0xFF;
+    cpu->regs.iocb = 0x00;
+    cpu->regs.option_reg = 0xFF;
+    cpu->regs.wdtcon = 0x08;            /* WDTPS 1:512, SWDTEN off */
+    cpu->regs.status = STATUS_NTO | STATUS_NPD;
+    cpu->regs.osccon = 0x60 | OSCCON_OSTS;  /* IRCF 4 MHz, running on the crystal (FOSC = HS) */
+    cpu->osc_seen = 0x60;
+    cpu->clock_div = 1;
+    cpu->regs.pr2 = 0xFF;
+    cpu->regs.txsta = TXSTA_TRMT;
+    cpu->regs.baudctl = 0x40;           /* RCIDL */
+    cpu->uart_out = uart_out;
+    cpu->pin_in[SIM_PORTB] = 0xFF;      /* Push buttons are active low */
+    cpu->sync_due = 1;
+
+    /* Programmed data EEPROM */
+    memset(cpu->eeprom, 0xFF, sizeof(cpu->eeprom));
+    memcpy(cpu->eeprom, sim_eeprom_image, sim_eeprom_image_size);
+
+    cpu->lcd.attached = lcd.attached;
+    cpu->lcd.port = lcd.port;
+    cpu->lcd.rs = lcd.rs;
+    cpu->lcd.en = lcd.en;
+    cpu->lcd.rw = lcd.rw;
+    memcpy(cpu->lcd.d, lcd.d, sizeof(lcd.d));
+    cpu->lcd.on_change = lcd.on_change;
+    SIM_LCD_Reset(&cpu->lcd);
+
+    SIM_SyncPorts();
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_PowerCycle( void )
+* \Description     : Power loss and power-on reset: same as SIM_Reset() but
+                     the data EEPROM keeps its contents and its wear counts,
+                     a write in progress is torn (the cell gets the low nibble
+                     of the new byte and keeps the high nibble of the old one).
+*******************************************************************************/
+void SIM_PowerCycle(void)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+    unsigned char eeprom[SIM_EEPROM_SIZE];
+    unsigned long wear[SIM_EEPROM_SIZE];
+
+    if(cpu->ee_busy)
+        cpu->eeprom[cpu->ee_address] = (unsigned char)((cpu->eeprom[cpu->ee_address] & 0xF0) | (cpu->ee_data & 0x0F));
+    memcpy(eeprom, cpu->eeprom, sizeof(eeprom));
+    memcpy(wear, cpu->ee_wear, sizeof(wear));
+    SIM_Reset();
+    memcpy(cpu->eeprom, eeprom, sizeof(eeprom));
+    memcpy(cpu->ee_wear, wear, sizeof(wear));
+}
+
+/******************************************************************************
+* \Syntax          : unsigned long SIM_InstanceSize( void )
+* \Description     : Returns the size of a simulated microcontroller (the
+                     memory given to SIM_Select()).
+*******************************************************************************/
+unsigned long SIM_InstanceSize(void)
+{
+    return sizeof(SIM_cpu_t);
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_Select( void *instance )
+* \Description     : Makes instance the simulated microcontroller every other
+                     function works on (NULL: the default one). A new instance
+                     (SIM_InstanceSize() bytes, zeroed) is started with
+                     SIM_Reset().
+*******************************************************************************/
+void SIM_Select(void *instance)
+{
+    SIM_cpu = (instance != NULL) ? (SIM_cpu_t *)instance : &sim_default;
+    SIM_regs = &SIM_cpu->regs;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned long long SIM_Now( void )
+* \Description     : Returns the virtual time in instruction cycles.
+*******************************************************************************/
+unsigned long long SIM_Now(void)
+{
+    return SIM_cpu->now;
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_Advance( unsigned long long cycles )
+* \Description     : Advances the virtual time (peripherals, inputs and
+                     interrupts are processed on the way).
+*******************************************************************************/
+void SIM_Advance(unsigned long long cycles)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+    unsigned long long end;
+
+    SIM_CatchUp();
+    SIM_Written();
+    end = cpu->now + cycles;
+    while(cpu->now < end)
+    {
+        unsigned long long next;
+        unsigned long long step;
+        unsigned long long before;
+
+        /* An interrupt enabled or flagged by the firmware itself (e.g. TXIE, TXIF) runs before the next step */
+        before = cpu->now;
+        SIM_Interrupts();
+        end += cpu->now - before;
+
+        next = SIM_NextEvent(0);
+        step = end - cpu->now;
+        if((next != SIM_NEVER) && (next > cpu->now) && (next - cpu->now < step))
+            step = next - cpu->now;
+
+        SIM_Peripherals(step);
+        cpu->now += step;
+
+        SIM_ApplyInputs();      /* Scheduled inputs */
+
+        /* The ISR runs in the middle of the busy-wait and makes it longer */
+        before = cpu->now;
+        SIM_Interrupts();
+        end += cpu->now - before;
+    }
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned char SIM_Timing( volatile void *reg )
+* \Description     : Returns 1 for a timer register, a timer or clock
+                     configuration register: its cycles run at once, before
+                     the firmware writes it.
+*******************************************************************************/
+static unsigned char SIM_Timing(volatile void *reg)
+{
+    unsigned long offset = (unsigned long)((const volatile unsigned char *)reg - &SIM_cpu->regs.porta);
+
+    return (offset < 64) && ((SIM_TIMING_REGS >> offset) & 1);
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_Quiet( volatile void *reg )
+* \Description     : Sets the end of the access fast path after a synchronized
+                     access: the next event (timer flags included, a polling
+                     loop is not needed to read them). None while an
+                     interrupt waits for dispatch or after a timer access
+                     (a write may follow, SIM_Written() does not see a 16-bit
+                     TMR1 write).
+*******************************************************************************/
+static void SIM_Quiet(volatile void *reg)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+
+    if((!cpu->in_isr && SIM_IrqPending()) || SIM_Timing(reg))
+        cpu->quiet_until = 0;
+    else
+        cpu->quiet_until = SIM_NextEvent(1);
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned char SIM_Defer( unsigned long long cycles )
+* \Description     : Advances the virtual time without running the
+                     peripherals if no event or interrupt comes before the end
+                     (SIM_CatchUp() runs them at the next synchronization).
+                     Returns 0 if SIM_Advance() is needed.
+*******************************************************************************/
+static unsigned char SIM_Defer(unsigned long long cycles)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+
+    if(cpu->irq_check)
+    {
+        cpu->irq_check = 0;
+        if(!cpu->in_isr && SIM_IrqPending())
+            cpu->quiet_until = 0;
+    }
+    if(cpu->now + cycles >= cpu->quiet_until)
+        return 0;
+    cpu->now += cycles;
+    cpu->lazy_cycles += cycles;
+    return 1;
+}
+
+/******************************************************************************
+* \Syntax          : volatile void *SIM_Access( volatile void *reg )
+* \Description     : Synchronizes the simulator before an SFR access (virtual
+                     time, peripherals, interrupts) and returns the register.
+*******************************************************************************/
+volatile void *SIM_Access(volatile void *reg)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+    unsigned char spinning = 0;
+
+    cpu->stats.sfr_accesses++;
+
+    /* Polling: the same register, which a peripheral event may change, is read again and again without changing */
+    if((reg == cpu->last_reg) && (*(volatile unsigned char *)reg == cpu->last_value) && SIM_Pollable(reg))
+    {
+        if(cpu->same_reg_count < SIM_SPIN_THRESHOLD)
+            cpu->same_reg_count++;
+        spinning = (cpu->same_reg_count >= SIM_SPIN_THRESHOLD);
+    }
+    else
+    {
+        cpu->last_reg = reg;
+        cpu->same_reg_count = 1;
+    }
+    cpu->last_value = *(volatile unsigned char *)reg;
+
+    /* Fast path: no event comes before the end of this access, after the effect of a write is observed */
+    SIM_Written();
+    if(!spinning && !cpu->tx_written && !SIM_Timing(reg) && SIM_Defer(SIM_ACCESS_CYCLES * cpu->clock_div))
+    {
+        SIM_Returned(reg);
+        return reg;
+    }
+
+    SIM_Sync();
+
+    if(!spinning)
+    {
+        SIM_Quiet(reg);
+        if(SIM_Defer(SIM_ACCESS_CYCLES * cpu->clock_div))
+        {
+            SIM_Returned(reg);
+            return reg;
+        }
+    }
+    else
+    {
+        unsigned long long next = SIM_NextEvent(1);
+
+        if((next != SIM_NEVER) && (next > cpu->now + SIM_ACCESS_CYCLES * cpu->clock_div))
+        {
+            cpu->stats.spin_cycles += next - cpu->now;
+            SIM_Advance(next - cpu->now);
+            SIM_Sync();
+            SIM_Quiet(reg);
+            SIM_Returned(reg);
+            return reg;
+        }
+    }
+    SIM_Advance(SIM_ACCESS_CYCLES * cpu->clock_div);
+    SIM_Quiet(reg);
+    SIM_Returned(reg);
+    return reg;
+}
+
+/******************************************************************************
+* \Syntax          : volatile void *SIM_AccessIndirect( volatile void *reg )
+* \Description     : Same as SIM_Access() for an SFR accessed through a
+                     pointer (FSR/INDF, charged SIM_INDIRECT_CYCLES).
+*******************************************************************************/
+volatile void *SIM_AccessIndirect(volatile void *reg)
+{
+    SIM_cpu->stats.sfr_indirect++;
+    SIM_Advance((SIM_INDIRECT_CYCLES - SIM_ACCESS_CYCLES) * SIM_cpu->clock_div);
+    return SIM_Access(reg);
+}
+
+/******************************************************************************
+* \Syntax          : volatile void *SIM_AccessTxreg( void )
+* \Description     : Same as SIM_Access() for TXREG, the byte written is
+                     loaded into the EUSART transmitter at the next access.
+*******************************************************************************/
+volatile void *SIM_AccessTxreg(void)
+{
+    volatile void *reg = SIM_Access(&SIM_cpu->regs.txreg);
+
+    SIM_cpu->tx_written = 1;
+    SIM_cpu->last_reg = 0;
+    return reg;
+}
+
+/******************************************************************************
+* \Syntax          : void _delay( unsigned long cycles )
+* \Description     : Virtual busy-wait of a number of instruction cycles.
+*******************************************************************************/
+void _delay(unsigned long cycles)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+    unsigned long long duration;
+
+    SIM_Sync();
+    cpu->last_reg = 0;
+    duration = (unsigned long long)cycles * cpu->clock_div;
+    cpu->stats.delay_cycles += duration;
+    if(!SIM_Defer(duration))
+        SIM_Advance(duration);
+    SIM_LCD_Sync(1);
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_Sleep( void )
+* \Description     : SLEEP instruction: the virtual time runs until a wake-up
+                     (interrupt-on-change, watchdog, enabled interrupt flag)
+                     with the oscillator and its timers stopped.
+*******************************************************************************/
+void SIM_Sleep(void)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+    SIM_regfile_t *r = &cpu->regs;
+    unsigned long long timeout = SIM_NEVER;
+    unsigned long long start;
+
+    SIM_Sync();
+    cpu->last_reg = 0;
+    cpu->stats.sleeps++;
+    if(SIM_WakePending())                   /* Executed as a NOP (nPD unchanged) */
+    {
+        SIM_Advance(cpu->clock_div);
+        return;
+    }
+
+    /* The oscillator stops: the timers freeze, a conversion not clocked by Frc is aborted */
+    cpu->sleeping = 1;
+    r->status = (unsigned char)((r->status | STATUS_NTO) & ~STATUS_NPD);
+    if(cpu->adc_busy && ((r->adcon0 >> 6) != 3))
+    {
+        cpu->adc_busy = 0;
+        r->adcon0 &= (unsigned char)~ADCON0_GO;
+    }
+    if(r->wdtcon & WDTCON_SWDTEN)
+        timeout = cpu->now + SIM_WdtPeriod();   /* SLEEP clears the watchdog */
+
+    start = cpu->now;
+    while(!SIM_WakePending())
+    {
+        unsigned long long next = SIM_NextEvent(0);
+
+        if(timeout < next)
+            next = timeout;
+        if(next == SIM_NEVER)
+            break;                          /* No wake-up source left: the host gives up */
+        SIM_Peripherals((next > cpu->now) ? next - cpu->now : 0);
+        if(next > cpu->now)
+            cpu->now = next;
+        SIM_ApplyInputs();
+        if(cpu->now >= timeout)
+        {
+            r->status &= (unsigned char)~STATUS_NTO;
+            cpu->stats.wdt_wakes++;
+            break;
+        }
+    }
+    cpu->stats.sleep_cycles += cpu->now - start;
+
+    /* Crystal: oscillator start-up timer (the timers still stopped), the internal oscillator runs at once. The ISR
+       runs at the next access if GIE is set. */
+    if(!(cpu->osc_seen & OSCCON_SCS))
+    {
+        SIM_Peripherals(SIM_OST_CYCLES);
+        cpu->now += SIM_OST_CYCLES;
+        SIM_ApplyInputs();
+        cpu->ost_busy = 0;
+        SIM_SetClockDiv(1);
+        SIM_OscStatus();
+    }
+    cpu->sleeping = 0;
+    cpu->quiet_until = 0;               /* The timers stopped */
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_Clrwdt( void )
+* \Description     : CLRWDT instruction: clears the watchdog, sets nTO and nPD.
+*******************************************************************************/
+void SIM_Clrwdt(void)
+{
+    SIM_cpu->regs.status |= STATUS_NTO | STATUS_NPD;
+    _delay(1);
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_MainLoop( void )
+* \Description     : To be called once per main loop pass. A pass that did
+                     not touch any SFR is waiting on RAM set by the ISR, so
+                     the virtual time is fast-forwarded to the next event.
+*******************************************************************************/
+void SIM_MainLoop(void)
+{
+    SIM_cpu_t *cpu = SIM_cpu;
+    unsigned long long next;
+
+    SIM_Sync();
+    if(cpu->stats.sfr_accesses == cpu->loop_accesses)
+    {
+        next = SIM_NextEvent(0);
+        if((next != SIM_NEVER) && (next > cpu->now))
+        {
+            cpu->stats.idle_cycles += next - cpu->now;
+            SIM_Advance(next - cpu->now);
+        }
+        else
+        {
+            SIM_Advance(SIM_LOOP_CYCLES * cpu->clock_div);
+        }
+    }
+    else if(!SIM_Defer(SIM_LOOP_CYCLES * cpu->clock_div))
+    {
+        SIM_Advance(SIM_LOOP_CYCLES * cpu->clock_div);
+    }
+    cpu->loop_accesses = cpu->stats.sfr_accesses;
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_SetPin( port, pin, level )
+* \Description     : Drives the external level of an input pin right now.
+*******************************************************************************/
+void SIM_SetPin(unsigned char port, unsigned char pin, unsigned char level)
+{
+    SIM_Written();
+    SIM_ApplyInput(port, pin, level);
+    SIM_cpu->quiet_until = 0;           /* May raise an interrupt-on-change */
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_StopAt( unsigned long long time )
+* \Description     : The main loop fast-forward (SIM_MainLoop) stops at the
+                     virtual time instead of jumping over it (a time the
+                     caller checks between passes), 0: none.
+*******************************************************************************/
+void SIM_StopAt(unsigned long long time)
+{
+    if(time != SIM_cpu->stop)
+    {
+        SIM_cpu->stop = time;
+        SIM_cpu->quiet_until = 0;
+    }
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_ScheduleInput( time, port, pin, level )
+* \Description     : Drives the external level of an input pin at a given
+                     virtual time (cycles).
+*******************************************************************************/
+void SIM_ScheduleInput(unsigned long long time, unsigned char port, unsigned char pin, unsigned char level)
+{
+    SIM_Schedule(time, port, pin, level);
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_ScheduleAnalog( time, channel, value )
+* \Description     : Sets the 10-bit value converted on an analog channel at
+                     a given virtual time (cycles).
+*******************************************************************************/
+void SIM_ScheduleAnalog(unsigned long long time, unsigned char channel, unsigned int value)
+{
+    SIM_Schedule(time, SIM_ANALOG, channel, value);
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char SIM_InputsFull( void )
+* \Description     : Returns 1 if no input change can be scheduled.
+*******************************************************************************/
+unsigned char SIM_InputsFull(void)
+{
+    return SIM_cpu->input_count >= SIM_INPUT_QUEUE_SIZE;
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_PressButton( time, pin, hold_ms )
+* \Description     : Schedules an active-low push button press on PORTB
+                     (press at time, release after hold_ms).
+*******************************************************************************/
+void SIM_PressButton(unsigned long long time, unsigned char pin, unsigned int hold_ms)
+{
+    SIM_ScheduleInput(time, SIM_PORTB, pin, 0);
+    SIM_ScheduleInput(time + SIM_CYCLES_MS(hold_ms), SIM_PORTB, pin, 1);
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_BounceButton( time, pin, hold_ms, bounces )
+* \Description     : Same as SIM_PressButton() with contact bounce: the pin
+                     toggles bounces times (pseudo-random 50us .. 1ms apart)
+                     after the press and after the release before it settles.
+*******************************************************************************/
+void SIM_BounceButton(unsigned long long time, unsigned char pin, unsigned int hold_ms, unsigned char bounces)
+{
+    unsigned long seed = (unsigned long)time ^ (pin * 2654435761UL);
+    unsigned long long at;
+
+    for(unsigned char edge = 0; edge < 2; edge++)
+    {
+        unsigned char level = edge;                 /* Press: settles low, release: settles high */
+
+        at = (edge == 0) ? time : time + SIM_CYCLES_MS(hold_ms);
+        for(unsigned char i = 0; i < bounces + 1; i++)
+        {
+            SIM_ScheduleInput(at, SIM_PORTB, pin, (i & 1) ? !level : level);
+            seed = seed * 1103515245UL + 12345UL;
+            at += SIM_CYCLES_MS(0.05) + (seed >> 8) % (unsigned long)SIM_CYCLES_MS(0.95);
+        }
+        /* Settled level */
+        SIM_ScheduleInput(at, SIM_PORTB, pin, level);
+    }
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char SIM_GetPin( port, pin )
+* \Description     : Returns the current level of a pin.
+*******************************************************************************/
+unsigned char SIM_GetPin(unsigned char port, unsigned char pin)
+{
+    SIM_SyncPorts();
+    return (*SIM_Port(port) >> pin) & 1;
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_SetAnalog( channel, value )
+* \Description     : Sets the 10-bit value converted on an analog channel.
+*******************************************************************************/
+void SIM_SetAnalog(unsigned char channel, unsigned int value)
+{
+    if(channel < SIM_ADC_CHANNELS)
+        SIM_cpu->analog[channel] = value & 0x3FF;
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_EepromData( a, b, c, d, e, f, g, h )
+* \Description     : Appends 8 bytes to the data EEPROM image programmed by
+                     SIM_Reset() (see __EEPROM_DATA).
+*******************************************************************************/
+void SIM_EepromData(unsigned char a, unsigned char b, unsigned char c, unsigned char d,
+                    unsigned char e, unsigned char f, unsigned char g, unsigned char h)
+{
+    const unsigned char data[8] = { a, b, c, d, e, f, g, h };
+
+    for(unsigned char i = 0; (i < 8) && (sim_eeprom_image_size < SIM_EEPROM_SIZE); i++)
+        sim_eeprom_image[sim_eeprom_image_size++] = data[i];
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char SIM_EepromRead( unsigned char address )
+* \Description     : Returns a byte of the data EEPROM (no virtual time).
+*******************************************************************************/
+unsigned char SIM_EepromRead(unsigned char address)
+{
+    return SIM_cpu->eeprom[address % SIM_EEPROM_SIZE];
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_EepromWrite( address, value )
+* \Description     : Changes a byte of the data EEPROM (no virtual time),
+                     e.g. to install a catalog after SIM_Reset().
+*******************************************************************************/
+void SIM_EepromWrite(unsigned char address, unsigned char value)
+{
+    SIM_cpu->eeprom[address % SIM_EEPROM_SIZE] = value;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned long SIM_EepromWear( unsigned char address )
+* \Description     : Returns the number of writes of a data EEPROM cell
+                     completed since SIM_Reset() (kept by SIM_PowerCycle()).
+*******************************************************************************/
+unsigned long SIM_EepromWear(unsigned char address)
+{
+    return SIM_cpu->ee_wear[address % SIM_EEPROM_SIZE];
+}
+
+/******************************************************************************
+* \Syntax          : const SIM_stats_t *SIM_Stats( void )
+* \Description     : Returns the simulator statistics.
+*******************************************************************************/
+const SIM_stats_t *SIM_Stats(void)
+{
+    return &SIM_cpu->stats;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned int SIM_EdgeLog( const SIM_edge_t **edges )
+* \Description     : Returns the number of logged output edges.
+*******************************************************************************/
+unsigned int SIM_EdgeLog(const SIM_edge_t **edges)
+{
+    *edges = SIM_cpu->edges;
+    return SIM_cpu->edge_count;
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_EdgeLogClear( void )
+* \Description     : Empties the edge log (the next edges are logged again).
+*******************************************************************************/
+void SIM_EdgeLogClear(void)
+{
+    SIM_cpu->edge_count = 0;
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_UART_Output( FILE *out )
+* \Description     : Copies every byte sent by the EUSART to a file or a pipe
+                     (NULL: none), the stream is flushed whenever the
+                     transmitter goes idle. The output survives a reset.
+*******************************************************************************/
+void SIM_UART_Output(FILE *out)
+{
+    SIM_cpu->uart_out = out;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned int SIM_UART_Log( const SIM_uart_byte_t **bytes )
+* \Description     : Returns the number of logged EUSART bytes.
+*******************************************************************************/
+unsigned int SIM_UART_Log(const SIM_uart_byte_t **bytes)
+{
+    *bytes = SIM_cpu->uart_log;
+    return SIM_cpu->uart_count;
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_UART_LogClear( void )
+* \Description     : Empties the EUSART log (the next bytes are logged again).
+*******************************************************************************/
+void SIM_UART_LogClear(void)
+{
+    SIM_cpu->uart_count = 0;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: SIM.c
+ *********************************************************************************************************************/
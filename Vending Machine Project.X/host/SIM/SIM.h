@@ -0,0 +1,358 @@
+/**********************************************************************************************************************
+ * Filename:    SIM.h
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the declaration of the host simulator APIs (virtual clock, pins, analog inputs, LCD model).
+ * NOTE:        Virtual time is counted in instruction cycles of the crystal (Fosc/4), 1 cycle = 1 us at 4 MHz. On a
+ *              slower internal oscillator (OSCCON) an instruction and a timer count last several cycles.
+ *
+*********************************************************************************************************************/
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdio.h>
+
+/**********************************************************************************************************************
+ *  Configuration
+ *********************************************************************************************************************/
+
+/* Oscillator frequency of the simulated crystal */
+#define     SIM_FOSC_HZ             4000000UL
+
+/* Instruction cycles charged for every SFR access */
+#define     SIM_ACCESS_CYCLES       1
+
+/* Instruction cycles charged for an SFR access through a pointer (FSR load, IRP and the INDF access; a bit mask
+   computed at run time is not charged) */
+#define     SIM_INDIRECT_CYCLES     4
+
+/* Back-to-back accesses of the same SFR with an unchanged value that are considered a polling loop (fast-forwarded) */
+#define     SIM_SPIN_THRESHOLD      4
+
+/* Acquisition time required between an ADC channel switch and the start of the conversion (TACQ, cycles) */
+#define     SIM_ADC_TACQ_CYCLES     11
+
+/* Data EEPROM erase/write time (TDEW = 5ms typical) */
+#define     SIM_EEPROM_WRITE_CYCLES 5000
+
+/* Watchdog clock (LFINTOSC, 31kHz typical) */
+#define     SIM_LFINTOSC_HZ         31000UL
+
+/* Oscillator start-up timer of the HS crystal, after a wake-up from sleep or a switch from the internal oscillator
+   (1024 Tosc) */
+#define     SIM_OST_CYCLES          256
+
+/* Maximum number of output edges kept in the edge log */
+#define     SIM_EDGE_LOG_SIZE       64
+
+/* Maximum number of bytes kept in the EUSART transmit log */
+#define     SIM_UART_LOG_SIZE       4096
+
+
+/**********************************************************************************************************************
+ *  GLOBAL CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Simulated ports (same numbering as DIO_port_e) */
+#define     SIM_PORTA               0
+#define     SIM_PORTB               1
+#define     SIM_PORTC               2
+
+/* Pin not connected */
+#define     SIM_NO_PIN              0xFF
+
+/* Conversions between virtual cycles and time */
+#define     SIM_CYCLES_PER_US       (SIM_FOSC_HZ / 4000000.0)
+#define     SIM_US(cycles)          ((double)(cycles) / SIM_CYCLES_PER_US)
+#define     SIM_MS(cycles)          (SIM_US(cycles) / 1000.0)
+#define     SIM_CYCLES_MS(ms)       ((unsigned long long)((ms) * 1000.0 * SIM_CYCLES_PER_US))
+
+
+/**********************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *********************************************************************************************************************/
+
+/* Output edge (recorded whenever an output pin of PORTA/PORTB/PORTC changes) */
+typedef struct
+{
+    unsigned long long time;        /* Virtual time of the edge (cycles) */
+    unsigned char port;             /* SIM_PORTx                         */
+    unsigned char pin;              /* Pin number                        */
+    unsigned char level;            /* New level                         */
+}SIM_edge_t;
+
+/* Byte sent by the EUSART (recorded when its stop bit ends) */
+typedef struct
+{
+    unsigned long long time;        /* Virtual time of the stop bit end (cycles) */
+    unsigned char value;
+}SIM_uart_byte_t;
+
+/* Simulator statistics */
+typedef struct
+{
+    unsigned long long sfr_accesses;    /* SFR accesses (through SIM_Access)             */
+    unsigned long long sfr_indirect;    /* SFR accesses through a pointer (included)     */
+    unsigned long long sfr_writes;      /* SFR accesses that changed the register        */
+    unsigned long long delay_cycles;    /* Cycles spent in __delay_ms/__delay_us         */
+    unsigned long long spin_cycles;     /* Cycles skipped while fast-forwarding polling  */
+    unsigned long long idle_cycles;     /* Idle main loop passes fast-forwarded (cycles) */
+    unsigned long long isr_calls;       /* Number of myISR() dispatches                  */
+    unsigned long long isr_cycles;      /* Cycles spent in myISR() (latency included)    */
+    unsigned long long isr_max_cycles;  /* Longest myISR() dispatch (worst case)         */
+    unsigned long long lcd_commands;    /* Command bytes received by the LCD             */
+    unsigned long long lcd_data;        /* Data bytes (characters) received by the LCD   */
+    unsigned long long lcd_nibbles;     /* Enable pulses seen by the LCD                 */
+    unsigned long long lcd_violations;  /* Transfers while the LCD controller was busy   */
+    unsigned long long lcd_reads;       /* Busy flag / address reads (R/W high)          */
+    unsigned long long adc_conversions; /* ADC conversions started                       */
+    unsigned long long adc_short_acq;   /* Conversions started before TACQ after a switch */
+    unsigned long long eeprom_reads;    /* Data EEPROM reads (RD)                        */
+    unsigned long long eeprom_writes;   /* Data EEPROM writes completed (WR)             */
+    unsigned long long sleeps;          /* SLEEP instructions (wake-up pending: NOP)     */
+    unsigned long long sleep_cycles;    /* Cycles spent sleeping (oscillator stopped)    */
+    unsigned long long wdt_wakes;       /* Wake-ups by a watchdog time-out               */
+    unsigned long long intosc_cycles;   /* Cycles run on the internal oscillator (awake) */
+    unsigned long long clock_switches;  /* System clock switches (OSCCON SCS)            */
+    unsigned long long uart_bytes;      /* Bytes sent by the EUSART                      */
+    unsigned long long uart_cycles;     /* Cycles of the characters sent (line busy)     */
+    unsigned long long uart_overruns;   /* TXREG written while full (byte lost)          */
+}SIM_stats_t;
+
+
+/**********************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void SIM_Reset( void )
+* \Description     : Power-on reset of the register file, the peripherals,
+                     the LCD model, the statistics and the virtual clock.
+                     The data EEPROM is programmed with the __EEPROM_DATA
+                     image (erased bytes read 0xFF).
+*******************************************************************************/
+void SIM_Reset(void);
+
+/******************************************************************************
+* \Syntax          : void SIM_PowerCycle( void )
+* \Description     : Power loss and power-on reset: same as SIM_Reset() but
+                     the data EEPROM keeps its contents and its wear counts,
+                     a write in progress is torn (the cell gets the low nibble
+                     of the new byte and keeps the high nibble of the old one).
+*******************************************************************************/
+void SIM_PowerCycle(void);
+
+/******************************************************************************
+* \Syntax          : unsigned long SIM_InstanceSize( void )
+* \Description     : Returns the size of a simulated microcontroller (the
+                     memory given to SIM_Select()).
+*******************************************************************************/
+unsigned long SIM_InstanceSize(void);
+
+/******************************************************************************
+* \Syntax          : void SIM_Select( void *instance )
+* \Description     : Makes instance the simulated microcontroller every other
+                     function works on (NULL: the default one). A new instance
+                     (SIM_InstanceSize() bytes, zeroed) is started with
+                     SIM_Reset().
+*******************************************************************************/
+void SIM_Select(void *instance);
+
+/******************************************************************************
+* \Syntax          : unsigned long long SIM_Now( void )
+* \Description     : Returns the virtual time in instruction cycles.
+*******************************************************************************/
+unsigned long long SIM_Now(void);
+
+/******************************************************************************
+* \Syntax          : void SIM_Advance( unsigned long long cycles )
+* \Description     : Advances the virtual time (peripherals, inputs and
+                     interrupts are processed on the way).
+*******************************************************************************/
+void SIM_Advance(unsigned long long cycles);
+
+/******************************************************************************
+* \Syntax          : void SIM_MainLoop( void )
+* \Description     : To be called once per main loop pass. A pass that did
+                     not touch any SFR is waiting on RAM set by the ISR, so
+                     the virtual time is fast-forwarded to the next event.
+*******************************************************************************/
+void SIM_MainLoop(void);
+
+/******************************************************************************
+* \Syntax          : void SIM_RunUntil( unsigned long long time,
+                                        unsigned long long *longest )
+* \Description     : Runs VM_Running() and SIM_MainLoop() until the virtual
+                     time, keeps the longest VM_Running() call (sleep
+                     excluded) in *longest if not NULL. SIM/SIM_RUN.c, only
+                     for the programs that link the firmware.
+*******************************************************************************/
+void SIM_RunUntil(unsigned long long time, unsigned long long *longest);
+
+/******************************************************************************
+* \Syntax          : long SIM_Instructions( void (*operation)(void) )
+* \Description     : Returns the host instructions executed by the operation
+                     in a single-stepped child process (Linux ptrace), the
+                     markers around it included: -1 if they cannot be
+                     counted. SIM/SIM_STEP.c.
+*******************************************************************************/
+long SIM_Instructions(void (*operation)(void));
+
+/******************************************************************************
+* \Syntax          : void SIM_SetPin( port, pin, level )
+* \Description     : Drives the external level of an input pin right now.
+*******************************************************************************/
+void SIM_SetPin(unsigned char port, unsigned char pin, unsigned char level);
+
+/******************************************************************************
+* \Syntax          : void SIM_StopAt( unsigned long long time )
+* \Description     : The main loop fast-forward (SIM_MainLoop) stops at the
+                     virtual time instead of jumping over it (a time the
+                     caller checks between passes), 0: none.
+*******************************************************************************/
+void SIM_StopAt(unsigned long long time);
+
+/******************************************************************************
+* \Syntax          : void SIM_ScheduleInput( time, port, pin, level )
+* \Description     : Drives the external level of an input pin at a given
+                     virtual time (cycles).
+*******************************************************************************/
+void SIM_ScheduleInput(unsigned long long time, unsigned char port, unsigned char pin, unsigned char level);
+
+/******************************************************************************
+* \Syntax          : void SIM_ScheduleAnalog( time, channel, value )
+* \Description     : Sets the 10-bit value converted on an analog channel at
+                     a given virtual time (cycles).
+*******************************************************************************/
+void SIM_ScheduleAnalog(unsigned long long time, unsigned char channel, unsigned int value);
+
+/******************************************************************************
+* \Syntax          : unsigned char SIM_InputsFull( void )
+* \Description     : Returns 1 if no input change can be scheduled.
+*******************************************************************************/
+unsigned char SIM_InputsFull(void);
+
+/******************************************************************************
+* \Syntax          : void SIM_PressButton( time, pin, hold_ms )
+* \Description     : Schedules an active-low push button press on PORTB
+                     (press at time, release after hold_ms).
+*******************************************************************************/
+void SIM_PressButton(unsigned long long time, unsigned char pin, unsigned int hold_ms);
+
+/******************************************************************************
+* \Syntax          : void SIM_BounceButton( time, pin, hold_ms, bounces )
+* \Description     : Same as SIM_PressButton() with contact bounce: the pin
+                     toggles bounces times (pseudo-random 50us .. 1ms apart)
+                     after the press and after the release before it settles.
+*******************************************************************************/
+void SIM_BounceButton(unsigned long long time, unsigned char pin, unsigned int hold_ms, unsigned char bounces);
+
+/******************************************************************************
+* \Syntax          : unsigned char SIM_GetPin( port, pin )
+* \Description     : Returns the current level of a pin.
+*******************************************************************************/
+unsigned char SIM_GetPin(unsigned char port, unsigned char pin);
+
+/******************************************************************************
+* \Syntax          : void SIM_SetAnalog( channel, value )
+* \Description     : Sets the 10-bit value converted on an analog channel.
+*******************************************************************************/
+void SIM_SetAnalog(unsigned char channel, unsigned int value);
+
+/******************************************************************************
+* \Syntax          : unsigned char SIM_EepromRead( unsigned char address )
+* \Description     : Returns a byte of the data EEPROM (no virtual time).
+*******************************************************************************/
+unsigned char SIM_EepromRead(unsigned char address);
+
+/******************************************************************************
+* \Syntax          : void SIM_EepromWrite( address, value )
+* \Description     : Changes a byte of the data EEPROM (no virtual time),
+                     e.g. to install a catalog after SIM_Reset().
+*******************************************************************************/
+void SIM_EepromWrite(unsigned char address, unsigned char value);
+
+/******************************************************************************
+* \Syntax          : unsigned long SIM_EepromWear( unsigned char address )
+* \Description     : Returns the number of writes of a data EEPROM cell
+                     completed since SIM_Reset() (kept by SIM_PowerCycle()).
+*******************************************************************************/
+unsigned long SIM_EepromWear(unsigned char address);
+
+/******************************************************************************
+* \Syntax          : const SIM_stats_t *SIM_Stats( void )
+* \Description     : Returns the simulator statistics.
+*******************************************************************************/
+const SIM_stats_t *SIM_Stats(void);
+
+/******************************************************************************
+* \Syntax          : unsigned int SIM_EdgeLog( const SIM_edge_t **edges )
+* \Description     : Returns the number of logged output edges.
+*******************************************************************************/
+unsigned int SIM_EdgeLog(const SIM_edge_t **edges);
+
+/******************************************************************************
+* \Syntax          : void SIM_EdgeLogClear( void )
+* \Description     : Empties the edge log (the next edges are logged again).
+*******************************************************************************/
+void SIM_EdgeLogClear(void);
+
+/******************************************************************************
+* \Syntax          : void SIM_UART_Output( FILE *out )
+* \Description     : Copies every byte sent by the EUSART to a file or a pipe
+                     (NULL: none), the stream is flushed whenever the
+                     transmitter goes idle. The output survives a reset.
+*******************************************************************************/
+void SIM_UART_Output(FILE *out);
+
+/******************************************************************************
+* \Syntax          : unsigned int SIM_UART_Log( const SIM_uart_byte_t **bytes )
+* \Description     : Returns the number of logged EUSART bytes.
+*******************************************************************************/
+unsigned int SIM_UART_Log(const SIM_uart_byte_t **bytes);
+
+/******************************************************************************
+* \Syntax          : void SIM_UART_LogClear( void )
+* \Description     : Empties the EUSART log (the next bytes are logged again).
+*******************************************************************************/
+void SIM_UART_LogClear(void);
+
+/******************************************************************************
+* \Syntax          : void SIM_LCD_Attach( port, rs, en, d4, d5, d6, d7 )
+* \Description     : Wires the HD44780 model to the given port pins.
+*******************************************************************************/
+void SIM_LCD_Attach(unsigned char port, unsigned char rs, unsigned char en,
+                    unsigned char d4, unsigned char d5, unsigned char d6, unsigned char d7);
+
+/******************************************************************************
+* \Syntax          : void SIM_LCD_AttachRW( unsigned char rw )
+* \Description     : Wires the R/W pin of the HD44780 model (same port,
+                     SIM_NO_PIN after SIM_LCD_Attach = tied to GND).
+*******************************************************************************/
+void SIM_LCD_AttachRW(unsigned char rw);
+
+/******************************************************************************
+* \Syntax          : const char *SIM_LCD_Row( unsigned char row )
+* \Description     : Returns the 16 visible characters of a display row.
+*******************************************************************************/
+const char *SIM_LCD_Row(unsigned char row);
+
+/******************************************************************************
+* \Syntax          : unsigned char SIM_LCD_RowStartsWith( row, text )
+* \Description     : Returns 1 if the visible row starts with text.
+*******************************************************************************/
+unsigned char SIM_LCD_RowStartsWith(unsigned char row, const char *text);
+
+/******************************************************************************
+* \Syntax          : void SIM_LCD_OnChange( void (*callback)(unsigned char row) )
+* \Description     : Calls back when a visible character of a row changes
+                     (the virtual time is the time of the data write), NULL
+                     removes the callback.
+*******************************************************************************/
+void SIM_LCD_OnChange(void (*callback)(unsigned char row));
+
+
+#endif /* SIM_H */
@@ -0,0 +1,341 @@
+/**********************************************************************************************************************
+ * Filename:    SIM_LCD.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the implementation of the HD44780 model (4/8-bit interface, DDRAM, busy time).
+ * NOTE:        The model only sees the port at synchronization points (SFR accesses, including the LCD struct
+ *              pointer through SIM_SFR_PTR, and busy-waits): an enable pulse is latched at the end of a busy-wait that
+ *              ran with EN high, or when EN was seen high and then low without any busy-wait in between.
+ *              With R/W high the model drives D7:D4 (busy flag and address counter) while EN is high.
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <string.h>
+#include "SIM_prv.h"
+
+/**********************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Execution times (us) */
+#define     SIM_LCD_CLEAR_US        1520
+#define     SIM_LCD_CMD_US          37
+#define     SIM_LCD_DATA_US         37
+
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : static void SIM_LCD_Busy( SIM_lcd_t *lcd, unsigned int us )
+* \Description     : Marks the controller busy for an execution time.
+*******************************************************************************/
+static void SIM_LCD_Busy(SIM_lcd_t *lcd, unsigned int us)
+{
+    lcd->busy_until = SIM_cpu->now + (unsigned long long)(us * SIM_CYCLES_PER_US);
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_LCD_Step( SIM_lcd_t *lcd, signed char dir )
+* \Description     : Moves the DDRAM address counter (2-line mode).
+*******************************************************************************/
+static void SIM_LCD_Step(SIM_lcd_t *lcd, signed char dir)
+{
+    if(dir > 0)
+    {
+        lcd->address++;
+        if(lcd->address == SIM_LCD_ROW_LEN)
+            lcd->address = 0x40;
+        else if(lcd->address >= 0x40 + SIM_LCD_ROW_LEN)
+            lcd->address = 0x00;
+    }
+    else
+    {
+        if(lcd->address == 0x00)
+            lcd->address = 0x40 + SIM_LCD_ROW_LEN - 1;
+        else if(lcd->address == 0x40)
+            lcd->address = SIM_LCD_ROW_LEN - 1;
+        else
+            lcd->address--;
+    }
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_LCD_Execute( SIM_lcd_t *lcd, rs, byte )
+* \Description     : Executes a complete instruction or data write.
+*******************************************************************************/
+static void SIM_LCD_Execute(SIM_lcd_t *lcd, unsigned char rs, unsigned char byte)
+{
+    if(rs)
+    {
+        unsigned char row = (lcd->address >= 0x40);
+        unsigned char col = (unsigned char)(lcd->address - (row ? 0x40 : 0x00));
+
+        if(col < SIM_LCD_ROW_LEN)
+        {
+            char previous = lcd->ddram[row][col];
+
+            lcd->ddram[row][col] = (char)byte;
+            if((col < SIM_LCD_COLS) && (previous != (char)byte) && lcd->on_change)
+                lcd->on_change(row);
+        }
+        SIM_LCD_Step(lcd, lcd->increment ? 1 : -1);
+        SIM_cpu->stats.lcd_data++;
+        SIM_LCD_Busy(lcd, SIM_LCD_DATA_US);
+        return;
+    }
+
+    SIM_cpu->stats.lcd_commands++;
+    SIM_LCD_Busy(lcd, SIM_LCD_CMD_US);
+    if(byte & 0x80)                 /* Set DDRAM address */
+    {
+        lcd->address = byte & 0x7F;
+    }
+    else if(byte & 0x40)            /* Set CGRAM address (not modelled) */
+    {
+    }
+    else if(byte & 0x20)            /* Function set */
+    {
+        lcd->four_bit = !(byte & 0x10);
+        lcd->high_nibble = 0;
+    }
+    else if(byte & 0x10)            /* Cursor/display shift */
+    {
+        if(!(byte & 0x08))
+            SIM_LCD_Step(lcd, (byte & 0x04) ? 1 : -1);
+    }
+    else if(byte & 0x08)            /* Display on/off control */
+    {
+        lcd->display_on = (byte >> 2) & 1;
+    }
+    else if(byte & 0x04)            /* Entry mode set */
+    {
+        lcd->increment = (byte >> 1) & 1;
+    }
+    else if(byte & 0x02)            /* Return home */
+    {
+        lcd->address = 0;
+        SIM_LCD_Busy(lcd, SIM_LCD_CLEAR_US);
+    }
+    else if(byte & 0x01)            /* Clear display */
+    {
+        memset(lcd->ddram, ' ', sizeof(lcd->ddram));
+        lcd->address = 0;
+        lcd->increment = 1;
+        SIM_LCD_Busy(lcd, SIM_LCD_CLEAR_US);
+    }
+}
+
+/******************************************************************************
+* \Syntax          : static void SIM_LCD_Latch( SIM_lcd_t *lcd, unsigned char port )
+* \Description     : Falling edge of EN: latches RS and D7:D4.
+*******************************************************************************/
+static void SIM_LCD_Latch(SIM_lcd_t *lcd, unsigned char port)
+{
+    unsigned char rs = (port >> lcd->rs) & 1;
+    unsigned char nibble = 0;
+
+    /* Read cycle: nothing is written */
+    if((lcd->rw != SIM_NO_PIN) && ((port >> lcd->rw) & 1))
+    {
+        SIM_cpu->stats.lcd_reads++;
+        if(lcd->four_bit)
+            lcd->read_low ^= 1;
+        return;
+    }
+
+    for(unsigned char i = 0; i < 4; i++)
+        nibble |= (unsigned char)(((port >> lcd->d[i]) & 1) << i);
+
+    SIM_cpu->stats.lcd_nibbles++;
+
+    /* A new instruction must not start while the controller is busy */
+    if(!(lcd->four_bit && lcd->high_nibble) && (SIM_cpu->now < lcd->busy_until))
+        SIM_cpu->stats.lcd_violations++;
+
+    if(!lcd->four_bit)
+    {
+        SIM_LCD_Execute(lcd, rs, (unsigned char)(nibble << 4));
+    }
+    else if(!lcd->high_nibble)
+    {
+        lcd->nibble = nibble;
+        lcd->high_nibble = 1;
+    }
+    else
+    {
+        lcd->high_nibble = 0;
+        SIM_LCD_Execute(lcd, rs, (unsigned char)((lcd->nibble << 4) | nibble));
+    }
+}
+
+
+/******************************************************************************
+* \Syntax          : static void SIM_LCD_Drive( SIM_lcd_t *lcd )
+* \Description     : Read cycle (R/W and EN high): drives the busy flag and
+                     the address counter on the data pins configured as input.
+*******************************************************************************/
+static void SIM_LCD_Drive(SIM_lcd_t *lcd)
+{
+    unsigned char *reg = &SIM_cpu->regs.porta + lcd->port;
+    unsigned char tris = (&SIM_cpu->regs.trisa)[lcd->port];
+    unsigned char *pins = &SIM_cpu->pin_in[lcd->port];
+    unsigned char value = (unsigned char)(((SIM_cpu->now < lcd->busy_until) ? 0x80 : 0x00) | lcd->address);
+    unsigned char nibble = (lcd->four_bit && lcd->read_low) ? (value & 0x0F) : (value >> 4);
+
+    for(unsigned char i = 0; i < 4; i++)
+    {
+        if((nibble >> i) & 1)
+            *pins |= (unsigned char)(1 << lcd->d[i]);
+        else
+            *pins &= (unsigned char)~(1 << lcd->d[i]);
+    }
+    *reg = (unsigned char)((*reg & ~tris) | (*pins & tris));
+}
+
+
+/**********************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void SIM_LCD_Reset( SIM_lcd_t *lcd )
+* \Description     : Power-on state of the HD44780 model.
+*******************************************************************************/
+void SIM_LCD_Reset(SIM_lcd_t *lcd)
+{
+    lcd->pending = 0;
+    lcd->en_high = 0;
+    lcd->four_bit = 0;
+    lcd->high_nibble = 0;
+    lcd->read_low = 0;
+    lcd->address = 0;
+    lcd->increment = 1;
+    lcd->display_on = 0;
+    lcd->busy_until = 0;
+    memset(lcd->ddram, ' ', sizeof(lcd->ddram));
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_LCD_Sync( unsigned char delay )
+* \Description     : Samples the LCD port and latches enable pulses
+                     (delay = 1 at the end of a busy-wait).
+*******************************************************************************/
+void SIM_LCD_Sync(unsigned char delay)
+{
+    SIM_lcd_t *lcd = &SIM_cpu->lcd;
+    unsigned char port;
+    unsigned char en;
+
+    if(!lcd->attached)
+        return;
+
+    port = (&SIM_cpu->regs.porta)[lcd->port];
+    en = (port >> lcd->en) & 1;
+
+    if(en)
+    {
+        if(!lcd->en_high)           /* Rising edge */
+        {
+            lcd->en_high = 1;
+            lcd->pending = 1;
+            if((lcd->rw != SIM_NO_PIN) && ((port >> lcd->rw) & 1))
+                SIM_LCD_Drive(lcd);
+        }
+        if(!lcd->pending)           /* Pulse already latched */
+            return;
+        lcd->pending_port = port;
+        if(delay)                   /* EN falls right after the busy-wait */
+        {
+            SIM_LCD_Latch(lcd, port);
+            lcd->pending = 0;
+        }
+    }
+    else
+    {
+        lcd->en_high = 0;
+        if(lcd->pending)
+        {
+            SIM_LCD_Latch(lcd, lcd->pending_port);
+            lcd->pending = 0;
+        }
+    }
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_LCD_Attach( port, rs, en, d4, d5, d6, d7 )
+* \Description     : Wires the HD44780 model to the given port pins.
+*******************************************************************************/
+void SIM_LCD_Attach(unsigned char port, unsigned char rs, unsigned char en,
+                    unsigned char d4, unsigned char d5, unsigned char d6, unsigned char d7)
+{
+    SIM_lcd_t *lcd = &SIM_cpu->lcd;
+
+    lcd->attached = 1;
+    lcd->port = port;
+    lcd->rs = rs;
+    lcd->en = en;
+    lcd->d[0] = d4;
+    lcd->d[1] = d5;
+    lcd->d[2] = d6;
+    lcd->d[3] = d7;
+    lcd->rw = SIM_NO_PIN;
+    SIM_LCD_Reset(lcd);
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_LCD_AttachRW( unsigned char rw )
+* \Description     : Wires the R/W pin of the HD44780 model (same port,
+                     SIM_NO_PIN after SIM_LCD_Attach = tied to GND).
+*******************************************************************************/
+void SIM_LCD_AttachRW(unsigned char rw)
+{
+    SIM_cpu->lcd.rw = rw;
+}
+
+/******************************************************************************
+* \Syntax          : const char *SIM_LCD_Row( unsigned char row )
+* \Description     : Returns the 16 visible characters of a display row.
+*******************************************************************************/
+const char *SIM_LCD_Row(unsigned char row)
+{
+    SIM_lcd_t *lcd = &SIM_cpu->lcd;
+
+    if(row >= SIM_LCD_ROWS)
+        row = SIM_LCD_ROWS - 1;
+    memcpy(lcd->row_text, lcd->ddram[row], SIM_LCD_COLS);
+    lcd->row_text[SIM_LCD_COLS] = '\0';
+    return lcd->row_text;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char SIM_LCD_RowStartsWith( row, text )
+* \Description     : Returns 1 if the visible row starts with text.
+*******************************************************************************/
+unsigned char SIM_LCD_RowStartsWith(unsigned char row, const char *text)
+{
+    return strncmp(SIM_LCD_Row(row), text, strlen(text)) == 0;
+}
+
+/******************************************************************************
+* \Syntax          : void SIM_LCD_OnChange( void (*callback)(unsigned char row) )
+* \Description     : Calls back when a visible character of a row changes
+                     (the virtual time is the time of the data write), NULL
+                     removes the callback.
+*******************************************************************************/
+void SIM_LCD_OnChange(void (*callback)(unsigned char row))
+{
+    SIM_cpu->lcd.on_change = callback;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: SIM_LCD.c
+ *********************************************************************************************************************/
@@ -0,0 +1,52 @@
+/**********************************************************************************************************************
+ * Filename:    SIM_RUN.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the main loop driver of the benches that link the firmware (VM_Running() then SIM_MainLoop()
+ *              until a virtual time).
+ * NOTE:        Kept apart from SIM.c so that the benches without the vending machine (LCD, ADC, DIO) still link.
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include "SIM_prv.h"
+
+/* Main loop pass of the firmware (VM.c) */
+extern void VM_Running(void);
+
+
+/**********************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void SIM_RunUntil( unsigned long long time,
+                                        unsigned long long *longest )
+* \Description     : Runs main loop passes until the virtual time. The
+                     longest VM_Running() call seen, sleep excluded, is kept
+                     in *longest (NULL: not measured).
+*******************************************************************************/
+void SIM_RunUntil(unsigned long long time, unsigned long long *longest)
+{
+    const SIM_stats_t *stats = SIM_Stats();
+
+    while(SIM_Now() < time)
+    {
+        unsigned long long start = SIM_Now() - stats->sleep_cycles;
+
+        VM_Running();
+        if((longest != NULL) && (SIM_Now() - stats->sleep_cycles - start > *longest))
+            *longest = SIM_Now() - stats->sleep_cycles - start;
+        SIM_MainLoop();
+    }
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: SIM_RUN.c
+ *********************************************************************************************************************/
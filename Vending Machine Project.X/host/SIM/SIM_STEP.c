@@ -0,0 +1,83 @@
+/**********************************************************************************************************************
+ * Filename:    SIM_STEP.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the instruction counter of the benches: a child process runs an operation between two
+ *              SIGSTOP and the parent single-steps it (Linux ptrace).
+ * NOTE:        The counts are host instructions, meant for comparing two builds of the same driver code (built with
+ *              SIM_DIRECT_SFR = 1 so that the simulator is not counted).
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#ifdef __linux__
+#include <signal.h>
+#include <unistd.h>
+#include <sys/ptrace.h>
+#include <sys/wait.h>
+#endif
+
+#include "SIM_prv.h"
+
+
+/**********************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : long SIM_Instructions( void (*operation)(void) )
+* \Description     : Returns the instructions executed by a child process
+                     between two SIGSTOP around the operation (marker
+                     included), -1 if they cannot be counted.
+*******************************************************************************/
+long SIM_Instructions(void (*operation)(void))
+{
+#ifdef __linux__
+    pid_t child = fork();
+    long count = 0;
+    int status;
+
+    if(child < 0)
+        return -1;
+    if(child == 0)
+    {
+        ptrace(PTRACE_TRACEME, 0, NULL, NULL);
+        raise(SIGSTOP);
+        operation();
+        raise(SIGSTOP);
+        _exit(0);
+    }
+
+    waitpid(child, &status, 0);
+    if(!WIFSTOPPED(status))
+        return -1;
+    for(;;)
+    {
+        if(ptrace(PTRACE_SINGLESTEP, child, NULL, NULL) < 0)
+        {
+            count = -1;
+            break;
+        }
+        waitpid(child, &status, 0);
+        if(!WIFSTOPPED(status) || (WSTOPSIG(status) == SIGSTOP))
+            break;
+        count++;
+    }
+    kill(child, SIGKILL);
+    waitpid(child, &status, 0);
+    return count;
+#else
+    (void)operation;
+    return -1;
+#endif
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: SIM_STEP.c
+ *********************************************************************************************************************/
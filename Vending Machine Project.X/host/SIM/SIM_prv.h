@@ -0,0 +1,178 @@
+/**********************************************************************************************************************
+ * Filename:    SIM_prv.h
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the private declaration of the simulator state and the peripheral models, which are used
+ *              internally by SIM.c and SIM_LCD.c.
+ *
+*********************************************************************************************************************/
+
+#ifndef SIM_PRV_H
+#define SIM_PRV_H
+
+#include <xc.h>
+#include "SIM.h"
+
+/**********************************************************************************************************************
+ *  LOCAL CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Maximum number of pending scheduled input changes */
+#define     SIM_INPUT_QUEUE_SIZE    1024
+
+/* Number of analog channels (AN0 : AN13) */
+#define     SIM_ADC_CHANNELS        14
+
+/* Port of a scheduled analog input (pin = channel, level = 10-bit value) */
+#define     SIM_ANALOG              3
+
+/* Data EEPROM size (bytes) */
+#define     SIM_EEPROM_SIZE         128
+
+/* "No event" marker for the next-event computation */
+#define     SIM_NEVER               (~0ULL)
+
+/* HD44780 DDRAM: 2 lines of 40 characters */
+#define     SIM_LCD_ROWS            2
+#define     SIM_LCD_ROW_LEN         40
+#define     SIM_LCD_COLS            16
+
+
+/**********************************************************************************************************************
+ *  LOCAL DATA TYPES AND STRUCTURES
+ *********************************************************************************************************************/
+
+/* Scheduled input change */
+typedef struct
+{
+    unsigned long long time;
+    unsigned char port;             /* SIM_PORTx or SIM_ANALOG */
+    unsigned char pin;
+    unsigned int level;
+}SIM_input_t;
+
+/* HD44780 model */
+typedef struct
+{
+    unsigned char attached;
+    unsigned char port;
+    unsigned char rs, en, d[4];
+    unsigned char rw;               /* R/W pin (SIM_NO_PIN = tied to GND)            */
+    unsigned char read_low;         /* 4-bit read: next nibble is the low one        */
+    unsigned char pending;          /* EN pulse seen but not latched yet             */
+    unsigned char en_high;          /* EN was high at the previous sample            */
+    unsigned char pending_port;     /* Port value while EN was high                  */
+    unsigned char four_bit;         /* Interface data length (0 = 8-bit after reset) */
+    unsigned char high_nibble;      /* 4-bit mode: waiting for the low nibble        */
+    unsigned char nibble;           /* Latched high nibble                           */
+    unsigned char address;          /* DDRAM address counter                         */
+    unsigned char increment;        /* Entry mode I/D                                */
+    unsigned char display_on;
+    unsigned long long busy_until;  /* Controller busy until (cycles)                */
+    char ddram[SIM_LCD_ROWS][SIM_LCD_ROW_LEN];
+    void (*on_change)(unsigned char row);       /* Called when a visible character changes */
+    char row_text[SIM_LCD_COLS + 1];
+}SIM_lcd_t;
+
+/* One simulated microcontroller */
+typedef struct
+{
+    SIM_regfile_t regs;
+
+    unsigned long long now;                     /* Virtual time (cycles)             */
+    unsigned char in_isr;                       /* Executing myISR()                 */
+    unsigned char sleeping;                     /* Oscillator stopped (SLEEP)        */
+    unsigned int clock_div;                     /* Cycles per instruction (crystal = 1) */
+    unsigned char osc_seen;                     /* OSCCON SCS and IRCF last seen     */
+    unsigned char ost_busy;                     /* Crystal starting up (switch)      */
+    unsigned long long ost_done;                /* End of the oscillator start-up    */
+
+    /* Polling-loop detection */
+    volatile void *last_reg;
+    unsigned char last_value;                   /* Value at the previous access      */
+    unsigned char same_reg_count;
+    unsigned long long loop_accesses;           /* SFR accesses at the previous main loop pass */
+
+    /* Write detection: the register returned by the last access, checked at the next simulator call */
+    volatile void *write_reg;
+    unsigned char write_value;                  /* Value when the access returned    */
+    unsigned char sync_due;                     /* A write for SIM_Sync() to observe */
+    unsigned char irq_check;                    /* An interrupt flag or enable write */
+
+    /* Access fast path: nothing to observe before quiet_until (no write, event or interrupt), the peripherals are
+       run for the skipped cycles at the next synchronization */
+    unsigned long long quiet_until;
+    unsigned long long lazy_cycles;
+
+    /* Peripherals */
+    unsigned int t0_prescaler;
+    unsigned int t1_prescaler;
+    unsigned int t2_prescaler;
+    unsigned char t2_postscaler;
+    unsigned char tmr2_seen;                    /* TMR2 after the last timer update  */
+    unsigned char t2con_seen;                   /* T2CON last seen                   */
+    unsigned char adc_busy;
+    unsigned long long adc_done;
+    unsigned char adc_chs;                      /* Channel select bits last seen     */
+    unsigned long long adc_switch;              /* Time of the last channel switch   */
+    unsigned int analog[SIM_ADC_CHANNELS];
+    unsigned char eeprom[SIM_EEPROM_SIZE];      /* Data EEPROM                       */
+    unsigned char ee_unlock;                    /* EECON2 sequence: 1 = 0x55, 2 = 0xAA */
+    unsigned char ee_busy;                      /* Write in progress                 */
+    unsigned long long ee_done;                 /* End of the write                  */
+    unsigned char ee_address;                   /* Latched when the write starts     */
+    unsigned char ee_data;
+    unsigned long ee_wear[SIM_EEPROM_SIZE];     /* Completed writes of every cell    */
+    unsigned char tx_written;                   /* TXREG written since the last sync */
+    unsigned char tx_busy;                      /* TSR shifting a byte out           */
+    unsigned char tx_full;                      /* TXREG holds the next byte         */
+    unsigned char tx_shift;                     /* Byte in the TSR                   */
+    unsigned char tx_next;                      /* Byte in TXREG                     */
+    unsigned long long tx_done;                 /* End of the stop bit in the TSR    */
+    FILE *uart_out;                             /* Copy of the sent bytes (or NULL)  */
+
+    /* Pins */
+    unsigned char pin_in[3];                    /* External levels of input pins     */
+    unsigned char out_prev[3];                  /* Output levels at the previous sync */
+    SIM_input_t inputs[SIM_INPUT_QUEUE_SIZE];   /* Sorted by time                    */
+    unsigned int input_count;
+    unsigned long long stop;                    /* Fast-forward limit (SIM_StopAt)   */
+
+    SIM_edge_t edges[SIM_EDGE_LOG_SIZE];
+    unsigned int edge_count;
+
+    SIM_uart_byte_t uart_log[SIM_UART_LOG_SIZE];
+    unsigned int uart_count;
+
+    SIM_lcd_t lcd;
+    SIM_stats_t stats;
+}SIM_cpu_t;
+
+
+/**********************************************************************************************************************
+ *  LOCAL DATA
+ *********************************************************************************************************************/
+
+extern SIM_cpu_t *SIM_cpu;          /* Currently running instance */
+
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void SIM_LCD_Reset( SIM_lcd_t *lcd )
+* \Description     : Power-on state of the HD44780 model.
+*******************************************************************************/
+void SIM_LCD_Reset(SIM_lcd_t *lcd);
+
+/******************************************************************************
+* \Syntax          : void SIM_LCD_Sync( unsigned char delay )
+* \Description     : Samples the LCD port and latches enable pulses
+                     (delay = 1 at the end of a busy-wait).
+*******************************************************************************/
+void SIM_LCD_Sync(unsigned char delay);
+
+#endif /* SIM_PRV_H */
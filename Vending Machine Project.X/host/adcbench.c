@@ -0,0 +1,130 @@
+/**********************************************************************************************************************
+ * Filename:    adcbench.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Measures ADC_Read on the host simulator when the same channel is read again and again and when two
+ *              channels are read alternately, and checks every result against the simulated input voltage.
+ *              Built with ADC_USE_SAMPLER = 0.
+ * NOTE:        Times are virtual: every SFR access, busy-wait and the acquisition delay are charged.
+ *              Usage: adcbench [reads]
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <xc.h>
+#include "SIM/SIM.h"
+#include "../source/ADC/ADC.h"
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Default number of reads per measurement */
+#define     ADCBENCH_READS          200
+
+/* Simulated input voltages (10-bit) */
+#define     ADCBENCH_VALUE_AN0      0x111
+#define     ADCBENCH_VALUE_AN9      0x2AA
+
+#if ADC_USE_SAMPLER == 1
+#error "adcbench measures ADC_Read (ADC_USE_SAMPLER = 0)"
+#endif
+
+
+/**********************************************************************************************************************
+ *  LOCAL DATA TYPES AND STRUCTURES
+ *********************************************************************************************************************/
+
+/* Result of one measurement */
+typedef struct
+{
+    double read_us;                 /* One ADC_Read                        */
+    double accesses;                /* SFR accesses per read               */
+    unsigned long wrong;            /* Results from the wrong input        */
+    unsigned long long short_acq;   /* Conversions started before TACQ     */
+}ADCBENCH_result_t;
+
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void myISR( void )
+* \Description     : ADC_Read uses no interrupt (interrupts stay off).
+*******************************************************************************/
+void myISR(void)
+{
+}
+
+/******************************************************************************
+* \Syntax          : static void ADCBENCH_Run( alternate, reads, result )
+* \Description     : Reads AN9 only, or AN0 and AN9 alternately.
+*******************************************************************************/
+static void ADCBENCH_Run(unsigned char alternate, unsigned long reads, ADCBENCH_result_t *result)
+{
+    const SIM_stats_t *stats = SIM_Stats();
+    unsigned long long start;
+    unsigned long long accesses;
+
+    SIM_Reset();
+    SIM_SetAnalog(ADC0, ADCBENCH_VALUE_AN0);
+    SIM_SetAnalog(ADC9, ADCBENCH_VALUE_AN9);
+    ADC_Init();
+
+    result->wrong = 0;
+    start = SIM_Now();
+    accesses = stats->sfr_accesses;
+    for(unsigned long i = 0; i < reads; i++)
+    {
+        ADC_channel_t channel = (alternate && (i & 1)) ? ADC0 : ADC9;
+        unsigned int expected = (channel == ADC0) ? ADCBENCH_VALUE_AN0 : ADCBENCH_VALUE_AN9;
+
+        if(ADC_Read(channel) != expected)
+            result->wrong++;
+    }
+    result->read_us = SIM_US(SIM_Now() - start) / reads;
+    result->accesses = (double)(stats->sfr_accesses - accesses) / reads;
+    result->short_acq = stats->adc_short_acq;
+}
+
+
+/**********************************************************************************************************************
+ *  MAIN
+ *********************************************************************************************************************/
+
+int main(int argc, char **argv)
+{
+    unsigned long reads = (argc > 1) ? strtoul(argv[1], NULL, 10) : ADCBENCH_READS;
+    ADCBENCH_result_t same;
+    ADCBENCH_result_t alternate;
+    int ok;
+
+    if(reads < 2)
+        reads = 2;
+
+    ADCBENCH_Run(0, reads, &same);
+    ADCBENCH_Run(1, reads, &alternate);
+    ok = (same.wrong == 0) && (alternate.wrong == 0) && (same.short_acq == 0) && (alternate.short_acq == 0);
+
+    printf("%-26s %14s %14s\n", "", "same channel", "alternating");
+    printf("%-26s %11.1f us %11.1f us\n", "ADC_Read", same.read_us, alternate.read_us);
+    printf("%-26s %14.2f %14.2f\n", "SFR accesses / read", same.accesses, alternate.accesses);
+    printf("%-26s %14lu %14lu\n", "wrong results", same.wrong, alternate.wrong);
+    printf("%-26s %14llu %14llu\n", "acquisition too short", same.short_acq, alternate.short_acq);
+    printf("result                     : %s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: adcbench.c
+ *********************************************************************************************************************/
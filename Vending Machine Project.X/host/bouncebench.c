@@ -0,0 +1,172 @@
+/**********************************************************************************************************************
+ * Filename:    bouncebench.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Bounce-injection stress test: runs the unmodified firmware (VM_Init / VM_Running / myISR) through a
+ *              customer transaction where every button press and release bounces, including two buttons pressed
+ *              at the same time, and checks the selected drink, the credit and the change on the LCD, and that no
+ *              press, release or long press event was dropped.
+ * NOTE:        Every round moves the presses by a few ms against the Timer2 tick and uses other bounce timings.
+ *              Usage: bouncebench [rounds] [bounces]
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SIM/SIM.h"
+#include "../source/VendingMachine/VM.h"
+#include "../source/ADC/ADC.h"
+#include "../source/Event/EVENT.h"
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Defaults */
+#define     BOUNCEBENCH_ROUNDS      20
+#define     BOUNCEBENCH_BOUNCES     8
+
+/* Push buttons on PORTB */
+#define     BOUNCEBENCH_SW0         0
+#define     BOUNCEBENCH_SW1         1
+#define     BOUNCEBENCH_SW2         2
+
+/* Button hold time (ms) */
+#define     BOUNCEBENCH_HOLD_MS     150
+
+
+/**********************************************************************************************************************
+ *  LOCAL DATA TYPES AND STRUCTURES
+ *********************************************************************************************************************/
+
+/* LCD content expected at a given time */
+typedef struct
+{
+    unsigned int time_ms;
+    unsigned char row;
+    const char *text;
+}BOUNCEBENCH_check_t;
+
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+/* Water (50p): 3 x SW0 from Cola, SW1 selects, SW0 = 10p, then SW0 + SW2 together = 60p --> 20p change */
+static const BOUNCEBENCH_check_t gChecks[] =
+{
+    { 1250, 0, "Insert Coins:" },
+    { 1250, 1, "50" },
+    { 1550, 1, "40" },
+    { 1900, 0, "Drink Dispensing" },
+    { 7500, 0, "Change due:" },
+    { 7500, 1, "20" },
+};
+
+/* Most button events pending at once, all rounds */
+static unsigned char gHighWater = 0;
+
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : static int BOUNCEBENCH_Round( offset_ms, bounces, verbose )
+* \Description     : One transaction with bouncing buttons, returns the number
+                     of failed checks.
+*******************************************************************************/
+static int BOUNCEBENCH_Round(unsigned int offset_ms, unsigned char bounces, unsigned char verbose)
+{
+    const unsigned int count = sizeof(gChecks) / sizeof(gChecks[0]);
+    unsigned int next = 0;
+    int failed = 0;
+
+    SIM_Reset();
+    SIM_LCD_Attach(SIM_PORTC, 0, 3, 4, 5, 6, 7);
+    SIM_SetAnalog(ADC9, 0x100);
+
+    SIM_BounceButton(SIM_CYCLES_MS(100 + offset_ms), BOUNCEBENCH_SW0, BOUNCEBENCH_HOLD_MS, bounces);
+    SIM_BounceButton(SIM_CYCLES_MS(400 + offset_ms), BOUNCEBENCH_SW0, BOUNCEBENCH_HOLD_MS, bounces);
+    SIM_BounceButton(SIM_CYCLES_MS(700 + offset_ms), BOUNCEBENCH_SW0, BOUNCEBENCH_HOLD_MS, bounces);
+    SIM_BounceButton(SIM_CYCLES_MS(1000 + offset_ms), BOUNCEBENCH_SW1, BOUNCEBENCH_HOLD_MS, bounces);
+    SIM_BounceButton(SIM_CYCLES_MS(1300 + offset_ms), BOUNCEBENCH_SW0, BOUNCEBENCH_HOLD_MS, bounces);
+    SIM_BounceButton(SIM_CYCLES_MS(1600 + offset_ms), BOUNCEBENCH_SW0, BOUNCEBENCH_HOLD_MS, bounces);
+    SIM_BounceButton(SIM_CYCLES_MS(1600 + offset_ms), BOUNCEBENCH_SW2, BOUNCEBENCH_HOLD_MS, bounces);
+
+    VM_Init();
+    while(next < count)
+    {
+        VM_Running();
+        SIM_MainLoop();
+
+        while((next < count) && (SIM_Now() >= SIM_CYCLES_MS(gChecks[next].time_ms + offset_ms)))
+        {
+            if(!SIM_LCD_RowStartsWith(gChecks[next].row, gChecks[next].text))
+            {
+                failed++;
+                if(verbose)
+                    printf("  offset %2u ms, %5u ms: row %u is |%s|, expected |%s...|\n", offset_ms,
+                           gChecks[next].time_ms, gChecks[next].row, SIM_LCD_Row(gChecks[next].row),
+                           gChecks[next].text);
+            }
+            next++;
+        }
+    }
+    if(EVENT_Dropped() != 0)
+    {
+        failed++;
+        if(verbose)
+            printf("  offset %2u ms: %u button events dropped\n", offset_ms, EVENT_Dropped());
+    }
+    if(EVENT_HighWater() > gHighWater)
+        gHighWater = EVENT_HighWater();
+    return failed;
+}
+
+
+/**********************************************************************************************************************
+ *  MAIN
+ *********************************************************************************************************************/
+
+int main(int argc, char **argv)
+{
+    unsigned long rounds = (argc > 1) ? strtoul(argv[1], NULL, 10) : BOUNCEBENCH_ROUNDS;
+    unsigned char bounces = (argc > 2) ? (unsigned char)strtoul(argv[2], NULL, 10) : BOUNCEBENCH_BOUNCES;
+    unsigned long failed_rounds = 0;
+    unsigned long failed_checks = 0;
+    unsigned long long isr_calls = 0;
+
+    if(rounds == 0)
+        rounds = 1;
+
+    for(unsigned long i = 0; i < rounds; i++)
+    {
+        int failed = BOUNCEBENCH_Round((unsigned int)((i * 7) % 23), bounces, failed_rounds < 3);
+
+        failed_checks += failed;
+        failed_rounds += (failed != 0);
+        isr_calls += SIM_Stats()->isr_calls;
+    }
+
+    printf("rounds               : %lu (%u bounces per press and release)\n", rounds, bounces);
+    printf("failed rounds        : %lu\n", failed_rounds);
+    printf("failed LCD checks    : %lu of %lu\n", failed_checks,
+           rounds * (unsigned long)(sizeof(gChecks) / sizeof(gChecks[0])));
+    printf("ISR calls / round    : %llu\n", isr_calls / rounds);
+    printf("events pending (max) : %u of %u\n", gHighWater, EVENT_QUEUE_SIZE - 1);
+    printf("result               : %s\n", (failed_rounds == 0) ? "ok" : "FAILED");
+    return (failed_rounds == 0) ? 0 : 1;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: bouncebench.c
+ *********************************************************************************************************************/
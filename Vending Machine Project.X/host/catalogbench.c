@@ -0,0 +1,277 @@
+/**********************************************************************************************************************
+ * Filename:    catalogbench.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Runs the unmodified firmware (VM_Init / VM_Running / myISR) with other drink catalogs written to the
+ *              data EEPROM: the programmed 4 products, a full catalog (CATALOG_MAX_PRODUCTS products, the last one
+ *              dispensed by slot 3 = RA3), an erased EEPROM and products on slots without a dispenser (RA1 change
+ *              LED, RA2 buzzer, RA6 crystal, slot 9). Checks every name and price on the LCD, the dispenser of the last product, that a product
+ *              on a bad slot ends the catalog without touching its pin, and reports the boot time of the catalog.
+ * NOTE:        The first run uses the EEPROM programmed with the firmware (__EEPROM_DATA), the other catalogs are
+ *              written with SIM_EepromWrite() after SIM_Reset(), like a reprogrammed EEPROM.
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "SIM/SIM.h"
+#include "../source/VendingMachine/VM.h"
+#include "../source/Catalog/CATALOG.h"
+#include "../source/Catalog/CATALOG_prv.h"
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Push buttons on PORTB */
+#define     CATALOGBENCH_SW0        0
+#define     CATALOGBENCH_SW1        1
+
+/* Time between two presses (ms) */
+#define     CATALOGBENCH_STEP_MS    300
+
+
+/**********************************************************************************************************************
+ *  LOCAL DATA TYPES AND STRUCTURES
+ *********************************************************************************************************************/
+
+typedef struct
+{
+    const char *name;
+    unsigned char price;
+    unsigned char slot;
+}CATALOGBENCH_product_t;
+
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+static const CATALOGBENCH_product_t gDefault[] =
+{
+    { "Cola", 8, 0 }, { "Lemonade", 8, 0 }, { "Orange", 6, 0 }, { "Water", 5, 0 },
+};
+
+/* Second product on a slot without a dispenser (CATALOG_SLOTS): the catalog ends after Cola */
+static const unsigned char gBadSlots[] = { 1, 2, 6, 9 };
+
+/* Full catalog: the first CATALOG_MAX_PRODUCTS - 1 products and the last one */
+static const CATALOGBENCH_product_t gProducts[] =
+{
+    { "Coffee", 9, 0 }, { "Juice", 7, 0 }, { "Soda", 4, 0 }, { "Cola", 8, 0 },
+    { "Lemonade", 8, 0 }, { "Orange", 6, 0 }, { "Water", 5, 0 }, { "Tea", 3, 3 },
+};
+
+#if CATALOG_MAX_PRODUCTS > 8
+#error "catalogbench: up to 8 products"
+#endif
+
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : static void CATALOGBENCH_Install( products, count )
+* \Description     : Writes a catalog into the data EEPROM (count = 0: the
+                     EEPROM is erased).
+*******************************************************************************/
+static void CATALOGBENCH_Install(const CATALOGBENCH_product_t *products, unsigned char count)
+{
+    for(unsigned int address = 0; address < 128; address++)
+        SIM_EepromWrite((unsigned char)address, 0xFF);
+    if(count == 0)
+        return;
+
+    SIM_EepromWrite(CATALOG_EEPROM_BASE, CATALOG_MAGIC);
+    SIM_EepromWrite(CATALOG_EEPROM_BASE + 1, count);
+    for(unsigned char i = 0; i < count; i++)
+    {
+        SIM_EepromWrite(CATALOG_RECORD(i), CATALOG_PACK(products[i].slot, products[i].price));
+        for(unsigned char c = 0; c < CATALOG_NAME_LENGTH; c++)
+            SIM_EepromWrite(CATALOG_RECORD(i) + 1 + c, (c < strlen(products[i].name)) ? products[i].name[c] : 0);
+    }
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned char CATALOGBENCH_Dispensed( pin )
+* \Description     : Returns 1 if the dispenser RA<pin> was turned on (edge
+                     log, the blocking build returns after dispensing).
+*******************************************************************************/
+static unsigned char CATALOGBENCH_Dispensed(unsigned char pin)
+{
+    const SIM_edge_t *edges;
+    unsigned int count = SIM_EdgeLog(&edges);
+
+    for(unsigned int i = 0; i < count; i++)
+    {
+        if((edges[i].port == SIM_PORTA) && (edges[i].pin == pin) && edges[i].level)
+            return 1;
+    }
+    return 0;
+}
+
+/******************************************************************************
+* \Syntax          : static int CATALOGBENCH_Run( title, products, count, install )
+* \Description     : Browses the whole catalog, buys the last product with
+                     10p coins and returns the number of failed checks
+                     (install = 0: the EEPROM programmed with the firmware
+                     must hold products).
+*******************************************************************************/
+static int CATALOGBENCH_Run(const char *title, const CATALOGBENCH_product_t *products, unsigned char count,
+                            unsigned char install)
+{
+    const SIM_stats_t *stats = SIM_Stats();
+    unsigned long long boot_reads;
+    unsigned long long boot_cycles;
+    unsigned long long t;
+    char expected[24];
+    int failed = 0;
+
+    SIM_Reset();
+    SIM_LCD_Attach(SIM_PORTC, 0, 3, 4, 5, 6, 7);
+    if(install)
+        CATALOGBENCH_Install(products, count);
+
+    VM_Init();
+    boot_reads = stats->eeprom_reads;
+    boot_cycles = SIM_Now();
+    printf("%s\n", title);
+
+    if(count == 0)
+    {
+        /* Nothing to sell: SW1 must not start a transaction */
+        SIM_PressButton(SIM_Now() + SIM_CYCLES_MS(100), CATALOGBENCH_SW1, 50);
+        SIM_RunUntil(SIM_Now() + SIM_CYCLES_MS(CATALOGBENCH_STEP_MS), NULL);
+        if(!SIM_LCD_RowStartsWith(0, "Select Drink:") || !SIM_LCD_RowStartsWith(1, "Out of Order"))
+        {
+            printf("  LCD |%s|%s|, expected Out of Order\n", SIM_LCD_Row(0), SIM_LCD_Row(1));
+            failed++;
+        }
+        printf("  boot                : %llu EEPROM reads, VM_Init %.1f ms\n", boot_reads, SIM_MS(boot_cycles));
+        return failed;
+    }
+
+    /* Every product, SW0 moves to the next one */
+    t = SIM_Now();
+    for(unsigned char i = 0; i < count; i++)
+    {
+        SIM_RunUntil(t + SIM_CYCLES_MS(CATALOGBENCH_STEP_MS), NULL);
+        snprintf(expected, sizeof(expected), "%s %u0p", products[i].name, products[i].price);
+        if(!SIM_LCD_RowStartsWith(1, expected) || (SIM_LCD_Row(1)[strlen(expected)] != ' '))
+        {
+            printf("  product %u: LCD |%s|, expected |%s|\n", i, SIM_LCD_Row(1), expected);
+            failed++;
+        }
+        t = SIM_Now();
+        if(i + 1 < count)
+            SIM_PressButton(t + SIM_CYCLES_MS(50), CATALOGBENCH_SW0, 50);
+    }
+
+    /* Buy the last product with 10p coins, its slot dispenses */
+    SIM_PressButton(t + SIM_CYCLES_MS(50), CATALOGBENCH_SW1, 50);
+    for(unsigned char i = 0; i < products[count - 1].price; i++)
+        SIM_PressButton(t + SIM_CYCLES_MS(350 + i * CATALOGBENCH_STEP_MS), CATALOGBENCH_SW0, 50);
+    SIM_RunUntil(t + SIM_CYCLES_MS(350 + products[count - 1].price * CATALOGBENCH_STEP_MS + 1000), NULL);
+    if(!SIM_LCD_RowStartsWith(0, "Drink Dispensing") || !CATALOGBENCH_Dispensed(products[count - 1].slot))
+    {
+        printf("  buy %s: LCD |%s|, RA%u not turned on\n", products[count - 1].name, SIM_LCD_Row(0),
+               products[count - 1].slot);
+        failed++;
+    }
+
+    printf("  products            : %u (names and prices checked, %s dispensed by RA%u)\n", count,
+           products[count - 1].name, products[count - 1].slot);
+    printf("  boot                : %llu EEPROM reads, VM_Init %.1f ms\n", boot_reads, SIM_MS(boot_cycles));
+    printf("  EEPROM reads        : %llu during %.1f s\n", stats->eeprom_reads - boot_reads, SIM_MS(SIM_Now()) / 1000);
+    return failed;
+}
+
+
+/******************************************************************************
+* \Syntax          : static int CATALOGBENCH_BadSlot( unsigned char slot )
+* \Description     : Installs Cola (slot 0) and Tea on the given slot: only
+                     Cola must be sold (SW0 stays on it, RA0 dispenses it)
+                     and the pin of the slot is never driven. Returns the
+                     number of failed checks.
+*******************************************************************************/
+static int CATALOGBENCH_BadSlot(unsigned char slot)
+{
+    const CATALOGBENCH_product_t products[] = { { "Cola", 8, 0 }, { "Tea", 3, slot } };
+    unsigned long long t;
+    int failed = 0;
+
+    SIM_Reset();
+    SIM_LCD_Attach(SIM_PORTC, 0, 3, 4, 5, 6, 7);
+    CATALOGBENCH_Install(products, 2);
+
+    VM_Init();
+    t = SIM_Now();
+    SIM_PressButton(t + SIM_CYCLES_MS(100), CATALOGBENCH_SW0, 50);
+    SIM_RunUntil(t + SIM_CYCLES_MS(CATALOGBENCH_STEP_MS), NULL);
+    if((CATALOG_Count() != 1) || !SIM_LCD_RowStartsWith(1, "Cola 80p"))
+    {
+        printf("  slot %u: %u products, LCD |%s|, expected Cola only\n", slot, CATALOG_Count(), SIM_LCD_Row(1));
+        failed++;
+    }
+
+    /* Buy what is displayed with 10p coins */
+    t = SIM_Now();
+    SIM_PressButton(t + SIM_CYCLES_MS(50), CATALOGBENCH_SW1, 50);
+    for(unsigned char i = 0; i < products[0].price; i++)
+        SIM_PressButton(t + SIM_CYCLES_MS(350 + i * CATALOGBENCH_STEP_MS), CATALOGBENCH_SW0, 50);
+    SIM_RunUntil(t + SIM_CYCLES_MS(350 + products[0].price * CATALOGBENCH_STEP_MS + 1000), NULL);
+    if(!CATALOGBENCH_Dispensed(0) || ((slot < 8) && CATALOGBENCH_Dispensed(slot)))
+    {
+        printf("  slot %u: RA0 %s, RA%u %s\n", slot, CATALOGBENCH_Dispensed(0) ? "on" : "off", slot,
+               CATALOGBENCH_Dispensed(slot) ? "driven" : "not driven");
+        failed++;
+    }
+    return failed;
+}
+
+
+/**********************************************************************************************************************
+ *  MAIN
+ *********************************************************************************************************************/
+
+int main(void)
+{
+    CATALOGBENCH_product_t full[CATALOG_MAX_PRODUCTS];
+    char title[32];
+    int failed = 0;
+
+    for(unsigned char i = 0; i + 1 < CATALOG_MAX_PRODUCTS; i++)
+        full[i] = gProducts[i];
+    full[CATALOG_MAX_PRODUCTS - 1] = gProducts[sizeof(gProducts) / sizeof(gProducts[0]) - 1];
+    snprintf(title, sizeof(title), "%u products", CATALOG_MAX_PRODUCTS);
+
+    failed += CATALOGBENCH_Run("programmed catalog", gDefault, sizeof(gDefault) / sizeof(gDefault[0]), 0);
+    failed += CATALOGBENCH_Run(title, full, CATALOG_MAX_PRODUCTS, 1);
+    failed += CATALOGBENCH_Run("erased EEPROM", NULL, 0, 1);
+
+    printf("bad slots\n");
+    for(unsigned char i = 0; i < sizeof(gBadSlots); i++)
+    {
+        int bad = CATALOGBENCH_BadSlot(gBadSlots[i]);
+
+        if(bad == 0)
+            printf("  slot %-14u: rejected (catalog ends, pin not driven)\n", gBadSlots[i]);
+        failed += bad;
+    }
+
+    printf("result               : %s\n", (failed == 0) ? "ok" : "FAILED");
+    return (failed == 0) ? 0 : 1;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: catalogbench.c
+ *********************************************************************************************************************/
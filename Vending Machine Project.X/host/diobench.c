@@ -0,0 +1,226 @@
+/**********************************************************************************************************************
+ * Filename:    diobench.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Compares the DIO function API (DIO_setPinValue) with the compile time pin macros (DIO_SET, DIO_CLEAR,
+ *              DIO_WRITE, DIO_WRITE_MASKED): the instructions executed per pin write, counted by single-stepping a
+ *              child process (SIM_Instructions), the time per pin write and the port value left by both. Then checks
+ *              that a pin held low by its load (read back wrong) keeps its output level when another pin of the port
+ *              is written: kept with the shadow latch (DIO_USE_SHADOW = 1), lost by a read-modify-write (diobench_rmw).
+ * NOTE:        Built with SIM_DIRECT_SFR = 1: the SFRs are plain memory, so only the driver code is counted. The
+ *              counts are host instructions; on the PIC the macros are one bsf/bcf on a port without a shadow latch
+ *              (PORTC, every port with DIO_USE_SHADOW = 0) and a few instructions on PORTA, against a call, the port
+ *              switch and the run time shift of DIO_setPinValue.
+ *              Usage: diobench
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include <time.h>
+
+#include <xc.h>
+#include "SIM/SIM.h"
+#include "../source/DIO/DIO.h"
+
+#if !defined(SIM_DIRECT_SFR) || (SIM_DIRECT_SFR != 1)
+#error "diobench: build with SIM_DIRECT_SFR = 1"
+#endif
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Pin writes timed per case */
+#define     DIOBENCH_ITERATIONS     10000000UL
+
+/* Port values before the checks (the pin changes from one of them) */
+#define     DIOBENCH_ZEROS          0x00
+#define     DIOBENCH_ONES           0xFF
+
+/* Pins of the cases: first and last case of the DIO_setPinValue port switch */
+#define     DIOBENCH_RA0            A, 0
+#define     DIOBENCH_RC7            C, 7
+#define     DIOBENCH_RA1            A, 1
+
+/* Pins of the masked cases: the dispenser LEDs (RA0, RA1) and a LCD data nibble (RC4..RC7) */
+#define     DIOBENCH_LEDS           0x03
+#define     DIOBENCH_NIBBLE         0xF0
+
+
+/**********************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *********************************************************************************************************************/
+
+/* One pin write, with the function API and with the macros */
+typedef struct
+{
+    const char *name;
+    void (*function)(void);
+    void (*macro)(void);
+}DIOBENCH_case_t;
+
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+static volatile unsigned char gValue = HIGH;        /* Pin value only known at run time */
+
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void myISR( void )
+* \Description     : No interrupt (the simulator is not run).
+*******************************************************************************/
+void myISR(void)
+{
+}
+
+/* Pin writes, called through a pointer (same call for every case, subtracted with DIOBENCH_Empty) */
+static void DIOBENCH_Empty(void)            { }
+static void DIOBENCH_SetFunction(void)      { DIO_setPinValue(DIO_PORTA, DIO_PIN0, HIGH); }
+static void DIOBENCH_SetMacro(void)         { DIO_SET(DIOBENCH_RA0); }
+static void DIOBENCH_ClearFunction(void)    { DIO_setPinValue(DIO_PORTA, DIO_PIN0, LOW); }
+static void DIOBENCH_ClearMacro(void)       { DIO_CLEAR(DIOBENCH_RA0); }
+static void DIOBENCH_SetCFunction(void)     { DIO_setPinValue(DIO_PORTC, DIO_PIN7, HIGH); }
+static void DIOBENCH_SetCMacro(void)        { DIO_SET(DIOBENCH_RC7); }
+static void DIOBENCH_WriteFunction(void)    { DIO_setPinValue(DIO_PORTA, DIO_PIN0, gValue); }
+static void DIOBENCH_WriteMacro(void)       { DIO_WRITE(DIOBENCH_RA0, gValue); }
+static void DIOBENCH_LedsFunction(void)     { DIO_setPinValue(DIO_PORTA, DIO_PIN0, LOW);
+                                              DIO_setPinValue(DIO_PORTA, DIO_PIN1, LOW); }
+static void DIOBENCH_LedsMacro(void)        { DIO_WRITE_MASKED(A, DIOBENCH_LEDS, 0x00); }
+static void DIOBENCH_NibbleFunction(void)   { DIO_setPinValue(DIO_PORTC, DIO_PIN4, gValue & 1);
+                                              DIO_setPinValue(DIO_PORTC, DIO_PIN5, gValue & 2);
+                                              DIO_setPinValue(DIO_PORTC, DIO_PIN6, gValue & 4);
+                                              DIO_setPinValue(DIO_PORTC, DIO_PIN7, gValue & 8); }
+static void DIOBENCH_NibbleMacro(void)      { DIO_WRITE_MASKED(C, DIOBENCH_NIBBLE, gValue << 4); }
+
+static const DIOBENCH_case_t gCases[] =
+{
+    { "set RA0",            DIOBENCH_SetFunction,   DIOBENCH_SetMacro },
+    { "clear RA0",          DIOBENCH_ClearFunction, DIOBENCH_ClearMacro },
+    { "set RC7",            DIOBENCH_SetCFunction,  DIOBENCH_SetCMacro },
+    { "write RA0 (var)",    DIOBENCH_WriteFunction, DIOBENCH_WriteMacro },
+    { "clear RA0+RA1",      DIOBENCH_LedsFunction,  DIOBENCH_LedsMacro },
+    { "nibble RC4..7",      DIOBENCH_NibbleFunction, DIOBENCH_NibbleMacro },
+};
+
+/******************************************************************************
+* \Syntax          : static double DIOBENCH_Time( void (*operation)(void) )
+* \Description     : Returns the time of one call in ns (call through the
+                     pointer included).
+*******************************************************************************/
+static double DIOBENCH_Time(void (*operation)(void))
+{
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(unsigned long i = 0; i < DIOBENCH_ITERATIONS; i++)
+        operation();
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / DIOBENCH_ITERATIONS;
+}
+
+/******************************************************************************
+* \Syntax          : static int DIOBENCH_Same( void (*a)(void), void (*b)(void),
+                                             unsigned char pattern )
+* \Description     : Returns 1 if both operations leave the same ports, the
+                     ports are set to pattern before each.
+*******************************************************************************/
+static int DIOBENCH_Same(void (*a)(void), void (*b)(void), unsigned char pattern)
+{
+    unsigned char porta, portc;
+
+    SIM_regs->porta = SIM_regs->portc = pattern;
+    a();
+    porta = SIM_regs->porta;
+    portc = SIM_regs->portc;
+    SIM_regs->porta = SIM_regs->portc = pattern;
+    b();
+    return (porta == SIM_regs->porta) && (portc == SIM_regs->portc);
+}
+
+/******************************************************************************
+* \Syntax          : static int DIOBENCH_Load( void )
+* \Description     : Sets RA0, pulls the pin low (heavy load, the port reads
+                     0) and sets RA1: returns 1 if RA0 is still driven high.
+*******************************************************************************/
+static int DIOBENCH_Load(void)
+{
+    SIM_regs->porta = 0x00;
+    DIO_CLEAR(DIOBENCH_RA1);
+    DIO_SET(DIOBENCH_RA0);
+    SIM_regs->porta &= (unsigned char)~0x01;
+    DIO_SET(DIOBENCH_RA1);
+    return SIM_regs->porta & 0x01;
+}
+
+
+/**********************************************************************************************************************
+ *  MAIN
+ *********************************************************************************************************************/
+
+int main(void)
+{
+    long empty = SIM_Instructions(DIOBENCH_Empty);
+    int errors = 0;
+    int ok;
+
+    SIM_Reset();
+    printf("shadow latch        : PORTA %s, PORTB %s, PORTC %s\n", DIO_SHADOW_A ? "yes" : "no",
+           DIO_SHADOW_B ? "yes" : "no", DIO_SHADOW_C ? "yes" : "no");
+    printf("pin write           :   instructions (function / macro)   ns per call (function / macro)\n");
+    for(unsigned int i = 0; i < sizeof(gCases) / sizeof(gCases[0]); i++)
+    {
+        const DIOBENCH_case_t *test = &gCases[i];
+        long function = SIM_Instructions(test->function);
+        long macro = SIM_Instructions(test->macro);
+        double function_ns = DIOBENCH_Time(test->function);
+        double macro_ns = DIOBENCH_Time(test->macro);
+
+        if((empty >= 0) && (function >= 0) && (macro >= 0))
+        {
+            printf("  %-18s:   %6ld / %-6ld                    %6.2f / %.2f\n", test->name, function - empty,
+                   macro - empty, function_ns, macro_ns);
+            if(macro >= function)
+                errors++;
+        }
+        else
+            printf("  %-18s:      n/a                             %6.2f / %.2f\n", test->name, function_ns,
+                   macro_ns);
+        if(!DIOBENCH_Same(test->function, test->macro, DIOBENCH_ZEROS) ||
+           !DIOBENCH_Same(test->function, test->macro, DIOBENCH_ONES))
+        {
+            printf("  %-18s: the ports differ\n", test->name);
+            errors++;
+        }
+    }
+
+    /* The shadow latch never reads the port back */
+    if(DIOBENCH_Load())
+        printf("loaded RA0, set RA1: RA0 kept\n");
+    else
+    {
+        printf("loaded RA0, set RA1: RA0 lost (read-modify-write)\n");
+        if(DIO_USE_SHADOW == 1)
+            errors++;
+    }
+
+    ok = (errors == 0);
+    printf("result              : %s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: diobench.c
+ *********************************************************************************************************************/
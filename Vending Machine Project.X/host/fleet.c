@@ -0,0 +1,736 @@
+/**********************************************************************************************************************
+ * Filename:    fleet.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Fleet simulator: N independent vending machines, each running the unmodified firmware (telemetry
+ *              build) on its own simulated microcontroller, serve synthetic customers (Poisson arrivals, random
+ *              drink and coins, human press timing) for the same virtual time. Reports the fleet transactions per
+ *              second, the latency percentiles (customer arrival to the machine back at the drink menu) over the
+ *              fleet and per machine, and the telemetry load at the back-office collector (frames and bytes per
+ *              second, busiest second).
+ * NOTE:        Every machine owns a register file (SIM_InstanceSize(), SIM_Select()) and a copy of the firmware RAM:
+ *              the firmware is linked as one object whose .data/.bss are renamed vm_ram/vm_zram (make fleet,
+ *              GNU objcopy), the copy of the machine is swapped in around each time slice it runs. The firmware RAM
+ *              is one image per process, so the workers are processes: the machines and the work queues live in
+ *              shared memory, every worker runs time slices from its own queue and steals from the others when it
+ *              is empty (-s queues every machine on worker 0 so that the others have to steal). A machine only
+ *              depends on its own seed, so the results do not depend on the workers: every machine is run again
+ *              alone at the end (one worker, this process) to check it.
+ *              Usage: fleet [-n machines] [-d duration s] [-a mean arrival s] [-w workers] [-s] [-v]
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <math.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "SIM/SIM.h"
+#include "../source/ADC/ADC.h"
+#include "../source/Catalog/CATALOG.h"
+#include "../source/LCD/LCD.h"
+#include "../source/UART/UART.h"
+#include "../source/VendingMachine/VM.h"
+
+#if VM_USE_TELEMETRY != 1
+#error "fleet: build with -DVM_USE_TELEMETRY=1 and the LCD on RC0..RC5"
+#endif
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Push buttons: drink selection (SW0 next, SW1 select), coins (SW0 10p, SW1 20p, SW2 50p) */
+#define     FLEET_SW0               0
+#define     FLEET_SW1               1
+#define     FLEET_SW2               2
+
+/* Tilt sensor at rest (below the 2V alarm threshold) */
+#define     FLEET_LEVEL_IDLE        0x100
+
+/* Customer: time before each press and press length (ms, uniform) */
+#define     FLEET_THINK_MIN_MS      200
+#define     FLEET_THINK_MAX_MS      900
+#define     FLEET_HOLD_MIN_MS       80
+#define     FLEET_HOLD_MAX_MS       200
+
+/* A customer not served this long after the arrival is counted as failed (ms) */
+#define     FLEET_TIMEOUT_MS        120000UL
+
+/* Virtual time run by a machine before its worker takes the next one (ms) */
+#define     FLEET_SLICE_MS          2000
+
+/* Latencies kept per machine (percentiles) */
+#define     FLEET_MAX_SAMPLES       512
+
+/* Defaults */
+#define     FLEET_MACHINES          100
+#define     FLEET_DURATION_S        300
+#define     FLEET_ARRIVAL_S         60
+
+/* Customer phases */
+#define     FLEET_WAITING           0       /* Next customer not arrived or machine busy */
+#define     FLEET_BUYING            1       /* Presses scheduled                        */
+#define     FLEET_DISPENSED         2       /* Drink out (RA0 back low)                 */
+
+
+/**********************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *********************************************************************************************************************/
+
+/* One machine and its customers (shared memory) */
+typedef struct
+{
+    unsigned long seed;                     /* Pseudo-random state of the customers   */
+    unsigned char started;                  /* VM_Init done                           */
+    unsigned char done;                     /* Ran the whole duration                 */
+    unsigned char phase;                    /* FLEET_WAITING / BUYING / DISPENSED     */
+    unsigned long long arrival;             /* Arrival of the current customer (cycles) */
+    unsigned long long start;               /* First press of the current customer   */
+    unsigned int sales;                     /* Customers served                       */
+    unsigned int failed;                    /* Customers not served in time           */
+    unsigned int samples;                   /* Latencies kept                         */
+    unsigned int latency_ms[FLEET_MAX_SAMPLES];
+    unsigned long long service_cycles;      /* First press to the menu, all customers */
+    unsigned long long wait_cycles;         /* Arrival to the first press, all customers */
+    unsigned long frames;                   /* Telemetry frames sent                  */
+    unsigned long bytes;                    /* Telemetry bytes sent                   */
+    unsigned char rx_length;                /* Telemetry frame being parsed: bytes    */
+    unsigned char rx_size;                  /* and its size                           */
+    unsigned long long lcd_violations;
+}FLEET_machine_t;
+
+/* Work queue of a worker (machine numbers, taken from the tail by its worker, stolen from the head) */
+typedef struct
+{
+    volatile unsigned char lock;
+    unsigned int head;
+    unsigned int tail;
+    unsigned long steals;                   /* Machines stolen by this worker */
+    unsigned long slices;                   /* Time slices run                */
+}FLEET_queue_t;
+
+/* Whole fleet (shared memory) */
+typedef struct
+{
+    unsigned int machines;
+    unsigned int workers;
+    unsigned long long end;                 /* Duration (cycles)                      */
+    double arrival_s;                       /* Mean time between customers            */
+    volatile unsigned int remaining;        /* Machines not done                      */
+    unsigned long ram_size;                 /* Firmware RAM (vm_ram + vm_zram)        */
+    unsigned long cpu_size;                 /* SIM_InstanceSize(), rounded up         */
+    FLEET_machine_t *machine;
+    unsigned char *ram;                     /* Firmware RAM of every machine          */
+    unsigned char *cpu;                     /* Register file of every machine         */
+    FLEET_queue_t *queue;
+    unsigned int *slots;                    /* Queue entries, machines per worker     */
+    unsigned int *second_frames;            /* Collector: frames per virtual second   */
+}FLEET_t;
+
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+/* Firmware RAM (sections of the firmware object, see the Makefile) */
+extern unsigned char __start_vm_ram[], __stop_vm_ram[];
+extern unsigned char __start_vm_zram[], __stop_vm_zram[];
+
+static unsigned char *gPowerOn;             /* Firmware RAM as after a reset (before any firmware code ran) */
+static FLEET_t *gFleet;
+
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : static void FLEET_RamSave( unsigned char *image )
+* \Description     : Copies the firmware RAM to an image.
+*******************************************************************************/
+static void FLEET_RamSave(unsigned char *image)
+{
+    unsigned long data = (unsigned long)(__stop_vm_ram - __start_vm_ram);
+
+    memcpy(image, __start_vm_ram, data);
+    memcpy(image + data, __start_vm_zram, (unsigned long)(__stop_vm_zram - __start_vm_zram));
+}
+
+/******************************************************************************
+* \Syntax          : static void FLEET_RamLoad( const unsigned char *image )
+* \Description     : Copies an image to the firmware RAM.
+*******************************************************************************/
+static void FLEET_RamLoad(const unsigned char *image)
+{
+    unsigned long data = (unsigned long)(__stop_vm_ram - __start_vm_ram);
+
+    memcpy(__start_vm_ram, image, data);
+    memcpy(__start_vm_zram, image + data, (unsigned long)(__stop_vm_zram - __start_vm_zram));
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned long FLEET_Random( FLEET_machine_t *m,
+                                                        unsigned long range )
+* \Description     : Returns a pseudo-random number in 0 .. range - 1
+                     (xorshift, per machine).
+*******************************************************************************/
+static unsigned long FLEET_Random(FLEET_machine_t *m, unsigned long range)
+{
+    unsigned long x = m->seed;
+
+    x ^= (x << 13) & 0xFFFFFFFFUL;
+    x ^= x >> 17;
+    x ^= (x << 5) & 0xFFFFFFFFUL;
+    m->seed = x;
+    return x % range;
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned long long FLEET_NextArrival( FLEET_machine_t *m )
+* \Description     : Returns the time to the next customer (exponential,
+                     cycles).
+*******************************************************************************/
+static unsigned long long FLEET_NextArrival(FLEET_machine_t *m)
+{
+    double u = (FLEET_Random(m, 1000000UL) + 0.5) / 1000000.0;
+
+    return SIM_CYCLES_MS(-1000.0 * gFleet->arrival_s * log(u));
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned long long FLEET_Press( FLEET_machine_t *m,
+                                                           unsigned long long at,
+                                                           unsigned char pin )
+* \Description     : Schedules a press after a think time, returns the time
+                     the button is released.
+*******************************************************************************/
+static unsigned long long FLEET_Press(FLEET_machine_t *m, unsigned long long at, unsigned char pin)
+{
+    unsigned int hold = FLEET_HOLD_MIN_MS + FLEET_Random(m, FLEET_HOLD_MAX_MS - FLEET_HOLD_MIN_MS + 1);
+
+    at += SIM_CYCLES_MS(FLEET_THINK_MIN_MS + FLEET_Random(m, FLEET_THINK_MAX_MS - FLEET_THINK_MIN_MS + 1));
+    SIM_PressButton(at, pin, hold);
+    return at + SIM_CYCLES_MS(hold);
+}
+
+/******************************************************************************
+* \Syntax          : static void FLEET_Buy( FLEET_machine_t *m )
+* \Description     : Schedules the presses of a customer: a random drink (SW0
+                     from the first one, SW1) and random coins until it is
+                     paid.
+*******************************************************************************/
+static void FLEET_Buy(FLEET_machine_t *m)
+{
+    static const unsigned char coins[3][2] = { { FLEET_SW0, 1 }, { FLEET_SW1, 2 }, { FLEET_SW2, 5 } };
+    unsigned char drink = (unsigned char)FLEET_Random(m, CATALOG_Count());
+    unsigned long long at = SIM_Now();
+    unsigned int paid = 0;
+
+    for(unsigned char i = 0; i < drink; i++)
+        at = FLEET_Press(m, at, FLEET_SW0);
+    at = FLEET_Press(m, at, FLEET_SW1);
+    while(paid < CATALOG_Price(drink))
+    {
+        unsigned char coin = (unsigned char)FLEET_Random(m, 3);
+
+        at = FLEET_Press(m, at, coins[coin][0]);
+        paid += coins[coin][1];
+    }
+}
+
+/******************************************************************************
+* \Syntax          : static void FLEET_Collect( FLEET_machine_t *m )
+* \Description     : Counts the telemetry frames sent since the last call
+                     (per machine and per virtual second of the fleet).
+*******************************************************************************/
+static void FLEET_Collect(FLEET_machine_t *m)
+{
+    const SIM_uart_byte_t *bytes;
+    unsigned int count = SIM_UART_Log(&bytes);
+
+    for(unsigned int i = 0; i < count; i++)
+    {
+        if((m->rx_length == 0) && (bytes[i].value != UART_SOF))
+            continue;
+        if(m->rx_length == 2)
+            m->rx_size = (unsigned char)(UART_FRAME_OVERHEAD + bytes[i].value);
+        if((++m->rx_length >= UART_FRAME_OVERHEAD) && (m->rx_length == m->rx_size))
+        {
+            unsigned long second = (unsigned long)(SIM_MS(bytes[i].time) / 1000.0);
+
+            m->frames++;
+            m->rx_length = 0;
+            if(second < gFleet->end / SIM_CYCLES_MS(1000) + 1)
+                __atomic_fetch_add(&gFleet->second_frames[second], 1, __ATOMIC_RELAXED);
+        }
+    }
+    m->bytes += count;
+    if(count)
+        SIM_UART_LogClear();
+}
+
+/******************************************************************************
+* \Syntax          : static void FLEET_Customer( FLEET_machine_t *m )
+* \Description     : Customer side of a main loop pass: starts buying when
+                     the customer has arrived and the machine shows the menu,
+                     records the latency once the drink is out and the menu
+                     is back.
+*******************************************************************************/
+static void FLEET_Customer(FLEET_machine_t *m)
+{
+    unsigned long long now = SIM_Now();
+    const SIM_edge_t *edges;
+    unsigned int count = SIM_EdgeLog(&edges);
+
+    /* Dispenser LED (RA0) back low: drink out */
+    for(unsigned int i = 0; i < count; i++)
+    {
+        if((m->phase == FLEET_BUYING) && (edges[i].port == SIM_PORTA) && (edges[i].pin == 0) && !edges[i].level)
+            m->phase = FLEET_DISPENSED;
+    }
+    if(count)
+        SIM_EdgeLogClear();
+
+    if(now < m->arrival)
+        return;
+    if(((m->phase == FLEET_WAITING) || (m->phase == FLEET_DISPENSED)) && SIM_LCD_RowStartsWith(0, "Select Drink:"))
+    {
+        if(m->phase == FLEET_DISPENSED)
+        {
+            unsigned long long latency = now - m->arrival;
+
+            if(m->samples < FLEET_MAX_SAMPLES)
+                m->latency_ms[m->samples++] = (unsigned int)SIM_MS(latency);
+            m->service_cycles += now - m->start;
+            m->wait_cycles += m->start - m->arrival;
+            m->sales++;
+            m->phase = FLEET_WAITING;
+            m->arrival += FLEET_NextArrival(m);
+            if(now < m->arrival)
+                return;
+        }
+        m->start = now;
+        m->phase = FLEET_BUYING;
+        FLEET_Buy(m);
+    }
+    else if(now - m->arrival > SIM_CYCLES_MS(FLEET_TIMEOUT_MS))
+    {
+        m->failed++;
+        m->phase = FLEET_WAITING;
+        m->arrival += FLEET_NextArrival(m);
+    }
+}
+
+/******************************************************************************
+* \Syntax          : static void FLEET_Run( unsigned int number,
+                                            FLEET_machine_t *m,
+                                            unsigned char *ram,
+                                            void *cpu,
+                                            unsigned long long slice )
+* \Description     : Swaps a machine in, runs it for a time slice (cycles, up
+                     to the end) and swaps it out.
+*******************************************************************************/
+static void FLEET_Run(unsigned int number, FLEET_machine_t *m, unsigned char *ram, void *cpu,
+                      unsigned long long slice)
+{
+    unsigned long long until;
+
+    SIM_Select(cpu);
+    FLEET_RamLoad(ram);
+    if(!m->started)
+    {
+        m->seed = 2463534242UL ^ (number * 2654435761UL & 0xFFFFFFFFUL);
+        if(m->seed == 0)
+            m->seed = 1;
+        SIM_Reset();
+        SIM_LCD_Attach(SIM_PORTC, LCD_RS_PIN, LCD_EN_PIN, LCD_D4_PIN, LCD_D4_PIN + 1, LCD_D4_PIN + 2,
+                       LCD_D4_PIN + 3);
+        SIM_SetAnalog(ADC9, FLEET_LEVEL_IDLE);
+        VM_Init();
+        m->arrival = FLEET_NextArrival(m);
+        m->started = 1;
+    }
+    until = (slice < gFleet->end - SIM_Now()) ? SIM_Now() + slice : gFleet->end;
+    while(SIM_Now() < until)
+    {
+        VM_Running();
+        SIM_MainLoop();
+        FLEET_Customer(m);
+    }
+    FLEET_Collect(m);
+    m->lcd_violations = SIM_Stats()->lcd_violations;
+    m->done = (SIM_Now() >= gFleet->end);
+    FLEET_RamSave(ram);
+    SIM_Select(NULL);
+}
+
+/******************************************************************************
+* \Syntax          : static void FLEET_Lock( FLEET_queue_t *queue )
+* \Description     : Takes the lock of a work queue (spins between processes).
+*******************************************************************************/
+static void FLEET_Lock(FLEET_queue_t *queue)
+{
+    while(__atomic_test_and_set(&queue->lock, __ATOMIC_ACQUIRE))
+        sched_yield();
+}
+
+/******************************************************************************
+* \Syntax          : static void FLEET_Unlock( FLEET_queue_t *queue )
+* \Description     : Releases the lock of a work queue.
+*******************************************************************************/
+static void FLEET_Unlock(FLEET_queue_t *queue)
+{
+    __atomic_clear(&queue->lock, __ATOMIC_RELEASE);
+}
+
+/******************************************************************************
+* \Syntax          : static void FLEET_Push( unsigned int worker, unsigned int number )
+* \Description     : Queues a machine on a worker (tail).
+*******************************************************************************/
+static void FLEET_Push(unsigned int worker, unsigned int number)
+{
+    FLEET_queue_t *queue = &gFleet->queue[worker];
+
+    FLEET_Lock(queue);
+    gFleet->slots[worker * gFleet->machines + queue->tail % gFleet->machines] = number;
+    queue->tail++;
+    FLEET_Unlock(queue);
+}
+
+/******************************************************************************
+* \Syntax          : static int FLEET_Take( unsigned int worker, unsigned int victim )
+* \Description     : Takes a machine from a queue: the tail of its own, the
+                     head of another (steal). Returns -1 if it is empty.
+*******************************************************************************/
+static int FLEET_Take(unsigned int worker, unsigned int victim)
+{
+    FLEET_queue_t *queue = &gFleet->queue[victim];
+    int number = -1;
+
+    FLEET_Lock(queue);
+    if(queue->head != queue->tail)
+    {
+        if(victim == worker)
+            number = (int)gFleet->slots[victim * gFleet->machines + --queue->tail % gFleet->machines];
+        else
+            number = (int)gFleet->slots[victim * gFleet->machines + queue->head++ % gFleet->machines];
+    }
+    FLEET_Unlock(queue);
+    return number;
+}
+
+/******************************************************************************
+* \Syntax          : static void FLEET_Worker( unsigned int worker )
+* \Description     : Runs time slices of the machines of its queue, steals a
+                     machine when it is empty, until every machine is done.
+*******************************************************************************/
+static void FLEET_Worker(unsigned int worker)
+{
+    while(__atomic_load_n(&gFleet->remaining, __ATOMIC_ACQUIRE) != 0)
+    {
+        int number = FLEET_Take(worker, worker);
+        FLEET_machine_t *m;
+
+        for(unsigned int i = 1; (number < 0) && (i < gFleet->workers); i++)
+        {
+            number = FLEET_Take(worker, (worker + i) % gFleet->workers);
+            if(number >= 0)
+                gFleet->queue[worker].steals++;
+        }
+        if(number < 0)
+        {
+            sched_yield();              /* The last machines are running elsewhere */
+            continue;
+        }
+
+        m = &gFleet->machine[number];
+        FLEET_Run((unsigned int)number, m, gFleet->ram + (unsigned long)number * gFleet->ram_size,
+                  gFleet->cpu + (unsigned long)number * gFleet->cpu_size,
+                  SIM_CYCLES_MS(FLEET_SLICE_MS));
+        gFleet->queue[worker].slices++;
+        if(m->done)
+            __atomic_fetch_sub(&gFleet->remaining, 1, __ATOMIC_RELEASE);
+        else
+            FLEET_Push(worker, (unsigned int)number);
+    }
+}
+
+/******************************************************************************
+* \Syntax          : static int FLEET_Compare( const void *a, const void *b )
+* \Description     : qsort order of the latencies.
+*******************************************************************************/
+static int FLEET_Compare(const void *a, const void *b)
+{
+    unsigned int x = *(const unsigned int *)a, y = *(const unsigned int *)b;
+
+    return (x > y) - (x < y);
+}
+
+/******************************************************************************
+* \Syntax          : static double FLEET_Percentile( const unsigned int *sorted,
+                                                    unsigned long count,
+                                                    double p )
+* \Description     : Returns a percentile of sorted latencies in s (nearest
+                     rank, 0 if none).
+*******************************************************************************/
+static double FLEET_Percentile(const unsigned int *sorted, unsigned long count, double p)
+{
+    unsigned long rank;
+
+    if(count == 0)
+        return 0.0;
+    rank = (unsigned long)ceil(p / 100.0 * count);
+    return sorted[(rank > 0) ? rank - 1 : 0] / 1000.0;
+}
+
+
+/**********************************************************************************************************************
+ *  MAIN
+ *********************************************************************************************************************/
+
+int main(int argc, char **argv)
+{
+    unsigned int machines = FLEET_MACHINES, workers = (unsigned int)sysconf(_SC_NPROCESSORS_ONLN);
+    double duration_s = FLEET_DURATION_S, arrival_s = FLEET_ARRIVAL_S;
+    int verbose = 0, skewed = 0, opt;
+    unsigned long seconds, sales = 0, failed = 0, frames = 0, bytes = 0, steals = 0, slices = 0, samples = 0;
+    unsigned long long lcd_violations = 0, service = 0, waiting = 0;
+    unsigned int *all, *p50, *p99, peak = 0;
+    unsigned long busiest = 0;
+    unsigned char *shared;
+    unsigned long size;
+    struct timespec start, end;
+    double wall_s;
+    int ok;
+
+    /* Firmware RAM as after a reset, before any firmware code runs */
+    size = (unsigned long)((__stop_vm_ram - __start_vm_ram) + (__stop_vm_zram - __start_vm_zram));
+    gPowerOn = malloc(size);
+    FLEET_RamSave(gPowerOn);
+
+    while((opt = getopt(argc, argv, "n:d:a:w:sv")) != -1)
+    {
+        switch(opt)
+        {
+            case 'n':
+                machines = (unsigned int)strtoul(optarg, NULL, 10);
+                break;
+            case 'd':
+                duration_s = strtod(optarg, NULL);
+                break;
+            case 'a':
+                arrival_s = strtod(optarg, NULL);
+                break;
+            case 'w':
+                workers = (unsigned int)strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                skewed = 1;
+                break;
+            case 'v':
+                verbose = 1;
+                break;
+            default:
+                fprintf(stderr, "usage: fleet [-n machines] [-d duration s] [-a mean arrival s] [-w workers] [-s] "
+                        "[-v]\n");
+                return 2;
+        }
+    }
+    if((machines == 0) || (workers == 0) || (duration_s <= 0) || (arrival_s <= 0))
+    {
+        fprintf(stderr, "usage: fleet [-n machines] [-d duration s] [-a mean arrival s] [-w workers] [-s] [-v]\n");
+        return 2;
+    }
+    if(workers > machines)
+        workers = machines;
+    seconds = (unsigned long)duration_s + 1;
+
+    /* Shared memory: fleet, machines, firmware RAM and register files, queues, collector */
+    {
+        unsigned long cpu_size = (SIM_InstanceSize() + 63) & ~63UL;
+        unsigned long offsets[7], total = 0;
+        unsigned long sizes[7] =
+        {
+            sizeof(FLEET_t),
+            machines * sizeof(FLEET_machine_t),
+            machines * ((size + 63) & ~63UL),
+            machines * cpu_size,
+            workers * sizeof(FLEET_queue_t),
+            (unsigned long)workers * machines * sizeof(unsigned int),
+            seconds * sizeof(unsigned int)
+        };
+
+        for(unsigned int i = 0; i < 7; i++)
+        {
+            offsets[i] = total;
+            total += (sizes[i] + 63) & ~63UL;
+        }
+        shared = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if(shared == MAP_FAILED)
+        {
+            perror("fleet");
+            return 2;
+        }
+        gFleet = (FLEET_t *)shared;
+        gFleet->machine = (FLEET_machine_t *)(shared + offsets[1]);
+        gFleet->ram = shared + offsets[2];
+        gFleet->cpu = shared + offsets[3];
+        gFleet->queue = (FLEET_queue_t *)(shared + offsets[4]);
+        gFleet->slots = (unsigned int *)(shared + offsets[5]);
+        gFleet->second_frames = (unsigned int *)(shared + offsets[6]);
+        gFleet->ram_size = (size + 63) & ~63UL;
+        gFleet->cpu_size = cpu_size;
+    }
+    gFleet->machines = machines;
+    gFleet->workers = workers;
+    gFleet->end = SIM_CYCLES_MS(duration_s * 1000.0);
+    gFleet->arrival_s = arrival_s;
+    gFleet->remaining = machines;
+    for(unsigned int i = 0; i < machines; i++)
+    {
+        memcpy(gFleet->ram + (unsigned long)i * gFleet->ram_size, gPowerOn, size);
+        FLEET_Push(skewed ? 0 : i % workers, i);       /* Skewed: the other workers start empty */
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(unsigned int worker = 0; worker < workers; worker++)
+    {
+        pid_t child = fork();
+
+        if(child < 0)
+        {
+            perror("fleet");
+            return 2;
+        }
+        if(child == 0)
+        {
+            FLEET_Worker(worker);
+            _exit(0);
+        }
+    }
+    while(wait(NULL) > 0)
+        ;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    wall_s = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    /* Fleet latencies and the p50/p99 of every machine */
+    all = malloc((unsigned long)machines * FLEET_MAX_SAMPLES * sizeof(unsigned int));
+    p50 = malloc(machines * sizeof(unsigned int));
+    p99 = malloc(machines * sizeof(unsigned int));
+    for(unsigned int i = 0; i < machines; i++)
+    {
+        FLEET_machine_t *m = &gFleet->machine[i];
+
+        qsort(m->latency_ms, m->samples, sizeof(unsigned int), FLEET_Compare);
+        p50[i] = (unsigned int)(1000.0 * FLEET_Percentile(m->latency_ms, m->samples, 50));
+        p99[i] = (unsigned int)(1000.0 * FLEET_Percentile(m->latency_ms, m->samples, 99));
+        memcpy(all + samples, m->latency_ms, m->samples * sizeof(unsigned int));
+        samples += m->samples;
+        sales += m->sales;
+        failed += m->failed;
+        frames += m->frames;
+        bytes += m->bytes;
+        service += m->service_cycles;
+        waiting += m->wait_cycles;
+        lcd_violations += m->lcd_violations;
+        if(verbose)
+            printf("machine %5u   : %3u sales, %u failed, latency p50 %.1f s p90 %.1f s p99 %.1f s\n", i, m->sales,
+                   m->failed, FLEET_Percentile(m->latency_ms, m->samples, 50),
+                   FLEET_Percentile(m->latency_ms, m->samples, 90), p99[i] / 1000.0);
+    }
+    for(unsigned int worker = 0; worker < workers; worker++)
+    {
+        steals += gFleet->queue[worker].steals;
+        slices += gFleet->queue[worker].slices;
+    }
+    for(unsigned long s = 0; s < seconds; s++)
+    {
+        if(gFleet->second_frames[s] > peak)
+        {
+            peak = gFleet->second_frames[s];
+            busiest = s;
+        }
+    }
+    qsort(all, samples, sizeof(unsigned int), FLEET_Compare);
+    qsort(p50, machines, sizeof(unsigned int), FLEET_Compare);
+    qsort(p99, machines, sizeof(unsigned int), FLEET_Compare);
+
+    printf("fleet           : %u machines, %.0f s of virtual time each, a customer every %.0f s (mean)\n", machines,
+           duration_s, arrival_s);
+    printf("transactions    : %lu (%lu failed), %.2f per second for the fleet\n", sales, failed,
+           sales / duration_s);
+    printf("latency         : p50 %.1f s, p90 %.1f s, p99 %.1f s, max %.1f s (arrival to the menu back)\n",
+           FLEET_Percentile(all, samples, 50), FLEET_Percentile(all, samples, 90),
+           FLEET_Percentile(all, samples, 99), FLEET_Percentile(all, samples, 100));
+    printf("                  %.1f s waiting for the machine, %.1f s served (mean)\n",
+           sales ? SIM_MS(waiting) / 1000.0 / sales : 0.0, sales ? SIM_MS(service) / 1000.0 / sales : 0.0);
+    printf("per machine     : p50 %.1f / %.1f / %.1f s, p99 %.1f / %.1f / %.1f s (min / median / max)\n",
+           p50[0] / 1000.0, p50[machines / 2] / 1000.0, p50[machines - 1] / 1000.0,
+           p99[0] / 1000.0, p99[machines / 2] / 1000.0, p99[machines - 1] / 1000.0);
+    printf("collector       : %lu frames, %lu bytes, %.1f frames/s and %.0f bytes/s (mean), busiest second %lu: "
+           "%u frames\n", frames, bytes, frames / duration_s, bytes / duration_s, busiest, peak);
+    printf("wall time       : %.2f s, %.0f transactions/s, %.0fx real time for the fleet\n", wall_s,
+           sales / wall_s, machines * duration_s / wall_s);
+    printf("workers         : %u processes, %lu slices of %u ms, %lu machines stolen%s\n", workers, slices,
+           FLEET_SLICE_MS, steals, skewed ? " (all queued on worker 0)" : "");
+    printf("LCD busy errors : %llu\n", lcd_violations);
+
+    /* Every machine again, alone and one after the other: same customers, same results if the machines are
+       isolated and the workers do not matter */
+    {
+        FLEET_machine_t *alone = malloc(sizeof(FLEET_machine_t));
+        unsigned char *ram = malloc(size);
+        void *cpu = malloc(SIM_InstanceSize());
+        unsigned int different = 0;
+
+        for(unsigned int i = 0; i < machines; i++)
+        {
+            const FLEET_machine_t *m = &gFleet->machine[i];
+
+            memset(alone, 0, sizeof(FLEET_machine_t));
+            memset(cpu, 0, SIM_InstanceSize());
+            memcpy(ram, gPowerOn, size);
+            do
+            {
+                FLEET_Run(i, alone, ram, cpu, ~0ULL);
+            }while(!alone->done);
+            qsort(alone->latency_ms, alone->samples, sizeof(unsigned int), FLEET_Compare);
+            if((alone->sales != m->sales) || (alone->failed != m->failed) || (alone->frames != m->frames) ||
+               (alone->bytes != m->bytes) || (alone->samples != m->samples) ||
+               (memcmp(alone->latency_ms, m->latency_ms, m->samples * sizeof(unsigned int)) != 0))
+                different++;
+        }
+        if(different)
+            printf("single worker   : %u of %u machines run alone DIFFERENT\n", different, machines);
+        else
+            printf("single worker   : every machine run alone, same sales, frames and latencies\n");
+        ok = (different == 0) && (failed == 0) && (sales > 0) && (lcd_violations == 0);
+    }
+
+    /* Skewed queues: the workers that started empty must have stolen */
+    if(skewed && (workers > 1) && (steals == 0))
+    {
+        printf("work stealing   : NONE\n");
+        ok = 0;
+    }
+
+    printf("result          : %s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: fleet.c
+ *********************************************************************************************************************/
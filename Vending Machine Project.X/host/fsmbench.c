@@ -0,0 +1,237 @@
+/**********************************************************************************************************************
+ * Filename:    fsmbench.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Checks the vending machine transition table (every next state valid, every state handles at least
+ *              one event, the completion events only enter a state), walks a purchase through VM_Dispatch alone
+ *              (every state change comes from the table) and measures the host time of VM_Dispatch for every
+ *              state, ignored events and button actions, to show that the dispatch time does not depend on the state.
+ * NOTE:        VM.c is included here to reach its private dispatcher and tables, it is not linked a second time.
+ *              Host times are wall clock (ns) and only compare the states with each other.
+ *              Usage: fsmbench [dispatches]
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "SIM/SIM.h"
+#include "../source/VendingMachine/VM.c"
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Default number of dispatches per state */
+#define     FSMBENCH_DISPATCHES     2000000UL
+
+/* Runs of a mode before it must have completed (5 progress steps of the drink dispense) */
+#define     FSMBENCH_STAGES         10
+
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+/* Read through volatile so that the compiler cannot fold the table lookups */
+static volatile unsigned char gEvent;
+
+static const char *const gStateNames[VM_SM_STATES] =
+{
+    "initial", "drink selection", "coin insertion", "drink dispense",
+    "drink ready", "dispense change", "tilt sensing", "alarm"
+};
+
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : static int FSMBENCH_Check( unsigned int *used )
+* \Description     : Checks the transition table, returns the number of errors
+                     and counts the transitions.
+*******************************************************************************/
+static int FSMBENCH_Check(unsigned int *used)
+{
+    int errors = 0;
+
+    *used = 0;
+    for(unsigned int state = 0; state < VM_SM_STATES; state++)
+    {
+        unsigned int entries = 0;
+
+        for(unsigned int event = 0; event < VM_SM_EVENTS; event++)
+        {
+            const VM_transition_t *transition = &gTransitions[state][event];
+
+            if((transition->action == NULL) && (transition->next == VM_STATE_SAME))
+                continue;
+            entries++;
+            if((event >= VM_SM_DONE) && ((transition->action != NULL) || (transition->next == VM_STATE_SAME)))
+            {
+                printf("  %s, completion event %u: must enter a state without an action\n", gStateNames[state], event);
+                errors++;
+            }
+            if((transition->next != VM_STATE_SAME) &&
+               ((transition->next < VM_STATE_INITIAL) || (transition->next > VM_STATE_ALARM)))
+            {
+                printf("  %s, event %u: invalid next state %u\n", gStateNames[state], event, transition->next);
+                errors++;
+            }
+        }
+        if(entries == 0)
+        {
+            printf("  %s: no transition\n", gStateNames[state]);
+            errors++;
+        }
+        *used += entries;
+    }
+    return errors;
+}
+
+/******************************************************************************
+* \Syntax          : static int FSMBENCH_Step( unsigned char event,
+                                              unsigned char next )
+* \Description     : Dispatches the event in the current state until the
+                     state changes (FSMBENCH_STAGES times at most), returns 1
+                     if the state entered is not the next one.
+*******************************************************************************/
+static int FSMBENCH_Step(unsigned char event, unsigned char next)
+{
+    unsigned char state = gCurrentState;
+
+    for(unsigned char i = 0; (i < FSMBENCH_STAGES) && (gCurrentState == state); i++)
+        VM_Dispatch(&gCurrentState, event);
+    if(gCurrentState == next)
+        return 0;
+    printf("  %s, event %u: %s instead of %s\n", gStateNames[state - VM_STATE_INITIAL], event,
+           gStateNames[gCurrentState - VM_STATE_INITIAL], gStateNames[next - VM_STATE_INITIAL]);
+    return 1;
+}
+
+/******************************************************************************
+* \Syntax          : static int FSMBENCH_Purchase( void )
+* \Description     : Buys the selected drink with 50p coins through
+                     VM_Dispatch alone, returns the number of wrong states.
+*******************************************************************************/
+static int FSMBENCH_Purchase(void)
+{
+    int errors = 0;
+
+    errors += FSMBENCH_Step(VM_SM_SW1, VM_STATE_COIN_INSERTION);
+    while(gCurrentDrinkPrice > 0)
+        VM_Dispatch(&gCurrentState, VM_SM_SW2);
+    errors += FSMBENCH_Step(VM_SM_RUN, VM_STATE_DRINK_DISPENSE);
+    if(gCurrentDrinkPrice < 0)
+    {
+        errors += FSMBENCH_Step(VM_SM_RUN, VM_STATE_DISPENSE_CHANGE);
+        errors += FSMBENCH_Step(VM_SM_RUN, VM_STATE_DRINK_READY);
+    }
+    else
+        errors += FSMBENCH_Step(VM_SM_RUN, VM_STATE_DRINK_READY);
+    errors += FSMBENCH_Step(VM_SM_RUN, VM_STATE_INITIAL);
+    errors += FSMBENCH_Step(VM_SM_RUN, VM_STATE_DRINK_SELECTION);
+    return errors;
+}
+
+/******************************************************************************
+* \Syntax          : static double FSMBENCH_Time( state, event, dispatches )
+* \Description     : Host time of one VM_Dispatch (ns), the state is restored
+                     before every dispatch.
+*******************************************************************************/
+static double FSMBENCH_Time(unsigned char state, unsigned char event, unsigned long dispatches)
+{
+    struct timespec start, end;
+    unsigned char current;
+
+    gEvent = event;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(unsigned long i = 0; i < dispatches; i++)
+    {
+        current = state;
+        VM_Dispatch(&current, gEvent);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / dispatches;
+}
+
+
+/**********************************************************************************************************************
+ *  MAIN
+ *********************************************************************************************************************/
+
+int main(int argc, char **argv)
+{
+    unsigned long dispatches = (argc > 1) ? strtoul(argv[1], NULL, 10) : FSMBENCH_DISPATCHES;
+    double ignored_min = 1e9, ignored_max = 0;
+    unsigned int used;
+    int errors;
+
+    if(dispatches == 0)
+        dispatches = 1;
+
+    SIM_Reset();
+    SIM_LCD_Attach(SIM_PORTC, 0, 3, 4, 5, 6, 7);
+    VM_Init();
+
+    errors = FSMBENCH_Check(&used);
+    printf("transition table     : %u states x %u events, %u transitions\n", VM_SM_STATES, VM_SM_EVENTS, used);
+    if(gCurrentState != VM_STATE_DRINK_SELECTION)
+        errors++;
+    else
+    {
+        int wrong = FSMBENCH_Purchase();
+
+        printf("purchase walk        : %s\n", (wrong == 0) ? "every state entered from the table" : "wrong states");
+        errors += wrong;
+    }
+
+    printf("%-22s %14s %14s\n", "dispatch (ns)", "ignored event", "button action");
+    for(unsigned char state = 0; state < VM_SM_STATES; state++)
+    {
+        double ignored = -1, action = -1;
+
+        /* First ignored event and first button with an action (the modes are not run here) */
+        for(unsigned char event = VM_SM_SW0; event < VM_SM_EVENTS; event++)
+        {
+            const VM_transition_t *transition = &gTransitions[state][event];
+
+            if((ignored < 0) && (transition->action == NULL) && (transition->next == VM_STATE_SAME))
+                ignored = FSMBENCH_Time(VM_STATE_INITIAL + state, event, dispatches);
+            else if((action < 0) && (event <= VM_SM_SW2) && (transition->action != NULL))
+                action = FSMBENCH_Time(VM_STATE_INITIAL + state, event, dispatches);
+        }
+        if(ignored >= 0)
+        {
+            if(ignored < ignored_min)
+                ignored_min = ignored;
+            if(ignored > ignored_max)
+                ignored_max = ignored;
+        }
+        printf("  %-20s ", gStateNames[state]);
+        if(ignored >= 0)
+            printf("%14.2f ", ignored);
+        else
+            printf("%14s ", "-");
+        if(action >= 0)
+            printf("%14.2f\n", action);
+        else
+            printf("%14s\n", "-");
+    }
+    printf("ignored event spread : %.2f ns (max - min over the states)\n", ignored_max - ignored_min);
+    printf("result               : %s\n", (errors == 0) ? "ok" : "FAILED");
+    return (errors == 0) ? 0 : 1;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: fsmbench.c
+ *********************************************************************************************************************/
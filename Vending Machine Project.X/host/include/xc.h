@@ -0,0 +1,441 @@
+/**********************************************************************************************************************
+ * Filename:    xc.h
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Host replacement for the XC8 <xc.h> device header (PIC16F882).
+ *              Every SFR used by the firmware is mapped onto a simulated register file, and every access goes
+ *              through SIM_Access() so the simulator can advance virtual time, run the peripheral models and
+ *              dispatch myISR() exactly like the hardware would between two instructions.
+ * NOTE:        Only used by the host build (see host/Makefile), the firmware build still uses the real <xc.h>.
+ *
+ *********************************************************************************************************************/
+
+#ifndef XC_H
+#define XC_H
+
+/**********************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *********************************************************************************************************************/
+
+/* Simulated register file (one instance per simulated microcontroller) */
+typedef struct
+{
+    unsigned char porta;
+    unsigned char portb;
+    unsigned char portc;
+    unsigned char trisa;
+    unsigned char trisb;
+    unsigned char trisc;
+    unsigned char ansel;
+    unsigned char anselh;
+    unsigned char iocb;
+    unsigned char wpub;
+    unsigned char intcon;
+    unsigned char pir1;
+    unsigned char pir2;
+    unsigned char pie1;
+    unsigned char pie2;
+    unsigned char option_reg;
+    unsigned char tmr0;
+    unsigned short tmr1;            /* TMR1H:TMR1L (little-endian host) */
+    unsigned char t1con;
+    unsigned char tmr2;
+    unsigned char pr2;
+    unsigned char t2con;
+    unsigned char adcon0;
+    unsigned char adcon1;
+    unsigned char adresh;
+    unsigned char adresl;
+    unsigned char eedat;
+    unsigned char eeadr;
+    unsigned char eecon1;
+    unsigned char eecon2;           /* Not a physical register (unlock sequence) */
+    unsigned char wdtcon;
+    unsigned char status;           /* nTO and nPD only */
+    unsigned char osccon;
+    unsigned char txsta;
+    unsigned char rcsta;
+    unsigned char spbrg;
+    unsigned char spbrgh;
+    unsigned char baudctl;
+    unsigned char txreg;            /* Last byte written (TXREG is write-only) */
+}SIM_regfile_t;
+
+/* Register bit-field views (same layout as the XC8 device header) */
+typedef struct
+{
+    unsigned RA0 :1;
+    unsigned RA1 :1;
+    unsigned RA2 :1;
+    unsigned RA3 :1;
+    unsigned RA4 :1;
+    unsigned RA5 :1;
+    unsigned RA6 :1;
+    unsigned RA7 :1;
+}PORTAbits_t;
+
+typedef struct
+{
+    unsigned RB0 :1;
+    unsigned RB1 :1;
+    unsigned RB2 :1;
+    unsigned RB3 :1;
+    unsigned RB4 :1;
+    unsigned RB5 :1;
+    unsigned RB6 :1;
+    unsigned RB7 :1;
+}PORTBbits_t;
+
+typedef struct
+{
+    unsigned RC0 :1;
+    unsigned RC1 :1;
+    unsigned RC2 :1;
+    unsigned RC3 :1;
+    unsigned RC4 :1;
+    unsigned RC5 :1;
+    unsigned RC6 :1;
+    unsigned RC7 :1;
+}PORTCbits_t;
+
+typedef struct
+{
+    unsigned RBIF   :1;
+    unsigned INTF   :1;
+    unsigned TMR0IF :1;
+    unsigned RBIE   :1;
+    unsigned INTE   :1;
+    unsigned TMR0IE :1;
+    unsigned PEIE   :1;
+    unsigned GIE    :1;
+}INTCONbits_t;
+
+typedef struct
+{
+    unsigned TMR1IF :1;
+    unsigned TMR2IF :1;
+    unsigned CCP1IF :1;
+    unsigned SSPIF  :1;
+    unsigned TXIF   :1;
+    unsigned RCIF   :1;
+    unsigned ADIF   :1;
+    unsigned        :1;
+}PIR1bits_t;
+
+typedef struct
+{
+    unsigned TMR1IE :1;
+    unsigned TMR2IE :1;
+    unsigned CCP1IE :1;
+    unsigned SSPIE  :1;
+    unsigned TXIE   :1;
+    unsigned RCIE   :1;
+    unsigned ADIE   :1;
+    unsigned        :1;
+}PIE1bits_t;
+
+typedef struct
+{
+    unsigned CCP2IF  :1;
+    unsigned         :1;
+    unsigned ULPWUIF :1;
+    unsigned BCLIF   :1;
+    unsigned EEIF    :1;
+    unsigned C1IF    :1;
+    unsigned C2IF    :1;
+    unsigned OSFIF   :1;
+}PIR2bits_t;
+
+typedef struct
+{
+    unsigned CCP2IE  :1;
+    unsigned         :1;
+    unsigned ULPWUIE :1;
+    unsigned BCLIE   :1;
+    unsigned EEIE    :1;
+    unsigned C1IE    :1;
+    unsigned C2IE    :1;
+    unsigned OSFIE   :1;
+}PIE2bits_t;
+
+typedef struct
+{
+    unsigned PS     :3;
+    unsigned PSA    :1;
+    unsigned T0SE   :1;
+    unsigned T0CS   :1;
+    unsigned INTEDG :1;
+    unsigned nRBPU  :1;
+}OPTION_REGbits_t;
+
+typedef struct
+{
+    unsigned TMR1ON  :1;
+    unsigned TMR1CS  :1;
+    unsigned nT1SYNC :1;
+    unsigned T1OSCEN :1;
+    unsigned T1CKPS  :2;
+    unsigned TMR1GE  :1;
+    unsigned T1GINV  :1;
+}T1CONbits_t;
+
+typedef struct
+{
+    unsigned T2CKPS :2;
+    unsigned TMR2ON :1;
+    unsigned TOUTPS :4;
+    unsigned        :1;
+}T2CONbits_t;
+
+typedef struct
+{
+    unsigned ADON :1;
+    unsigned GO   :1;
+    unsigned CHS  :4;
+    unsigned ADCS :2;
+}ADCON0bits_t;
+
+typedef struct
+{
+    unsigned RD    :1;
+    unsigned WR    :1;
+    unsigned WREN  :1;
+    unsigned WRERR :1;
+    unsigned       :3;
+    unsigned EEPGD :1;
+}EECON1bits_t;
+
+typedef struct
+{
+    unsigned C      :1;
+    unsigned DC     :1;
+    unsigned Z      :1;
+    unsigned nPD    :1;
+    unsigned nTO    :1;
+    unsigned RP     :2;
+    unsigned IRP    :1;
+}STATUSbits_t;
+
+typedef struct
+{
+    unsigned SWDTEN :1;
+    unsigned WDTPS  :4;
+    unsigned        :3;
+}WDTCONbits_t;
+
+typedef struct
+{
+    unsigned SCS    :1;
+    unsigned LTS    :1;
+    unsigned HTS    :1;
+    unsigned OSTS   :1;
+    unsigned IRCF   :3;
+    unsigned        :1;
+}OSCCONbits_t;
+
+typedef struct
+{
+    unsigned TX9D   :1;
+    unsigned TRMT   :1;
+    unsigned BRGH   :1;
+    unsigned SENDB  :1;
+    unsigned SYNC   :1;
+    unsigned TXEN   :1;
+    unsigned TX9    :1;
+    unsigned CSRC   :1;
+}TXSTAbits_t;
+
+typedef struct
+{
+    unsigned RX9D   :1;
+    unsigned OERR   :1;
+    unsigned FERR   :1;
+    unsigned ADDEN  :1;
+    unsigned CREN   :1;
+    unsigned SREN   :1;
+    unsigned RX9    :1;
+    unsigned SPEN   :1;
+}RCSTAbits_t;
+
+typedef struct
+{
+    unsigned ABDEN  :1;
+    unsigned WUE    :1;
+    unsigned        :1;
+    unsigned BRG16  :1;
+    unsigned SCKP   :1;
+    unsigned        :1;
+    unsigned RCIDL  :1;
+    unsigned ABDOVF :1;
+}BAUDCTLbits_t;
+
+
+/**********************************************************************************************************************
+ *  GLOBAL DATA
+ *********************************************************************************************************************/
+
+extern SIM_regfile_t *SIM_regs;     /* Register file of the currently running instance */
+
+
+/**********************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : volatile void *SIM_Access( volatile void *reg )
+* \Description     : Synchronizes the simulator before an SFR access (virtual
+                     time, peripherals, interrupts) and returns the register.
+*******************************************************************************/
+volatile void *SIM_Access(volatile void *reg);
+
+/******************************************************************************
+* \Syntax          : volatile void *SIM_AccessIndirect( volatile void *reg )
+* \Description     : Same as SIM_Access() for an SFR accessed through a
+                     pointer (FSR/INDF, charged SIM_INDIRECT_CYCLES).
+*******************************************************************************/
+volatile void *SIM_AccessIndirect(volatile void *reg);
+
+/******************************************************************************
+* \Syntax          : volatile void *SIM_AccessTxreg( void )
+* \Description     : Same as SIM_Access() for TXREG, the byte written is
+                     loaded into the EUSART transmitter at the next access.
+*******************************************************************************/
+volatile void *SIM_AccessTxreg(void);
+
+/******************************************************************************
+* \Syntax          : void _delay( unsigned long cycles )
+* \Description     : Virtual busy-wait of a number of instruction cycles.
+*******************************************************************************/
+void _delay(unsigned long cycles);
+
+/******************************************************************************
+* \Syntax          : void SIM_Sleep( void )
+* \Description     : SLEEP instruction: the virtual time runs until a wake-up
+                     (interrupt-on-change, watchdog, enabled interrupt flag)
+                     with the oscillator and its timers stopped.
+*******************************************************************************/
+void SIM_Sleep(void);
+
+/******************************************************************************
+* \Syntax          : void SIM_Clrwdt( void )
+* \Description     : CLRWDT instruction: clears the watchdog, sets nTO and nPD.
+*******************************************************************************/
+void SIM_Clrwdt(void);
+
+/******************************************************************************
+* \Syntax          : void SIM_EepromData( a, b, c, d, e, f, g, h )
+* \Description     : Appends 8 bytes to the data EEPROM image programmed by
+                     SIM_Reset() (see __EEPROM_DATA).
+*******************************************************************************/
+void SIM_EepromData(unsigned char a, unsigned char b, unsigned char c, unsigned char d,
+                    unsigned char e, unsigned char f, unsigned char g, unsigned char h);
+
+
+/**********************************************************************************************************************
+ *  SFR MACROS
+ *********************************************************************************************************************/
+
+/* SIM_DIRECT_SFR = 1: the SFRs are plain memory, without the simulator (instruction counts of the driver code alone) */
+#if defined(SIM_DIRECT_SFR) && (SIM_DIRECT_SFR == 1)
+#define     _SIM_SFR(r, type)       (*(volatile type *)&SIM_regs->r)
+#else
+#define     _SIM_SFR(r, type)       (*(volatile type *)SIM_Access(&SIM_regs->r))
+#endif
+
+/* SFR accessed through a pointer (e.g. the port of the LCD struct), used by the firmware when defined */
+#define     SIM_SFR_PTR(p)          (*(volatile unsigned char *)SIM_AccessIndirect(p))
+
+#define     PORTA           _SIM_SFR(porta, unsigned char)
+#define     PORTB           _SIM_SFR(portb, unsigned char)
+#define     PORTC           _SIM_SFR(portc, unsigned char)
+#define     TRISA           _SIM_SFR(trisa, unsigned char)
+#define     TRISB           _SIM_SFR(trisb, unsigned char)
+#define     TRISC           _SIM_SFR(trisc, unsigned char)
+#define     ANSEL           _SIM_SFR(ansel, unsigned char)
+#define     ANSELH          _SIM_SFR(anselh, unsigned char)
+#define     IOCB            _SIM_SFR(iocb, unsigned char)
+#define     WPUB            _SIM_SFR(wpub, unsigned char)
+#define     INTCON          _SIM_SFR(intcon, unsigned char)
+#define     PIR1            _SIM_SFR(pir1, unsigned char)
+#define     PIR2            _SIM_SFR(pir2, unsigned char)
+#define     PIE1            _SIM_SFR(pie1, unsigned char)
+#define     PIE2            _SIM_SFR(pie2, unsigned char)
+#define     OPTION_REG      _SIM_SFR(option_reg, unsigned char)
+#define     TMR0            _SIM_SFR(tmr0, unsigned char)
+#define     TMR1            _SIM_SFR(tmr1, unsigned short)
+#define     TMR1L           (((volatile unsigned char *)SIM_Access(&SIM_regs->tmr1))[0])
+#define     TMR1H           (((volatile unsigned char *)SIM_Access(&SIM_regs->tmr1))[1])
+#define     T1CON           _SIM_SFR(t1con, unsigned char)
+#define     TMR2            _SIM_SFR(tmr2, unsigned char)
+#define     PR2             _SIM_SFR(pr2, unsigned char)
+#define     T2CON           _SIM_SFR(t2con, unsigned char)
+#define     ADCON0          _SIM_SFR(adcon0, unsigned char)
+#define     ADCON1          _SIM_SFR(adcon1, unsigned char)
+#define     ADRESH          _SIM_SFR(adresh, unsigned char)
+#define     ADRESL          _SIM_SFR(adresl, unsigned char)
+#define     EEDAT           _SIM_SFR(eedat, unsigned char)
+#define     EEADR           _SIM_SFR(eeadr, unsigned char)
+#define     EECON1          _SIM_SFR(eecon1, unsigned char)
+#define     EECON2          _SIM_SFR(eecon2, unsigned char)
+#define     WDTCON          _SIM_SFR(wdtcon, unsigned char)
+#define     STATUS          _SIM_SFR(status, unsigned char)
+#define     OSCCON          _SIM_SFR(osccon, unsigned char)
+#define     TXSTA           _SIM_SFR(txsta, unsigned char)
+#define     RCSTA           _SIM_SFR(rcsta, unsigned char)
+#define     SPBRG           _SIM_SFR(spbrg, unsigned char)
+#define     SPBRGH          _SIM_SFR(spbrgh, unsigned char)
+#define     BAUDCTL         _SIM_SFR(baudctl, unsigned char)
+#define     TXREG           (*(volatile unsigned char *)SIM_AccessTxreg())
+
+#define     PORTAbits       _SIM_SFR(porta, PORTAbits_t)
+#define     PORTBbits       _SIM_SFR(portb, PORTBbits_t)
+#define     PORTCbits       _SIM_SFR(portc, PORTCbits_t)
+#define     INTCONbits      _SIM_SFR(intcon, INTCONbits_t)
+#define     PIR1bits        _SIM_SFR(pir1, PIR1bits_t)
+#define     PIE1bits        _SIM_SFR(pie1, PIE1bits_t)
+#define     PIR2bits        _SIM_SFR(pir2, PIR2bits_t)
+#define     PIE2bits        _SIM_SFR(pie2, PIE2bits_t)
+#define     OPTION_REGbits  _SIM_SFR(option_reg, OPTION_REGbits_t)
+#define     T1CONbits       _SIM_SFR(t1con, T1CONbits_t)
+#define     T2CONbits       _SIM_SFR(t2con, T2CONbits_t)
+#define     ADCON0bits      _SIM_SFR(adcon0, ADCON0bits_t)
+#define     EECON1bits      _SIM_SFR(eecon1, EECON1bits_t)
+#define     WDTCONbits      _SIM_SFR(wdtcon, WDTCONbits_t)
+#define     STATUSbits      _SIM_SFR(status, STATUSbits_t)
+#define     OSCCONbits      _SIM_SFR(osccon, OSCCONbits_t)
+#define     TXSTAbits       _SIM_SFR(txsta, TXSTAbits_t)
+#define     RCSTAbits       _SIM_SFR(rcsta, RCSTAbits_t)
+#define     BAUDCTLbits     _SIM_SFR(baudctl, BAUDCTLbits_t)
+
+
+/**********************************************************************************************************************
+ *  COMPILER BUILT-INS
+ *********************************************************************************************************************/
+
+/* The simulator calls myISR() itself, the qualifier has no meaning on the host */
+#define     __interrupt(...)
+
+/* Same definitions as the XC8 headers: _XTAL_FREQ must be defined by the including file */
+#define     __delay_us(x)       _delay((unsigned long)((x)*(_XTAL_FREQ/4000000.0)))
+#define     __delay_ms(x)       _delay((unsigned long)((x)*(_XTAL_FREQ/4000.0)))
+
+/* Initial data EEPROM content, 8 bytes per use from address 0 (in the order of the constructors = source order) */
+#define     _SIM_EEPROM_NAME(line)          _SIM_EEPROM_NAME2(line)
+#define     _SIM_EEPROM_NAME2(line)         SIM_EepromData_ ## line
+#define     __EEPROM_DATA(a, b, c, d, e, f, g, h)                                                   \
+    __attribute__((constructor(1000 + __LINE__))) static void _SIM_EEPROM_NAME(__LINE__)(void)      \
+    { SIM_EepromData(a, b, c, d, e, f, g, h); }                                                     \
+    extern void SIM_EepromData(unsigned char, unsigned char, unsigned char, unsigned char,          \
+                               unsigned char, unsigned char, unsigned char, unsigned char)
+
+#if defined(SIM_DIRECT_SFR) && (SIM_DIRECT_SFR == 1)
+#define     NOP()               __asm__ __volatile__("nop")     /* One instruction, as on the PIC */
+#else
+#define     NOP()               _delay(1)
+#endif
+#define     CLRWDT()            SIM_Clrwdt()
+#define     SLEEP()             SIM_Sleep()
+
+#endif /* XC_H */
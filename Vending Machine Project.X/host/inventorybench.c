@@ -0,0 +1,263 @@
+/**********************************************************************************************************************
+ * Filename:    inventorybench.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Runs the firmware with the sales and inventory counters (VM_USE_INVENTORY = 1): two Lemonades are
+ *              stocked, three back-to-back customers buy them and a Cola, the drink selection skips the sold out
+ *              Lemonade, the three sales are flushed together once the machine is idle (EEIF writer, no main loop pass
+ *              waits for a write) and they survive a power cycle. Every product sold out shows "Sold Out".
+ * NOTE:        SIM_PowerCycle() keeps the data EEPROM, the sales not flushed are lost like on a real reset.
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+
+#include "SIM/SIM.h"
+#include "../source/ADC/ADC.h"
+#include "../source/Catalog/CATALOG.h"
+#include "../source/EEPROM/EEPROM.h"
+#include "../source/Inventory/INVENTORY.h"
+#include "../source/VendingMachine/VM.h"
+
+#if (VM_USE_INVENTORY != 1) || (VM_USE_SCHEDULER != 1)
+#error "inventorybench: build with VM_USE_INVENTORY = 1 and VM_USE_SCHEDULER = 1"
+#endif
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Push buttons on PORTB */
+#define     INVENTORYBENCH_SW0      0
+#define     INVENTORYBENCH_SW1      1
+#define     INVENTORYBENCH_SW2      2
+
+/* Tilt sensor level (10-bit, below the alarm threshold) */
+#define     INVENTORYBENCH_LEVEL    0x100
+
+/* Catalog products (programmed image) */
+#define     INVENTORYBENCH_COLA     0
+#define     INVENTORYBENCH_LEMONADE 1
+
+/* Lemonades stocked */
+#define     INVENTORYBENCH_STOCK    2
+
+/* Scenario (virtual ms): a customer every 20s (served in 17s), the last one checked before, end */
+#define     INVENTORYBENCH_PERIOD_MS    20000
+#define     INVENTORYBENCH_CUSTOMERS    3
+#define     INVENTORYBENCH_END_MS       75000
+
+/* Hold time of a press (ms) */
+#define     INVENTORYBENCH_HOLD_MS  120
+
+/* Longest wait for the queued records (ms) */
+#define     INVENTORYBENCH_TIMEOUT_MS   1000
+
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+static unsigned long long gLongestPass = 0;         /* Longest VM_Running() call, sleep excluded (cycles) */
+
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : static void INVENTORYBENCH_Customer( unsigned long long start,
+                                                         unsigned char next )
+* \Description     : Schedules a customer: next SW0 presses, SW1, then two
+                     50p coins (every drink costs up to 80p).
+*******************************************************************************/
+static void INVENTORYBENCH_Customer(unsigned long long start, unsigned char next)
+{
+    unsigned long long time = start;
+
+    for(unsigned char i = 0; i < next; i++)
+        SIM_PressButton(time += SIM_CYCLES_MS(500), INVENTORYBENCH_SW0, INVENTORYBENCH_HOLD_MS);
+    SIM_PressButton(time += SIM_CYCLES_MS(500), INVENTORYBENCH_SW1, INVENTORYBENCH_HOLD_MS);
+    SIM_PressButton(time += SIM_CYCLES_MS(500), INVENTORYBENCH_SW2, INVENTORYBENCH_HOLD_MS);
+    SIM_PressButton(time += SIM_CYCLES_MS(500), INVENTORYBENCH_SW2, INVENTORYBENCH_HOLD_MS);
+}
+
+/******************************************************************************
+* \Syntax          : static int INVENTORYBENCH_Drain( void )
+* \Description     : Runs the main loop until the queued records are written,
+                     returns 0 on time-out.
+*******************************************************************************/
+static int INVENTORYBENCH_Drain(void)
+{
+    unsigned long long timeout = SIM_Now() + SIM_CYCLES_MS(INVENTORYBENCH_TIMEOUT_MS);
+
+    while(INVENTORY_Busy() && (SIM_Now() < timeout))
+        SIM_RunUntil(SIM_Now() + 1, &gLongestPass);
+    return !INVENTORY_Busy();
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned long INVENTORYBENCH_Writes( void )
+* \Description     : Returns the writes of the counter bytes of the EEPROM.
+*******************************************************************************/
+static unsigned long INVENTORYBENCH_Writes(void)
+{
+    unsigned long writes = 0;
+
+    for(unsigned char address = INVENTORY_EEPROM_BASE; address < INVENTORY_EEPROM_BASE + INVENTORY_EEPROM_SIZE;
+        address++)
+        writes += SIM_EepromWear(address);
+    return writes;
+}
+
+/******************************************************************************
+* \Syntax          : static int INVENTORYBENCH_Check( const char *title )
+* \Description     : Prints the counters of every product, returns the number
+                     of mismatches with 2 Lemonades and 1 Cola sold, the
+                     Lemonades sold out and the other products not counted.
+*******************************************************************************/
+static int INVENTORYBENCH_Check(const char *title)
+{
+    int errors = 0;
+
+    printf("%s:\n", title);
+    for(unsigned char index = 0; index < CATALOG_Count(); index++)
+    {
+        unsigned int sales = INVENTORY_Sales(index);
+        unsigned char stock = INVENTORY_Stock(index);
+        unsigned int expected = (index == INVENTORYBENCH_LEMONADE) ? INVENTORYBENCH_STOCK :
+                                (index == INVENTORYBENCH_COLA) ? 1 : 0;
+
+        if(stock == INVENTORY_UNTRACKED)
+            printf("  product %u           : %u sales, stock not counted\n", index, sales);
+        else
+            printf("  product %u           : %u sales, %u left%s\n", index, sales, stock,
+                   INVENTORY_Available(index) ? "" : " (sold out)");
+        if((sales != expected) ||
+           (stock != ((index == INVENTORYBENCH_LEMONADE) ? 0 : INVENTORY_UNTRACKED)) ||
+           (INVENTORY_Available(index) != (index != INVENTORYBENCH_LEMONADE)))
+            errors++;
+    }
+    return errors;
+}
+
+
+/**********************************************************************************************************************
+ *  MAIN
+ *********************************************************************************************************************/
+
+int main(void)
+{
+    const SIM_stats_t *stats = SIM_Stats();
+    unsigned long long reads, recovery;
+    unsigned long writes;
+    int errors = 0;
+    int ok;
+
+    /* 1. Erased counters: nothing counted, the Lemonades are stocked */
+    SIM_Reset();
+    SIM_LCD_Attach(SIM_PORTC, 0, 3, 4, 5, 6, 7);
+    SIM_SetAnalog(ADC9, INVENTORYBENCH_LEVEL);
+    VM_Init();
+    for(unsigned char index = 0; index < CATALOG_Count(); index++)
+    {
+        if((INVENTORY_Sales(index) != 0) || (INVENTORY_Stock(index) != INVENTORY_UNTRACKED) ||
+           !INVENTORY_Available(index))
+            errors++;
+    }
+    INVENTORY_Restock(INVENTORYBENCH_LEMONADE, INVENTORYBENCH_STOCK);
+    if(!INVENTORYBENCH_Drain() || (EEPROM_Read(INVENTORY_EEPROM_BASE + INVENTORYBENCH_LEMONADE *
+                                               INVENTORY_RECORD_SIZE) != INVENTORYBENCH_STOCK))
+        errors++;                                                           /* Stock written */
+    writes = INVENTORYBENCH_Writes();
+    gLongestPass = 0;                   /* Main loop of the customers (the first drink name waited for the stock) */
+
+    /* 2. Two Lemonades (SW0 once from Cola) and a Cola (SW0 three times: Orange, Water, Cola) */
+    INVENTORYBENCH_Customer(0, 1);
+    INVENTORYBENCH_Customer(SIM_CYCLES_MS(INVENTORYBENCH_PERIOD_MS), 1);
+    INVENTORYBENCH_Customer(SIM_CYCLES_MS(2 * INVENTORYBENCH_PERIOD_MS), 3);
+    SIM_RunUntil(SIM_CYCLES_MS(2 * INVENTORYBENCH_PERIOD_MS), &gLongestPass);
+    printf("before the last customer: %u sales not flushed, %lu counter writes\n", INVENTORY_Dirty(),
+           INVENTORYBENCH_Writes() - writes);
+    if((INVENTORY_Dirty() != INVENTORYBENCH_STOCK) || (INVENTORYBENCH_Writes() != writes) ||
+       INVENTORY_Available(INVENTORYBENCH_LEMONADE) || !SIM_LCD_RowStartsWith(1, "Cola"))
+        errors++;
+
+    /* First SW0 of the last customer: Lemonade is skipped, no counter read */
+    reads = stats->eeprom_reads;
+    SIM_RunUntil(SIM_CYCLES_MS(2 * INVENTORYBENCH_PERIOD_MS + 1000), &gLongestPass);
+    reads = stats->eeprom_reads - reads;
+    printf("  SW0 from Cola       : \"%s\", %llu EEPROM reads (the name, %u bytes)\n", SIM_LCD_Row(1), reads,
+           CATALOG_NAME_LENGTH);
+    if(!SIM_LCD_RowStartsWith(1, "Orange") || (reads > CATALOG_NAME_LENGTH))
+        errors++;
+
+    SIM_RunUntil(SIM_CYCLES_MS(INVENTORYBENCH_END_MS), &gLongestPass);
+    errors += INVENTORYBENCH_Check("after the idle time-out");
+    writes = INVENTORYBENCH_Writes() - writes;
+    printf("  counter writes      : %lu for %u sales (%u bytes per sale written one by one)\n", writes,
+           INVENTORYBENCH_CUSTOMERS, INVENTORY_RECORD_SIZE);
+    printf("  longest main loop   : %.2f ms (a counter byte written in place would stall it %.1f ms)\n",
+           SIM_MS(gLongestPass), SIM_MS(SIM_EEPROM_WRITE_CYCLES));
+    if((INVENTORY_Dirty() != 0) || INVENTORY_Busy() || (writes > INVENTORYBENCH_CUSTOMERS) ||
+       (gLongestPass >= SIM_EEPROM_WRITE_CYCLES) || !SIM_LCD_RowStartsWith(0, "Select Drink:"))
+        errors++;
+
+    /* 3. Power cycle: the counters and the sold out Lemonade are recovered */
+    SIM_PowerCycle();
+    SIM_SetAnalog(ADC9, INVENTORYBENCH_LEVEL);
+    reads = stats->eeprom_reads;
+    recovery = SIM_Now();
+    INVENTORY_Init(CATALOG_Count());
+    recovery = SIM_Now() - recovery;
+    reads = stats->eeprom_reads - reads;
+    VM_Init();
+    errors += INVENTORYBENCH_Check("after a power cycle");
+    printf("  recovery            : %.3f ms, %llu EEPROM reads\n", SIM_MS(recovery), reads);
+    SIM_PressButton(SIM_Now() + SIM_CYCLES_MS(500), INVENTORYBENCH_SW0, INVENTORYBENCH_HOLD_MS);
+    SIM_RunUntil(SIM_Now() + SIM_CYCLES_MS(1000), &gLongestPass);
+    if((reads != CATALOG_Count()) || !SIM_LCD_RowStartsWith(1, "Orange"))
+        errors++;
+
+    /* A sale only updates RAM (the stock was read at boot) */
+    reads = stats->eeprom_reads;
+    INVENTORY_Sold(INVENTORYBENCH_COLA);
+    reads = stats->eeprom_reads - reads;
+    printf("  sale                : %llu EEPROM reads\n", reads);
+    if(reads != 0)
+        errors++;
+
+    /* 4. Every product sold out: nothing to select */
+    for(unsigned char index = 0; index < CATALOG_Count(); index++)
+        INVENTORY_Restock(index, 0);
+    if(!INVENTORYBENCH_Drain())                                             /* Last write complete */
+        errors++;
+    SIM_PowerCycle();
+    SIM_SetAnalog(ADC9, INVENTORYBENCH_LEVEL);
+    VM_Init();
+    SIM_PressButton(SIM_Now() + SIM_CYCLES_MS(500), INVENTORYBENCH_SW1, INVENTORYBENCH_HOLD_MS);
+    SIM_RunUntil(SIM_Now() + SIM_CYCLES_MS(1000), &gLongestPass);
+    printf("sold out: \"%s\"", SIM_LCD_Row(0));
+    printf(" / \"%s\" after SW1\n", SIM_LCD_Row(1));
+    if(!SIM_LCD_RowStartsWith(0, "Select Drink:") || !SIM_LCD_RowStartsWith(1, "Sold Out"))
+        errors++;
+
+    printf("RAM                 : %u bytes (%u products: sales not flushed and stock, writer state)\n",
+           2 * CATALOG_MAX_PRODUCTS + 6, CATALOG_MAX_PRODUCTS);
+    printf("EEPROM              : %u .. %u (%u bytes per product), catalog 0 .. %u\n", INVENTORY_EEPROM_BASE,
+           INVENTORY_EEPROM_BASE + INVENTORY_EEPROM_SIZE - 1, INVENTORY_RECORD_SIZE, CATALOG_EEPROM_SIZE - 1);
+    ok = (errors == 0) && (stats->lcd_violations == 0);
+    printf("result              : %s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: inventorybench.c
+ *********************************************************************************************************************/
@@ -0,0 +1,238 @@
+/**********************************************************************************************************************
+ * Filename:    journalbench.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Runs the firmware with the transaction journal (VM_USE_JOURNAL = 1) through one customer and a tilt
+ *              alarm, power cycles the simulated device and checks that the records are recovered, then fills the
+ *              ring several times (wear of every EEPROM cell) and cuts the power in the middle of a record.
+ * NOTE:        SIM_PowerCycle() keeps the data EEPROM and tears the byte being written, like a real power loss.
+ *              Usage: journalbench [laps]
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SIM/SIM.h"
+#include "../source/ADC/ADC.h"
+#include "../source/Catalog/CATALOG.h"
+#include "../source/Journal/JOURNAL.h"
+#include "../source/VendingMachine/VM.h"
+
+#if VM_USE_JOURNAL != 1
+#error "journalbench: build with VM_USE_JOURNAL = 1"
+#endif
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Default number of times the ring is filled for the wear check */
+#define     JOURNALBENCH_LAPS       5
+
+/* Push buttons on PORTB */
+#define     JOURNALBENCH_SW0        0
+#define     JOURNALBENCH_SW1        1
+#define     JOURNALBENCH_SW2        2
+
+/* Tilt sensor levels (10-bit, the alarm threshold is 2V = 0x199) */
+#define     JOURNALBENCH_LEVEL_IDLE 0x100
+#define     JOURNALBENCH_LEVEL_TILT 0x250
+
+/* Scenario (virtual ms): customer served by, tilt at, tilt released at, end */
+#define     JOURNALBENCH_TILT_MS    20000
+#define     JOURNALBENCH_RELEASE_MS 22000
+#define     JOURNALBENCH_END_MS     25000
+
+/* Give up waiting for a commit after (virtual ms) */
+#define     JOURNALBENCH_TIMEOUT_MS 2000
+
+/* Tag of the records appended by the wear test */
+#define     JOURNALBENCH_TAG        0x70
+
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+/* Records of the customer and the alarm, newest first: Lemonade (80p) paid 100p, 20p change, alarm on and off */
+static const JOURNAL_record_t gExpected[] =
+{
+    { 3, VM_JOURNAL_ALARM, 0 },
+    { 2, VM_JOURNAL_ALARM, 1 },
+    { 1, VM_JOURNAL_CHANGE, 2 },
+    { 0, VM_JOURNAL_SALE(1), 8 },
+};
+
+static unsigned long long gLongestPass = 0;         /* Longest VM_Running() call, sleep excluded (cycles) */
+
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : static int JOURNALBENCH_Flush( void )
+* \Description     : Commits the buffered records and runs the main loop until
+                     they are written, returns 0 on time-out.
+*******************************************************************************/
+static int JOURNALBENCH_Flush(void)
+{
+    unsigned long long timeout = SIM_Now() + SIM_CYCLES_MS(JOURNALBENCH_TIMEOUT_MS);
+
+    JOURNAL_Commit();
+    while(JOURNAL_Busy() && (SIM_Now() < timeout))
+        SIM_RunUntil(SIM_Now() + 1, &gLongestPass);
+    return !JOURNAL_Busy();
+}
+
+/******************************************************************************
+* \Syntax          : static int JOURNALBENCH_Check( const char *title )
+* \Description     : Compares the newest records with the customer and the
+                     alarm, returns the number of mismatches.
+*******************************************************************************/
+static int JOURNALBENCH_Check(const char *title)
+{
+    const unsigned char count = sizeof(gExpected) / sizeof(gExpected[0]);
+    JOURNAL_record_t record;
+    int errors = 0;
+
+    printf("%s: %u records\n", title, JOURNAL_Count());
+    if(JOURNAL_Count() != count)
+        errors++;
+    for(unsigned char age = 0; age < count; age++)
+    {
+        if(!JOURNAL_Get(age, &record))
+        {
+            printf("  age %u: missing\n", age);
+            errors++;
+            continue;
+        }
+        printf("  age %u: seq %3u, tag 0x%02X, value %u\n", age, record.seq, record.tag, record.value);
+        if((record.seq != gExpected[age].seq) || (record.tag != gExpected[age].tag) ||
+           (record.value != gExpected[age].value))
+            errors++;
+    }
+    return errors;
+}
+
+
+/**********************************************************************************************************************
+ *  MAIN
+ *********************************************************************************************************************/
+
+int main(int argc, char **argv)
+{
+    unsigned long laps = (argc > 1) ? strtoul(argv[1], NULL, 10) : JOURNALBENCH_LAPS;
+    const SIM_stats_t *stats = SIM_Stats();
+    unsigned long long writes, recovery;
+    unsigned long wear_min = ~0UL, wear_max = 0, catalog_wear = 0;
+    JOURNAL_record_t before, record;
+    int errors = 0;
+    int ok;
+
+    /* 1. Customer and alarm, committed while the machine waits for the next customer */
+    SIM_Reset();
+    SIM_LCD_Attach(SIM_PORTC, 0, 3, 4, 5, 6, 7);
+    SIM_SetAnalog(ADC9, JOURNALBENCH_LEVEL_IDLE);
+    VM_Init();
+    if(JOURNAL_Count() != 0)
+        errors++;
+    SIM_PressButton(SIM_CYCLES_MS(500), JOURNALBENCH_SW0, 120);
+    SIM_PressButton(SIM_CYCLES_MS(1000), JOURNALBENCH_SW1, 120);
+    SIM_PressButton(SIM_CYCLES_MS(1500), JOURNALBENCH_SW2, 120);
+    SIM_PressButton(SIM_CYCLES_MS(2000), JOURNALBENCH_SW2, 120);
+    SIM_RunUntil(SIM_CYCLES_MS(JOURNALBENCH_TILT_MS), &gLongestPass);
+    SIM_SetAnalog(ADC9, JOURNALBENCH_LEVEL_TILT);
+    SIM_RunUntil(SIM_CYCLES_MS(JOURNALBENCH_RELEASE_MS), &gLongestPass);
+    SIM_SetAnalog(ADC9, JOURNALBENCH_LEVEL_IDLE);
+    SIM_RunUntil(SIM_CYCLES_MS(JOURNALBENCH_END_MS), &gLongestPass);
+    errors += JOURNALBENCH_Check("after the customer");
+    writes = 0;
+    for(unsigned char address = JOURNAL_EEPROM_BASE; address < EEPROM_SIZE; address++)
+        writes += SIM_EepromWear(address);
+    printf("  EEPROM writes       : %llu (%u bytes per record), %u dropped\n", writes, JOURNAL_RECORD_SIZE,
+           JOURNAL_Dropped());
+    printf("  longest main loop   : %.2f ms (a record written in place would stall it %.1f ms)\n",
+           SIM_MS(gLongestPass), JOURNAL_RECORD_SIZE * SIM_MS(SIM_EEPROM_WRITE_CYCLES));
+    if((writes != JOURNAL_RECORD_SIZE * JOURNAL_Count()) || JOURNAL_Busy() ||
+       (gLongestPass >= SIM_EEPROM_WRITE_CYCLES) || !SIM_LCD_RowStartsWith(0, "Select Drink:"))
+        errors++;
+
+    /* 2. Power cycle: the journal continues after the newest record */
+    SIM_PowerCycle();
+    SIM_SetAnalog(ADC9, JOURNALBENCH_LEVEL_IDLE);
+    recovery = SIM_Now();
+    JOURNAL_Init();
+    recovery = SIM_Now() - recovery;
+    VM_Init();
+    errors += JOURNALBENCH_Check("after a power cycle");
+    printf("  recovery            : %.2f ms, %u EEPROM reads\n", SIM_MS(recovery),
+           JOURNAL_RECORDS * JOURNAL_RECORD_SIZE);
+
+    /* 3. Wear: the ring is filled laps times, every slot takes the same number of writes */
+    for(unsigned long i = 0; i < laps * JOURNAL_RECORDS; i++)
+    {
+        if(!JOURNAL_Append(JOURNALBENCH_TAG, (unsigned char)i) || !JOURNALBENCH_Flush())
+            errors++;
+    }
+    for(unsigned char address = 0; address < EEPROM_SIZE; address++)
+    {
+        unsigned long wear = SIM_EepromWear(address);
+
+        if(address < CATALOG_EEPROM_SIZE)
+            catalog_wear += wear;
+        else if(address >= JOURNAL_EEPROM_BASE)
+        {
+            if(wear < wear_min)
+                wear_min = wear;
+            if(wear > wear_max)
+                wear_max = wear;
+        }
+    }
+    printf("wear: %lu laps of %u records\n", laps, JOURNAL_RECORDS);
+    printf("  writes per cell     : %lu .. %lu (journal), %lu (catalog)\n", wear_min, wear_max, catalog_wear);
+    if((wear_max - wear_min > 1) || (catalog_wear != 0) || (JOURNAL_Count() != JOURNAL_RECORDS))
+        errors++;
+
+    /* 4. Power loss while the third byte of a record is written */
+    JOURNAL_Get(0, &before);
+    JOURNAL_Append(JOURNALBENCH_TAG, 0xAA);
+    JOURNAL_Commit();
+    writes = stats->eeprom_writes;
+    while(stats->eeprom_writes < writes + 2)
+        SIM_RunUntil(SIM_Now() + 1, &gLongestPass);
+    SIM_RunUntil(SIM_Now() + SIM_EEPROM_WRITE_CYCLES / 2, &gLongestPass);
+    SIM_PowerCycle();
+    SIM_SetAnalog(ADC9, JOURNALBENCH_LEVEL_IDLE);
+    VM_Init();
+    printf("torn record: %u records after the power cycle\n", JOURNAL_Count());
+    if((JOURNAL_Count() != JOURNAL_RECORDS - 1) || !JOURNAL_Get(0, &record) || (record.seq != before.seq) ||
+       (record.value != before.value))
+        errors++;
+    JOURNAL_Append(JOURNALBENCH_TAG, 0x55);
+    if(!JOURNALBENCH_Flush() || (JOURNAL_Count() != JOURNAL_RECORDS) || !JOURNAL_Get(0, &record) ||
+       (record.seq != (unsigned char)(before.seq + 1)) || (record.value != 0x55) || !JOURNAL_Get(1, &record) ||
+       (record.seq != before.seq))
+        errors++;
+    printf("  rewritten           : seq %u, value 0x%02X, %u records\n", (unsigned char)(before.seq + 1), 0x55,
+           JOURNAL_Count());
+
+    printf("RAM                 : %u bytes of buffer (%u records)\n", 2 * JOURNAL_BUFFER, JOURNAL_BUFFER);
+    printf("EEPROM              : %u .. %u (%u slots), catalog 0 .. %u\n", JOURNAL_EEPROM_BASE, EEPROM_SIZE - 1,
+           JOURNAL_RECORDS, CATALOG_EEPROM_SIZE - 1);
+    ok = (errors == 0) && (stats->lcd_violations == 0);
+    printf("result              : %s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: journalbench.c
+ *********************************************************************************************************************/
@@ -0,0 +1,437 @@
+/**********************************************************************************************************************
+ * Filename:    latbench.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: End-to-end transaction latency: scripted customer sessions run through the unmodified firmware
+ *              (drink selection, coin insertion, drink dispensing, change dispensing, drink ready) and every stage
+ *              is measured in virtual time: its duration, the response to the press that ends it, the LCD data
+ *              bytes and commands, the SFR accesses and writes, the busy-waiting (__delay and polling loops), the
+ *              idle main loop passes (nothing due, no SFR touched), the sleep and the ISR time. The same source is
+ *              built non-blocking (latbench, default options) and blocking (latbench_blocking, VM_USE_SCHEDULER = 0
+ *              and LCD_USE_QUEUE = 0).
+ * NOTE:        A stage starts when its first row (e.g. "Insert Coins:") is complete on the simulated LCD, so both
+ *              builds are measured at the same point whatever the LCD path. The SFR writes are the accesses that
+ *              changed the register (a write of the same value is not seen). Everything but the wall time is virtual
+ *              and deterministic, -j prints one JSON document to compare firmware versions and builds. A session
+ *              of the non-blocking build fails if it busy-waits more than LATBENCH_MAX_BUSY_PERCENT of its time.
+ *              Usage: latbench [-j]
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "SIM/SIM.h"
+#include "../source/VendingMachine/VM.h"
+#include "../source/ADC/ADC.h"
+#include "../source/LCD/LCD.h"
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Give up if a session takes longer than this (virtual ms) */
+#define     LATBENCH_TIMEOUT_MS     60000
+
+/* Customer script: first press after power-on, then one press every LATBENCH_PRESS_MS (held LATBENCH_HOLD_MS) */
+#define     LATBENCH_FIRST_MS       100
+#define     LATBENCH_PRESS_MS       200
+#define     LATBENCH_HOLD_MS        50
+#define     LATBENCH_MAX_PRESSES    8
+
+/* Push buttons on PORTB: drink selection (next, select) and coin insertion (10p, 20p, 50p) */
+#define     LATBENCH_NEXT           0
+#define     LATBENCH_SELECT         1
+#define     LATBENCH_10P            0
+#define     LATBENCH_20P            1
+#define     LATBENCH_50P            2
+
+/* Stages, in transaction order */
+#define     LATBENCH_SELECTION      0
+#define     LATBENCH_COINS          1
+#define     LATBENCH_DISPENSE       2
+#define     LATBENCH_CHANGE         3
+#define     LATBENCH_READY          4
+#define     LATBENCH_STAGES         5
+
+/* Non-blocking build: most busy-waiting allowed, in percent of the session (the waits are scheduler ticks) */
+#define     LATBENCH_MAX_BUSY_PERCENT   1
+
+/* No stage yet (power-on) */
+#define     LATBENCH_BOOT           (-1)
+
+
+/**********************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *********************************************************************************************************************/
+
+/* Scripted customer session */
+typedef struct
+{
+    const char *name;
+    unsigned char presses[LATBENCH_MAX_PRESSES];    /* Push buttons, in order             */
+    unsigned char count;                            /* Number of presses                  */
+    unsigned char selected;                         /* Index of the press that selects    */
+    unsigned char change;                           /* 1: change is due                   */
+}LATBENCH_session_t;
+
+/* Measures of one stage */
+typedef struct
+{
+    unsigned char seen;                 /* The stage was entered                              */
+    unsigned long long start;           /* Its first row complete on the LCD (cycles)         */
+    unsigned long long end;             /* The next stage's first row complete (cycles)       */
+    unsigned long long press;           /* Press that ends the stage (cycles), 0: none        */
+    SIM_stats_t entry;                  /* Simulator statistics at the start                  */
+    SIM_stats_t exit;                   /* Simulator statistics at the end                    */
+}LATBENCH_stage_t;
+
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+/* Lemonade 80p with 20p change, Cola 80p paid exactly with three coins, Water 50p, Orange 60p with 10p change */
+static const LATBENCH_session_t gSessions[] =
+{
+    { "lemonade-change", { LATBENCH_NEXT, LATBENCH_SELECT, LATBENCH_50P, LATBENCH_50P }, 4, 1, 1 },
+    { "cola-exact",      { LATBENCH_SELECT, LATBENCH_50P, LATBENCH_20P, LATBENCH_10P }, 4, 0, 0 },
+    { "water-exact",     { LATBENCH_NEXT, LATBENCH_NEXT, LATBENCH_NEXT, LATBENCH_SELECT, LATBENCH_50P }, 5, 3, 0 },
+    { "orange-change",   { LATBENCH_NEXT, LATBENCH_NEXT, LATBENCH_SELECT, LATBENCH_50P, LATBENCH_20P }, 5, 2, 1 },
+};
+
+#define     LATBENCH_SESSIONS       (sizeof(gSessions) / sizeof(gSessions[0]))
+
+/* First LCD row of every stage */
+static const char *const gHeadlines[LATBENCH_STAGES] =
+{
+    "Select Drink:", "Insert Coins:", "Drink Dispensing", "Change due:", "Please Collect"
+};
+
+/* Stage names (JSON keys) */
+static const char *const gNames[LATBENCH_STAGES] =
+{
+    "drink_selection", "coin_insertion", "dispense_drink", "dispense_change", "drink_ready"
+};
+
+static const SIM_stats_t gZero;             /* Counters of the totals start from 0          */
+static LATBENCH_stage_t gStages[LATBENCH_SESSIONS][LATBENCH_STAGES];
+static LATBENCH_stage_t *gCurrent;          /* Stages of the session running              */
+static int gStage;                          /* Stage running, LATBENCH_BOOT before the first */
+static unsigned char gDone;                 /* Back to drink selection after drink ready  */
+
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : static void LATBENCH_Changed( unsigned char row )
+* \Description     : LCD callback: the stage ends when the first row of a
+                     later stage is complete (dispense change is skipped when
+                     no change is due), drink ready ends on drink selection.
+*******************************************************************************/
+static void LATBENCH_Changed(unsigned char row)
+{
+    int next;
+
+    if((row != 0) || gDone)
+        return;
+
+    for(next = gStage + 1; next <= LATBENCH_STAGES; next++)
+    {
+        if(SIM_LCD_RowStartsWith(0, gHeadlines[next % LATBENCH_STAGES]))
+            break;
+    }
+    if((next > LATBENCH_STAGES) || ((next == LATBENCH_STAGES) && (gStage != LATBENCH_READY)))
+        return;
+
+    if(gStage != LATBENCH_BOOT)
+    {
+        gCurrent[gStage].end = SIM_Now();
+        gCurrent[gStage].exit = *SIM_Stats();
+    }
+    if(next == LATBENCH_STAGES)
+    {
+        gDone = 1;
+        return;
+    }
+    gStage = next;
+    gCurrent[gStage].seen = 1;
+    gCurrent[gStage].start = SIM_Now();
+    gCurrent[gStage].entry = *SIM_Stats();
+}
+
+/******************************************************************************
+* \Syntax          : static int LATBENCH_Session( unsigned int index )
+* \Description     : Runs one scripted session from power-on until the
+                     machine is back to drink selection. Returns 0 on
+                     success.
+*******************************************************************************/
+static int LATBENCH_Session(unsigned int index)
+{
+    const LATBENCH_session_t *session = &gSessions[index];
+    const SIM_edge_t *edges;
+    unsigned int edge_count;
+    unsigned char dispensed = 0;
+    unsigned long long time;
+
+    gCurrent = gStages[index];
+    gStage = LATBENCH_BOOT;
+    gDone = 0;
+
+    SIM_Reset();
+    SIM_LCD_Attach(SIM_PORTC, 0, 3, 4, 5, 6, 7);   /* Same wiring as VM_Init */
+    SIM_SetAnalog(ADC9, 0x100);                     /* Tilt sensor below 2V   */
+
+    for(unsigned char i = 0; i < session->count; i++)
+    {
+        time = SIM_CYCLES_MS(LATBENCH_FIRST_MS + i * LATBENCH_PRESS_MS);
+        SIM_PressButton(time, session->presses[i], LATBENCH_HOLD_MS);
+        if(i == session->selected)
+            gCurrent[LATBENCH_SELECTION].press = time;
+        if(i == session->count - 1)
+            gCurrent[LATBENCH_COINS].press = time;
+    }
+
+    VM_Init();
+    while(!gDone && (SIM_Now() < SIM_CYCLES_MS(LATBENCH_TIMEOUT_MS)))
+    {
+        VM_Running();
+        SIM_MainLoop();
+    }
+
+    edge_count = SIM_EdgeLog(&edges);
+    for(unsigned int i = 0; i < edge_count; i++)
+    {
+        if((edges[i].port == SIM_PORTA) && (edges[i].pin == 0) && !edges[i].level)
+            dispensed = 1;
+    }
+
+    for(int stage = 0; stage < LATBENCH_STAGES; stage++)
+    {
+        if(gCurrent[stage].seen != ((stage != LATBENCH_CHANGE) || session->change))
+            return 1;
+    }
+#if (VM_USE_SCHEDULER == 1) && (LCD_USE_QUEUE == 1)
+    if((SIM_Stats()->delay_cycles + SIM_Stats()->spin_cycles) * 100 > SIM_Now() * LATBENCH_MAX_BUSY_PERCENT)
+        return 1;
+#endif
+    return (gDone && dispensed && (SIM_Stats()->lcd_violations == 0)) ? 0 : 1;
+}
+
+/******************************************************************************
+* \Syntax          : static void LATBENCH_Add( SIM_stats_t *sum,
+                                              const SIM_stats_t *after,
+                                              const SIM_stats_t *before )
+* \Description     : Adds the counters measured (after - before) to sum.
+*******************************************************************************/
+static void LATBENCH_Add(SIM_stats_t *sum, const SIM_stats_t *after, const SIM_stats_t *before)
+{
+    sum->sfr_accesses += after->sfr_accesses - before->sfr_accesses;
+    sum->sfr_writes += after->sfr_writes - before->sfr_writes;
+    sum->delay_cycles += after->delay_cycles - before->delay_cycles;
+    sum->spin_cycles += after->spin_cycles - before->spin_cycles;
+    sum->idle_cycles += after->idle_cycles - before->idle_cycles;
+    sum->sleep_cycles += after->sleep_cycles - before->sleep_cycles;
+    sum->isr_cycles += after->isr_cycles - before->isr_cycles;
+    sum->lcd_commands += after->lcd_commands - before->lcd_commands;
+    sum->lcd_data += after->lcd_data - before->lcd_data;
+}
+
+/******************************************************************************
+* \Syntax          : static void LATBENCH_PrintRow( const char *name,
+                                                   unsigned long long cycles,
+                                                   double response_ms,
+                                                   const SIM_stats_t *counters )
+* \Description     : Prints one table row (response_ms < 0: none).
+*******************************************************************************/
+static void LATBENCH_PrintRow(const char *name, unsigned long long cycles, double response_ms,
+                              const SIM_stats_t *counters)
+{
+    char response[16] = "-";
+
+    if(response_ms >= 0)
+        snprintf(response, sizeof(response), "%.3f", response_ms);
+    printf("  %-16s %10.3f %9s %6llu / %-4llu %8llu / %-6llu %10.3f %10.3f %10.3f %9.3f\n", name, SIM_MS(cycles),
+           response, counters->lcd_data, counters->lcd_commands, counters->sfr_accesses, counters->sfr_writes,
+           SIM_MS(counters->delay_cycles + counters->spin_cycles), SIM_MS(counters->idle_cycles),
+           SIM_MS(counters->sleep_cycles), SIM_MS(counters->isr_cycles));
+}
+
+/******************************************************************************
+* \Syntax          : static void LATBENCH_PrintJsonCounters( const SIM_stats_t *counters )
+* \Description     : Prints the counters of a stage or a total as JSON
+                     members.
+*******************************************************************************/
+static void LATBENCH_PrintJsonCounters(const SIM_stats_t *counters)
+{
+    printf("\"lcd_data\": %llu, \"lcd_commands\": %llu, \"sfr_accesses\": %llu, \"sfr_writes\": %llu, "
+           "\"delay_ms\": %.3f, \"polling_ms\": %.3f, \"busy_wait_ms\": %.3f, \"idle_ms\": %.3f, \"sleep_ms\": %.3f, "
+           "\"isr_ms\": %.3f", counters->lcd_data, counters->lcd_commands, counters->sfr_accesses, counters->sfr_writes,
+           SIM_MS(counters->delay_cycles), SIM_MS(counters->spin_cycles),
+           SIM_MS(counters->delay_cycles + counters->spin_cycles), SIM_MS(counters->idle_cycles),
+           SIM_MS(counters->sleep_cycles), SIM_MS(counters->isr_cycles));
+}
+
+/******************************************************************************
+* \Syntax          : static void LATBENCH_PrintJson( const int *failed )
+* \Description     : Prints the results as one JSON document (virtual time
+                     only, the same firmware gives the same document).
+*******************************************************************************/
+static void LATBENCH_PrintJson(const int *failed)
+{
+    SIM_stats_t all = gZero;
+    unsigned long long all_cycles = 0;
+    int errors = 0;
+
+    printf("{\n");
+    printf("  \"bench\": \"latbench\",\n");
+    printf("  \"build\": { \"VM_USE_SCHEDULER\": %d, \"LCD_USE_QUEUE\": %d, \"VM_USE_SLEEP\": %d },\n",
+           VM_USE_SCHEDULER, LCD_USE_QUEUE, VM_USE_SLEEP);
+    printf("  \"sessions\": [\n");
+    for(unsigned int i = 0; i < LATBENCH_SESSIONS; i++)
+    {
+        SIM_stats_t sum = gZero;
+        unsigned long long cycles = 0;
+
+        errors += failed[i];
+        printf("    { \"name\": \"%s\", \"ok\": %s, \"stages\": [\n", gSessions[i].name, failed[i] ? "false" : "true");
+        for(int stage = 0; stage < LATBENCH_STAGES; stage++)
+        {
+            const LATBENCH_stage_t *measure = &gStages[i][stage];
+            SIM_stats_t counters;
+
+            printf("      { \"stage\": \"%s\", ", gNames[stage]);
+            if(!measure->seen || !measure->end)
+            {
+                printf("\"skipped\": true }%s\n", (stage < LATBENCH_STAGES - 1) ? "," : "");
+                continue;
+            }
+            counters = gZero;
+            LATBENCH_Add(&counters, &measure->exit, &measure->entry);
+            LATBENCH_Add(&sum, &measure->exit, &measure->entry);
+            cycles += measure->end - measure->start;
+            printf("\"ms\": %.3f, ", SIM_MS(measure->end - measure->start));
+            if(measure->press)
+                printf("\"response_ms\": %.3f, ", SIM_MS(measure->end - measure->press));
+            LATBENCH_PrintJsonCounters(&counters);
+            printf(" }%s\n", (stage < LATBENCH_STAGES - 1) ? "," : "");
+        }
+        printf("      ],\n      \"total\": { \"ms\": %.3f, ", SIM_MS(cycles));
+        LATBENCH_PrintJsonCounters(&sum);
+        printf(" } }%s\n", (i < LATBENCH_SESSIONS - 1) ? "," : "");
+
+        all_cycles += cycles;
+        LATBENCH_Add(&all, &sum, &gZero);
+    }
+    printf("  ],\n  \"total\": { \"ms\": %.3f, ", SIM_MS(all_cycles));
+    LATBENCH_PrintJsonCounters(&all);
+    printf(" },\n  \"result\": \"%s\"\n}\n", errors ? "FAILED" : "ok");
+}
+
+/******************************************************************************
+* \Syntax          : static void LATBENCH_PrintTable( const int *failed,
+                                                     double wall_us )
+* \Description     : Prints the stages of every session and the totals.
+*******************************************************************************/
+static void LATBENCH_PrintTable(const int *failed, double wall_us)
+{
+    SIM_stats_t all = gZero;
+    unsigned long long all_cycles = 0;
+    int errors = 0;
+
+    printf("build           : %s (VM_USE_SCHEDULER = %d, LCD_USE_QUEUE = %d, VM_USE_SLEEP = %d)\n",
+           (VM_USE_SCHEDULER == 1) ? "non-blocking" : "blocking", VM_USE_SCHEDULER, LCD_USE_QUEUE, VM_USE_SLEEP);
+    for(unsigned int i = 0; i < LATBENCH_SESSIONS; i++)
+    {
+        SIM_stats_t sum = gZero;
+        unsigned long long cycles = 0;
+
+        errors += failed[i];
+        printf("session %-15s: %s\n", gSessions[i].name, failed[i] ? "FAILED" : "ok");
+        printf("  stage                  ms  response  LCD data/cmd   SFR acc / writes  busy-wait ms"
+               "    idle ms   sleep ms    ISR ms\n");
+        for(int stage = 0; stage < LATBENCH_STAGES; stage++)
+        {
+            const LATBENCH_stage_t *measure = &gStages[i][stage];
+            SIM_stats_t counters;
+
+            if(!measure->seen || !measure->end)
+            {
+                printf("  %-16s    skipped\n", gNames[stage]);
+                continue;
+            }
+            counters = gZero;
+            LATBENCH_Add(&counters, &measure->exit, &measure->entry);
+            LATBENCH_Add(&sum, &measure->exit, &measure->entry);
+            cycles += measure->end - measure->start;
+            LATBENCH_PrintRow(gNames[stage], measure->end - measure->start,
+                              measure->press ? SIM_MS(measure->end - measure->press) : -1.0, &counters);
+        }
+        LATBENCH_PrintRow("total", cycles, -1.0, &sum);
+
+        all_cycles += cycles;
+        LATBENCH_Add(&all, &sum, &gZero);
+    }
+    printf("all sessions    : %.3f ms virtual, %llu LCD data bytes, %llu LCD commands, %llu SFR writes, "
+           "%.3f ms busy-waiting, %.3f ms idle\n", SIM_MS(all_cycles), all.lcd_data, all.lcd_commands, all.sfr_writes,
+           SIM_MS(all.delay_cycles + all.spin_cycles), SIM_MS(all.idle_cycles));
+    printf("wall time       : %.1f ms (%.0fx real time)\n", wall_us / 1e3, SIM_US(all_cycles) / wall_us);
+    printf("result          : %s\n", errors ? "FAILED" : "ok");
+}
+
+
+/**********************************************************************************************************************
+ *  MAIN
+ *********************************************************************************************************************/
+
+int main(int argc, char **argv)
+{
+    int failed[LATBENCH_SESSIONS];
+    int errors = 0;
+    unsigned char json = 0;
+    struct timespec start, end;
+    int option;
+
+    while((option = getopt(argc, argv, "j")) != -1)
+    {
+        switch(option)
+        {
+            case 'j':
+                json = 1;
+                break;
+
+            default:
+                fprintf(stderr, "usage: %s [-j]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    SIM_LCD_OnChange(LATBENCH_Changed);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(unsigned int i = 0; i < LATBENCH_SESSIONS; i++)
+    {
+        failed[i] = LATBENCH_Session(i);
+        errors += failed[i];
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if(json)
+        LATBENCH_PrintJson(failed);
+    else
+        LATBENCH_PrintTable(failed, (end.tv_sec - start.tv_sec) * 1e6 + (end.tv_nsec - start.tv_nsec) / 1e3);
+    return errors ? 1 : 0;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: latbench.c
+ *********************************************************************************************************************/
@@ -0,0 +1,218 @@
+/**********************************************************************************************************************
+ * Filename:    lcdbench.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Measures the LCD driver command and character throughput on the host simulator, with the fixed
+ *              delays (R/W tied to GND), with busy flag polling (R/W on RC1) and with a display that never answers
+ *              (R/W wired but D7 pulled high: every poll times out). Built with LCD_USE_BUSY_FLAG = 1 and
+ *              LCD_USE_QUEUE = 0, with the LCD struct (lcdbench) or with the build time pins and LCD_RW_PIN = 1
+ *              (lcdbench_static, no fixed delays column: the R/W wiring is fixed at build time).
+ * NOTE:        Times are virtual: every SFR access and busy-wait is charged (the port accesses done through the
+ *              LCD port pointer at SIM_INDIRECT_CYCLES).
+ *              Usage: lcdbench [operations]
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <xc.h>
+#include "SIM/SIM.h"
+#include "../source/LCD/LCD.h"
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* LCD wiring (same as the vending machine, R/W on RC1 when polled) */
+#if LCD_STATIC_PINS == 1
+#if LCD_RW_PIN == LCD_NO_PIN
+#error "lcdbench: build time pins without a R/W pin (LCD_RW_PIN)"
+#endif
+#define     LCDBENCH_RW             LCD_RW_PIN
+#define     LCDBENCH_FIXED          0           /* No fixed delays run with a R/W pin built in */
+#else
+#define     LCDBENCH_RW             1
+#define     LCDBENCH_FIXED          1
+#endif
+
+/* Command written with the fixed delays after the time-out (two nibbles, __delay_ms(4) each) */
+#define     LCDBENCH_FALLBACK_US    8000
+
+/* D7 of the LCD port (pulled high when the display does not answer) */
+#define     LCDBENCH_D7             7
+
+/* Default number of operations per measurement */
+#define     LCDBENCH_OPERATIONS     200
+
+
+/**********************************************************************************************************************
+ *  LOCAL DATA TYPES AND STRUCTURES
+ *********************************************************************************************************************/
+
+/* Result of one mode */
+typedef struct
+{
+    double init_us;                 /* LCD_Init                            */
+    double cmd_us;                  /* One cursor move (LCD_SetCursor)     */
+    double char_us;                 /* One character (LCD_PutChar)         */
+    double clear_us;                /* LCD_BufferClear + 16 characters     */
+    unsigned long long violations;
+    unsigned long long reads;
+    int ok;
+}LCDBENCH_result_t;
+
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void myISR( void )
+* \Description     : The LCD driver uses no interrupt (interrupts stay off).
+*******************************************************************************/
+void myISR(void)
+{
+}
+
+/******************************************************************************
+* \Syntax          : static double LCDBENCH_Since( unsigned long long start )
+* \Description     : Virtual time elapsed since start (us).
+*******************************************************************************/
+static double LCDBENCH_Since(unsigned long long start)
+{
+    return SIM_US(SIM_Now() - start);
+}
+
+/******************************************************************************
+* \Syntax          : static void LCDBENCH_Run( rw, missing, operations, result )
+* \Description     : Runs every measurement with the given R/W wiring,
+                     missing = 1: the R/W pin does not reach the display and
+                     D7 is pulled high (busy for ever).
+*******************************************************************************/
+static void LCDBENCH_Run(unsigned char rw, unsigned char missing, unsigned long operations,
+                         LCDBENCH_result_t *result)
+{
+    LCD display = { &PORTC, 0, 3, 4, 5, 6, 7, rw };
+    unsigned long long start;
+
+    SIM_Reset();
+    SIM_LCD_Attach(SIM_PORTC, 0, 3, 4, 5, 6, 7);
+    SIM_LCD_AttachRW((missing || (rw == LCD_NO_PIN)) ? SIM_NO_PIN : rw);
+    if(missing)
+        SIM_SetPin(SIM_PORTC, LCDBENCH_D7, 1);
+
+    start = SIM_Now();
+    LCD_Init(display);
+    result->init_us = LCDBENCH_Since(start);
+
+    start = SIM_Now();
+    for(unsigned long i = 0; i < operations; i++)
+        LCD_SetCursor((unsigned char)(i & 1), (unsigned char)(i % LCD_COLS));
+    result->cmd_us = LCDBENCH_Since(start) / operations;
+
+    /* Characters only (the cursor moves back to the start of the row are not counted) */
+    result->char_us = 0;
+    for(unsigned long i = 0; i < operations; i++)
+    {
+        if((i % LCD_COLS) == 0)
+        {
+            LCD_SetCursor(0, 0);
+            start = SIM_Now();
+        }
+        LCD_PutChar((char)('A' + (i % LCD_COLS)));
+        if(((i % LCD_COLS) == (LCD_COLS - 1)) || (i == operations - 1))
+            result->char_us += LCDBENCH_Since(start);
+    }
+    result->char_us /= operations;
+
+    start = SIM_Now();
+    for(unsigned long i = 0; i < operations / LCD_COLS + 1; i++)
+    {
+        LCD_BufferClear();
+        LCD_PutString("0123456789ABCDEF");
+    }
+    result->clear_us = LCDBENCH_Since(start) / (operations / LCD_COLS + 1);
+
+    result->violations = SIM_Stats()->lcd_violations;
+    result->reads = SIM_Stats()->lcd_reads;
+    if(missing)     /* The display is not checked, only that the polls gave up near LCD_BUSY_TIMEOUT_US */
+        result->ok = (result->cmd_us < LCDBENCH_FALLBACK_US + 1.5 * LCD_BUSY_TIMEOUT_US);
+    else
+        result->ok = SIM_LCD_RowStartsWith(0, "0123456789ABCDEF") && (result->violations == 0);
+}
+
+
+/******************************************************************************
+* \Syntax          : static void LCDBENCH_Print( name, format, fixed, polled, missing )
+* \Description     : Prints one row, a column not measured (< 0 or a fixed
+                     delays column not run) is printed as '-'.
+*******************************************************************************/
+static void LCDBENCH_Print(const char *name, const char *format, double fixed, double polled, double missing)
+{
+    double values[3] = { (LCDBENCH_FIXED && (fixed >= 0)) ? fixed : -1, polled, missing };
+
+    printf("%-26s", name);
+    for(unsigned char i = 0; i < 3; i++)
+    {
+        putchar(' ');
+        if(values[i] < 0)
+            printf("%14s", "-");
+        else
+            printf(format, values[i]);
+    }
+    putchar('\n');
+}
+
+
+/**********************************************************************************************************************
+ *  MAIN
+ *********************************************************************************************************************/
+
+int main(int argc, char **argv)
+{
+    unsigned long operations = (argc > 1) ? strtoul(argv[1], NULL, 10) : LCDBENCH_OPERATIONS;
+    LCDBENCH_result_t fixed;
+    LCDBENCH_result_t polled;
+    LCDBENCH_result_t missing;
+    int ok;
+
+    if(operations == 0)
+        operations = 1;
+
+    fixed.ok = 1;
+    fixed.init_us = fixed.cmd_us = fixed.char_us = fixed.clear_us = -1;
+    fixed.reads = fixed.violations = 0;
+    if(LCDBENCH_FIXED)
+        LCDBENCH_Run(LCD_NO_PIN, 0, operations, &fixed);
+    LCDBENCH_Run(LCDBENCH_RW, 0, operations, &polled);
+    LCDBENCH_Run(LCDBENCH_RW, 1, operations, &missing);
+    ok = fixed.ok && polled.ok && missing.ok;
+
+    printf("%-26s %14s %14s %14s\n", "", "fixed delays", "busy flag", "no answer");
+    LCDBENCH_Print("LCD_Init", "%11.1f us", fixed.init_us, polled.init_us, missing.init_us);
+    LCDBENCH_Print("command (set cursor)", "%11.1f us", fixed.cmd_us, polled.cmd_us, missing.cmd_us);
+    LCDBENCH_Print("character", "%11.1f us", fixed.char_us, polled.char_us, missing.char_us);
+    LCDBENCH_Print("clear + 16 characters", "%11.1f us", fixed.clear_us, polled.clear_us, missing.clear_us);
+    LCDBENCH_Print("command throughput", "%11.0f /s", 1e6 / fixed.cmd_us, 1e6 / polled.cmd_us,
+                   1e6 / missing.cmd_us);
+    LCDBENCH_Print("character throughput", "%11.0f /s", 1e6 / fixed.char_us, 1e6 / polled.char_us,
+                   1e6 / missing.char_us);
+    LCDBENCH_Print("busy flag reads", "%14.0f", fixed.reads, polled.reads, -1);
+    LCDBENCH_Print("LCD busy errors", "%14.0f", fixed.violations, polled.violations, -1);
+    if(!LCDBENCH_FIXED)
+        printf("(build time pins with R/W on RC%u: no fixed delays run)\n", LCDBENCH_RW);
+    printf("result                     : %s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: lcdbench.c
+ *********************************************************************************************************************/
@@ -0,0 +1,228 @@
+/**********************************************************************************************************************
+ * Filename:    lcdcost.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Measures the port work of the LCD driver per character (LCD_PutChar and the two LCD_QueueTick
+ *              nibbles) for the pin mapping it is built with (LCD_STATIC_PINS = 1: build time, 0: LCD struct).
+ * NOTE:        Only the SFR accesses are charged (SIM_ACCESS_CYCLES direct, SIM_INDIRECT_CYCLES through the LCD
+ *              struct pointer), so the cycles are a lower bound of the real cost of both mappings. The writes of
+ *              the LCD struct mapping go through DIO_writePortMasked() (a read-modify-write of PORTC per nibble and
+ *              per RS/EN change, the call is not charged), only the busy flag is read through the pointer.
+ *              Built with SIM_DIRECT_SFR = 1 (lcdcost_insn), the driver instructions per character are counted
+ *              instead by single-stepping it (SIM_Instructions): the run time shifts and the DIO_writePortMasked()
+ *              calls of the LCD struct mapping against the constant masks of the build time mapping. These are host
+ *              instructions, the ratio of both builds is the meaningful figure.
+ *              Usage: lcdcost              report of this build
+ *                     lcdcost -q           "cycles accesses" per character (input of the next form)
+ *                     lcdcost CYC ACC      report and savings against another build
+ *                     lcdcost_insn -q      instructions per character (input of the next form)
+ *                     lcdcost_insn INSN    report and saving against another build, fails if nothing is saved
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <xc.h>
+#include "SIM/SIM.h"
+#include "../source/LCD/LCD.h"
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Characters measured */
+#define     LCDCOST_CHARACTERS      1000
+
+/* Characters single-stepped (SIM_DIRECT_SFR = 1) */
+#define     LCDCOST_STEPPED         16
+
+#if LCD_USE_QUEUE == 0
+#error "lcdcost measures the transmit queue path (LCD_USE_QUEUE = 1)"
+#endif
+
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void myISR( void )
+* \Description     : LCD_QueueTick() is called directly (interrupts stay off).
+*******************************************************************************/
+void myISR(void)
+{
+}
+
+/******************************************************************************
+* \Syntax          : static void LCDCOST_Tick( void )
+* \Description     : Lets the time of one timer interrupt period elapse.
+*******************************************************************************/
+static void LCDCOST_Tick(void)
+{
+    SIM_Advance(SIM_CYCLES_MS(LCD_QUEUE_TICK_US / 1000.0));
+}
+
+/******************************************************************************
+* \Syntax          : static void LCDCOST_Drain( void )
+* \Description     : Sends the whole transmit queue.
+*******************************************************************************/
+static void LCDCOST_Drain(void)
+{
+    while(LCD_QueueFree() != LCD_QUEUE_SIZE - 1)
+    {
+        LCDCOST_Tick();
+        LCD_QueueTick();
+    }
+    for(unsigned char i = 0; i < 8; i++)        /* Pending wait ticks (clear) */
+    {
+        LCDCOST_Tick();
+        LCD_QueueTick();
+    }
+}
+
+
+#if defined(SIM_DIRECT_SFR) && (SIM_DIRECT_SFR == 1)
+/******************************************************************************
+* \Syntax          : static void LCDCOST_Empty( void )
+* \Description     : Nothing, the instructions of the counting markers.
+*******************************************************************************/
+static void LCDCOST_Empty(void)
+{
+}
+
+/******************************************************************************
+* \Syntax          : static void LCDCOST_Characters( void )
+* \Description     : Queues and sends LCDCOST_STEPPED characters.
+*******************************************************************************/
+static void LCDCOST_Characters(void)
+{
+    for(unsigned char i = 0; i < LCDCOST_STEPPED; i++)
+    {
+        LCD_PutChar((char)('A' + i));
+        LCD_QueueTick();
+        LCD_QueueTick();
+    }
+}
+#endif
+
+
+/**********************************************************************************************************************
+ *  MAIN
+ *********************************************************************************************************************/
+
+#if defined(SIM_DIRECT_SFR) && (SIM_DIRECT_SFR == 1)
+int main(int argc, char **argv)
+{
+    LCD display = { &PORTC, 0, 3, 4, 5, 6, 7, LCD_NO_PIN };
+    long empty, characters;
+    double insn;
+
+    SIM_Reset();
+    LCD_Init(display);
+    LCD_Clear();
+    LCDCOST_Drain();
+
+    empty = SIM_Instructions(LCDCOST_Empty);
+    characters = SIM_Instructions(LCDCOST_Characters);
+    if((empty < 0) || (characters < 0))
+    {
+        fprintf(stderr, "lcdcost: the instructions cannot be counted (Linux ptrace)\n");
+        return 1;
+    }
+    insn = (double)(characters - empty) / LCDCOST_STEPPED;
+
+    if((argc > 1) && (strcmp(argv[1], "-q") == 0))
+    {
+        printf("%.2f\n", insn);
+        return 0;
+    }
+
+    printf("pin mapping          : %s\n", LCD_STATIC_PINS ? "build time (LCD_STATIC_PINS = 1)" : "LCD struct (LCD_STATIC_PINS = 0)");
+    printf("driver insns / char  : %.2f (host)\n", insn);
+    if(argc > 1)
+    {
+        double base = strtod(argv[1], NULL);
+
+        printf("saved / char         : %.2f instructions (%.0f%%)\n", base - insn, 100.0 * (base - insn) / base);
+        return (insn < base) ? 0 : 1;
+    }
+    return 0;
+}
+#else
+int main(int argc, char **argv)
+{
+    LCD display = { &PORTC, 0, 3, 4, 5, 6, 7, LCD_NO_PIN };
+    const SIM_stats_t *stats = SIM_Stats();
+    unsigned long long cycles = 0;
+    unsigned long long accesses, indirect, delay, start;
+    double cyc, acc;
+
+    SIM_Reset();
+    SIM_LCD_Attach(SIM_PORTC, 0, 3, 4, 5, 6, 7);
+    LCD_Init(display);
+    LCD_Clear();
+    LCDCOST_Drain();
+
+    accesses = stats->sfr_accesses;
+    indirect = stats->sfr_indirect;
+    delay = stats->delay_cycles;
+    for(unsigned int i = 0; i < LCDCOST_CHARACTERS; i++)
+    {
+        start = SIM_Now();
+        LCD_PutChar((char)('A' + (i % 16)));
+        LCD_QueueTick();
+        cycles += SIM_Now() - start;
+        LCDCOST_Tick();
+
+        start = SIM_Now();
+        LCD_QueueTick();
+        cycles += SIM_Now() - start;
+        LCDCOST_Tick();
+    }
+    cycles -= stats->delay_cycles - delay;      /* Enable pulse NOP() */
+    accesses = stats->sfr_accesses - accesses;
+    indirect = stats->sfr_indirect - indirect;
+
+    cyc = (double)cycles / LCDCOST_CHARACTERS;
+    acc = (double)accesses / LCDCOST_CHARACTERS;
+
+    if((argc > 1) && (strcmp(argv[1], "-q") == 0))
+    {
+        printf("%.2f %.2f\n", cyc, acc);
+        return 0;
+    }
+
+    printf("pin mapping          : %s\n", LCD_STATIC_PINS ? "build time (LCD_STATIC_PINS = 1)" : "LCD struct (LCD_STATIC_PINS = 0)");
+    printf("SFR accesses / char  : %.2f (%.2f through the LCD struct pointer)\n", acc, (double)indirect / LCDCOST_CHARACTERS);
+    printf("port cycles / char   : %.2f\n", cyc);
+    printf("LCD busy errors      : %llu\n", stats->lcd_violations);
+    if(argc > 2)
+    {
+        double base_cyc = strtod(argv[1], NULL);
+        double base_acc = strtod(argv[2], NULL);
+
+        /* Same port work: no percentage of a difference that is only rounding */
+        if((base_cyc - cyc < 0.005) && (cyc - base_cyc < 0.005) &&
+           (base_acc - acc < 0.005) && (acc - base_acc < 0.005))
+            printf("saved / char         : no change (same port cycles and SFR accesses)\n");
+        else
+            printf("saved / char         : %.2f cycles (%.0f%%), %.2f SFR accesses (%.0f%%)\n",
+                   base_cyc - cyc, 100.0 * (base_cyc - cyc) / base_cyc,
+                   base_acc - acc, 100.0 * (base_acc - acc) / base_acc);
+    }
+    return (stats->lcd_violations == 0) ? 0 : 1;
+}
+#endif
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: lcdcost.c
+ *********************************************************************************************************************/
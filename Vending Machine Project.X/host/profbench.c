@@ -0,0 +1,151 @@
+/**********************************************************************************************************************
+ * Filename:    profbench.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Runs the firmware built with the cycle profiler (PROF_ENABLE = 1) through one customer transaction
+ *              and an idle machine and prints the probe table (count, min / mean / max cycles) of every mode, every
+ *              interrupt source and the LCD flush, the same table PROF_Get() returns on the PIC (PIC16F886 build,
+ *              the table does not fit beside the application on the PIC16F882). Then one probe is run until its
+ *              32-bit sum is halved, to check that it keeps counting.
+ * NOTE:        The probes read the simulated Timer1, so the table is checked against the ISR time the simulator
+ *              measures itself (with its entry / exit latency). A probe of the main loop includes the interrupts it
+ *              was preempted by. The simulator only charges the SFR accesses and the delays, the C code between them
+ *              is free: the host table is a lower bound of the hardware table, with the same layout and counts.
+ *              Usage: profbench [idle_ms]
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <xc.h>
+
+#include "SIM/SIM.h"
+#include "../source/ADC/ADC.h"
+#include "../source/VendingMachine/VM.h"
+#include "../source/Profiler/PROF.h"
+
+#if PROF_ENABLE != 1
+#error "profbench: build with -DPROF_ENABLE=1"
+#endif
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Default idle time after the customer (virtual ms) */
+#define     PROFBENCH_IDLE_MS       10000
+
+/* Push buttons on PORTB */
+#define     PROFBENCH_SW0           0
+#define     PROFBENCH_SW1           1
+#define     PROFBENCH_SW2           2
+
+/* Give up if the customer is not served within (virtual ms) */
+#define     PROFBENCH_TIMEOUT_MS    30000
+
+/* Sections of PROFBENCH_CYCLES cycles run through one probe: the 32-bit sum is halved after 2^32 / PROFBENCH_CYCLES
+   sections (each section a delay, the simulator skips it in one step) */
+#define     PROFBENCH_CYCLES        60000U
+#define     PROFBENCH_SECTIONS      100000UL
+
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+static const char *const gProbeNames[VM_PROBES] =
+{
+    [VM_PROBE_MODE(VM_STATE_DRINK_SELECTION)]   = "mode drink selection",
+    [VM_PROBE_MODE(VM_STATE_COIN_INSERTION)]    = "mode coin insertion",
+    [VM_PROBE_MODE(VM_STATE_DRINK_DISPENSE)]    = "mode drink dispense",
+    [VM_PROBE_MODE(VM_STATE_DRINK_READY)]       = "mode drink ready",
+    [VM_PROBE_MODE(VM_STATE_DISPENSE_CHANGE)]   = "mode dispense change",
+    [VM_PROBE_ISR_TICK]                         = "ISR Timer2 tick",
+    [VM_PROBE_ISR_ADC]                          = "ISR ADC",
+    [VM_PROBE_ISR_LCD]                          = "ISR LCD queue",
+    [VM_PROBE_LCD_FLUSH]                        = "LCD flush",
+};
+
+
+/**********************************************************************************************************************
+ *  MAIN
+ *********************************************************************************************************************/
+
+int main(int argc, char **argv)
+{
+    unsigned long idle_ms = (argc > 1) ? strtoul(argv[1], NULL, 10) : PROFBENCH_IDLE_MS;
+    const SIM_stats_t *stats = SIM_Stats();
+    const PROF_probe_t *probe;
+    unsigned long long isr_sum = 0;
+    unsigned long long customer;
+    unsigned char missing = 0;
+    int ok;
+
+    SIM_Reset();
+    SIM_LCD_Attach(SIM_PORTC, 0, 3, 4, 5, 6, 7);
+    SIM_SetAnalog(ADC9, 0x100);                     /* Tilt sensor below 2V */
+    VM_Init();
+    PROF_Clear();                                   /* Start-up (LCD init) not counted */
+
+    /* Lemonade (80p): 50p + 50p --> 20p change, every mode runs */
+    customer = SIM_Now();
+    SIM_PressButton(customer + SIM_CYCLES_MS(500), PROFBENCH_SW0, 120);
+    SIM_PressButton(customer + SIM_CYCLES_MS(1000), PROFBENCH_SW1, 120);
+    SIM_PressButton(customer + SIM_CYCLES_MS(1500), PROFBENCH_SW2, 120);
+    SIM_PressButton(customer + SIM_CYCLES_MS(2000), PROFBENCH_SW2, 120);
+    SIM_RunUntil(customer + SIM_CYCLES_MS(PROFBENCH_TIMEOUT_MS), NULL);
+
+    /* Nobody at the machine */
+    SIM_RunUntil(SIM_Now() + SIM_CYCLES_MS(idle_ms), NULL);
+
+    printf("%-22s %8s %8s %10s %8s %12s\n", "probe", "count", "min", "mean", "max", "total (ms)");
+    for(unsigned char id = 0; id < PROF_MAX_PROBES; id++)
+    {
+        probe = PROF_Get(id);
+        printf("  %-20s %8lu %8u %10.1f %8u %12.2f\n", gProbeNames[id], (unsigned long)probe->count, probe->min,
+               probe->count ? (double)probe->sum / probe->count : 0.0, probe->max, SIM_MS(probe->sum));
+        if(probe->count == 0)
+            missing++;
+        if(id < VM_PROBES_ISR)
+            isr_sum += probe->sum;
+    }
+    printf("probe overhead       : %u cycles (subtracted)\n", PROF_Overhead());
+    printf("probe table          : %u bytes of RAM (%u probes, budget %u)\n", (unsigned int)PROF_RAM,
+           (unsigned int)PROF_MAX_PROBES, (unsigned int)PROF_RAM_BUDGET);
+    printf("ISR (probes)         : %.2f ms\n", SIM_MS(isr_sum));
+    printf("ISR (simulator)      : %.2f ms, %llu calls (entry and exit latency included)\n",
+           SIM_MS(stats->isr_cycles), stats->isr_calls);
+
+    /* Every probe hit, the record size of the budget check, the probes inside the ISR cannot take longer than the ISR */
+    ok = (missing == 0) && (sizeof(PROF_probe_t) == PROF_PROBE_SIZE) && (isr_sum <= stats->isr_cycles) &&
+         SIM_LCD_RowStartsWith(0, "Select Drink:");
+
+    /* Past a full sum the probe still counts (sum and count halved) and its mean stays between min and max */
+    PROF_Clear();
+    for(unsigned long i = 0; i < PROFBENCH_SECTIONS; i++)
+    {
+        PROF_BEGIN(VM_PROBE_LCD_FLUSH);
+        _delay(PROFBENCH_CYCLES);
+        PROF_END(VM_PROBE_LCD_FLUSH);
+    }
+    probe = PROF_Get(VM_PROBE_LCD_FLUSH);
+    printf("full sum             : %lu sections, count %lu, mean %.1f cycles (min %u, max %u)\n", PROFBENCH_SECTIONS,
+           (unsigned long)probe->count, (double)probe->sum / probe->count, probe->min, probe->max);
+    ok = ok && (probe->count > 0) && (probe->count < PROFBENCH_SECTIONS) &&
+         (probe->count > PROFBENCH_SECTIONS - ((uint32_t)0xFFFFFFFF / PROFBENCH_CYCLES)) &&
+         (probe->sum >= (uint64_t)probe->min * probe->count) && (probe->sum <= (uint64_t)probe->max * probe->count);
+    printf("result               : %s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: profbench.c
+ *********************************************************************************************************************/
@@ -0,0 +1,194 @@
+/**********************************************************************************************************************
+ * Filename:    sleepbench.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Runs the firmware through an idle machine, one slow customer and an idle machine again and reports
+ *              the active versus sleep duty cycle of every vending machine state, the wake-ups, the time awake on
+ *              the internal oscillator and, with the scheduler, the scheduler time of the idle machine against the
+ *              virtual time (Timer2 stops in sleep mode, the watchdog wake-ups make up its ticks) and the tilt sensor
+ *              sampling period.
+ * NOTE:        VM.c is included here to read the current state after every main loop pass, it is not linked a second
+ *              time. The time of a pass is charged to the state it started in.
+ *              Usage: sleepbench [idle_ms]
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SIM/SIM.h"
+#include "../source/VendingMachine/VM.c"
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Default idle time before and after the customer (virtual ms) */
+#define     SLEEPBENCH_IDLE_MS      30000
+
+/* Push buttons on PORTB */
+#define     SLEEPBENCH_SW0          0
+#define     SLEEPBENCH_SW1          1
+#define     SLEEPBENCH_SW2          2
+
+/* Give up if the customer is not served within (virtual ms) */
+#define     SLEEPBENCH_TIMEOUT_MS   60000
+
+/* Minimum share of the idle drink selection time spent sleeping (%) */
+#define     SLEEPBENCH_MIN_SLEEP    90.0
+
+/* Largest gap between the scheduler time and the virtual time of the idle machine (%) */
+#define     SLEEPBENCH_MAX_DRIFT    2.0
+
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+static const char *const gStateNames[VM_SM_STATES] =
+{
+    "initial", "drink selection", "coin insertion", "drink dispense",
+    "drink ready", "dispense change", "tilt sensing", "alarm"
+};
+
+/* Time of every state and the part spent sleeping (cycles) */
+static unsigned long long gStateCycles[VM_SM_STATES];
+static unsigned long long gStateSleep[VM_SM_STATES];
+
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : static void SLEEPBENCH_Pass( void )
+* \Description     : One main loop pass, charged to the current state.
+*******************************************************************************/
+static void SLEEPBENCH_Pass(void)
+{
+    const SIM_stats_t *stats = SIM_Stats();
+    unsigned char state = gCurrentState - VM_STATE_INITIAL;
+    unsigned long long start = SIM_Now();
+    unsigned long long sleep = stats->sleep_cycles;
+
+    SIM_RunUntil(start + 1, NULL);
+
+    gStateCycles[state] += SIM_Now() - start;
+    gStateSleep[state] += stats->sleep_cycles - sleep;
+}
+
+/******************************************************************************
+* \Syntax          : static void SLEEPBENCH_RunUntil( unsigned long long time )
+* \Description     : Runs the main loop until the virtual time.
+*******************************************************************************/
+static void SLEEPBENCH_RunUntil(unsigned long long time)
+{
+    while(SIM_Now() < time)
+        SLEEPBENCH_Pass();
+}
+
+
+/**********************************************************************************************************************
+ *  MAIN
+ *********************************************************************************************************************/
+
+int main(int argc, char **argv)
+{
+    unsigned long idle_ms = (argc > 1) ? strtoul(argv[1], NULL, 10) : SLEEPBENCH_IDLE_MS;
+    const SIM_stats_t *stats = SIM_Stats();
+    const SIM_edge_t *edges;
+    unsigned long long idle_sleep, idle_cycles;
+    unsigned long long customer, end;
+    unsigned char dispensed = 0;
+    unsigned int edge_count;
+    double drift = 0.0;
+    int ok;
+#if VM_USE_SCHEDULER == 1
+    SCHED_tick_t ticks;
+    unsigned long long idle_time;
+#endif
+
+    SIM_Reset();
+    SIM_LCD_Attach(SIM_PORTC, 0, 3, 4, 5, 6, 7);
+    SIM_SetAnalog(ADC9, 0x100);                     /* Tilt sensor below 2V */
+    VM_Init();
+
+    /* Nobody at the machine */
+#if VM_USE_SCHEDULER == 1
+    idle_time = SIM_Now();
+    ticks = SCHED_Now();
+#endif
+    SLEEPBENCH_RunUntil(SIM_Now() + SIM_CYCLES_MS(idle_ms));
+#if VM_USE_SCHEDULER == 1
+    ticks = (SCHED_tick_t)(SCHED_Now() - ticks);
+    idle_time = SIM_Now() - idle_time;
+    drift = 100.0 * (ticks * (SCHED_TICK_US / 1000.0) - SIM_MS(idle_time)) / SIM_MS(idle_time);
+#endif
+    idle_cycles = gStateCycles[VM_STATE_DRINK_SELECTION - VM_STATE_INITIAL];
+    idle_sleep = gStateSleep[VM_STATE_DRINK_SELECTION - VM_STATE_INITIAL];
+
+    /* A slow customer: Lemonade (80p), 2s between the coins (50p + 50p --> 20p change) */
+    customer = SIM_Now();
+    SIM_PressButton(customer + SIM_CYCLES_MS(1000), SLEEPBENCH_SW0, 120);
+    SIM_PressButton(customer + SIM_CYCLES_MS(3000), SLEEPBENCH_SW1, 120);
+    SIM_PressButton(customer + SIM_CYCLES_MS(5000), SLEEPBENCH_SW2, 120);
+    SIM_PressButton(customer + SIM_CYCLES_MS(7000), SLEEPBENCH_SW2, 120);
+    while(SIM_Now() < customer + SIM_CYCLES_MS(SLEEPBENCH_TIMEOUT_MS))
+    {
+        SLEEPBENCH_Pass();
+        edge_count = SIM_EdgeLog(&edges);
+        for(unsigned int i = 0; i < edge_count; i++)
+        {
+            if((edges[i].port == SIM_PORTA) && (edges[i].pin == 0) && !edges[i].level)
+                dispensed = 1;
+        }
+        if(dispensed && (gCurrentState == VM_STATE_DRINK_SELECTION))
+            break;
+    }
+    end = SIM_Now();
+
+    /* Nobody at the machine again */
+    SLEEPBENCH_RunUntil(SIM_Now() + SIM_CYCLES_MS(idle_ms));
+
+    printf("%-18s %10s %12s %9s\n", "state", "time (s)", "active (ms)", "sleeping");
+    for(unsigned char state = 0; state < VM_SM_STATES; state++)
+    {
+        if(gStateCycles[state] == 0)
+            continue;
+        printf("  %-16s %10.3f %12.1f %8.1f%%\n", gStateNames[state], SIM_MS(gStateCycles[state]) / 1000,
+               SIM_MS(gStateCycles[state] - gStateSleep[state]), 100.0 * gStateSleep[state] / gStateCycles[state]);
+    }
+    printf("total                : %.3f s, %.1f %% sleeping\n", SIM_MS(SIM_Now()) / 1000,
+           100.0 * stats->sleep_cycles / SIM_Now());
+    printf("idle (no customer)   : %.1f %% sleeping, %.2f ms active per second\n",
+           100.0 * idle_sleep / idle_cycles, 1000.0 * SIM_MS(idle_cycles - idle_sleep) / SIM_MS(idle_cycles));
+    printf("customer served in   : %.3f s (%s)\n", SIM_MS(end - customer) / 1000, dispensed ? "dispensed" : "TIMEOUT");
+    printf("wake-ups             : %llu SLEEP, %llu watchdog, %llu other\n", stats->sleeps, stats->wdt_wakes,
+           stats->sleeps - stats->wdt_wakes);
+#if VM_USE_SCHEDULER == 1
+    printf("scheduler time idle  : %u ticks, %+.2f %% of the virtual time, tilt sampled every %.2f ms\n", ticks,
+           drift, SIM_MS(idle_time) / ticks);
+#endif
+    printf("ADC conversions      : %llu\n", stats->adc_conversions);
+    printf("internal oscillator  : %.1f ms awake, %llu clock switches\n", SIM_MS(stats->intosc_cycles),
+           stats->clock_switches);
+    printf("ISR time             : %.1f us worst case, %.1f us mean\n", SIM_US(stats->isr_max_cycles),
+           stats->isr_calls ? SIM_US(stats->isr_cycles) / stats->isr_calls : 0.0);
+
+    ok = dispensed && SIM_LCD_RowStartsWith(0, "Select Drink:") &&
+         ((VM_USE_SLEEP == 0) || (100.0 * idle_sleep / idle_cycles >= SLEEPBENCH_MIN_SLEEP)) &&
+         (drift <= SLEEPBENCH_MAX_DRIFT) && (drift >= -SLEEPBENCH_MAX_DRIFT);
+    printf("result               : %s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: sleepbench.c
+ *********************************************************************************************************************/
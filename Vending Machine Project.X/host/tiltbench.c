@@ -0,0 +1,166 @@
+/**********************************************************************************************************************
+ * Filename:    tiltbench.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Runs the unmodified firmware (VM_Init / VM_Running / myISR) with a noisy tilt sensor (VR2 on AN9) and
+ *              reports the false alarms, the alarm (RA2) detection and release latencies and the ISR cost.
+ * NOTE:        The noise is a uniform pseudo-random offset, a new value is applied on every main loop pass.
+ *              Usage: tiltbench [steps]
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SIM/SIM.h"
+#include "../source/VendingMachine/VM.h"
+#include "../source/ADC/ADC.h"
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Default number of tilt steps */
+#define     TILTBENCH_STEPS         10
+
+/* Sensor levels (10-bit, the alarm threshold is 2V = 0x199) */
+#define     TILTBENCH_LEVEL_IDLE    0x180       /* 1.88V, below the threshold */
+#define     TILTBENCH_LEVEL_TILT    0x250       /* 2.90V, tilted              */
+#define     TILTBENCH_NOISE         32          /* +/- noise amplitude        */
+
+/* Duration of the noise test and of every step (virtual ms) */
+#define     TILTBENCH_NOISE_MS      20000
+#define     TILTBENCH_HOLD_MS       1500
+
+/* Alarm buzzer */
+#define     TILTBENCH_ALARM_PIN     2
+
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+static unsigned long gSeed = 12345;             /* Noise generator state */
+
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : static unsigned int TILTBENCH_Noisy( unsigned int level )
+* \Description     : Level plus a pseudo-random offset (deterministic).
+*******************************************************************************/
+static unsigned int TILTBENCH_Noisy(unsigned int level)
+{
+    /* 32-bit LCG, bits 30..16 only: the low bits repeat with the main loop cadence */
+    gSeed = (gSeed * 1103515245UL + 12345UL) & 0xFFFFFFFFUL;
+    return level + (unsigned int)(((gSeed >> 16) & 0x7FFF) % (2 * TILTBENCH_NOISE + 1)) - TILTBENCH_NOISE;
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned long TILTBENCH_Run( level, ms, alarm, edges )
+* \Description     : Runs the firmware for ms with a noisy sensor at level.
+                     Returns the time until RA2 first reaches alarm (cycles,
+                     0 if never) and counts the RA2 rising edges.
+*******************************************************************************/
+static unsigned long long TILTBENCH_Run(unsigned int level, unsigned long ms, unsigned char alarm,
+                                        unsigned long *edges)
+{
+    unsigned long long start = SIM_Now();
+    unsigned long long end = start + SIM_CYCLES_MS(ms);
+    unsigned long long reached = 0;
+    unsigned char previous = SIM_GetPin(SIM_PORTA, TILTBENCH_ALARM_PIN);
+
+    while(SIM_Now() < end)
+    {
+        unsigned char pin;
+
+        SIM_SetAnalog(ADC9, TILTBENCH_Noisy(level));
+        VM_Running();
+        SIM_MainLoop();
+
+        pin = SIM_GetPin(SIM_PORTA, TILTBENCH_ALARM_PIN);
+        if(pin && !previous)
+            (*edges)++;
+        if((reached == 0) && (pin == alarm))
+            reached = SIM_Now() - start;
+        previous = pin;
+    }
+    return reached;
+}
+
+
+/**********************************************************************************************************************
+ *  MAIN
+ *********************************************************************************************************************/
+
+int main(int argc, char **argv)
+{
+    unsigned long steps = (argc > 1) ? strtoul(argv[1], NULL, 10) : TILTBENCH_STEPS;
+    const SIM_stats_t *stats = SIM_Stats();
+    unsigned long false_alarms = 0;
+    unsigned long edges = 0;
+    unsigned long missed = 0;
+    double detect_sum = 0, detect_max = 0;
+    double release_sum = 0, release_max = 0;
+
+    if(steps == 0)
+        steps = 1;
+
+    SIM_Reset();
+    SIM_LCD_Attach(SIM_PORTC, 0, 3, 4, 5, 6, 7);
+    SIM_SetAnalog(ADC9, TILTBENCH_LEVEL_IDLE);
+    VM_Init();
+
+    /* Untilted machine, noisy sensor: every alarm is a false alarm */
+    TILTBENCH_Run(TILTBENCH_LEVEL_IDLE, TILTBENCH_NOISE_MS, 2, &false_alarms);
+
+    /* Tilt steps, the start phase moves by 7ms every step */
+    for(unsigned long i = 0; i < steps; i++)
+    {
+        unsigned long long detect, release;
+
+        TILTBENCH_Run(TILTBENCH_LEVEL_IDLE, 7 * (i % 10) + 1, 2, &edges);
+        detect = TILTBENCH_Run(TILTBENCH_LEVEL_TILT, TILTBENCH_HOLD_MS, 1, &edges);
+        release = TILTBENCH_Run(TILTBENCH_LEVEL_IDLE - 2 * TILTBENCH_NOISE, TILTBENCH_HOLD_MS, 0, &edges);
+        if((detect == 0) || (release == 0))
+        {
+            missed++;
+            continue;
+        }
+        detect_sum += SIM_MS(detect);
+        release_sum += SIM_MS(release);
+        if(SIM_MS(detect) > detect_max)
+            detect_max = SIM_MS(detect);
+        if(SIM_MS(release) > release_max)
+            release_max = SIM_MS(release);
+    }
+
+    printf("false alarms         : %lu in %u ms (idle 0x%X +/- %u)\n", false_alarms, TILTBENCH_NOISE_MS,
+           TILTBENCH_LEVEL_IDLE, TILTBENCH_NOISE);
+    if(missed < steps)
+    {
+        printf("detection latency    : %.1f ms mean, %.1f ms worst (%lu steps)\n",
+               detect_sum / (steps - missed), detect_max, steps - missed);
+        printf("release latency      : %.1f ms mean, %.1f ms worst\n",
+               release_sum / (steps - missed), release_max);
+    }
+    printf("missed steps         : %lu\n", missed);
+    printf("ISR time             : %.1f us worst case, %.1f us mean\n", SIM_US(stats->isr_max_cycles),
+           stats->isr_calls ? SIM_US(stats->isr_cycles) / stats->isr_calls : 0.0);
+    printf("ADC conversions      : %llu\n", stats->adc_conversions);
+    printf("result               : %s\n", ((false_alarms == 0) && (missed == 0)) ? "ok" : "FAILED");
+    return ((false_alarms == 0) && (missed == 0)) ? 0 : 1;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: tiltbench.c
+ *********************************************************************************************************************/
@@ -0,0 +1,208 @@
+/**********************************************************************************************************************
+ * Filename:    tlmbench.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Runs the firmware built with the telemetry channel (VM_USE_TELEMETRY = 1, LCD on RC0..RC5) through one
+ *              customer and a tilt alarm raised while the machine sleeps, decodes the frames sent on the EUSART and
+ *              reports the channel load, the ring buffer use and the character time on both clocks.
+ * NOTE:        Built with VM_USE_INPUT_TRACE = 1 (tlmbench_trace) the input frames are decoded as well.
+ * NOTE:        The bytes are copied to the file or pipe given on the command line, a local collector (tlmdump) can
+ *              take them in while the simulation runs.
+ *              Usage: tlmbench [output file or pipe]
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "SIM/SIM.h"
+#include "../source/ADC/ADC.h"
+#include "../source/LCD/LCD.h"
+#include "../source/UART/UART.h"
+#include "../source/VendingMachine/VM.h"
+
+#if VM_USE_TELEMETRY != 1
+#error "tlmbench: build with -DVM_USE_TELEMETRY=1 and the LCD on RC0..RC5"
+#endif
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Push buttons on PORTB */
+#define     TLMBENCH_SW0            0
+#define     TLMBENCH_SW1            1
+#define     TLMBENCH_SW2            2
+
+/* Tilt sensor levels (10-bit, the alarm threshold is 2V = 0x199) */
+#define     TLMBENCH_LEVEL_IDLE     0x100
+#define     TLMBENCH_LEVEL_TILT     0x250
+
+/* Length of the scenario (virtual ms): customer, tilt at, tilt released at */
+#define     TLMBENCH_CUSTOMER_MS    20000
+#define     TLMBENCH_TILT_MS        25000
+#define     TLMBENCH_RELEASE_MS     27000
+#define     TLMBENCH_END_MS         30000
+
+/* Expected sale: Lemonade (catalog index 1, 80p) paid with 50p + 50p */
+#define     TLMBENCH_DRINK          1
+#define     TLMBENCH_PAID           10
+
+/* Maximum character time error (%) */
+#define     TLMBENCH_MAX_BAUD_ERROR 2.0
+
+/* Input frames expected with VM_USE_INPUT_TRACE = 1: the first, 4 presses and releases, tilt and release */
+#define     TLMBENCH_MIN_INPUTS     11
+
+
+/**********************************************************************************************************************
+ *  MAIN
+ *********************************************************************************************************************/
+
+int main(int argc, char **argv)
+{
+    const SIM_stats_t *stats = SIM_Stats();
+    const SIM_uart_byte_t *bytes;
+    unsigned int count;
+    unsigned int frames = 0, bad = 0, states = 0, sales = 0, alarms = 0, inputs = 0;
+    unsigned char sale_ok = 0, alarm_on = 0, alarm_off = 0;
+    double char_us = 1e7 / UART_BAUD;               /* Start, 8 data and stop bits */
+    double worst_error = 0.0;
+    FILE *out = NULL;
+    int ok;
+
+    if(argc > 1)
+    {
+        out = fopen(argv[1], "wb");
+        if(out == NULL)
+        {
+            perror(argv[1]);
+            return 2;
+        }
+    }
+
+    SIM_UART_Output(out);
+    SIM_Reset();
+    SIM_LCD_Attach(SIM_PORTC, LCD_RS_PIN, LCD_EN_PIN, LCD_D4_PIN, LCD_D4_PIN + 1, LCD_D4_PIN + 2, LCD_D4_PIN + 3);
+    SIM_SetAnalog(ADC9, TLMBENCH_LEVEL_IDLE);
+    VM_Init();
+
+    /* Lemonade (80p): 50p + 50p --> 20p change */
+    SIM_PressButton(SIM_CYCLES_MS(500), TLMBENCH_SW0, 120);
+    SIM_PressButton(SIM_CYCLES_MS(1000), TLMBENCH_SW1, 120);
+    SIM_PressButton(SIM_CYCLES_MS(1500), TLMBENCH_SW2, 120);
+    SIM_PressButton(SIM_CYCLES_MS(2000), TLMBENCH_SW2, 120);
+    SIM_RunUntil(SIM_CYCLES_MS(TLMBENCH_CUSTOMER_MS), NULL);
+
+    /* Tilt while the machine sleeps on the idle clock */
+    SIM_RunUntil(SIM_CYCLES_MS(TLMBENCH_TILT_MS), NULL);
+    SIM_SetAnalog(ADC9, TLMBENCH_LEVEL_TILT);
+    SIM_RunUntil(SIM_CYCLES_MS(TLMBENCH_RELEASE_MS), NULL);
+    SIM_SetAnalog(ADC9, TLMBENCH_LEVEL_IDLE);
+    SIM_RunUntil(SIM_CYCLES_MS(TLMBENCH_END_MS), NULL);
+
+    if(out != NULL)
+        fclose(out);
+
+    /* Decode the frames, the character time is the spacing of back-to-back bytes of a frame */
+    count = SIM_UART_Log(&bytes);
+    for(unsigned int i = 0; i < count; )
+    {
+        unsigned char type, length, sum;
+
+        if((bytes[i].value != UART_SOF) || (i + UART_FRAME_OVERHEAD > count))
+        {
+            bad++;
+            i++;
+            continue;
+        }
+        type = bytes[i + 1].value;
+        length = bytes[i + 2].value;
+        if(i + UART_FRAME_OVERHEAD + length > count)
+        {
+            bad++;
+            break;
+        }
+        sum = 0;
+        for(unsigned int j = i + 1; j < i + UART_FRAME_OVERHEAD + length; j++)
+        {
+            double error = 100.0 * (SIM_US(bytes[j].time - bytes[j - 1].time) - char_us) / char_us;
+
+            sum += bytes[j].value;
+            if(error < 0)
+                error = -error;
+            if(error > worst_error)
+                worst_error = error;
+        }
+        if(sum != 0)
+        {
+            bad++;
+            i++;
+            continue;
+        }
+
+        frames++;
+        printf("  %10.3f ms  ", SIM_MS(bytes[i].time));
+        switch(type)
+        {
+            case VM_TLM_STATE:
+                states++;
+                printf("state %u\n", bytes[i + 3].value);
+                break;
+            case VM_TLM_SALE:
+                sales++;
+                printf("sale  drink %u, price %u0p, change %u0p\n", bytes[i + 3].value, bytes[i + 4].value,
+                       bytes[i + 5].value);
+                sale_ok = (length == 3) && (bytes[i + 3].value == TLMBENCH_DRINK) &&
+                          (bytes[i + 4].value + bytes[i + 5].value == TLMBENCH_PAID);
+                break;
+            case VM_TLM_ALARM:
+                alarms++;
+                printf("alarm %s\n", bytes[i + 3].value ? "on" : "off");
+                if(bytes[i + 3].value)
+                    alarm_on = 1;
+                else
+                    alarm_off = alarm_on;
+                break;
+            case VM_TLM_INPUT:
+                inputs++;
+                printf("input tick %u, buttons %u%u%u, tilt %u\n", bytes[i + 3].value | (bytes[i + 4].value << 8),
+                       bytes[i + 5].value & 1, (bytes[i + 5].value >> 1) & 1, (bytes[i + 5].value >> 2) & 1,
+                       (bytes[i + 6].value << 8) | bytes[i + 7].value);
+                break;
+            default:
+                printf("type %u, %u bytes\n", type, length);
+                break;
+        }
+        i += UART_FRAME_OVERHEAD + length;
+    }
+
+    printf("frames               : %u (%u state, %u sale, %u alarm, %u input), %u bad\n", frames, states, sales,
+           alarms, inputs, bad);
+    printf("bytes sent           : %llu, channel busy %.3f %% of %.1f s, %llu overruns\n", stats->uart_bytes,
+           100.0 * stats->uart_cycles / SIM_Now(), SIM_MS(SIM_Now()) / 1000, stats->uart_overruns);
+    printf("ring buffer          : %u of %u bytes used at most, %u frames dropped\n", UART_HighWater(),
+           UART_TX_SIZE - 1, UART_Dropped());
+    printf("character time       : %.1f us at %lu baud, %.2f %% worst error\n", char_us, UART_BAUD, worst_error);
+    printf("sleep                : %.1f %% of the time, %llu clock switches\n",
+           100.0 * stats->sleep_cycles / SIM_Now(), stats->clock_switches);
+    printf("LCD busy errors      : %llu\n", stats->lcd_violations);
+
+    ok = (bad == 0) && (frames > 0) && sale_ok && (sales == 1) && alarm_off && (UART_Dropped() == 0) &&
+         (stats->uart_overruns == 0) && (worst_error <= TLMBENCH_MAX_BAUD_ERROR) &&
+         (stats->lcd_violations == 0) && SIM_LCD_RowStartsWith(0, "Select Drink:") &&
+         ((VM_USE_INPUT_TRACE == 0) || (inputs >= TLMBENCH_MIN_INPUTS));
+    printf("result               : %s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: tlmbench.c
+ *********************************************************************************************************************/
@@ -0,0 +1,233 @@
+/**********************************************************************************************************************
+ * Filename:    tlmdump.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Local collector of the telemetry channel: reads the EUSART byte stream from a file, a pipe or the
+ *              standard input and prints every frame (state changes, sales, alarms, inputs) as it arrives.
+ * NOTE:        A byte stream that starts in the middle of a frame or has corrupted bytes is resynchronized on the
+ *              next start of frame whose check is valid, the skipped bytes are counted.
+ * NOTE:        With -t the input frames (VM_USE_INPUT_TRACE = 1) are written as an input trace timed in Timer2 ticks
+ *              for tracereplay: the levels of the first frame from the power-on reset, then every change at the tick
+ *              it was sampled at, END a while after the last frame. The inputs are as the main loop saw them: a
+ *              change that lasts less than a main loop pass, or whose frame is dropped, is not in the trace.
+ *              Usage: tlmdump [-t trace] [file or pipe]
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../source/UART/UART.h"
+#include "../source/VendingMachine/VM.h"
+#include "../source/ADC/ADC.h"
+#include "../source/Scheduler/SCHED.h"
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Longest frame */
+#define     TLMDUMP_MAX_FRAME       (UART_FRAME_OVERHEAD + 255)
+
+/* Push buttons of the input frames (SW0..SW2 on PORTB bits 0..2) */
+#define     TLMDUMP_BUTTONS         3
+
+/* Trace end after the last input frame (the machine back at the drink menu) */
+#define     TLMDUMP_TRACE_TAIL_MS   20000UL
+
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+static const char *const gStateNames[] =
+{
+    "initial", "drink selection", "coin insertion", "drink dispense",
+    "drink ready", "dispense change", "tilt sensing", "alarm"
+};
+
+static unsigned char gFrame[TLMDUMP_MAX_FRAME];     /* Frame being received      */
+static unsigned int gLength = 0;                    /* Bytes received            */
+static unsigned long gFrames = 0;                   /* Valid frames              */
+static unsigned long gSkipped = 0;                  /* Bytes outside a frame     */
+static FILE *gTrace = NULL;                         /* Input trace (-t)          */
+static unsigned long gInputs = 0;                   /* Input frames traced       */
+static unsigned long gTick = 0;                     /* Unwrapped tick of the last input frame */
+static unsigned char gButtons = 0;                  /* Last push buttons traced  */
+static unsigned int gTilt = 0;                      /* Last tilt sensor traced   */
+
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : static void TLMDUMP_Trace( const unsigned char *payload )
+* \Description     : Writes the inputs of a VM_TLM_INPUT frame that changed to
+                     the input trace.
+*******************************************************************************/
+static void TLMDUMP_Trace(const unsigned char *payload)
+{
+    unsigned int tick = payload[0] | ((unsigned int)payload[1] << 8);
+    unsigned char buttons = payload[2];
+    unsigned int tilt = ((unsigned int)payload[3] << 8) | payload[4];
+
+    if(gInputs++ == 0)
+    {
+        /* Levels since the power-on reset */
+        gTick = tick;
+        fputs("# Input trace from the VM_TLM_INPUT frames, times in Timer2 ticks\n", gTrace);
+        for(unsigned char pin = 0; pin < TLMDUMP_BUTTONS; pin++)
+            fprintf(gTrace, "t0 B %u %u\n", pin, (buttons >> pin) & 1);
+        fprintf(gTrace, "t0 A %u %u\n", ADC9, tilt);
+    }
+    else
+    {
+        /* The frame has the low 16 bits of the tick */
+        gTick += (unsigned int)(tick - gTick) & 0xFFFF;
+        for(unsigned char pin = 0; pin < TLMDUMP_BUTTONS; pin++)
+        {
+            if(((buttons ^ gButtons) >> pin) & 1)
+                fprintf(gTrace, "t%lu B %u %u\n", gTick, pin, (buttons >> pin) & 1);
+        }
+        if(tilt != gTilt)
+            fprintf(gTrace, "t%lu A %u %u\n", gTick, ADC9, tilt);
+    }
+    gButtons = buttons;
+    gTilt = tilt;
+}
+
+/******************************************************************************
+* \Syntax          : static void TLMDUMP_Print( void )
+* \Description     : Prints the frame received.
+*******************************************************************************/
+static void TLMDUMP_Print(void)
+{
+    unsigned char type = gFrame[1];
+    unsigned char length = gFrame[2];
+    const unsigned char *payload = &gFrame[3];
+
+    gFrames++;
+    printf("%6lu  ", gFrames);
+    if((type == VM_TLM_STATE) && (length == 1) && (payload[0] >= VM_STATE_INITIAL) &&
+       (payload[0] <= VM_STATE_ALARM))
+        printf("state  %s\n", gStateNames[payload[0] - VM_STATE_INITIAL]);
+    else if((type == VM_TLM_SALE) && (length == 3))
+        printf("sale   drink %u, price %u0p, change %u0p\n", payload[0], payload[1], payload[2]);
+    else if((type == VM_TLM_ALARM) && (length == 1))
+        printf("alarm  %s\n", payload[0] ? "on" : "off");
+    else if((type == VM_TLM_INPUT) && (length == VM_TLM_INPUT_SIZE))
+    {
+        printf("input  tick %u, buttons SW0 %u SW1 %u SW2 %u, tilt %u\n", payload[0] | (payload[1] << 8),
+               payload[2] & 1, (payload[2] >> 1) & 1, (payload[2] >> 2) & 1, (payload[3] << 8) | payload[4]);
+        if(gTrace != NULL)
+            TLMDUMP_Trace(payload);
+    }
+    else
+    {
+        printf("type %u:", type);
+        for(unsigned char i = 0; i < length; i++)
+            printf(" %02X", payload[i]);
+        printf("\n");
+    }
+    fflush(stdout);
+}
+
+/******************************************************************************
+* \Syntax          : static void TLMDUMP_Feed( unsigned char value )
+* \Description     : Adds a received byte to the frame, a frame whose check
+                     fails is scanned again from its second byte.
+*******************************************************************************/
+static void TLMDUMP_Feed(unsigned char value)
+{
+    unsigned char sum = 0;
+    unsigned char retry[TLMDUMP_MAX_FRAME];
+    unsigned int retry_length;
+
+    if((gLength == 0) && (value != UART_SOF))
+    {
+        gSkipped++;
+        return;
+    }
+    gFrame[gLength++] = value;
+    if((gLength < UART_FRAME_OVERHEAD) || (gLength < UART_FRAME_OVERHEAD + (unsigned int)gFrame[2]))
+        return;
+
+    for(unsigned int i = 1; i < gLength; i++)
+        sum += gFrame[i];
+    if(sum == 0)
+    {
+        TLMDUMP_Print();
+        gLength = 0;
+        return;
+    }
+
+    /* Not a frame: the start of frame was a data byte */
+    gSkipped++;
+    retry_length = gLength - 1;
+    memcpy(retry, &gFrame[1], retry_length);
+    gLength = 0;
+    for(unsigned int i = 0; i < retry_length; i++)
+        TLMDUMP_Feed(retry[i]);
+}
+
+
+/**********************************************************************************************************************
+ *  MAIN
+ *********************************************************************************************************************/
+
+int main(int argc, char **argv)
+{
+    FILE *in = stdin;
+    int c;
+
+    while((c = getopt(argc, argv, "t:")) != -1)
+    {
+        if(c != 't')
+        {
+            fprintf(stderr, "usage: tlmdump [-t trace] [file or pipe]\n");
+            return 2;
+        }
+        gTrace = fopen(optarg, "w");
+        if(gTrace == NULL)
+        {
+            perror(optarg);
+            return 2;
+        }
+    }
+    if(optind < argc)
+    {
+        in = fopen(argv[optind], "rb");
+        if(in == NULL)
+        {
+            perror(argv[optind]);
+            return 2;
+        }
+    }
+
+    while((c = fgetc(in)) != EOF)
+        TLMDUMP_Feed((unsigned char)c);
+
+    printf("frames  : %lu, %lu bytes skipped, %u bytes of an incomplete frame\n", gFrames, gSkipped, gLength);
+    if(gTrace != NULL)
+    {
+        fprintf(gTrace, "t%lu END\n", gTick + SCHED_MS_TO_TICKS(TLMDUMP_TRACE_TAIL_MS));
+        fclose(gTrace);
+        printf("trace   : %lu input frames\n", gInputs);
+    }
+    if(in != stdin)
+        fclose(in);
+    return 0;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: tlmdump.c
+ *********************************************************************************************************************/
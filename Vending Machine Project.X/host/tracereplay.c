@@ -0,0 +1,803 @@
+/**********************************************************************************************************************
+ * Filename:    tracereplay.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Replays input traces (push button edges, analog samples, power cycles) through the unmodified firmware
+ *              (VM_Init / VM_Running / myISR) on the host simulator as fast as it runs, and checks the output log
+ *              (RA0/RA1/RA2 edges, LCD rows) against a golden log: a field incident captured as a trace is replayed
+ *              and kept as a regression test.
+ * NOTE:        Trace: one entry per line, "#" starts a comment.
+ *                  <time> B <pin> <level>      push button pin of PORTB (1 = released, 0 = pressed)
+ *                  <time> A <channel> <value>  10-bit value of an analog channel (VR2 = 9)
+ *                  <time> POWER                power cycle, the next times count from the power-on reset again
+ *                  <time> END                  end of the trace
+ *              time is the virtual time in us since the power-on reset, or tN: the input is set just after the
+ *              Timer2 tick N - 1, before the ISR samples it at tick N (collector of the VM_TLM_INPUT frames, tlmdump
+ *              -t). A trace runs from the power-on reset with the push buttons released and the analog inputs at 0.
+ * NOTE:        Output log: "<us> R<port><pin> <level>" for an output edge, "<us> LCD<row> |<16 characters>|" when a
+ *              row changed and settled (time of its last change), "<us> POWER" and "<us> END". The golden log of
+ *              x.trace is x.golden, written with -w.
+ * NOTE:        The firmware is linked as one object whose .data/.bss are renamed vm_ram/vm_zram (make tracereplay,
+ *              GNU objcopy, as fleet): every power-on segment starts from the image of its RAM saved before any
+ *              firmware code ran, like after a real reset; the data EEPROM and the input levels are handed on.
+ *              Usage: tracereplay [-w | -p] [-r repeat] [-j jobs] trace...
+ *                       -w     write the golden logs
+ *                       -p     print the output logs
+ *                       -r N   replay every trace N times (throughput)
+ *                       -j N   replay in N processes
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "SIM/SIM.h"
+#include "../source/VendingMachine/VM.h"
+#include "../source/LCD/LCD.h"
+#include "../source/Scheduler/SCHED.h"
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Entry kinds */
+#define     TRACE_BUTTON            'B'
+#define     TRACE_ANALOG            'A'
+#define     TRACE_POWER             'P'
+#define     TRACE_END               'E'
+
+/* Analog channels of the simulator (AN0 : AN13) */
+#define     TRACE_ANALOG_CHANNELS   14
+
+/* Give up if a segment of a trace runs longer than this (virtual ms) */
+#define     TRACE_TIMEOUT_MS        3600000UL
+
+/* Longest line of a trace */
+#define     TRACE_LINE_SIZE         256
+
+/* Data EEPROM of the PIC16F882 (kept across a power cycle) */
+#define     TRACE_EEPROM_SIZE       128
+
+/* How a power-on segment ended */
+#define     TRACE_SEGMENT_END       0
+#define     TRACE_SEGMENT_POWER     1
+#define     TRACE_SEGMENT_TIMEOUT   2
+
+/* LCD rows checked */
+#define     TRACE_LCD_ROWS          2
+
+/* A row is logged once it has not changed for this long (the LCD queue writes a character every ~520us) */
+#define     TRACE_LCD_SETTLE_MS     5
+
+
+/**********************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *********************************************************************************************************************/
+
+/* Trace entry */
+typedef struct
+{
+    unsigned long long time;        /* Virtual us, or tick number if tick */
+    unsigned char tick;             /* time is a Timer2 tick             */
+    unsigned char kind;             /* TRACE_xxx                         */
+    unsigned char number;           /* Pin or analog channel             */
+    unsigned int value;             /* Level or 10-bit value             */
+}TRACE_entry_t;
+
+/* Trace and its golden log */
+typedef struct
+{
+    const char *path;
+    TRACE_entry_t *entries;
+    unsigned int count;
+    char *golden;                   /* Golden log (NULL: none)           */
+}TRACE_t;
+
+/* State handed from a power-on segment to the next (the firmware RAM is not, every segment starts from gPowerOn) */
+typedef struct
+{
+    unsigned int index;                             /* First entry, then next entry           */
+    unsigned char status;                           /* TRACE_SEGMENT_xxx                      */
+    unsigned char powered;                          /* eeprom kept from a power cycle         */
+    unsigned char buttons;                          /* PORTB levels set by the trace          */
+    unsigned int analog[TRACE_ANALOG_CHANNELS];     /* Analog values set by the trace         */
+    unsigned char eeprom[TRACE_EEPROM_SIZE];        /* Data EEPROM after the power cycle      */
+    unsigned long long cycles;                      /* Virtual time of the segment            */
+}TRACE_segment_t;
+
+/* LCD row as written and as logged */
+typedef struct
+{
+    char text[LCD_COLS + 1];        /* Row as last seen                  */
+    char logged[LCD_COLS + 1];      /* Row as last logged                */
+    unsigned long long changed;     /* Virtual time text changed         */
+}TRACE_row_t;
+
+/* Output log */
+typedef struct
+{
+    char *text;
+    size_t length;
+    size_t size;
+}TRACE_log_t;
+
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+static TRACE_segment_t gSegment;                            /* Power-on segment being replayed */
+
+/* Firmware RAM (fw object sections, see the NOTE) and its image before any firmware code ran */
+extern unsigned char __start_vm_ram[], __stop_vm_ram[];
+extern unsigned char __start_vm_zram[], __stop_vm_zram[];
+static unsigned char *gPowerOn;
+
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : static void TRACE_Reserve( TRACE_log_t *log, size_t length )
+* \Description     : Makes room for length more characters (and the
+                     terminating null) in the output log.
+*******************************************************************************/
+static void TRACE_Reserve(TRACE_log_t *log, size_t length)
+{
+    if(log->size - log->length > length)
+        return;
+    while(log->size - log->length <= length)
+        log->size = log->size ? 2 * log->size : 4096;
+    log->text = realloc(log->text, log->size);
+    if(log->text == NULL)
+    {
+        perror("tracereplay");
+        exit(2);
+    }
+}
+
+/******************************************************************************
+* \Syntax          : static void TRACE_Printf( TRACE_log_t *log, format, ... )
+* \Description     : Appends a line to the output log.
+*******************************************************************************/
+static void TRACE_Printf(TRACE_log_t *log, const char *format, ...) __attribute__((format(printf, 2, 3)));
+static void TRACE_Printf(TRACE_log_t *log, const char *format, ...)
+{
+    va_list args;
+    int length;
+
+    TRACE_Reserve(log, TRACE_LINE_SIZE);
+    va_start(args, format);
+    length = vsnprintf(log->text + log->length, log->size - log->length, format, args);
+    va_end(args);
+    if(length > 0)
+        log->length += (size_t)length;
+}
+
+/******************************************************************************
+* \Syntax          : static char *TRACE_ReadFile( const char *path )
+* \Description     : Returns the contents of a file (NULL if it cannot be
+                     read), to be freed by the caller.
+*******************************************************************************/
+static char *TRACE_ReadFile(const char *path)
+{
+    FILE *in = fopen(path, "rb");
+    char *text;
+    long size;
+
+    if(in == NULL)
+        return NULL;
+    fseek(in, 0, SEEK_END);
+    size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    text = malloc((size_t)size + 1);
+    if((text != NULL) && (fread(text, 1, (size_t)size, in) != (size_t)size))
+    {
+        free(text);
+        text = NULL;
+    }
+    if(text != NULL)
+        text[size] = '\0';
+    fclose(in);
+    return text;
+}
+
+/******************************************************************************
+* \Syntax          : static char *TRACE_GoldenPath( const char *path )
+* \Description     : Returns the path of the golden log of a trace (.trace
+                     replaced by .golden), to be freed by the caller.
+*******************************************************************************/
+static char *TRACE_GoldenPath(const char *path)
+{
+    size_t length = strlen(path);
+    char *golden = malloc(length + sizeof(".golden"));
+
+    if(golden == NULL)
+        return NULL;
+    strcpy(golden, path);
+    if((length > 6) && (strcmp(path + length - 6, ".trace") == 0))
+        golden[length - 6] = '\0';
+    strcat(golden, ".golden");
+    return golden;
+}
+
+/******************************************************************************
+* \Syntax          : static int TRACE_Load( TRACE_t *trace, const char *path )
+* \Description     : Reads a trace file, returns 0 on success (an error is
+                     printed with its line number otherwise).
+*******************************************************************************/
+static int TRACE_Load(TRACE_t *trace, const char *path)
+{
+    FILE *in = fopen(path, "r");
+    char line[TRACE_LINE_SIZE];
+    unsigned int size = 0, number = 0;
+    int segment_tick = -1;                  /* Time base of the segment: -1 unknown, 0 us, 1 ticks */
+    unsigned long long last = 0;
+    int ended = 0;
+
+    memset(trace, 0, sizeof(*trace));
+    trace->path = path;
+    if(in == NULL)
+    {
+        perror(path);
+        return 1;
+    }
+
+    while(fgets(line, sizeof(line), in) != NULL)
+    {
+        TRACE_entry_t entry = { 0 };
+        char time[32], kind[16];
+        unsigned int a = 0, b = 0;
+        char *comment = strchr(line, '#');
+        char *end;
+        int fields;
+
+        number++;
+        if(comment != NULL)
+            *comment = '\0';
+        fields = sscanf(line, "%31s %15s %u %u", time, kind, &a, &b);
+        if(fields <= 0)
+            continue;
+        if(ended)
+        {
+            fprintf(stderr, "%s:%u: entry after END\n", path, number);
+            fclose(in);
+            return 1;
+        }
+
+        entry.tick = (time[0] == 't');
+        entry.time = strtoull(time + entry.tick, &end, 10);
+        if((*end != '\0') || (fields < 2))
+            fields = 0;
+        else if((strcmp(kind, "B") == 0) && (fields == 4) && (a < 8) && (b <= 1))
+            entry.kind = TRACE_BUTTON;
+        else if((strcmp(kind, "A") == 0) && (fields == 4) && (a < TRACE_ANALOG_CHANNELS) && (b <= 0x3FF))
+            entry.kind = TRACE_ANALOG;
+        else if((strcmp(kind, "POWER") == 0) && (fields == 2))
+            entry.kind = TRACE_POWER;
+        else if((strcmp(kind, "END") == 0) && (fields == 2))
+            entry.kind = TRACE_END;
+        else
+            fields = 0;
+        if(fields == 0)
+        {
+            fprintf(stderr, "%s:%u: bad entry\n", path, number);
+            fclose(in);
+            return 1;
+        }
+
+        /* One time base per segment (between power cycles), times in order */
+        if(((segment_tick >= 0) && (segment_tick != entry.tick)) || (entry.time < last))
+        {
+            fprintf(stderr, "%s:%u: time out of order or mixed time bases\n", path, number);
+            fclose(in);
+            return 1;
+        }
+        if(entry.tick && (VM_USE_SCHEDULER != 1))
+        {
+            fprintf(stderr, "%s:%u: tick times need the scheduler build\n", path, number);
+            fclose(in);
+            return 1;
+        }
+        segment_tick = entry.tick;
+        last = entry.time;
+        if(entry.kind == TRACE_POWER)
+        {
+            segment_tick = -1;
+            last = 0;
+        }
+        ended = (entry.kind == TRACE_END);
+        entry.number = (unsigned char)a;
+        entry.value = b;
+
+        if(trace->count == size)
+        {
+            size = size ? 2 * size : 64;
+            trace->entries = realloc(trace->entries, size * sizeof(TRACE_entry_t));
+            if(trace->entries == NULL)
+            {
+                perror(path);
+                exit(2);
+            }
+        }
+        trace->entries[trace->count++] = entry;
+    }
+    fclose(in);
+    if(!ended)
+    {
+        fprintf(stderr, "%s: no END entry\n", path);
+        return 1;
+    }
+    return 0;
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned char TRACE_Due( const TRACE_entry_t *entry )
+* \Description     : Returns 1 if a tick entry, a power cycle or the end of
+                     the trace is due.
+*******************************************************************************/
+static unsigned char TRACE_Due(const TRACE_entry_t *entry)
+{
+    if(entry->tick)
+        return (unsigned long long)SCHED_Now() + 1 >= entry->time;
+    return SIM_Now() >= SIM_CYCLES_MS(entry->time / 1000.0);
+}
+
+/******************************************************************************
+* \Syntax          : static void TRACE_Apply( const TRACE_entry_t *entry )
+* \Description     : Sets a push button or an analog input now.
+*******************************************************************************/
+static void TRACE_Apply(const TRACE_entry_t *entry)
+{
+    if(entry->kind == TRACE_BUTTON)
+        SIM_SetPin(SIM_PORTB, entry->number, (unsigned char)entry->value);
+    else
+        SIM_SetAnalog(entry->number, entry->value);
+}
+
+/******************************************************************************
+* \Syntax          : static void TRACE_Track( const TRACE_entry_t *entry )
+* \Description     : Keeps the input levels set by the trace (restored after
+                     a power cycle).
+*******************************************************************************/
+static void TRACE_Track(const TRACE_entry_t *entry)
+{
+    if(entry->kind == TRACE_BUTTON)
+    {
+        if(entry->value)
+            gSegment.buttons |= (unsigned char)(1 << entry->number);
+        else
+            gSegment.buttons &= (unsigned char)~(1 << entry->number);
+    }
+    else
+    {
+        gSegment.analog[entry->number] = entry->value;
+    }
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned int TRACE_Feed( const TRACE_t *trace,
+                                                     unsigned int index )
+* \Description     : Schedules the inputs timed in us (as long as the input
+                     queue takes them) and sets the tick inputs that are due,
+                     up to the next power cycle or the end. Returns the index
+                     of the next entry.
+*******************************************************************************/
+static unsigned int TRACE_Feed(const TRACE_t *trace, unsigned int index)
+{
+    while(index < trace->count)
+    {
+        const TRACE_entry_t *entry = &trace->entries[index];
+
+        if((entry->kind == TRACE_POWER) || (entry->kind == TRACE_END))
+            break;
+        if(entry->tick)
+        {
+            if(!TRACE_Due(entry))
+                break;
+            TRACE_Apply(entry);
+        }
+        else
+        {
+            unsigned long long time = SIM_CYCLES_MS(entry->time / 1000.0);
+
+            if(SIM_InputsFull())
+                break;
+            if(entry->kind == TRACE_BUTTON)
+                SIM_ScheduleInput(time, SIM_PORTB, entry->number, (unsigned char)entry->value);
+            else
+                SIM_ScheduleAnalog(time, entry->number, entry->value);
+        }
+        TRACE_Track(entry);
+        index++;
+    }
+    return index;
+}
+
+/******************************************************************************
+* \Syntax          : static void TRACE_Outputs( TRACE_log_t *log,
+                                                TRACE_row_t *rows,
+                                                unsigned char flush )
+* \Description     : Logs the new output edges and the LCD rows that changed
+                     and settled (flush: also the rows not settled yet).
+*******************************************************************************/
+static void TRACE_Outputs(TRACE_log_t *log, TRACE_row_t *rows, unsigned char flush)
+{
+    const SIM_edge_t *edges;
+    unsigned int count = SIM_EdgeLog(&edges);
+    unsigned long long now = SIM_Now();
+
+    for(unsigned int i = 0; i < count; i++)
+        TRACE_Printf(log, "%.0f R%c%u %u\n", SIM_US(edges[i].time), "ABC"[edges[i].port], edges[i].pin,
+                     edges[i].level);
+    if(count)
+        SIM_EdgeLogClear();
+
+    for(unsigned char row = 0; row < TRACE_LCD_ROWS; row++)
+    {
+        TRACE_row_t *lcd = &rows[row];
+        const char *text = SIM_LCD_Row(row);
+
+        if(memcmp(text, lcd->text, LCD_COLS) != 0)
+        {
+            memcpy(lcd->text, text, LCD_COLS);
+            lcd->changed = now;
+        }
+        if((flush || (now - lcd->changed >= SIM_CYCLES_MS(TRACE_LCD_SETTLE_MS))) &&
+           (memcmp(lcd->text, lcd->logged, LCD_COLS) != 0))
+        {
+            memcpy(lcd->logged, lcd->text, LCD_COLS);
+            TRACE_Printf(log, "%.0f LCD%u |%s|\n", SIM_US(lcd->changed), row, lcd->logged);
+        }
+    }
+}
+
+/******************************************************************************
+* \Syntax          : static void TRACE_Segment( const TRACE_t *trace,
+                                                TRACE_log_t *log )
+* \Description     : Replays a trace from a power-on reset up to the next
+                     power cycle or the end (gSegment: first entry, levels
+                     and data EEPROM in, next entry, levels and data EEPROM
+                     out).
+*******************************************************************************/
+static void TRACE_Segment(const TRACE_t *trace, TRACE_log_t *log)
+{
+    TRACE_row_t rows[TRACE_LCD_ROWS];
+    const TRACE_entry_t *stop;
+    unsigned int index = gSegment.index;
+
+    SIM_Reset();
+    SIM_LCD_Attach(SIM_PORTC, LCD_RS_PIN, LCD_EN_PIN, LCD_D4_PIN, LCD_D4_PIN + 1, LCD_D4_PIN + 2, LCD_D4_PIN + 3);
+    if(gSegment.powered)
+    {
+        for(unsigned char address = 0; address < TRACE_EEPROM_SIZE; address++)
+            SIM_EepromWrite(address, gSegment.eeprom[address]);
+    }
+    for(unsigned char row = 0; row < TRACE_LCD_ROWS; row++)
+    {
+        memset(rows[row].text, ' ', LCD_COLS);
+        memset(rows[row].logged, ' ', LCD_COLS);
+        rows[row].text[LCD_COLS] = rows[row].logged[LCD_COLS] = '\0';
+        rows[row].changed = 0;
+    }
+    for(unsigned char pin = 0; pin < 8; pin++)
+        SIM_SetPin(SIM_PORTB, pin, (gSegment.buttons >> pin) & 1);
+    for(unsigned char channel = 0; channel < TRACE_ANALOG_CHANNELS; channel++)
+        SIM_SetAnalog(channel, gSegment.analog[channel]);
+
+    index = TRACE_Feed(trace, index);
+    VM_Init();
+    for(;;)
+    {
+        index = TRACE_Feed(trace, index);
+        stop = &trace->entries[index];
+        if(!stop->tick)
+            SIM_StopAt(SIM_CYCLES_MS(stop->time / 1000.0));     /* Not jumped over by an idle pass */
+        if(((stop->kind == TRACE_POWER) || (stop->kind == TRACE_END)) && TRACE_Due(stop))
+            break;
+        if(SIM_Now() > SIM_CYCLES_MS(TRACE_TIMEOUT_MS))
+        {
+            TRACE_Printf(log, "%.0f TIMEOUT\n", SIM_US(SIM_Now()));
+            gSegment.status = TRACE_SEGMENT_TIMEOUT;
+            gSegment.cycles = SIM_Now();
+            return;
+        }
+        VM_Running();
+        SIM_MainLoop();
+        TRACE_Outputs(log, rows, 0);
+    }
+    TRACE_Outputs(log, rows, 1);
+    gSegment.cycles = SIM_Now();
+
+    if(stop->kind == TRACE_END)
+    {
+        TRACE_Printf(log, "%.0f END\n", SIM_US(SIM_Now()));
+        gSegment.status = TRACE_SEGMENT_END;
+        return;
+    }
+    TRACE_Printf(log, "%.0f POWER\n", SIM_US(SIM_Now()));
+    SIM_PowerCycle();                   /* Tears an EEPROM write in progress */
+    for(unsigned char address = 0; address < TRACE_EEPROM_SIZE; address++)
+        gSegment.eeprom[address] = SIM_EepromRead(address);
+    gSegment.powered = 1;
+    gSegment.status = TRACE_SEGMENT_POWER;
+    gSegment.index = index + 1;
+}
+
+/******************************************************************************
+* \Syntax          : static void TRACE_PowerOnSave( void )
+* \Description     : Saves the firmware RAM as initialized by the host C
+                     runtime, before any firmware code ran.
+*******************************************************************************/
+static void TRACE_PowerOnSave(void)
+{
+    unsigned long data = (unsigned long)(__stop_vm_ram - __start_vm_ram);
+
+    gPowerOn = malloc(data + (unsigned long)(__stop_vm_zram - __start_vm_zram));
+    memcpy(gPowerOn, __start_vm_ram, data);
+    memcpy(gPowerOn + data, __start_vm_zram, (unsigned long)(__stop_vm_zram - __start_vm_zram));
+}
+
+/******************************************************************************
+* \Syntax          : static void TRACE_PowerOnLoad( void )
+* \Description     : Restores the firmware RAM saved by TRACE_PowerOnSave().
+*******************************************************************************/
+static void TRACE_PowerOnLoad(void)
+{
+    unsigned long data = (unsigned long)(__stop_vm_ram - __start_vm_ram);
+
+    memcpy(__start_vm_ram, gPowerOn, data);
+    memcpy(__start_vm_zram, gPowerOn + data, (unsigned long)(__stop_vm_zram - __start_vm_zram));
+}
+
+/******************************************************************************
+* \Syntax          : static int TRACE_Replay( const TRACE_t *trace,
+                                              TRACE_log_t *log,
+                                              unsigned long long *cycles )
+* \Description     : Replays a trace from the power-on reset into the output
+                     log, every power-on segment from the power-on image of
+                     the firmware RAM. Returns 0 if the trace ran to its END
+                     entry, cycles gets the virtual time of all the segments.
+*******************************************************************************/
+static int TRACE_Replay(const TRACE_t *trace, TRACE_log_t *log, unsigned long long *cycles)
+{
+    log->length = 0;
+    *cycles = 0;
+    memset(&gSegment, 0, sizeof(gSegment));
+    gSegment.buttons = 0xFF;
+    gSegment.status = TRACE_SEGMENT_POWER;
+
+    while(gSegment.status == TRACE_SEGMENT_POWER)
+    {
+        TRACE_PowerOnLoad();
+        TRACE_Segment(trace, log);
+        *cycles += gSegment.cycles;
+    }
+    return gSegment.status != TRACE_SEGMENT_END;
+}
+
+/******************************************************************************
+* \Syntax          : static int TRACE_Check( const TRACE_t *trace,
+                                             const TRACE_log_t *log )
+* \Description     : Compares the output log with the golden log, prints the
+                     first line that differs. Returns 0 if they match.
+*******************************************************************************/
+static int TRACE_Check(const TRACE_t *trace, const TRACE_log_t *log)
+{
+    const char *expected = trace->golden;
+    const char *got = log->text;
+    unsigned int line = 1;
+    size_t i = 0;
+
+    if(expected == NULL)
+    {
+        printf("%s: no golden log\n", trace->path);
+        return 1;
+    }
+    if((strlen(expected) == log->length) && (memcmp(expected, got, log->length) == 0))
+        return 0;
+
+    /* First line that differs */
+    while((i < log->length) && (expected[i] == got[i]))
+    {
+        if(got[i] == '\n')
+            line++;
+        i++;
+    }
+    while((i > 0) && (got[i - 1] != '\n'))
+        i--;
+    printf("%s:%u: expected \"%.*s\", got \"%.*s\"\n", trace->path, line,
+           (int)strcspn(expected + i, "\n"), expected + i,
+           (int)((i < log->length) ? strcspn(got + i, "\n") : 0), (i < log->length) ? got + i : "");
+    return 1;
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned long TRACE_Run( TRACE_t *traces,
+                                                     unsigned int count,
+                                                     unsigned long repeat,
+                                                     unsigned int job,
+                                                     unsigned int jobs,
+                                                     double *virtual_s )
+* \Description     : Replays the share of a job (replay i of every job with
+                     i % jobs == job) and checks the golden logs, returns the
+                     number of failed replays.
+*******************************************************************************/
+static unsigned long TRACE_Run(TRACE_t *traces, unsigned int count, unsigned long repeat, unsigned int job,
+                               unsigned int jobs, double *virtual_s)
+{
+    TRACE_log_t log = { 0 };
+    unsigned long failed = 0;
+    unsigned long long cycles;
+
+    *virtual_s = 0.0;
+    for(unsigned long i = job; i < repeat * count; i += jobs)
+    {
+        TRACE_t *trace = &traces[i % count];
+
+        if(TRACE_Replay(trace, &log, &cycles) != 0)
+        {
+            printf("%s: no END (timeout)\n", trace->path);
+            failed++;
+        }
+        else if(TRACE_Check(trace, &log) != 0)
+            failed++;
+        *virtual_s += SIM_MS(cycles) / 1000.0;
+    }
+    free(log.text);
+    return failed;
+}
+
+
+/**********************************************************************************************************************
+ *  MAIN
+ *********************************************************************************************************************/
+
+int main(int argc, char **argv)
+{
+    TRACE_t *traces;
+    TRACE_log_t log = { 0 };
+    unsigned long repeat = 1, failed = 0;
+    unsigned int jobs = 1, count = 0;
+    int golden = 0, print = 0;
+    double virtual_s = 0.0, wall_s;
+    struct timespec start, end;
+    int opt;
+
+    TRACE_PowerOnSave();
+    while((opt = getopt(argc, argv, "wpr:j:")) != -1)
+    {
+        switch(opt)
+        {
+            case 'w':
+                golden = 1;
+                break;
+            case 'p':
+                print = 1;
+                break;
+            case 'r':
+                repeat = strtoul(optarg, NULL, 10);
+                break;
+            case 'j':
+                jobs = (unsigned int)strtoul(optarg, NULL, 10);
+                break;
+            default:
+                fprintf(stderr, "usage: tracereplay [-w | -p] [-r repeat] [-j jobs] trace...\n");
+                return 2;
+        }
+    }
+    if((optind >= argc) || (repeat == 0) || (jobs == 0))
+    {
+        fprintf(stderr, "usage: tracereplay [-w | -p] [-r repeat] [-j jobs] trace...\n");
+        return 2;
+    }
+
+    traces = calloc((size_t)(argc - optind), sizeof(TRACE_t));
+    for(int i = optind; i < argc; i++)
+    {
+        char *golden = TRACE_GoldenPath(argv[i]);
+
+        if(TRACE_Load(&traces[count], argv[i]) != 0)
+            return 2;
+        traces[count].golden = TRACE_ReadFile(golden);
+        free(golden);
+        count++;
+    }
+
+    /* Golden logs written or output logs printed: one replay each */
+    if(golden || print)
+    {
+        for(unsigned int i = 0; i < count; i++)
+        {
+            char *path = TRACE_GoldenPath(traces[i].path);
+            FILE *out = stdout;
+            unsigned long long cycles;
+
+            failed += (TRACE_Replay(&traces[i], &log, &cycles) != 0);
+            if(golden && ((out = fopen(path, "w")) == NULL))
+            {
+                perror(path);
+                return 2;
+            }
+            fwrite(log.text, 1, log.length, out);
+            if(golden)
+            {
+                fclose(out);
+                printf("%s: %s\n", path, "written");
+            }
+            free(path);
+        }
+        return failed ? 1 : 0;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if(jobs == 1)
+    {
+        failed = TRACE_Run(traces, count, repeat, 0, 1, &virtual_s);
+    }
+    else
+    {
+        /* Each job sends its failed replays and its virtual time through a pipe */
+        int fds[2];
+
+        if(pipe(fds) != 0)
+        {
+            perror("tracereplay");
+            return 2;
+        }
+        for(unsigned int job = 0; job < jobs; job++)
+        {
+            if(fork() == 0)
+            {
+                struct { unsigned long failed; double virtual_s; } result;
+
+                close(fds[0]);
+                result.failed = TRACE_Run(traces, count, repeat, job, jobs, &result.virtual_s);
+                if(write(fds[1], &result, sizeof(result)) != sizeof(result))
+                    _exit(2);
+                _exit(0);
+            }
+        }
+        close(fds[1]);
+        for(unsigned int job = 0; job < jobs; job++)
+        {
+            struct { unsigned long failed; double virtual_s; } result;
+
+            if(read(fds[0], &result, sizeof(result)) != sizeof(result))
+            {
+                failed++;
+                continue;
+            }
+            failed += result.failed;
+            virtual_s += result.virtual_s;
+        }
+        while(wait(NULL) > 0)
+            ;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    wall_s = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    printf("traces          : %u, %lu replays in %u jobs, %lu failed\n", count, repeat * count, jobs, failed);
+    printf("virtual time    : %.3f s per replay (mean)\n", virtual_s / (repeat * count));
+    printf("wall time       : %.1f us per replay, %.0f replays/s, %.0fx real time\n",
+           1e6 * wall_s / (repeat * count), (repeat * count) / wall_s, virtual_s / wall_s);
+    printf("result          : %s\n", failed ? "FAILED" : "ok");
+    return failed ? 1 : 0;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: tracereplay.c
+ *********************************************************************************************************************/
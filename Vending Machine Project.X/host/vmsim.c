@@ -0,0 +1,168 @@
+/**********************************************************************************************************************
+ * Filename:    vmsim.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Runs a complete customer transaction through the unmodified firmware (VM_Init / VM_Running / myISR)
+ *              on the host simulator and reports the virtual timeline against the wall time.
+ *              Usage: vmsim [transactions]
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "SIM/SIM.h"
+#include "../source/VendingMachine/VM.h"
+#include "../source/ADC/ADC.h"
+#include "../source/LCD/LCD.h"
+#include "../source/Event/EVENT.h"
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Give up if a transaction takes longer than this (virtual ms) */
+#define     VMSIM_TIMEOUT_MS        60000
+
+/* Push buttons on PORTB */
+#define     VMSIM_SW0               0
+#define     VMSIM_SW1               1
+#define     VMSIM_SW2               2
+
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+/* Virtual time from the main loop seeing "Please Collect" to "Select Drink:" (next customer), includes the 5s
+   drink ready mode unless it blocks inside VM_Running (VM_USE_SCHEDULER = 0) */
+static unsigned long long gRestartCycles = 0;
+
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : static double VMSIM_WallUs( struct timespec *start )
+* \Description     : Wall time elapsed since start (us).
+*******************************************************************************/
+static double VMSIM_WallUs(const struct timespec *start)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start->tv_sec) * 1e6 + (end.tv_nsec - start->tv_nsec) / 1e3;
+}
+
+/******************************************************************************
+* \Syntax          : static int VMSIM_Transaction( unsigned char verbose )
+* \Description     : One customer: next drink (Lemonade 80p), select, insert
+                     50p + 50p and collect 20p change. Returns 0 on success.
+*******************************************************************************/
+static int VMSIM_Transaction(unsigned char verbose)
+{
+    const SIM_edge_t *edges;
+    unsigned int edge_count;
+    unsigned char dispensed = 0;
+    unsigned char change = 0;
+    unsigned long long collect = 0;
+
+    SIM_Reset();
+    SIM_LCD_Attach(SIM_PORTC, 0, 3, 4, 5, 6, 7);   /* Same wiring as VM_Init */
+    SIM_SetAnalog(ADC9, 0x100);                     /* Tilt sensor below 2V   */
+
+    SIM_PressButton(SIM_CYCLES_MS(100), VMSIM_SW0, 50);
+    SIM_PressButton(SIM_CYCLES_MS(300), VMSIM_SW1, 50);
+    SIM_PressButton(SIM_CYCLES_MS(500), VMSIM_SW2, 50);
+    SIM_PressButton(SIM_CYCLES_MS(700), VMSIM_SW2, 50);
+
+    VM_Init();
+    while(SIM_Now() < SIM_CYCLES_MS(VMSIM_TIMEOUT_MS))
+    {
+        VM_Running();
+        SIM_MainLoop();
+
+        edge_count = SIM_EdgeLog(&edges);
+        for(unsigned int i = 0; i < edge_count; i++)
+        {
+            if((edges[i].port == SIM_PORTA) && (edges[i].pin == 0) && !edges[i].level)
+                dispensed = 1;
+            if((edges[i].port == SIM_PORTA) && (edges[i].pin == 1) && !edges[i].level)
+                change = 1;
+        }
+        if((collect == 0) && SIM_LCD_RowStartsWith(0, "Please Collect"))
+            collect = SIM_Now();
+        if(dispensed && SIM_LCD_RowStartsWith(0, "Select Drink:"))
+            break;
+    }
+    gRestartCycles = (collect != 0) ? (SIM_Now() - collect) : 0;
+
+    if(verbose)
+    {
+        edge_count = SIM_EdgeLog(&edges);
+        for(unsigned int i = 0; i < edge_count; i++)
+            printf("  %10.3f ms  R%c%u -> %u\n", SIM_MS(edges[i].time),
+                   "ABC"[edges[i].port], edges[i].pin, edges[i].level);
+        printf("  LCD  |%s|\n", SIM_LCD_Row(0));
+        printf("       |%s|\n", SIM_LCD_Row(1));
+    }
+    return (dispensed && change && SIM_LCD_RowStartsWith(0, "Select Drink:")) ? 0 : 1;
+}
+
+
+/**********************************************************************************************************************
+ *  MAIN
+ *********************************************************************************************************************/
+
+int main(int argc, char **argv)
+{
+    unsigned long transactions = (argc > 1) ? strtoul(argv[1], NULL, 10) : 1;
+    const SIM_stats_t *stats = SIM_Stats();
+    struct timespec start;
+    double wall_us;
+    int failed = 0;
+
+    if(transactions == 0)
+        transactions = 1;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(unsigned long i = 0; i < transactions; i++)
+        failed |= VMSIM_Transaction(i == 0);
+    wall_us = VMSIM_WallUs(&start);
+
+    printf("transaction     : %s\n", failed ? "FAILED" : "ok");
+    printf("virtual time    : %.3f ms\n", SIM_MS(SIM_Now()));
+    printf("wall time       : %.1f us per transaction (%lu runs)\n", wall_us / transactions, transactions);
+    printf("speed-up        : %.0fx real time\n", (SIM_US(SIM_Now()) * transactions) / wall_us);
+    printf("collect->select : %.3f ms (5s drink ready mode + restart)\n", SIM_MS(gRestartCycles));
+    printf("SFR accesses    : %llu\n", stats->sfr_accesses);
+    printf("ISR calls       : %llu\n", stats->isr_calls);
+    printf("ISR time        : %.1f us worst case, %.1f us mean\n", SIM_US(stats->isr_max_cycles),
+           stats->isr_calls ? SIM_US(stats->isr_cycles) / stats->isr_calls : 0.0);
+    printf("delay cycles    : %llu\n", stats->delay_cycles);
+    printf("polling cycles  : %llu\n", stats->spin_cycles);
+    printf("idle cycles     : %llu\n", stats->idle_cycles);
+    printf("sleep           : %.1f %% of the time, %llu SLEEP, %llu watchdog wake-ups\n",
+           100.0 * stats->sleep_cycles / SIM_Now(), stats->sleeps, stats->wdt_wakes);
+    printf("LCD cmd / data  : %llu / %llu\n", stats->lcd_commands, stats->lcd_data);
+    printf("LCD busy errors : %llu\n", stats->lcd_violations);
+    printf("event queue     : %u / %u entries (high-water mark), %u dropped\n", EVENT_HighWater(),
+           EVENT_QUEUE_SIZE - 1, EVENT_Dropped());
+#if LCD_USE_QUEUE == 1
+    printf("LCD queue usage : %u / %u entries (high-water mark)\n", LCD_QueueHighWater(), LCD_QUEUE_SIZE - 1);
+#endif
+    return failed;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: vmsim.c
+ *********************************************************************************************************************/
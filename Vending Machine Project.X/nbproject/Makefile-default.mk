@@ -51,17 +51,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=main.c source/LCD/LCD.c source/DIO/DIO.c source/ADC/ADC.c source/VendingMachine/VM.c
+SOURCEFILES_QUOTED_IF_SPACED=main.c source/LCD/LCD.c source/DIO/DIO.c source/ADC/ADC.c source/VendingMachine/VM.c source/Scheduler/SCHED.c source/Filter/FILTER.c source/Event/EVENT.c source/Debounce/DEBOUNCE.c source/EEPROM/EEPROM.c source/Catalog/CATALOG.c source/Power/POWER.c source/Clock/CLOCK.c source/Profiler/PROF.c source/UART/UART.c source/Journal/JOURNAL.c source/Inventory/INVENTORY.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/main.p1 ${OBJECTDIR}/source/LCD/LCD.p1 ${OBJECTDIR}/source/DIO/DIO.p1 ${OBJECTDIR}/source/ADC/ADC.p1 ${OBJECTDIR}/source/VendingMachine/VM.p1
-POSSIBLE_DEPFILES=${OBJECTDIR}/main.p1.d ${OBJECTDIR}/source/LCD/LCD.p1.d ${OBJECTDIR}/source/DIO/DIO.p1.d ${OBJECTDIR}/source/ADC/ADC.p1.d ${OBJECTDIR}/source/VendingMachine/VM.p1.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/main.p1 ${OBJECTDIR}/source/LCD/LCD.p1 ${OBJECTDIR}/source/DIO/DIO.p1 ${OBJECTDIR}/source/ADC/ADC.p1 ${OBJECTDIR}/source/VendingMachine/VM.p1 ${OBJECTDIR}/source/Scheduler/SCHED.p1 ${OBJECTDIR}/source/Filter/FILTER.p1 ${OBJECTDIR}/source/Event/EVENT.p1 ${OBJECTDIR}/source/Debounce/DEBOUNCE.p1 ${OBJECTDIR}/source/EEPROM/EEPROM.p1 ${OBJECTDIR}/source/Catalog/CATALOG.p1 ${OBJECTDIR}/source/Power/POWER.p1 ${OBJECTDIR}/source/Clock/CLOCK.p1 ${OBJECTDIR}/source/Profiler/PROF.p1 ${OBJECTDIR}/source/UART/UART.p1 ${OBJECTDIR}/source/Journal/JOURNAL.p1 ${OBJECTDIR}/source/Inventory/INVENTORY.p1
+POSSIBLE_DEPFILES=${OBJECTDIR}/main.p1.d ${OBJECTDIR}/source/LCD/LCD.p1.d ${OBJECTDIR}/source/DIO/DIO.p1.d ${OBJECTDIR}/source/ADC/ADC.p1.d ${OBJECTDIR}/source/VendingMachine/VM.p1.d ${OBJECTDIR}/source/Scheduler/SCHED.p1.d ${OBJECTDIR}/source/Filter/FILTER.p1.d ${OBJECTDIR}/source/Event/EVENT.p1.d ${OBJECTDIR}/source/Debounce/DEBOUNCE.p1.d ${OBJECTDIR}/source/EEPROM/EEPROM.p1.d ${OBJECTDIR}/source/Catalog/CATALOG.p1.d ${OBJECTDIR}/source/Power/POWER.p1.d ${OBJECTDIR}/source/Clock/CLOCK.p1.d ${OBJECTDIR}/source/Profiler/PROF.p1.d ${OBJECTDIR}/source/UART/UART.p1.d ${OBJECTDIR}/source/Journal/JOURNAL.p1.d ${OBJECTDIR}/source/Inventory/INVENTORY.p1.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/main.p1 ${OBJECTDIR}/source/LCD/LCD.p1 ${OBJECTDIR}/source/DIO/DIO.p1 ${OBJECTDIR}/source/ADC/ADC.p1 ${OBJECTDIR}/source/VendingMachine/VM.p1
+OBJECTFILES=${OBJECTDIR}/main.p1 ${OBJECTDIR}/source/LCD/LCD.p1 ${OBJECTDIR}/source/DIO/DIO.p1 ${OBJECTDIR}/source/ADC/ADC.p1 ${OBJECTDIR}/source/VendingMachine/VM.p1 ${OBJECTDIR}/source/Scheduler/SCHED.p1 ${OBJECTDIR}/source/Filter/FILTER.p1 ${OBJECTDIR}/source/Event/EVENT.p1 ${OBJECTDIR}/source/Debounce/DEBOUNCE.p1 ${OBJECTDIR}/source/EEPROM/EEPROM.p1 ${OBJECTDIR}/source/Catalog/CATALOG.p1 ${OBJECTDIR}/source/Power/POWER.p1 ${OBJECTDIR}/source/Clock/CLOCK.p1 ${OBJECTDIR}/source/Profiler/PROF.p1 ${OBJECTDIR}/source/UART/UART.p1 ${OBJECTDIR}/source/Journal/JOURNAL.p1 ${OBJECTDIR}/source/Inventory/INVENTORY.p1
 
 # Source Files
-SOURCEFILES=main.c source/LCD/LCD.c source/DIO/DIO.c source/ADC/ADC.c source/VendingMachine/VM.c
+SOURCEFILES=main.c source/LCD/LCD.c source/DIO/DIO.c source/ADC/ADC.c source/VendingMachine/VM.c source/Scheduler/SCHED.c source/Filter/FILTER.c source/Event/EVENT.c source/Debounce/DEBOUNCE.c source/EEPROM/EEPROM.c source/Catalog/CATALOG.c source/Power/POWER.c source/Clock/CLOCK.c source/Profiler/PROF.c source/UART/UART.c source/Journal/JOURNAL.c source/Inventory/INVENTORY.c
 
 
 
@@ -120,6 +120,102 @@ ${OBJECTDIR}/source/ADC/ADC.p1: source/ADC/ADC.c  nbproject/Makefile-${CND_CONF}
 	@-${MV} ${OBJECTDIR}/source/ADC/ADC.d ${OBJECTDIR}/source/ADC/ADC.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/source/ADC/ADC.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/source/Scheduler/SCHED.p1: source/Scheduler/SCHED.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Scheduler" 
+	@${RM} ${OBJECTDIR}/source/Scheduler/SCHED.p1.d 
+	@${RM} ${OBJECTDIR}/source/Scheduler/SCHED.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Scheduler/SCHED.p1 source/Scheduler/SCHED.c 
+	@-${MV} ${OBJECTDIR}/source/Scheduler/SCHED.d ${OBJECTDIR}/source/Scheduler/SCHED.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Scheduler/SCHED.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/Inventory/INVENTORY.p1: source/Inventory/INVENTORY.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Inventory" 
+	@${RM} ${OBJECTDIR}/source/Inventory/INVENTORY.p1.d 
+	@${RM} ${OBJECTDIR}/source/Inventory/INVENTORY.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Inventory/INVENTORY.p1 source/Inventory/INVENTORY.c 
+	@-${MV} ${OBJECTDIR}/source/Inventory/INVENTORY.d ${OBJECTDIR}/source/Inventory/INVENTORY.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Inventory/INVENTORY.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/Journal/JOURNAL.p1: source/Journal/JOURNAL.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Journal" 
+	@${RM} ${OBJECTDIR}/source/Journal/JOURNAL.p1.d 
+	@${RM} ${OBJECTDIR}/source/Journal/JOURNAL.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Journal/JOURNAL.p1 source/Journal/JOURNAL.c 
+	@-${MV} ${OBJECTDIR}/source/Journal/JOURNAL.d ${OBJECTDIR}/source/Journal/JOURNAL.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Journal/JOURNAL.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/UART/UART.p1: source/UART/UART.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/UART" 
+	@${RM} ${OBJECTDIR}/source/UART/UART.p1.d 
+	@${RM} ${OBJECTDIR}/source/UART/UART.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/UART/UART.p1 source/UART/UART.c 
+	@-${MV} ${OBJECTDIR}/source/UART/UART.d ${OBJECTDIR}/source/UART/UART.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/UART/UART.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/Profiler/PROF.p1: source/Profiler/PROF.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Profiler" 
+	@${RM} ${OBJECTDIR}/source/Profiler/PROF.p1.d 
+	@${RM} ${OBJECTDIR}/source/Profiler/PROF.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Profiler/PROF.p1 source/Profiler/PROF.c 
+	@-${MV} ${OBJECTDIR}/source/Profiler/PROF.d ${OBJECTDIR}/source/Profiler/PROF.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Profiler/PROF.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/Clock/CLOCK.p1: source/Clock/CLOCK.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Clock" 
+	@${RM} ${OBJECTDIR}/source/Clock/CLOCK.p1.d 
+	@${RM} ${OBJECTDIR}/source/Clock/CLOCK.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Clock/CLOCK.p1 source/Clock/CLOCK.c 
+	@-${MV} ${OBJECTDIR}/source/Clock/CLOCK.d ${OBJECTDIR}/source/Clock/CLOCK.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Clock/CLOCK.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/Power/POWER.p1: source/Power/POWER.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Power" 
+	@${RM} ${OBJECTDIR}/source/Power/POWER.p1.d 
+	@${RM} ${OBJECTDIR}/source/Power/POWER.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Power/POWER.p1 source/Power/POWER.c 
+	@-${MV} ${OBJECTDIR}/source/Power/POWER.d ${OBJECTDIR}/source/Power/POWER.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Power/POWER.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/Catalog/CATALOG.p1: source/Catalog/CATALOG.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Catalog" 
+	@${RM} ${OBJECTDIR}/source/Catalog/CATALOG.p1.d 
+	@${RM} ${OBJECTDIR}/source/Catalog/CATALOG.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Catalog/CATALOG.p1 source/Catalog/CATALOG.c 
+	@-${MV} ${OBJECTDIR}/source/Catalog/CATALOG.d ${OBJECTDIR}/source/Catalog/CATALOG.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Catalog/CATALOG.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/EEPROM/EEPROM.p1: source/EEPROM/EEPROM.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/EEPROM" 
+	@${RM} ${OBJECTDIR}/source/EEPROM/EEPROM.p1.d 
+	@${RM} ${OBJECTDIR}/source/EEPROM/EEPROM.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/EEPROM/EEPROM.p1 source/EEPROM/EEPROM.c 
+	@-${MV} ${OBJECTDIR}/source/EEPROM/EEPROM.d ${OBJECTDIR}/source/EEPROM/EEPROM.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/EEPROM/EEPROM.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/Debounce/DEBOUNCE.p1: source/Debounce/DEBOUNCE.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Debounce" 
+	@${RM} ${OBJECTDIR}/source/Debounce/DEBOUNCE.p1.d 
+	@${RM} ${OBJECTDIR}/source/Debounce/DEBOUNCE.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Debounce/DEBOUNCE.p1 source/Debounce/DEBOUNCE.c 
+	@-${MV} ${OBJECTDIR}/source/Debounce/DEBOUNCE.d ${OBJECTDIR}/source/Debounce/DEBOUNCE.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Debounce/DEBOUNCE.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/Event/EVENT.p1: source/Event/EVENT.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Event" 
+	@${RM} ${OBJECTDIR}/source/Event/EVENT.p1.d 
+	@${RM} ${OBJECTDIR}/source/Event/EVENT.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Event/EVENT.p1 source/Event/EVENT.c 
+	@-${MV} ${OBJECTDIR}/source/Event/EVENT.d ${OBJECTDIR}/source/Event/EVENT.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Event/EVENT.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/Filter/FILTER.p1: source/Filter/FILTER.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Filter" 
+	@${RM} ${OBJECTDIR}/source/Filter/FILTER.p1.d 
+	@${RM} ${OBJECTDIR}/source/Filter/FILTER.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -mdebugger=none   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Filter/FILTER.p1 source/Filter/FILTER.c 
+	@-${MV} ${OBJECTDIR}/source/Filter/FILTER.d ${OBJECTDIR}/source/Filter/FILTER.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Filter/FILTER.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 ${OBJECTDIR}/source/VendingMachine/VM.p1: source/VendingMachine/VM.c  nbproject/Makefile-${CND_CONF}.mk 
 	@${MKDIR} "${OBJECTDIR}/source/VendingMachine" 
 	@${RM} ${OBJECTDIR}/source/VendingMachine/VM.p1.d 
@@ -161,6 +257,102 @@ ${OBJECTDIR}/source/ADC/ADC.p1: source/ADC/ADC.c  nbproject/Makefile-${CND_CONF}
 	@-${MV} ${OBJECTDIR}/source/ADC/ADC.d ${OBJECTDIR}/source/ADC/ADC.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/source/ADC/ADC.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/source/Scheduler/SCHED.p1: source/Scheduler/SCHED.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Scheduler" 
+	@${RM} ${OBJECTDIR}/source/Scheduler/SCHED.p1.d 
+	@${RM} ${OBJECTDIR}/source/Scheduler/SCHED.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Scheduler/SCHED.p1 source/Scheduler/SCHED.c 
+	@-${MV} ${OBJECTDIR}/source/Scheduler/SCHED.d ${OBJECTDIR}/source/Scheduler/SCHED.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Scheduler/SCHED.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/Inventory/INVENTORY.p1: source/Inventory/INVENTORY.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Inventory" 
+	@${RM} ${OBJECTDIR}/source/Inventory/INVENTORY.p1.d 
+	@${RM} ${OBJECTDIR}/source/Inventory/INVENTORY.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Inventory/INVENTORY.p1 source/Inventory/INVENTORY.c 
+	@-${MV} ${OBJECTDIR}/source/Inventory/INVENTORY.d ${OBJECTDIR}/source/Inventory/INVENTORY.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Inventory/INVENTORY.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/Journal/JOURNAL.p1: source/Journal/JOURNAL.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Journal" 
+	@${RM} ${OBJECTDIR}/source/Journal/JOURNAL.p1.d 
+	@${RM} ${OBJECTDIR}/source/Journal/JOURNAL.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Journal/JOURNAL.p1 source/Journal/JOURNAL.c 
+	@-${MV} ${OBJECTDIR}/source/Journal/JOURNAL.d ${OBJECTDIR}/source/Journal/JOURNAL.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Journal/JOURNAL.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/UART/UART.p1: source/UART/UART.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/UART" 
+	@${RM} ${OBJECTDIR}/source/UART/UART.p1.d 
+	@${RM} ${OBJECTDIR}/source/UART/UART.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/UART/UART.p1 source/UART/UART.c 
+	@-${MV} ${OBJECTDIR}/source/UART/UART.d ${OBJECTDIR}/source/UART/UART.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/UART/UART.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/Profiler/PROF.p1: source/Profiler/PROF.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Profiler" 
+	@${RM} ${OBJECTDIR}/source/Profiler/PROF.p1.d 
+	@${RM} ${OBJECTDIR}/source/Profiler/PROF.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Profiler/PROF.p1 source/Profiler/PROF.c 
+	@-${MV} ${OBJECTDIR}/source/Profiler/PROF.d ${OBJECTDIR}/source/Profiler/PROF.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Profiler/PROF.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/Clock/CLOCK.p1: source/Clock/CLOCK.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Clock" 
+	@${RM} ${OBJECTDIR}/source/Clock/CLOCK.p1.d 
+	@${RM} ${OBJECTDIR}/source/Clock/CLOCK.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Clock/CLOCK.p1 source/Clock/CLOCK.c 
+	@-${MV} ${OBJECTDIR}/source/Clock/CLOCK.d ${OBJECTDIR}/source/Clock/CLOCK.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Clock/CLOCK.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/Power/POWER.p1: source/Power/POWER.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Power" 
+	@${RM} ${OBJECTDIR}/source/Power/POWER.p1.d 
+	@${RM} ${OBJECTDIR}/source/Power/POWER.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Power/POWER.p1 source/Power/POWER.c 
+	@-${MV} ${OBJECTDIR}/source/Power/POWER.d ${OBJECTDIR}/source/Power/POWER.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Power/POWER.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/Catalog/CATALOG.p1: source/Catalog/CATALOG.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Catalog" 
+	@${RM} ${OBJECTDIR}/source/Catalog/CATALOG.p1.d 
+	@${RM} ${OBJECTDIR}/source/Catalog/CATALOG.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Catalog/CATALOG.p1 source/Catalog/CATALOG.c 
+	@-${MV} ${OBJECTDIR}/source/Catalog/CATALOG.d ${OBJECTDIR}/source/Catalog/CATALOG.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Catalog/CATALOG.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/EEPROM/EEPROM.p1: source/EEPROM/EEPROM.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/EEPROM" 
+	@${RM} ${OBJECTDIR}/source/EEPROM/EEPROM.p1.d 
+	@${RM} ${OBJECTDIR}/source/EEPROM/EEPROM.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/EEPROM/EEPROM.p1 source/EEPROM/EEPROM.c 
+	@-${MV} ${OBJECTDIR}/source/EEPROM/EEPROM.d ${OBJECTDIR}/source/EEPROM/EEPROM.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/EEPROM/EEPROM.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/Debounce/DEBOUNCE.p1: source/Debounce/DEBOUNCE.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Debounce" 
+	@${RM} ${OBJECTDIR}/source/Debounce/DEBOUNCE.p1.d 
+	@${RM} ${OBJECTDIR}/source/Debounce/DEBOUNCE.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Debounce/DEBOUNCE.p1 source/Debounce/DEBOUNCE.c 
+	@-${MV} ${OBJECTDIR}/source/Debounce/DEBOUNCE.d ${OBJECTDIR}/source/Debounce/DEBOUNCE.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Debounce/DEBOUNCE.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/Event/EVENT.p1: source/Event/EVENT.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Event" 
+	@${RM} ${OBJECTDIR}/source/Event/EVENT.p1.d 
+	@${RM} ${OBJECTDIR}/source/Event/EVENT.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Event/EVENT.p1 source/Event/EVENT.c 
+	@-${MV} ${OBJECTDIR}/source/Event/EVENT.d ${OBJECTDIR}/source/Event/EVENT.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Event/EVENT.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/source/Filter/FILTER.p1: source/Filter/FILTER.c  nbproject/Makefile-${CND_CONF}.mk 
+	@${MKDIR} "${OBJECTDIR}/source/Filter" 
+	@${RM} ${OBJECTDIR}/source/Filter/FILTER.p1.d 
+	@${RM} ${OBJECTDIR}/source/Filter/FILTER.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c   -mdfp="${DFP_DIR}/xc8"  -fshort-double -fshort-float -O2 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx32 -Wl,--data-init -mno-keep-startup -mno-osccal -mno-resetbits -mno-save-resetbits -mno-download -mno-stackcall -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto     -o ${OBJECTDIR}/source/Filter/FILTER.p1 source/Filter/FILTER.c 
+	@-${MV} ${OBJECTDIR}/source/Filter/FILTER.d ${OBJECTDIR}/source/Filter/FILTER.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/source/Filter/FILTER.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 ${OBJECTDIR}/source/VendingMachine/VM.p1: source/VendingMachine/VM.c  nbproject/Makefile-${CND_CONF}.mk 
 	@${MKDIR} "${OBJECTDIR}/source/VendingMachine" 
 	@${RM} ${OBJECTDIR}/source/VendingMachine/VM.p1.d 
@@ -14,6 +14,23 @@
 
 #include <xc.h>
 #include "ADC.h"
+#include "ADC_prv.h"
+#include "../Clock/CLOCK.h"
+
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+static unsigned char gChannel = ADC_NO_CHANNEL;                             /* Channel connected to the ADC */
+static unsigned int gAnalog = 0;                                            /* Channels set analog (bit n)  */
+
+#if ADC_USE_SAMPLER == 1
+static const ADC_channel_t *gSamplerChannels;                               /* Channels sampled round-robin */
+static unsigned char gSamplerCount = 0;                                     /* Number of channels           */
+static unsigned char gSamplerIndex = 0;                                     /* Channel being converted      */
+static volatile unsigned int gSamplerResult[ADC_SAMPLER_MAX_CHANNELS];      /* Latest value cache           */
+#endif
 
 /**********************************************************************************************************************
  *  FUNCTIONS
@@ -37,6 +54,10 @@ void ADC_Init( )
 #endif
     /* Enable ADC */
     ADCON0 |= 0x01;
+
+    /* Nothing selected yet: the first read sets the channel up */
+    gChannel = ADC_NO_CHANNEL;
+    gAnalog = 0;
 }
 
 /******************************************************************************
@@ -47,31 +68,124 @@ unsigned int ADC_Read(ADC_channel_t channel)
 {
     unsigned int result;        /* Variable to store the result */
     
-    /* Enable analog input for this channel */
-    if(channel < 5)     /* Channel is in PORTA */
-    {
-        ANSEL |= (1 << channel);
-        /* Choose channel */
-        ADCON0 |= (channel << 2);
-    }
-    else                /* Channel is in PORTB */
-    {
-        /* Enable Analog Input for the corresponding pin in PORTB */
-            ANSELH |= ( 1<< (channel-8) );
-            /* Choose channel */
-            ADCON0 |= (channel << 2);
-    }
+    /* Connect the channel, the hold capacitor must charge after a switch */
+    if(ADC_SelectChannel(channel))
+        CLOCK_DELAY_US(ADC_ACQUISITION_TIME_US);     /* Crystal or internal oscillator */
     ADCON0bits.GO = 1;          /* Set GO Bit to start conversion */
     while(ADCON0bits.GO==1);    /* Wait for GO bit to clear=conversion complete */
     
-#if     ADC_RESOLUTION_10_BIT == 1
-    result =(ADRESH<<8)+ADRESL; /* Combine to produce final 10 bit result */
-#elif   ADC_RESOLUTION_10_BIT == 0
-    result = ADRESH;             /* 8-bit result */
-#endif
+    result = ADC_RESULT();
     return result;
 }
 
+/******************************************************************************
+* \Syntax          : static unsigned char ADC_SelectChannel( ADC_channel_t channel )
+* \Description     : Private function that makes the channel pin analog and
+                     connects it to the ADC, the registers are only written if
+                     the channel changes. Returns 1 on a switch [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char ADC_SelectChannel(ADC_channel_t channel)
+{
+    if(channel == gChannel)                     /* Already connected */
+        return 0;
+
+    /* Enable analog input for this channel (once) */
+    if(!(gAnalog & (1U << channel)))
+    {
+        if(channel < ADC_FIRST_ANSELH_CHANNEL)      /* Channel is in PORTA */
+            ANSEL |= (1 << channel);
+        else                                        /* Channel is in PORTB */
+            ANSELH |= (1 << (channel - ADC_FIRST_ANSELH_CHANNEL));
+        gAnalog |= (1U << channel);
+    }
+    /* Choose channel (previous channel bits cleared) */
+    ADCON0 = (ADCON0 & ~ADC_CHS_MASK) | (channel << ADC_CHS_SHIFT);
+    gChannel = channel;
+    return 1;
+}
+
+#if ADC_USE_SAMPLER == 1
+/******************************************************************************
+* \Syntax          : void ADC_SamplerInit( const ADC_channel_t *channels, count )
+* \Description     : Sets up the round-robin sampling of count channels (up to
+                     ADC_SAMPLER_MAX_CHANNELS) and enables the ADC interrupt.
+                     ADC_Read() must not be used while the sampler runs.
+*******************************************************************************/
+void ADC_SamplerInit(const ADC_channel_t *channels, unsigned char count)
+{
+    PIE1bits.ADIE = 0;          /* Disable ADC Interrupt */
+    if(count > ADC_SAMPLER_MAX_CHANNELS)
+        count = ADC_SAMPLER_MAX_CHANNELS;
+    gSamplerChannels = channels;
+    gSamplerCount = count;
+    gSamplerIndex = 0;
+    for(unsigned char i = 0 ; i < count ; i++)
+        gSamplerResult[i] = 0;
+
+    /* First channel connected now, acquisition time until the first start */
+    ADC_SelectChannel(channels[0]);
+    PIR1bits.ADIF = 0;          /* Clear ADC Flag        */
+    PIE1bits.ADIE = 1;          /* Enable ADC Interrupt  */
+}
+
+/******************************************************************************
+* \Syntax          : void ADC_SamplerStart( void )
+* \Description     : Starts the conversion of the current channel, never waits
+                     (ignored while a conversion is running)
+                     [CALLED FROM THE TIMER INTERRUPT].
+*******************************************************************************/
+void ADC_SamplerStart(void)
+{
+    if((gSamplerCount != 0) && !ADCON0bits.GO)
+        ADCON0bits.GO = 1;      /* Set GO Bit to start conversion */
+}
+
+/******************************************************************************
+* \Syntax          : void ADC_SamplerComplete( void )
+* \Description     : Stores the result of the current channel and selects the
+                     next one, its acquisition time elapses until the next start
+                     [CALLED FROM THE ADC INTERRUPT].
+*******************************************************************************/
+void ADC_SamplerComplete(void)
+{
+    gSamplerResult[gSamplerIndex] = ADC_RESULT();
+
+    if(gSamplerCount > 1)
+    {
+        if(++gSamplerIndex == gSamplerCount)
+            gSamplerIndex = 0;
+        ADC_SelectChannel(gSamplerChannels[gSamplerIndex]);
+    }
+}
+
+/******************************************************************************
+* \Syntax          : unsigned int ADC_Latest( unsigned char index )
+* \Description     : Returns the latest result of the channel at the given index
+                     of the sampler channel list.
+*******************************************************************************/
+unsigned int ADC_Latest(unsigned char index)
+{
+    unsigned int value;
+
+    /* The 16-bit result is written by the ISR: read until both bytes are consistent */
+    do
+    {
+        value = gSamplerResult[index];
+    } while(value != gSamplerResult[index]);
+    return value;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char ADC_SamplerBusy( void )
+* \Description     : Returns 1 while a conversion started by ADC_SamplerStart()
+                     runs (the conversion is aborted in sleep mode).
+*******************************************************************************/
+unsigned char ADC_SamplerBusy(void)
+{
+    return ADCON0bits.GO;
+}
+#endif
+
 
 /**********************************************************************************************************************
  *  END OF FILE: ADC.c
@@ -7,6 +7,8 @@
  * Description: Contains the declaration of ADC APIs and essential MACROS for using the ADC peripheral.
  * NOTE:        The ADC corresponds to PORTA starting from RA0 : RA5.
  * NOTE:        This file contains configuration for ADC (such using 8-bit or 10-bit value, adc clk frequency, etc.)
+ * NOTE:        The selected channel and its analog input are remembered, ADC_Init() must be called again if another
+ *              module writes ADCON0 channel bits or makes the pin digital.
  * 
 *********************************************************************************************************************/
 
@@ -32,6 +34,24 @@
 */
 #define     ADC_CLK_FREQ            1
 
+/* Choose the conversion mode used by the application:
+    1      -->      Sampler: conversions started from a timer tick, results collected by the ADC interrupt (ADIF),
+                    6 bytes of RAM. Host only: the PIC16F882 image has no flash to spare for it (a PIC16F886 has)
+    0      -->      Blocking: ADC_Read() waits for the GO bit (PIC16F882 build)
+*/
+#ifndef ADC_USE_SAMPLER
+#define     ADC_USE_SAMPLER         0
+#endif
+
+#if defined(_16F882) && (ADC_USE_SAMPLER == 1)
+#error "ADC: the sampler does not fit in the PIC16F882 (build it on the host or for the PIC16F886)"
+#endif
+
+/* Maximum number of channels sampled round-robin (one result cache entry each) */
+#ifndef ADC_SAMPLER_MAX_CHANNELS
+#define     ADC_SAMPLER_MAX_CHANNELS    1
+#endif
+
 
 /**********************************************************************************************************************
  *  GLOBAL DATA TYPES AND STRUCTURES
@@ -70,5 +90,45 @@ void ADC_Init();
 *******************************************************************************/
 unsigned int ADC_Read(ADC_channel_t channel);
 
+#if ADC_USE_SAMPLER == 1
+/******************************************************************************
+* \Syntax          : void ADC_SamplerInit( const ADC_channel_t *channels, count )
+* \Description     : Sets up the round-robin sampling of count channels (up to
+                     ADC_SAMPLER_MAX_CHANNELS) and enables the ADC interrupt.
+                     ADC_Read() must not be used while the sampler runs.
+*******************************************************************************/
+void ADC_SamplerInit(const ADC_channel_t *channels, unsigned char count);
+
+/******************************************************************************
+* \Syntax          : void ADC_SamplerStart( void )
+* \Description     : Starts the conversion of the current channel, never waits
+                     (ignored while a conversion is running)
+                     [CALLED FROM THE TIMER INTERRUPT].
+*******************************************************************************/
+void ADC_SamplerStart(void);
+
+/******************************************************************************
+* \Syntax          : void ADC_SamplerComplete( void )
+* \Description     : Stores the result of the current channel and selects the
+                     next one, its acquisition time elapses until the next start
+                     [CALLED FROM THE ADC INTERRUPT].
+*******************************************************************************/
+void ADC_SamplerComplete(void);
+
+/******************************************************************************
+* \Syntax          : unsigned int ADC_Latest( unsigned char index )
+* \Description     : Returns the latest result of the channel at the given index
+                     of the sampler channel list.
+*******************************************************************************/
+unsigned int ADC_Latest(unsigned char index);
+
+/******************************************************************************
+* \Syntax          : unsigned char ADC_SamplerBusy( void )
+* \Description     : Returns 1 while a conversion started by ADC_SamplerStart()
+                     runs (the conversion is aborted in sleep mode).
+*******************************************************************************/
+unsigned char ADC_SamplerBusy(void);
+#endif
+
 
 #endif /* ADC_H */
\ No newline at end of file
@@ -0,0 +1,53 @@
+/**********************************************************************************************************************
+ * Filename:    ADC_prv.h
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the private declaration of ADC APIs and private MACROs, which are used internally
+ * 
+*********************************************************************************************************************/
+
+#ifndef  ADC_PRV_H
+#define  ADC_PRV_H
+
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* ADCON0 channel select bits (CHS3:CHS0) */
+#define     ADC_CHS_MASK            0x3C
+#define     ADC_CHS_SHIFT           2
+
+/* First channel of PORTB (AN8 --> ANSELH bit 0) */
+#define     ADC_FIRST_ANSELH_CHANNEL    8
+
+/* No channel selected yet */
+#define     ADC_NO_CHANNEL          0xFF
+
+/* Acquisition time after a channel switch (TACQ = 11.5us at 50C, datasheet) */
+#define     ADC_ACQUISITION_TIME_US     12
+
+/* Conversion result */
+#if     ADC_RESOLUTION_10_BIT == 1
+#define     ADC_RESULT()            ((ADRESH<<8)+ADRESL)    /* Combine to produce final 10 bit result */
+#elif   ADC_RESOLUTION_10_BIT == 0
+#define     ADC_RESULT()            (ADRESH)                /* 8-bit result */
+#endif
+
+
+/**********************************************************************************************************************
+ *  PRIVATE FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : static unsigned char ADC_SelectChannel( ADC_channel_t channel )
+* \Description     : Private function that makes the channel pin analog and
+                     connects it to the ADC, the registers are only written if
+                     the channel changes. Returns 1 on a switch [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char ADC_SelectChannel(ADC_channel_t channel);
+
+
+#endif /* ADC_PRV_H */
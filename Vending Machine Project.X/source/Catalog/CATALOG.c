@@ -0,0 +1,135 @@
+/**********************************************************************************************************************
+ * Filename:    CATALOG.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the implementation of the drink catalog (EEPROM storage, RAM cache of the prices and slots)
+ *              and the catalog programmed with the firmware.
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <xc.h>
+
+#include "CATALOG.h"
+#include "CATALOG_prv.h"
+#include "../EEPROM/EEPROM.h"
+
+#if CATALOG_EEPROM_BASE + CATALOG_HEADER_SIZE + CATALOG_MAX_PRODUCTS * CATALOG_RECORD_SIZE != CATALOG_EEPROM_SIZE
+#error "CATALOG: CATALOG_EEPROM_SIZE does not match the EEPROM layout"
+#endif
+
+#if CATALOG_EEPROM_SIZE > EEPROM_SIZE
+#error "CATALOG: the catalog does not fit in the EEPROM"
+#endif
+
+
+/**********************************************************************************************************************
+ *  EEPROM DATA
+ *********************************************************************************************************************/
+
+/* Catalog programmed with the firmware: magic, 4 products { packed slot/price, name }, all dispensed by slot 0 (RA0),
+   then 0xFF (erased EEPROM: end of the catalog, room for 4 more products before the counters of the inventory).
+   Products are added or repriced by rewriting the EEPROM, the code does not change. */
+__EEPROM_DATA(CATALOG_MAGIC, 4, CATALOG_PACK(0, 8), 'C', 'o', 'l', 'a', 0);
+__EEPROM_DATA(0, 0, 0, CATALOG_PACK(0, 8), 'L', 'e', 'm', 'o');
+__EEPROM_DATA('n', 'a', 'd', 'e', CATALOG_PACK(0, 6), 'O', 'r', 'a');
+__EEPROM_DATA('n', 'g', 'e', 0, 0, CATALOG_PACK(0, 5), 'W', 'a');
+__EEPROM_DATA('t', 'e', 'r', 0, 0, 0, 0xFF, 0xFF);
+
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+static unsigned char gProducts[CATALOG_MAX_PRODUCTS];      /* Packed slot/price of every product */
+static unsigned char gCount = 0;                            /* Number of products                 */
+
+
+/**********************************************************************************************************************
+ *  FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : unsigned char CATALOG_Init( void )
+* \Description     : Loads the prices and slots from the EEPROM into the RAM
+                     cache and returns the number of products (0 if the
+                     EEPROM holds no valid catalog), the catalog ends at the
+                     first product with an invalid price or slot.
+*******************************************************************************/
+unsigned char CATALOG_Init(void)
+{
+    unsigned char count;
+    unsigned char packed;
+
+    gCount = 0;
+    if(EEPROM_Read(CATALOG_EEPROM_BASE) != CATALOG_MAGIC)
+        return 0;                               /* Erased or not a catalog */
+    count = EEPROM_Read(CATALOG_EEPROM_BASE + 1);
+    if(count > CATALOG_MAX_PRODUCTS)
+        count = CATALOG_MAX_PRODUCTS;
+
+    /* The catalog ends at the first product without a valid price or a dispenser wired to its slot */
+    while(gCount < count)
+    {
+        packed = EEPROM_Read(CATALOG_RECORD(gCount));
+        if((CATALOG_PRICE(packed) == 0) || (CATALOG_PRICE(packed) > CATALOG_MAX_PRICE))
+            break;
+        if(!((CATALOG_SLOTS >> CATALOG_SLOT(packed)) & 1))
+            break;
+        gProducts[gCount++] = packed;
+    }
+    return gCount;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char CATALOG_Count( void )
+* \Description     : Returns the number of products.
+*******************************************************************************/
+unsigned char CATALOG_Count(void)
+{
+    return gCount;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char CATALOG_Price( unsigned char index )
+* \Description     : Returns the price of a product (x10p, index must be
+                     below CATALOG_Count()).
+*******************************************************************************/
+unsigned char CATALOG_Price(unsigned char index)
+{
+    return CATALOG_PRICE(gProducts[index]);
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char CATALOG_Slot( unsigned char index )
+* \Description     : Returns the dispenser slot of a product (index must be
+                     below CATALOG_Count()).
+*******************************************************************************/
+unsigned char CATALOG_Slot(unsigned char index)
+{
+    return CATALOG_SLOT(gProducts[index]);
+}
+
+/******************************************************************************
+* \Syntax          : void CATALOG_Name( unsigned char index, char *name )
+* \Description     : Copies the name of a product from the EEPROM into name
+                     (CATALOG_NAME_LENGTH + 1 characters, '\0' terminated).
+*******************************************************************************/
+void CATALOG_Name(unsigned char index, char *name)
+{
+    unsigned char address = CATALOG_RECORD(index) + 1;
+
+    for(unsigned char i = 0; i < CATALOG_NAME_LENGTH; i++)
+        name[i] = (char)EEPROM_Read(address + i);
+    name[CATALOG_NAME_LENGTH] = '\0';
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: CATALOG.c
+ *********************************************************************************************************************/
@@ -0,0 +1,97 @@
+/**********************************************************************************************************************
+ * Filename:    CATALOG.h
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the declaration of the drink catalog APIs and essential MACROS. The catalog is stored in the
+ *              data EEPROM (name, price and dispenser slot of every product) and the prices and slots are cached in
+ *              RAM at boot, one packed byte per product.
+ * NOTE:        The names stay in the EEPROM (RAM is 128 bytes), CATALOG_Name() reads them when they are displayed.
+ *
+*********************************************************************************************************************/
+
+#ifndef CATALOG_H
+#define CATALOG_H
+
+
+/**********************************************************************************************************************
+ *  Configuration
+ *********************************************************************************************************************/
+
+/* Maximum number of products (one byte of RAM and 9 bytes of EEPROM each, 2.5 more bytes of RAM with the inventory) */
+#ifndef CATALOG_MAX_PRODUCTS
+#define     CATALOG_MAX_PRODUCTS    8
+#endif
+
+#if (CATALOG_MAX_PRODUCTS < 1) || (CATALOG_MAX_PRODUCTS > 14)
+#error "CATALOG: CATALOG_MAX_PRODUCTS must be 1 to 14 (128 bytes of EEPROM)"
+#endif
+
+/* Dispenser slots wired on the board (bit n = slot n = RAn): RA0, RA3, RA4 and RA5. RA1 and RA2 drive the change
+   LED and the alarm buzzer, RA6/RA7 the crystal, slots 8 to 15 do not exist: a product on another slot ends the
+   catalog like an invalid price */
+#ifndef CATALOG_SLOTS
+#define     CATALOG_SLOTS           0x39
+#endif
+
+
+/**********************************************************************************************************************
+ *  GLOBAL CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Characters of a product name (padded with '\0') */
+#define     CATALOG_NAME_LENGTH     8
+
+/* Highest price (x10p, one digit on the LCD) */
+#define     CATALOG_MAX_PRICE       9
+
+/* EEPROM bytes taken by the catalog from address 0 (header and CATALOG_MAX_PRODUCTS records), free after */
+#define     CATALOG_EEPROM_SIZE     (2 + CATALOG_MAX_PRODUCTS * (1 + CATALOG_NAME_LENGTH))
+
+/* Packed product byte: dispenser slot (high nibble) and price x10p (low nibble) */
+#define     CATALOG_PACK(slot, price)   ((unsigned char)(((slot) << 4) | ((price) & 0x0F)))
+
+
+/**********************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : unsigned char CATALOG_Init( void )
+* \Description     : Loads the prices and slots from the EEPROM into the RAM
+                     cache and returns the number of products (0 if the
+                     EEPROM holds no valid catalog), the catalog ends at the
+                     first product with an invalid price or slot.
+*******************************************************************************/
+unsigned char CATALOG_Init(void);
+
+/******************************************************************************
+* \Syntax          : unsigned char CATALOG_Count( void )
+* \Description     : Returns the number of products.
+*******************************************************************************/
+unsigned char CATALOG_Count(void);
+
+/******************************************************************************
+* \Syntax          : unsigned char CATALOG_Price( unsigned char index )
+* \Description     : Returns the price of a product (x10p, index must be
+                     below CATALOG_Count()).
+*******************************************************************************/
+unsigned char CATALOG_Price(unsigned char index);
+
+/******************************************************************************
+* \Syntax          : unsigned char CATALOG_Slot( unsigned char index )
+* \Description     : Returns the dispenser slot of a product (index must be
+                     below CATALOG_Count()).
+*******************************************************************************/
+unsigned char CATALOG_Slot(unsigned char index);
+
+/******************************************************************************
+* \Syntax          : void CATALOG_Name( unsigned char index, char *name )
+* \Description     : Copies the name of a product from the EEPROM into name
+                     (CATALOG_NAME_LENGTH + 1 characters, '\0' terminated).
+*******************************************************************************/
+void CATALOG_Name(unsigned char index, char *name);
+
+
+#endif /* CATALOG_H */
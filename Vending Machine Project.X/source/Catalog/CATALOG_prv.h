@@ -0,0 +1,39 @@
+/**********************************************************************************************************************
+ * Filename:    CATALOG_prv.h
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the private MACROs of the drink catalog (EEPROM layout), which are used internally
+ *
+*********************************************************************************************************************/
+
+#ifndef  CATALOG_PRV_H
+#define  CATALOG_PRV_H
+
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* EEPROM layout (__EEPROM_DATA programs the EEPROM from address 0):
+    [0]                 CATALOG_MAGIC
+    [1]                 number of products
+    [2 + 9 * i]         packed byte of product i (CATALOG_PACK)
+    [3 + 9 * i] ...     name of product i (CATALOG_NAME_LENGTH characters)
+*/
+#define     CATALOG_EEPROM_BASE     0
+#define     CATALOG_MAGIC           0xCA
+#define     CATALOG_HEADER_SIZE     2
+#define     CATALOG_RECORD_SIZE     (1 + CATALOG_NAME_LENGTH)
+
+/* EEPROM address of the packed byte of a product (the name follows) */
+#define     CATALOG_RECORD(index)   ((unsigned char)(CATALOG_EEPROM_BASE + CATALOG_HEADER_SIZE + \
+                                                     (index) * CATALOG_RECORD_SIZE))
+
+/* Packed product byte */
+#define     CATALOG_PRICE(packed)   ((packed) & 0x0F)
+#define     CATALOG_SLOT(packed)    ((packed) >> 4)
+
+
+#endif  /* CATALOG_PRV_H */
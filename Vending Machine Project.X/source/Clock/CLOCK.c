@@ -0,0 +1,104 @@
+/**********************************************************************************************************************
+ * Filename:    CLOCK.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the implementation of the clock management APIs (crystal / internal oscillator switch).
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <xc.h>
+
+#include "CLOCK.h"
+#include "../UART/UART.h"
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+static unsigned char gClock = CLOCK_FULL;          /* Current operating point */
+
+/**********************************************************************************************************************
+ *  FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void CLOCK_Init( void )
+* \Description     : Selects the idle frequency and runs the device on the
+                     crystal (full speed).
+*******************************************************************************/
+void CLOCK_Init(void)
+{
+    OSCCONbits.IRCF = CLOCK_IDLE_IRCF;      /* Internal oscillator frequency */
+    OSCCONbits.SCS = 0;                     /* Crystal (FOSC = HS)           */
+    while(!OSCCONbits.OSTS);
+    gClock = CLOCK_FULL;
+}
+
+/******************************************************************************
+* \Syntax          : void CLOCK_Set( unsigned char point )
+* \Description     : Switches to an operating point (CLOCK_FULL / CLOCK_IDLE)
+                     and reloads the Timer2 prescaler, the ADC clock and the
+                     EUSART baud rate generator [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+void CLOCK_Set(unsigned char point)
+{
+    unsigned char gie;
+    unsigned char txie;
+
+    if(point == gClock)
+        return;
+
+    /* A character must not change its baud rate: the transmitter is drained, the other interrupts still run */
+    txie = PIE1bits.TXIE;
+    PIE1bits.TXIE = 0;
+    if(TXSTAbits.TXEN)
+        while(!TXSTAbits.TRMT);
+
+    /* TAD must not change during a conversion, the ISR must not run between the clock and the prescaler */
+    gie = INTCONbits.GIE;
+    INTCONbits.GIE = 0;
+    while(ADCON0bits.GO);
+
+    if(point == CLOCK_IDLE)
+    {
+        OSCCONbits.SCS = 1;                             /* Internal oscillator at once, the crystal stops */
+        T2CONbits.T2CKPS = CLOCK_T2CKPS(CLOCK_IDLE_HZ);
+        ADCON0bits.ADCS = CLOCK_ADCS(CLOCK_IDLE_HZ);
+        SPBRGH = (unsigned char)(UART_SPBRG(CLOCK_IDLE_HZ) >> 8);
+        SPBRG = (unsigned char)UART_SPBRG(CLOCK_IDLE_HZ);
+    }
+    else
+    {
+        OSCCONbits.SCS = 0;                             /* Crystal after its start-up timer */
+        while(!OSCCONbits.OSTS);
+        T2CONbits.T2CKPS = CLOCK_T2CKPS(CLOCK_FULL_HZ);
+        ADCON0bits.ADCS = CLOCK_ADCS(CLOCK_FULL_HZ);
+        SPBRGH = (unsigned char)(UART_SPBRG(CLOCK_FULL_HZ) >> 8);
+        SPBRG = (unsigned char)UART_SPBRG(CLOCK_FULL_HZ);
+    }
+    gClock = point;
+
+    if(gie)
+        INTCONbits.GIE = 1;
+    PIE1bits.TXIE = txie;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char CLOCK_Get( void )
+* \Description     : Returns the current operating point.
+*******************************************************************************/
+unsigned char CLOCK_Get(void)
+{
+    return gClock;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: CLOCK.c
+ *********************************************************************************************************************/
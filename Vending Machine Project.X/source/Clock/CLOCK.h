@@ -0,0 +1,105 @@
+/**********************************************************************************************************************
+ * Filename:    CLOCK.h
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the declaration of the clock management APIs (two operating points: the HS crystal and the
+ *              internal oscillator selected by OSCCON) and the compile time settings of every operating point.
+ * NOTE:        The Timer2 prescaler, the ADC clock and the EUSART baud rate generator are changed with the system
+ *              clock, so the Timer2 tick and the baud rate keep their period. A T2CON write clears the Timer2
+ *              prescaler and postscaler: the tick running at a switch restarts.
+ * NOTE:        The crystal stops on the internal oscillator, it runs the device again after its start-up timer
+ *              (1024 Tosc), CLOCK_Set() waits for it.
+ *
+*********************************************************************************************************************/
+
+#ifndef CLOCK_H
+#define CLOCK_H
+
+
+/**********************************************************************************************************************
+ *  Configuration
+ *********************************************************************************************************************/
+
+/* HS crystal (_XTAL_FREQ, full speed) */
+#ifndef CLOCK_FULL_HZ
+#define     CLOCK_FULL_HZ           4000000UL
+#endif
+
+/* Internal oscillator of the idle operating point (OSCCON IRCF), the Timer2 tick must fit its prescaler:
+    6      -->      4 MHz      (Timer2 prescaler 1:16)
+    4      -->      1 MHz      (Timer2 prescaler 1:4)
+    2      -->      250 kHz    (Timer2 prescaler 1:1)
+*/
+#ifndef CLOCK_IDLE_IRCF
+#define     CLOCK_IDLE_IRCF         4
+#endif
+
+/* Timer2 prescaler of the tick at full speed */
+#define     CLOCK_T2_PRESCALER      16
+
+
+/**********************************************************************************************************************
+ *  GLOBAL CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Operating points */
+#define     CLOCK_FULL              0       /* HS crystal                       */
+#define     CLOCK_IDLE              1       /* Internal oscillator (IRCF)       */
+
+/* Frequency of the idle operating point (HFINTOSC 125 kHz .. 8 MHz) */
+#define     CLOCK_IDLE_HZ           (62500UL << CLOCK_IDLE_IRCF)
+
+/* Timer2 prescaler bits (T2CKPS) that keep the tick period at a clock frequency */
+#define     CLOCK_T2_DIVIDER(hz)    ((CLOCK_T2_PRESCALER * (hz)) / CLOCK_FULL_HZ)
+#define     CLOCK_T2CKPS(hz)        ((CLOCK_T2_DIVIDER(hz) == 16) ? 2 : ((CLOCK_T2_DIVIDER(hz) == 4) ? 1 : 0))
+
+/* ADC clock bits (ADCS) at a clock frequency: TAD within 1.6us .. 9us (Fosc/2, /8, /32, else Frc) */
+#define     CLOCK_ADCS(hz)          (((hz) < 250000UL) ? 3 : (((hz) <= 1250000UL) ? 0 : (((hz) <= 5000000UL) ? 1 : 2)))
+
+/* Instruction cycles of a delay at a clock frequency (rounded up) */
+#define     CLOCK_CYCLES_US(hz, us) ((((unsigned long)(us) * ((hz) / 4000UL)) + 999UL) / 1000UL)
+
+/* Busy-wait of us microseconds on the current operating point (__delay_us only holds for the crystal) */
+#define     CLOCK_DELAY_US(us)      do { if(OSCCONbits.SCS) _delay(CLOCK_CYCLES_US(CLOCK_IDLE_HZ, us));         \
+                                         else _delay(CLOCK_CYCLES_US(CLOCK_FULL_HZ, us)); } while(0)
+
+#if (CLOCK_IDLE_IRCF < 1) || (CLOCK_IDLE_IRCF > 6) || \
+    (CLOCK_T2_DIVIDER(CLOCK_IDLE_HZ) * CLOCK_FULL_HZ != CLOCK_T2_PRESCALER * CLOCK_IDLE_HZ) || \
+    ((CLOCK_T2_DIVIDER(CLOCK_IDLE_HZ) != 1) && (CLOCK_T2_DIVIDER(CLOCK_IDLE_HZ) != 4) && \
+     (CLOCK_T2_DIVIDER(CLOCK_IDLE_HZ) != 16))
+#error "CLOCK: the Timer2 tick needs a prescaler of 1, 4 or 16 at CLOCK_IDLE_IRCF"
+#endif
+
+
+/**********************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void CLOCK_Init( void )
+* \Description     : Selects the idle frequency and runs the device on the
+                     crystal (full speed).
+*******************************************************************************/
+void CLOCK_Init(void);
+
+/******************************************************************************
+* \Syntax          : void CLOCK_Set( unsigned char point )
+* \Description     : Switches to an operating point (CLOCK_FULL / CLOCK_IDLE)
+                     and reloads the Timer2 prescaler, the ADC clock and the
+                     EUSART baud rate generator. Waits for the EUSART
+                     transmitter to drain, then for a running conversion and
+                     for the crystal start-up (interrupts disabled meanwhile)
+                     [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+void CLOCK_Set(unsigned char point);
+
+/******************************************************************************
+* \Syntax          : unsigned char CLOCK_Get( void )
+* \Description     : Returns the current operating point.
+*******************************************************************************/
+unsigned char CLOCK_Get(void);
+
+
+#endif /* CLOCK_H */
@@ -16,6 +16,20 @@
 #include <xc.h>
 #include "DIO.h"
 
+/**********************************************************************************************************************
+ *  GLOBAL DATA
+ *********************************************************************************************************************/
+
+#if DIO_SHADOW_A == 1
+volatile unsigned char DIO_shadowA = 0;     /* Shadow latch of PORTA */
+#endif
+#if DIO_SHADOW_B == 1
+volatile unsigned char DIO_shadowB = 0;     /* Shadow latch of PORTB */
+#endif
+#if DIO_SHADOW_C == 1
+volatile unsigned char DIO_shadowC = 0;     /* Shadow latch of PORTC */
+#endif
+
 /**********************************************************************************************************************
  *  LOCAL FUNCTIONS
  *********************************************************************************************************************/
@@ -145,33 +159,75 @@ void DIO_setPinMode(DIO_port_e port, DIO_pin_e pin, DIO_mode_e mode)
 *******************************************************************************/
 void DIO_setPinValue(DIO_port_e port, DIO_pin_e pin, unsigned char value)
 {
-    /* Set the value of the pin in the corresponding port */
+    /* One pin of the corresponding port */
+    DIO_writePortMasked(port, (unsigned char)(1 << pin), (value == LOW) ? 0x00 : 0xFF);
+}
+
+/******************************************************************************
+* \Syntax          : void DIO_writePortMasked( enum port, unsigned char mask,
+                                               unsigned char value )
+* \Description     : Sets the pins of mask in a port to their bit in value
+                     with one port write, the other pins are unchanged
+                     [CALLED FROM THE MAIN LOOP OR THE ISR].
+*******************************************************************************/
+void DIO_writePortMasked(DIO_port_e port, unsigned char mask, unsigned char value)
+{
+#if DIO_USE_SHADOW == 1
+    unsigned char gie = 0;
+#endif
+
+    /* Shadow: the shadow and the port change together, on a DIO_LOCK_x port a pin written by the ISR in between
+       would be lost. No shadow: read-modify-write of the port */
     switch(port)
     {
         case DIO_PORTA:
-            if(value == LOW)
-                PORTA &= ~(1 << pin);
-            else
-                PORTA |= (1 << pin);
+#if DIO_SHADOW_A == 1
+            if(DIO_LOCK_A)
+            {
+                gie = INTCONbits.GIE;
+                INTCONbits.GIE = 0;
+            }
+            DIO_shadowA = (DIO_shadowA & ~mask) | (value & mask);
+            PORTA = DIO_shadowA;
+#else
+            PORTA = (PORTA & ~mask) | (value & mask);
+#endif
             break;
         case DIO_PORTB:
-            if(value == LOW)
-                PORTB &= ~(1 << pin);
-            else
-                PORTB |= (1 << pin);
+#if DIO_SHADOW_B == 1
+            if(DIO_LOCK_B)
+            {
+                gie = INTCONbits.GIE;
+                INTCONbits.GIE = 0;
+            }
+            DIO_shadowB = (DIO_shadowB & ~mask) | (value & mask);
+            PORTB = DIO_shadowB;
+#else
+            PORTB = (PORTB & ~mask) | (value & mask);
+#endif
             break;
         case DIO_PORTC:
-            if(value == LOW)
-                PORTC &= ~(1 << pin);
-            else
-                PORTC |= (1 << pin);
+#if DIO_SHADOW_C == 1
+            if(DIO_LOCK_C)
+            {
+                gie = INTCONbits.GIE;
+                INTCONbits.GIE = 0;
+            }
+            DIO_shadowC = (DIO_shadowC & ~mask) | (value & mask);
+            PORTC = DIO_shadowC;
+#else
+            PORTC = (PORTC & ~mask) | (value & mask);
+#endif
             break;
-        default:    /* Incorrect Value */
+        default:    /* Incorrect Port */
             break;
     }
+#if DIO_USE_SHADOW == 1
+    if(gie)
+        INTCONbits.GIE = 1;
+#endif
 }
 
-
 /**********************************************************************************************************************
  *  END OF FILE: DIO.c
  *********************************************************************************************************************/
\ No newline at end of file
@@ -5,12 +5,70 @@
  * Author:      Hosam Mohamed
  *
  * Description: Contains the declaration of DIO APIs and essential MACROS for port & pin manipulation.
+ * NOTE:        DIO_SET/DIO_CLEAR/DIO_WRITE/DIO_READ take a compile time pin descriptor ("port letter, pin number",
+ *              e.g. #define VM_BUZZER_PIN A, 2) and compile to a few instructions without a call (a single bsf/bcf
+ *              on a port without a shadow latch, btfsc/btfss for a read). DIO_setPinValue() stays for a port or pin
+ *              only known at run time (e.g. the dispenser slot of a catalog product).
+ * NOTE:        The writes (functions and macros) to a DIO_SHADOW_x port go through its shadow latch: the port is
+ *              written whole from RAM, never read back, with the interrupts held off on the DIO_LOCK_x ports so the
+ *              main loop and the ISR can both write pins of the same port. The macros of these ports are statements,
+ *              not expressions.
  * 
 *********************************************************************************************************************/
 
 #ifndef DIO_H
 #define DIO_H
 
+
+/**********************************************************************************************************************
+ *  Configuration
+ *********************************************************************************************************************/
+
+/* Output latch:
+    1      -->      Shadow latch in RAM (DIO_shadowA/B/C): a write updates the shadow and copies it to the port, so
+                    a pin that reads back wrong (slow edge, heavy load) is never written back by the read-modify-write
+                    of another pin, and several pins change in one write (DIO_writePortMasked)
+    0      -->      Read-modify-write of the port (bsf/bcf)
+*/
+#ifndef DIO_USE_SHADOW
+#define     DIO_USE_SHADOW          1
+#endif
+
+/* Ports written through their shadow latch (DIO_USE_SHADOW = 1), the pin macros of the other ports are a single
+   bsf/bcf (the port has no LAT register, a read-modify-write is only safe where every output reads back as written):
+    PORTA   -->     Shadow: the dispenser LEDs and the buzzer load their pins
+    PORTB   -->     None: push buttons (inputs)
+    PORTC   -->     None: the LCD inputs read back as written (RC6/RC7 belong to the EUSART in the telemetry build)
+*/
+#ifndef DIO_SHADOW_A
+#define     DIO_SHADOW_A            DIO_USE_SHADOW
+#endif
+#ifndef DIO_SHADOW_B
+#define     DIO_SHADOW_B            0
+#endif
+#ifndef DIO_SHADOW_C
+#define     DIO_SHADOW_C            0
+#endif
+
+#if (DIO_USE_SHADOW == 0) && ((DIO_SHADOW_A == 1) || (DIO_SHADOW_B == 1) || (DIO_SHADOW_C == 1))
+#error "DIO: DIO_SHADOW_x = 1 requires DIO_USE_SHADOW = 1"
+#endif
+
+/* Shadow writes to a port (DIO_SHADOW_x = 1):
+    1      -->      Interrupts held off, the port is written from the main loop and from the ISR (PORTA: LEDs and
+                    buzzer of the blocking build)
+    0      -->      No lock, the port is written from one context at a time (PORTC: LCD only, the EUSART owns RC6/RC7)
+*/
+#ifndef DIO_LOCK_A
+#define     DIO_LOCK_A              1
+#endif
+#ifndef DIO_LOCK_B
+#define     DIO_LOCK_B              1
+#endif
+#ifndef DIO_LOCK_C
+#define     DIO_LOCK_C              0
+#endif
+
 /**********************************************************************************************************************
  *  GLOBAL CONSTANT MACROS
  *********************************************************************************************************************/
@@ -35,6 +93,64 @@
     #define LOW 0
 #endif
 
+/* Compile time pin access, pin = descriptor "port letter, pin number" (expanded before the names are pasted) */
+#define     DIO_SET(pin)                        _DIO_WRITE(pin, HIGH)
+#define     DIO_CLEAR(pin)                      _DIO_WRITE(pin, LOW)
+#define     DIO_WRITE(pin, value)               _DIO_WRITE(pin, value)                  /* HIGH/LOW        */
+#define     DIO_READ(pin)                       _DIO_READ(pin)                          /* Pin level       */
+
+/* Compile time masked write of several pins of a port (port letter, e.g. DIO_WRITE_MASKED(C, 0xF0, data)) */
+#define     DIO_WRITE_MASKED(port, mask, value) _DIO_WRITE_MASKED(port, mask, value)
+
+#define     _DIO_READ(port, n)                  (PORT ## port ## bits.R ## port ## n)
+#define     _DIO_WRITE(port, n, value)          _DIO_WRITE_ ## port(port, n, value)
+#define     _DIO_WRITE_MASKED(port, mask, value) _DIO_WRITE_MASKED_ ## port(port, mask, value)
+
+/* Port with a shadow latch: shadow updated and copied to the port, with the interrupts held off if DIO_LOCK_x (left
+   off inside the ISR) */
+#define     _DIO_SHADOW_PIN(port, n, value)     _DIO_SHADOW_WRITE(port, ((value) != LOW) ? DIO_shadow ## port | \
+                                                                  (unsigned char)(1 << (n)) : DIO_shadow ## port & \
+                                                                  (unsigned char)~(1 << (n)))
+#define     _DIO_SHADOW_MASKED(port, mask, value) _DIO_SHADOW_WRITE(port, (unsigned char)((DIO_shadow ## port & \
+                                                                  ~(mask)) | ((value) & (mask))))
+#define     _DIO_SHADOW_WRITE(port, shadow)     do { if(DIO_LOCK_ ## port) {                            \
+                                                         unsigned char _gie = INTCONbits.GIE;           \
+                                                         INTCONbits.GIE = 0;                            \
+                                                         DIO_shadow ## port = (shadow);                 \
+                                                         PORT ## port = DIO_shadow ## port;             \
+                                                         if(_gie) INTCONbits.GIE = 1;                   \
+                                                     } else {                                           \
+                                                         DIO_shadow ## port = (shadow);                 \
+                                                         PORT ## port = DIO_shadow ## port;             \
+                                                     } } while(0)
+
+/* Port without a shadow latch: one bsf/bcf, read-modify-write of the port for several pins */
+#define     _DIO_RMW_PIN(port, n, value)        (PORT ## port ## bits.R ## port ## n = ((value) != LOW))
+#define     _DIO_RMW_MASKED(port, mask, value)  (PORT ## port = (unsigned char)((PORT ## port & ~(mask)) | \
+                                                                                 ((value) & (mask))))
+
+#if DIO_SHADOW_A == 1
+#define     _DIO_WRITE_A                        _DIO_SHADOW_PIN
+#define     _DIO_WRITE_MASKED_A                 _DIO_SHADOW_MASKED
+#else
+#define     _DIO_WRITE_A                        _DIO_RMW_PIN
+#define     _DIO_WRITE_MASKED_A                 _DIO_RMW_MASKED
+#endif
+#if DIO_SHADOW_B == 1
+#define     _DIO_WRITE_B                        _DIO_SHADOW_PIN
+#define     _DIO_WRITE_MASKED_B                 _DIO_SHADOW_MASKED
+#else
+#define     _DIO_WRITE_B                        _DIO_RMW_PIN
+#define     _DIO_WRITE_MASKED_B                 _DIO_RMW_MASKED
+#endif
+#if DIO_SHADOW_C == 1
+#define     _DIO_WRITE_C                        _DIO_SHADOW_PIN
+#define     _DIO_WRITE_MASKED_C                 _DIO_SHADOW_MASKED
+#else
+#define     _DIO_WRITE_C                        _DIO_RMW_PIN
+#define     _DIO_WRITE_MASKED_C                 _DIO_RMW_MASKED
+#endif
+
 
 /**********************************************************************************************************************
  *  GLOBAL DATA TYPES AND STRUCTURES
@@ -70,6 +186,22 @@ typedef enum
 }DIO_mode_e;
 
 
+/**********************************************************************************************************************
+ *  GLOBAL DATA
+ *********************************************************************************************************************/
+
+/* Shadow latches of the ports (written by the DIO functions and macros only) */
+#if DIO_SHADOW_A == 1
+extern volatile unsigned char DIO_shadowA;
+#endif
+#if DIO_SHADOW_B == 1
+extern volatile unsigned char DIO_shadowB;
+#endif
+#if DIO_SHADOW_C == 1
+extern volatile unsigned char DIO_shadowC;
+#endif
+
+
 /**********************************************************************************************************************
  *  GLOBAL FUNCTIONS
  *********************************************************************************************************************/
@@ -87,5 +219,14 @@ void DIO_setPinMode(DIO_port_e port, DIO_pin_e pin, DIO_mode_e mode);
 *******************************************************************************/
 void DIO_setPinValue(DIO_port_e port, DIO_pin_e pin, unsigned char value);
 
+/******************************************************************************
+* \Syntax          : void DIO_writePortMasked( enum port, unsigned char mask,
+                                               unsigned char value )
+* \Description     : Sets the pins of mask in a port to their bit in value
+                     with one port write, the other pins are unchanged
+                     [CALLED FROM THE MAIN LOOP OR THE ISR].
+*******************************************************************************/
+void DIO_writePortMasked(DIO_port_e port, unsigned char mask, unsigned char value);
+
 
 #endif /* DIO_H */
\ No newline at end of file
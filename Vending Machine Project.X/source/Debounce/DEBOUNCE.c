@@ -0,0 +1,96 @@
+/**********************************************************************************************************************
+ * Filename:    DEBOUNCE.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the implementation of the 8-input vertical counter debouncer.
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include "DEBOUNCE.h"
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+static unsigned char gState = 0;            /* Debounced state                                  */
+static unsigned char gCount0 = 0xFF;        /* Counter bit 0 of every input (1 = idle)          */
+#if DEBOUNCE_SAMPLES == 4
+static unsigned char gCount1 = 0xFF;        /* Counter bit 1 of every input                     */
+#endif
+static unsigned char gLongTicks = 0;        /* Ticks since the pressed inputs last changed      */
+
+
+/**********************************************************************************************************************
+ *  FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void DEBOUNCE_Init( unsigned char pressed )
+* \Description     : Sets the debounced state (bit n = 1: input n pressed) and
+                     resets the counters.
+*******************************************************************************/
+void DEBOUNCE_Init(unsigned char pressed)
+{
+    gState = pressed;
+    gCount0 = 0xFF;
+#if DEBOUNCE_SAMPLES == 4
+    gCount1 = 0xFF;
+#endif
+    gLongTicks = 0;
+}
+
+/******************************************************************************
+* \Syntax          : void DEBOUNCE_Tick( unsigned char sample, events )
+* \Description     : Debounces one sample of the 8 inputs (bit n = 1: input n
+                     pressed) and returns the events of this tick
+                     [CALLED FROM THE TIMER INTERRUPT].
+*******************************************************************************/
+void DEBOUNCE_Tick(unsigned char sample, DEBOUNCE_events_t *events)
+{
+    unsigned char changed = gState ^ sample;    /* Inputs that differ from the state */
+
+    /* Inputs that agree with the state reload their counter, the others count down */
+    gCount0 = ~(gCount0 & changed);
+#if DEBOUNCE_SAMPLES == 4
+    gCount1 = gCount0 ^ (gCount1 & changed);
+    changed &= gCount0 & gCount1;               /* Counter rolled over */
+#else
+    changed &= gCount0;
+#endif
+    gState ^= changed;
+
+    events->pressed = changed & gState;
+    events->released = changed & ~gState;
+    events->long_press = 0;
+
+    /* One hold counter for all the inputs: restarts whenever an input changes */
+    if(changed || !gState)
+    {
+        gLongTicks = 0;
+    }
+    else if(gLongTicks < DEBOUNCE_LONG_TICKS)
+    {
+        if(++gLongTicks == DEBOUNCE_LONG_TICKS)
+            events->long_press = gState;
+    }
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char DEBOUNCE_State( void )
+* \Description     : Returns the debounced state (bit n = 1: input n pressed).
+*******************************************************************************/
+unsigned char DEBOUNCE_State(void)
+{
+    return gState;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: DEBOUNCE.c
+ *********************************************************************************************************************/
@@ -0,0 +1,79 @@
+/**********************************************************************************************************************
+ * Filename:    DEBOUNCE.h
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the declaration of the 8-input debouncer APIs (vertical counters, one bit of every counter
+ *              per byte, so the 8 inputs are debounced together in a few instructions per tick).
+ * NOTE:        DEBOUNCE_Tick() must be called from a periodic interrupt (Timer2 in the vending machine), an input
+ *              changes state after DEBOUNCE_SAMPLES consecutive ticks with the new level.
+ *
+*********************************************************************************************************************/
+
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+
+/**********************************************************************************************************************
+ *  Configuration
+ *********************************************************************************************************************/
+
+/* Consecutive equal samples before an input changes state:
+    2      -->      1-bit vertical counter (22.88ms tick: 23ms .. 46ms)
+    4      -->      2-bit vertical counter (22.88ms tick: 69ms .. 92ms)
+*/
+#ifndef DEBOUNCE_SAMPLES
+#define     DEBOUNCE_SAMPLES        2
+#endif
+
+/* Ticks an input must stay pressed for a long press (44 x 22.88ms = 1s) */
+#ifndef DEBOUNCE_LONG_TICKS
+#define     DEBOUNCE_LONG_TICKS     44
+#endif
+
+#if (DEBOUNCE_SAMPLES != 2) && (DEBOUNCE_SAMPLES != 4)
+#error "DEBOUNCE: DEBOUNCE_SAMPLES must be 2 or 4"
+#endif
+
+
+/**********************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *********************************************************************************************************************/
+
+/* Events of one tick (bit n = input n) */
+typedef struct
+{
+    unsigned char pressed;          /* Became pressed                         */
+    unsigned char released;         /* Became released                        */
+    unsigned char long_press;       /* Pressed for DEBOUNCE_LONG_TICKS (once) */
+}DEBOUNCE_events_t;
+
+
+/**********************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void DEBOUNCE_Init( unsigned char pressed )
+* \Description     : Sets the debounced state (bit n = 1: input n pressed) and
+                     resets the counters.
+*******************************************************************************/
+void DEBOUNCE_Init(unsigned char pressed);
+
+/******************************************************************************
+* \Syntax          : void DEBOUNCE_Tick( unsigned char sample, events )
+* \Description     : Debounces one sample of the 8 inputs (bit n = 1: input n
+                     pressed) and returns the events of this tick
+                     [CALLED FROM THE TIMER INTERRUPT].
+*******************************************************************************/
+void DEBOUNCE_Tick(unsigned char sample, DEBOUNCE_events_t *events);
+
+/******************************************************************************
+* \Syntax          : unsigned char DEBOUNCE_State( void )
+* \Description     : Returns the debounced state (bit n = 1: input n pressed).
+*******************************************************************************/
+unsigned char DEBOUNCE_State(void);
+
+
+#endif /* DEBOUNCE_H */
@@ -0,0 +1,107 @@
+/**********************************************************************************************************************
+ * Filename:    EEPROM.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the implementation of the data EEPROM APIs (EECON1/EECON2 read and write sequences).
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <xc.h>
+
+#include "EEPROM.h"
+
+/**********************************************************************************************************************
+ *  FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : unsigned char EEPROM_Read( unsigned char address )
+* \Description     : Returns the byte at address (waits for a write in
+                     progress, the EEIF interrupt is held off meanwhile)
+                     [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+unsigned char EEPROM_Read(unsigned char address)
+{
+    unsigned char eeie = PIE2bits.EEIE;
+    unsigned char data;
+
+    PIE2bits.EEIE = 0;              /* No write started by the EEIF interrupt meanwhile */
+    while(EECON1bits.WR);           /* Previous write in progress */
+
+    EEADR = address;
+    EECON1bits.EEPGD = 0;           /* Data memory */
+    EECON1bits.RD = 1;              /* Data available in the next cycle */
+    data = EEDAT;
+    if(eeie)
+        PIE2bits.EEIE = 1;
+    return data;
+}
+
+/******************************************************************************
+* \Syntax          : void EEPROM_Write( unsigned char address,
+                                        unsigned char data )
+* \Description     : Starts writing data at address (waits for a write in
+                     progress, interrupts are disabled for the unlock
+                     sequence) [CALLED FROM THE MAIN LOOP OR THE EEIF ISR].
+*******************************************************************************/
+void EEPROM_Write(unsigned char address, unsigned char data)
+{
+    unsigned char gie;
+    unsigned char eeie = PIE2bits.EEIE;
+
+    PIE2bits.EEIE = 0;              /* No write started by the EEIF interrupt meanwhile */
+    while(EECON1bits.WR);           /* Previous write in progress */
+
+    EEADR = address;
+    EEDAT = data;
+    EECON1bits.EEPGD = 0;           /* Data memory */
+    EECON1bits.WREN = 1;            /* Enable writes */
+
+    /* Required sequence, must not be interrupted */
+    gie = INTCONbits.GIE;
+    INTCONbits.GIE = 0;
+    EECON2 = 0x55;
+    EECON2 = 0xAA;
+    EECON1bits.WR = 1;              /* Start the write */
+    if(gie)
+        INTCONbits.GIE = 1;
+
+    EECON1bits.WREN = 0;            /* The write in progress completes */
+    if(eeie)
+        PIE2bits.EEIE = 1;
+}
+
+/******************************************************************************
+* \Syntax          : void EEPROM_WriteStart( void )
+* \Description     : Starts the EEIF writer after bytes were queued: the ISR
+                     writes the first one at once (PEIE must be set)
+                     [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+void EEPROM_WriteStart(void)
+{
+    if(!PIE2bits.EEIE)              /* Enabled: the queued bytes follow the write in progress */
+    {
+        PIR2bits.EEIF = 1;          /* The ISR writes the first byte */
+        PIE2bits.EEIE = 1;
+    }
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char EEPROM_Busy( void )
+* \Description     : Returns 1 while a write is in progress.
+*******************************************************************************/
+unsigned char EEPROM_Busy(void)
+{
+    return EECON1bits.WR;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: EEPROM.c
+ *********************************************************************************************************************/
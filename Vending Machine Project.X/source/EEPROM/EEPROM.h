@@ -0,0 +1,65 @@
+/**********************************************************************************************************************
+ * Filename:    EEPROM.h
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the declaration of the data EEPROM APIs (PIC16F882: 128 bytes) and essential MACROS.
+ * NOTE:        A write takes about 5ms, EEPROM_Write() starts it and returns, the next access waits for it.
+ * NOTE:        EEPROM_Read() and EEPROM_Write() hold the EEIF interrupt off, so the writes an EEIF handler starts (the
+ *              journal, the inventory counters) never change EEADR/EEDAT under them. They can also be called from that
+ *              handler.
+ * NOTE:        EEPROM_WriteStart() starts the EEIF writer shared by the queues: on every EEIF the ISR asks each queue
+ *              for its next byte in turn and disables EEIE when none has one left, so no caller waits for a write.
+ *
+*********************************************************************************************************************/
+
+#ifndef EEPROM_H
+#define EEPROM_H
+
+
+/**********************************************************************************************************************
+ *  GLOBAL CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Size of the data EEPROM (bytes) */
+#define     EEPROM_SIZE             128
+
+
+/**********************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : unsigned char EEPROM_Read( unsigned char address )
+* \Description     : Returns the byte at address (waits for a write in
+                     progress, the EEIF interrupt is held off meanwhile)
+                     [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+unsigned char EEPROM_Read(unsigned char address);
+
+/******************************************************************************
+* \Syntax          : void EEPROM_Write( unsigned char address,
+                                        unsigned char data )
+* \Description     : Starts writing data at address (waits for a write in
+                     progress, interrupts are disabled for the unlock
+                     sequence) [CALLED FROM THE MAIN LOOP OR THE EEIF ISR].
+*******************************************************************************/
+void EEPROM_Write(unsigned char address, unsigned char data);
+
+/******************************************************************************
+* \Syntax          : void EEPROM_WriteStart( void )
+* \Description     : Starts the EEIF writer after bytes were queued: the ISR
+                     writes the first one at once (PEIE must be set)
+                     [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+void EEPROM_WriteStart(void);
+
+/******************************************************************************
+* \Syntax          : unsigned char EEPROM_Busy( void )
+* \Description     : Returns 1 while a write is in progress.
+*******************************************************************************/
+unsigned char EEPROM_Busy(void);
+
+
+#endif /* EEPROM_H */
@@ -0,0 +1,124 @@
+/**********************************************************************************************************************
+ * Filename:    EVENT.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the implementation of the single producer / single consumer event queue.
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include "EVENT.h"
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+static EVENT_t gEvents[EVENT_QUEUE_SIZE];                   /* Ring buffer                        */
+static volatile unsigned char gEventHead = 0;               /* Next free entry (ISR)              */
+static volatile unsigned char gEventTail = 0;               /* Oldest event (main loop)           */
+static unsigned char gEventDropped = 0;                     /* Events lost, queue full            */
+static unsigned char gEventHighWater = 0;                   /* Maximum number of pending events   */
+
+
+/**********************************************************************************************************************
+ *  FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void EVENT_Init( void )
+* \Description     : Empties the queue and resets the statistics.
+*******************************************************************************/
+void EVENT_Init(void)
+{
+    gEventTail = gEventHead;
+    gEventDropped = 0;
+    gEventHighWater = 0;
+}
+
+/******************************************************************************
+* \Syntax          : void EVENT_Push( EVENT_t event )
+* \Description     : Appends an event, it is dropped (and counted) if the queue
+                     is full [CALLED FROM THE ISR].
+*******************************************************************************/
+void EVENT_Push(EVENT_t event)
+{
+    unsigned char head = gEventHead;
+    unsigned char next = (head + 1) & (EVENT_QUEUE_SIZE - 1);
+    unsigned char used;
+
+    if(next == gEventTail)              /* Full */
+    {
+        if(gEventDropped != 0xFF)
+            gEventDropped++;
+        return;
+    }
+    gEvents[head] = event;
+    gEventHead = next;                  /* Published after the record is written */
+
+    used = (next - gEventTail) & (EVENT_QUEUE_SIZE - 1);
+    if(used > gEventHighWater)
+        gEventHighWater = used;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char EVENT_Pop( EVENT_t *event )
+* \Description     : Removes the oldest event, returns 0 if the queue is empty
+                     [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+unsigned char EVENT_Pop(EVENT_t *event)
+{
+    unsigned char tail = gEventTail;
+
+    if(tail == gEventHead)              /* Empty */
+        return 0;
+    *event = gEvents[tail];
+    gEventTail = (tail + 1) & (EVENT_QUEUE_SIZE - 1);    /* Entry released after it is read */
+    return 1;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char EVENT_Pending( void )
+* \Description     : Returns 1 if at least one event is queued.
+*******************************************************************************/
+unsigned char EVENT_Pending(void)
+{
+    return gEventTail != gEventHead;
+}
+
+/******************************************************************************
+* \Syntax          : void EVENT_Flush( void )
+* \Description     : Drops every pending event [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+void EVENT_Flush(void)
+{
+    gEventTail = gEventHead;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char EVENT_Dropped( void )
+* \Description     : Returns the number of events dropped because the queue
+                     was full (saturates at 255).
+*******************************************************************************/
+unsigned char EVENT_Dropped(void)
+{
+    return gEventDropped;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char EVENT_HighWater( void )
+* \Description     : Returns the maximum number of pending events seen.
+*******************************************************************************/
+unsigned char EVENT_HighWater(void)
+{
+    return gEventHighWater;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: EVENT.c
+ *********************************************************************************************************************/
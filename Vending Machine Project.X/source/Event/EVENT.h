@@ -0,0 +1,102 @@
+/**********************************************************************************************************************
+ * Filename:    EVENT.h
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the declaration of the event queue APIs (single producer: the ISR, single consumer: the
+ *              main loop) and essential MACROS.
+ * NOTE:        No interrupt is disabled: the ISR only writes the head index and the main loop only writes the tail
+ *              index, both are single bytes (atomic on the PIC16).
+ *
+*********************************************************************************************************************/
+
+#ifndef EVENT_H
+#define EVENT_H
+
+
+/**********************************************************************************************************************
+ *  Configuration
+ *********************************************************************************************************************/
+
+/* Number of entries (power of 2, one entry is kept free): one tick of the vending machine queues up to 3 events
+   (press, release and long press of different buttons) and its slowest main loop pass that drains the queue takes
+   less than 2 ticks, 6 events */
+#ifndef EVENT_QUEUE_SIZE
+#define     EVENT_QUEUE_SIZE        8
+#endif
+
+#if (EVENT_QUEUE_SIZE & (EVENT_QUEUE_SIZE - 1)) || (EVENT_QUEUE_SIZE > 128)
+#error "EVENT: EVENT_QUEUE_SIZE must be a power of 2 up to 128"
+#endif
+
+
+/**********************************************************************************************************************
+ *  GLOBAL CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* One event record is one byte: type (high nibble) and data (low nibble) */
+#define     EVENT_MAKE(type, data)  ((EVENT_t)(((type) << 4) | ((data) & 0x0F)))
+#define     EVENT_TYPE(event)       ((event) >> 4)
+#define     EVENT_DATA(event)       ((event) & 0x0F)
+
+
+/**********************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *********************************************************************************************************************/
+
+/* Event record */
+typedef unsigned char EVENT_t;
+
+
+/**********************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void EVENT_Init( void )
+* \Description     : Empties the queue and resets the statistics.
+*******************************************************************************/
+void EVENT_Init(void);
+
+/******************************************************************************
+* \Syntax          : void EVENT_Push( EVENT_t event )
+* \Description     : Appends an event, it is dropped (and counted) if the queue
+                     is full [CALLED FROM THE ISR].
+*******************************************************************************/
+void EVENT_Push(EVENT_t event);
+
+/******************************************************************************
+* \Syntax          : unsigned char EVENT_Pop( EVENT_t *event )
+* \Description     : Removes the oldest event, returns 0 if the queue is empty
+                     [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+unsigned char EVENT_Pop(EVENT_t *event);
+
+/******************************************************************************
+* \Syntax          : unsigned char EVENT_Pending( void )
+* \Description     : Returns 1 if at least one event is queued.
+*******************************************************************************/
+unsigned char EVENT_Pending(void);
+
+/******************************************************************************
+* \Syntax          : void EVENT_Flush( void )
+* \Description     : Drops every pending event [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+void EVENT_Flush(void);
+
+/******************************************************************************
+* \Syntax          : unsigned char EVENT_Dropped( void )
+* \Description     : Returns the number of events dropped because the queue
+                     was full (saturates at 255).
+*******************************************************************************/
+unsigned char EVENT_Dropped(void);
+
+/******************************************************************************
+* \Syntax          : unsigned char EVENT_HighWater( void )
+* \Description     : Returns the maximum number of pending events seen.
+*******************************************************************************/
+unsigned char EVENT_HighWater(void);
+
+
+#endif /* EVENT_H */
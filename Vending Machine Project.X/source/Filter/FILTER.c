@@ -0,0 +1,81 @@
+/**********************************************************************************************************************
+ * Filename:    FILTER.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the implementation of the fixed-point sample filter (moving average, decimation and
+ *              hysteresis).
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include "FILTER.h"
+
+/**********************************************************************************************************************
+ *  FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void FILTER_Init( FILTER_t *filter, on, off, initial )
+* \Description     : Fills the ring buffer with the initial value and sets the
+                     hysteresis thresholds: the output is set when the average
+                     exceeds on and cleared when it falls below off (off < on).
+*******************************************************************************/
+void FILTER_Init(FILTER_t *filter, unsigned int on, unsigned int off, unsigned int initial)
+{
+    for(unsigned char i = 0 ; i < FILTER_SIZE ; i++)
+        filter->samples[i] = (unsigned char)(initial >> FILTER_SHIFT);
+    filter->sum = (initial >> FILTER_SHIFT) * FILTER_SIZE;
+
+    /* Compared with the sum: no division per sample */
+    filter->on_sum = (on >> FILTER_SHIFT) * FILTER_SIZE;
+    filter->off_sum = (off >> FILTER_SHIFT) * FILTER_SIZE;
+    filter->index = 0;
+    filter->decimation = FILTER_DECIMATION;
+    filter->output = 0;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char FILTER_Add( FILTER_t *filter, sample )
+* \Description     : Adds a sample to the moving average and returns the
+                     comparator output (bounded time).
+*******************************************************************************/
+unsigned char FILTER_Add(FILTER_t *filter, unsigned int sample)
+{
+    unsigned char stored = (unsigned char)(sample >> FILTER_SHIFT);
+
+    /* Running sum: the oldest sample leaves, the new one enters */
+    filter->sum += stored - filter->samples[filter->index];
+    filter->samples[filter->index] = stored;
+    filter->index = (filter->index + 1) & (FILTER_SIZE - 1);
+
+    /* Decimation: compare once every FILTER_DECIMATION samples */
+    if(--filter->decimation == 0)
+    {
+        filter->decimation = FILTER_DECIMATION;
+        if(filter->sum > filter->on_sum)
+            filter->output = 1;
+        else if(filter->sum < filter->off_sum)
+            filter->output = 0;
+    }
+    return filter->output;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned int FILTER_Average( const FILTER_t *filter )
+* \Description     : Returns the average of the last FILTER_SIZE samples (low
+                     FILTER_SHIFT bits cleared).
+*******************************************************************************/
+unsigned int FILTER_Average(const FILTER_t *filter)
+{
+    return (filter->sum / FILTER_SIZE) << FILTER_SHIFT;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: FILTER.c
+ *********************************************************************************************************************/
@@ -0,0 +1,86 @@
+/**********************************************************************************************************************
+ * Filename:    FILTER.h
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the declaration of the fixed-point sample filter APIs (moving average over a ring buffer,
+ *              decimation and a hysteresis comparator) and essential MACROS.
+ * NOTE:        Every sample costs the same few additions and compares (no division, no loop), so the filter can
+ *              be run from an interrupt.
+ *
+*********************************************************************************************************************/
+
+#ifndef FILTER_H
+#define FILTER_H
+
+
+/**********************************************************************************************************************
+ *  Configuration
+ *********************************************************************************************************************/
+
+/* Number of samples averaged (power of 2, the sum of the stored samples must fit in 16 bits) */
+#ifndef FILTER_SIZE
+#define     FILTER_SIZE             4
+#endif
+
+/* Low bits dropped from a sample: the 10-bit ADC samples are stored as 8 bits (one byte of RAM each) */
+#ifndef FILTER_SHIFT
+#define     FILTER_SHIFT            2
+#endif
+
+/* The comparator output is updated once every FILTER_DECIMATION samples */
+#ifndef FILTER_DECIMATION
+#define     FILTER_DECIMATION       2
+#endif
+
+#if (FILTER_SIZE & (FILTER_SIZE - 1)) || (FILTER_SIZE > 64)
+#error "FILTER: FILTER_SIZE must be a power of 2 up to 64"
+#endif
+
+
+/**********************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *********************************************************************************************************************/
+
+/* Filter instance */
+typedef struct
+{
+    unsigned char samples[FILTER_SIZE];     /* Ring buffer of the last samples >> FILTER_SHIFT    */
+    unsigned int sum;                       /* Sum of the ring buffer                             */
+    unsigned int on_sum;                    /* Output set above (threshold x FILTER_SIZE, shifted) */
+    unsigned int off_sum;                   /* Output cleared below                               */
+    unsigned char index;                    /* Oldest sample                              */
+    unsigned char decimation;               /* Samples until the next comparison          */
+    unsigned char output;                   /* Comparator output (0 / 1)                  */
+}FILTER_t;
+
+
+/**********************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void FILTER_Init( FILTER_t *filter, on, off, initial )
+* \Description     : Fills the ring buffer with the initial value and sets the
+                     hysteresis thresholds: the output is set when the average
+                     exceeds on and cleared when it falls below off (off < on).
+*******************************************************************************/
+void FILTER_Init(FILTER_t *filter, unsigned int on, unsigned int off, unsigned int initial);
+
+/******************************************************************************
+* \Syntax          : unsigned char FILTER_Add( FILTER_t *filter, sample )
+* \Description     : Adds a sample to the moving average and returns the
+                     comparator output (bounded time).
+*******************************************************************************/
+unsigned char FILTER_Add(FILTER_t *filter, unsigned int sample);
+
+/******************************************************************************
+* \Syntax          : unsigned int FILTER_Average( const FILTER_t *filter )
+* \Description     : Returns the average of the last FILTER_SIZE samples (low
+                     FILTER_SHIFT bits cleared).
+*******************************************************************************/
+unsigned int FILTER_Average(const FILTER_t *filter);
+
+
+#endif /* FILTER_H */
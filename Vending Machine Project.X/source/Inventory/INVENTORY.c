@@ -0,0 +1,260 @@
+/**********************************************************************************************************************
+ * Filename:    INVENTORY.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the implementation of the sales and inventory counters (RAM sales and stock coalesced into
+ *              the EEPROM counters by the EEIF writer).
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <xc.h>
+
+#include "INVENTORY.h"
+#include "INVENTORY_prv.h"
+#include "../EEPROM/EEPROM.h"
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+static volatile unsigned char gPending[(CATALOG_MAX_PRODUCTS + 1) / 2]; /* Sales not flushed, nibble per product */
+static volatile unsigned char gStock[CATALOG_MAX_PRODUCTS];   /* Stock, sales not flushed included               */
+static unsigned char gDirty = 0;                            /* Sales not flushed, all products                  */
+static volatile unsigned char gQueued = 0;                  /* Records queued to the EEIF writer (bit = index)   */
+static volatile unsigned char gWriting = INVENTORY_NO_PRODUCT;  /* Record being written (ISR)                   */
+static unsigned char gStep = INVENTORY_STEP_LOW;            /* Next byte of the record being written (ISR)      */
+static volatile uint16_t gSales = 0;                        /* Sales written in that record (ISR)               */
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : static uint16_t INVENTORY_ReadSales( unsigned char address )
+* \Description     : Reads the flushed sales of the record at address
+                     [USED INTERNALLY].
+*******************************************************************************/
+static uint16_t INVENTORY_ReadSales(unsigned char address)
+{
+    return (uint16_t)((unsigned char)~EEPROM_Read(address + INVENTORY_SALES_LOW) |
+                      ((uint16_t)(unsigned char)~EEPROM_Read(address + INVENTORY_SALES_HIGH) << 8));
+}
+
+/**********************************************************************************************************************
+ *  FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void INVENTORY_Init( unsigned char count )
+* \Description     : Reads the stock of the count products (one EEPROM read
+                     each) into RAM and clears the sales not flushed.
+*******************************************************************************/
+void INVENTORY_Init(unsigned char count)
+{
+    gDirty = 0;
+    gQueued = 0;
+    gWriting = INVENTORY_NO_PRODUCT;
+    gStep = INVENTORY_STEP_LOW;
+    for(unsigned char index = 0; index < sizeof(gPending); index++)
+        gPending[index] = 0;
+    for(unsigned char index = 0; index < CATALOG_MAX_PRODUCTS; index++)
+        gStock[index] = (index < count) ? EEPROM_Read(INVENTORY_RECORD(index) + INVENTORY_STOCK) : INVENTORY_UNTRACKED;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char INVENTORY_Available( unsigned char index )
+* \Description     : Returns 1 if the product is in stock (RAM only).
+*******************************************************************************/
+unsigned char INVENTORY_Available(unsigned char index)
+{
+    return gStock[index] != 0;
+}
+
+/******************************************************************************
+* \Syntax          : void INVENTORY_Sold( unsigned char index )
+* \Description     : Counts a sale and decrements the stock in RAM, the
+                     product is out of stock when its last item is sold
+                     [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+void INVENTORY_Sold(unsigned char index)
+{
+    unsigned char eeie;
+
+    if(INVENTORY_PENDING(index) == INVENTORY_PENDING_MAX)  /* Would overflow: the EEIF writer takes them */
+    {
+        INVENTORY_Flush();
+        while(INVENTORY_PENDING(index) == INVENTORY_PENDING_MAX);
+    }
+
+    eeie = PIE2bits.EEIE;
+    PIE2bits.EEIE = 0;                  /* The EEIF writer takes the sales and reads the stock */
+    gPending[index >> 1] += (unsigned char)(1 << INVENTORY_PENDING_SHIFT(index));
+    if((gStock[index] != INVENTORY_UNTRACKED) && (gStock[index] != 0))
+        gStock[index]--;
+    if(eeie)
+        PIE2bits.EEIE = 1;
+
+    if(gDirty != 0xFF)
+        gDirty++;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char INVENTORY_Dirty( void )
+* \Description     : Returns the number of sales not flushed (saturates at
+                     255).
+*******************************************************************************/
+unsigned char INVENTORY_Dirty(void)
+{
+    return gDirty;
+}
+
+/******************************************************************************
+* \Syntax          : void INVENTORY_Flush( void )
+* \Description     : Queues the records of the products with sales not
+                     flushed to the EEIF writer and returns at once
+                     [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+void INVENTORY_Flush(void)
+{
+    unsigned char eeie = PIE2bits.EEIE;
+
+    PIE2bits.EEIE = 0;                  /* Shared with the EEIF writer */
+    for(unsigned char index = 0; index < CATALOG_MAX_PRODUCTS; index++)
+    {
+        if(INVENTORY_PENDING(index) != 0)
+            gQueued |= (unsigned char)(1 << index);
+    }
+    if(eeie)
+        PIE2bits.EEIE = 1;
+    gDirty = 0;
+
+    if(gQueued != 0)
+        EEPROM_WriteStart();
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char INVENTORY_WriteTick( void )
+* \Description     : Starts writing the next byte of the queued records that
+                     changes (sales, then stock) and returns 1, 0 when they
+                     are all written [CALLED FROM THE EEIF ISR, no write in
+                     progress].
+*******************************************************************************/
+unsigned char INVENTORY_WriteTick(void)
+{
+    unsigned char index, address, data;
+    uint16_t sales;
+
+    for(;;)
+    {
+        if(gWriting == INVENTORY_NO_PRODUCT)
+        {
+            if(gQueued == 0)            /* All written (until the next INVENTORY_Flush) */
+                return 0;
+            for(index = 0; !(gQueued & (unsigned char)(1 << index)); index++);
+            gQueued &= (unsigned char)~(1 << index);
+
+            /* The sales not flushed are taken now, the main loop counts the next ones */
+            sales = INVENTORY_ReadSales(INVENTORY_RECORD(index));
+            data = INVENTORY_PENDING(index);
+            gSales = (sales > 0xFFFFu - data) ? 0xFFFFu : (uint16_t)(sales + data);
+            gPending[index >> 1] &= (unsigned char)~(INVENTORY_PENDING_MAX << INVENTORY_PENDING_SHIFT(index));
+            gWriting = index;
+            gStep = INVENTORY_STEP_LOW;
+        }
+
+        address = INVENTORY_RECORD(gWriting);
+        switch(gStep)
+        {
+            case INVENTORY_STEP_LOW:
+                address += INVENTORY_SALES_LOW;
+                data = (unsigned char)~gSales;
+                break;
+            case INVENTORY_STEP_HIGH:
+                address += INVENTORY_SALES_HIGH;
+                data = (unsigned char)~(gSales >> 8);
+                break;
+            default:                    /* Stock of the sales written */
+                address += INVENTORY_STOCK;
+                data = gStock[gWriting];
+                if(data != INVENTORY_UNTRACKED)
+                    data += INVENTORY_PENDING(gWriting);
+                gWriting = INVENTORY_NO_PRODUCT;
+                break;
+        }
+        gStep++;
+
+        /* Only the bytes that change are written */
+        if(EEPROM_Read(address) != data)
+        {
+            EEPROM_Write(address, data);
+            return 1;
+        }
+    }
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char INVENTORY_Busy( void )
+* \Description     : Returns 1 while records are queued or being written.
+*******************************************************************************/
+unsigned char INVENTORY_Busy(void)
+{
+    return (gQueued != 0) || (gWriting != INVENTORY_NO_PRODUCT) || EEPROM_Busy();
+}
+
+/******************************************************************************
+* \Syntax          : uint16_t INVENTORY_Sales( unsigned char index )
+* \Description     : Returns the number of sales of a product (flushed or
+                     not).
+*******************************************************************************/
+uint16_t INVENTORY_Sales(unsigned char index)
+{
+    unsigned char eeie = PIE2bits.EEIE;
+    uint16_t sales;
+
+    PIE2bits.EEIE = 0;                  /* Consistent with the EEIF writer */
+    sales = (index == gWriting) ? gSales : INVENTORY_ReadSales(INVENTORY_RECORD(index));
+    sales = (sales > 0xFFFFu - INVENTORY_PENDING(index)) ? 0xFFFFu : (uint16_t)(sales + INVENTORY_PENDING(index));
+    if(eeie)
+        PIE2bits.EEIE = 1;
+    return sales;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char INVENTORY_Stock( unsigned char index )
+* \Description     : Returns the remaining stock of a product (RAM, sales not
+                     flushed included) or INVENTORY_UNTRACKED.
+*******************************************************************************/
+unsigned char INVENTORY_Stock(unsigned char index)
+{
+    return gStock[index];
+}
+
+/******************************************************************************
+* \Syntax          : void INVENTORY_Restock( unsigned char index,
+                                             unsigned char stock )
+* \Description     : Sets the stock of a product (INVENTORY_UNTRACKED: no
+                     longer counted) and queues its record with the sales not
+                     flushed [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+void INVENTORY_Restock(unsigned char index, unsigned char stock)
+{
+    unsigned char eeie = PIE2bits.EEIE;
+
+    PIE2bits.EEIE = 0;                  /* Shared with the EEIF writer */
+    gStock[index] = stock;
+    gQueued |= (unsigned char)(1 << index);
+    if(eeie)
+        PIE2bits.EEIE = 1;
+    INVENTORY_Flush();
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: INVENTORY.c
+ *********************************************************************************************************************/
@@ -0,0 +1,138 @@
+/**********************************************************************************************************************
+ * Filename:    INVENTORY.h
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the declaration of the sales and inventory counter APIs and essential MACROS: the sales count
+ *              and the remaining stock of every catalog product are kept in the data EEPROM, a sale only updates RAM
+ *              and INVENTORY_Flush() queues the sales of several transactions at once (coalesced) to the EEIF writer
+ *              (EEPROM_WriteStart), one byte per EEIF interrupt, so no caller waits for the 5ms writes.
+ * NOTE:        RAM holds the stock read by INVENTORY_Init() and the sales not flushed yet (a byte and a nibble per
+ *              product, 15 sales at most), so a sale and INVENTORY_Available() never read the EEPROM. A product whose
+ *              stock reads INVENTORY_UNTRACKED (erased EEPROM) is never out of stock until it is restocked.
+ * NOTE:        The sales not flushed are lost on a reset. A reset during a flush can count the sales of that flush
+ *              without their stock decrement (the sales are written first).
+ *
+*********************************************************************************************************************/
+
+#ifndef INVENTORY_H
+#define INVENTORY_H
+
+#include <stdint.h>
+
+#include "../Catalog/CATALOG.h"
+
+
+/**********************************************************************************************************************
+ *  Configuration
+ *********************************************************************************************************************/
+
+/* Sales waiting for a flush before it is due at once (the caller flushes when the machine is idle) */
+#ifndef INVENTORY_DIRTY_MAX
+#define     INVENTORY_DIRTY_MAX     4
+#endif
+
+/* EEPROM address of the counters (default: right after the catalog) */
+#ifndef INVENTORY_EEPROM_BASE
+#define     INVENTORY_EEPROM_BASE   CATALOG_EEPROM_SIZE
+#endif
+
+#if CATALOG_MAX_PRODUCTS > 8
+#error "INVENTORY: up to 8 products (one byte out of stock mask)"
+#endif
+
+
+/**********************************************************************************************************************
+ *  GLOBAL CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Stock of a product that is not counted (erased EEPROM) */
+#define     INVENTORY_UNTRACKED     0xFF
+
+/* EEPROM bytes of the counters of one product (stock, sales) and of all of them */
+#define     INVENTORY_RECORD_SIZE   3
+#define     INVENTORY_EEPROM_SIZE   (CATALOG_MAX_PRODUCTS * INVENTORY_RECORD_SIZE)
+
+
+/**********************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void INVENTORY_Init( unsigned char count )
+* \Description     : Reads the stock of the count products (one EEPROM read
+                     each) into RAM and clears the sales not flushed. To be
+                     called before the interrupts are enabled.
+*******************************************************************************/
+void INVENTORY_Init(unsigned char count);
+
+/******************************************************************************
+* \Syntax          : unsigned char INVENTORY_Available( unsigned char index )
+* \Description     : Returns 1 if the product is in stock (RAM only).
+*******************************************************************************/
+unsigned char INVENTORY_Available(unsigned char index);
+
+/******************************************************************************
+* \Syntax          : void INVENTORY_Sold( unsigned char index )
+* \Description     : Counts a sale and decrements the stock in RAM, the
+                     product is out of stock when its last item is sold
+                     [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+void INVENTORY_Sold(unsigned char index);
+
+/******************************************************************************
+* \Syntax          : unsigned char INVENTORY_Dirty( void )
+* \Description     : Returns the number of sales not flushed (saturates at
+                     255).
+*******************************************************************************/
+unsigned char INVENTORY_Dirty(void);
+
+/******************************************************************************
+* \Syntax          : void INVENTORY_Flush( void )
+* \Description     : Queues the records of the products with sales not
+                     flushed to the EEIF writer and returns at once (PEIE
+                     must be set) [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+void INVENTORY_Flush(void);
+
+/******************************************************************************
+* \Syntax          : unsigned char INVENTORY_WriteTick( void )
+* \Description     : Starts writing the next byte of the queued records that
+                     changes (sales, then stock) and returns 1, 0 when they
+                     are all written [CALLED FROM THE EEIF ISR, no write in
+                     progress].
+*******************************************************************************/
+unsigned char INVENTORY_WriteTick(void);
+
+/******************************************************************************
+* \Syntax          : unsigned char INVENTORY_Busy( void )
+* \Description     : Returns 1 while records are queued or being written.
+*******************************************************************************/
+unsigned char INVENTORY_Busy(void);
+
+/******************************************************************************
+* \Syntax          : uint16_t INVENTORY_Sales( unsigned char index )
+* \Description     : Returns the number of sales of a product (flushed or
+                     not).
+*******************************************************************************/
+uint16_t INVENTORY_Sales(unsigned char index);
+
+/******************************************************************************
+* \Syntax          : unsigned char INVENTORY_Stock( unsigned char index )
+* \Description     : Returns the remaining stock of a product (RAM, sales not
+                     flushed included) or INVENTORY_UNTRACKED.
+*******************************************************************************/
+unsigned char INVENTORY_Stock(unsigned char index);
+
+/******************************************************************************
+* \Syntax          : void INVENTORY_Restock( unsigned char index,
+                                             unsigned char stock )
+* \Description     : Sets the stock of a product (INVENTORY_UNTRACKED: no
+                     longer counted) and queues its record with the sales not
+                     flushed [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+void INVENTORY_Restock(unsigned char index, unsigned char stock);
+
+
+#endif /* INVENTORY_H */
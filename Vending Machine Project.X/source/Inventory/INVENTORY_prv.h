@@ -0,0 +1,47 @@
+/**********************************************************************************************************************
+ * Filename:    INVENTORY_prv.h
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the private MACROs of the sales and inventory counters (EEPROM layout), which are used
+ *              internally
+ *
+*********************************************************************************************************************/
+
+#ifndef  INVENTORY_PRV_H
+#define  INVENTORY_PRV_H
+
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* EEPROM record of product i at INVENTORY_EEPROM_BASE + INVENTORY_RECORD_SIZE * i:
+    [0]     remaining stock (INVENTORY_UNTRACKED: not counted)
+    [1]     sales, low byte, complemented (an erased EEPROM reads 0 sales)
+    [2]     sales, high byte, complemented
+*/
+#define     INVENTORY_STOCK         0
+#define     INVENTORY_SALES_LOW     1
+#define     INVENTORY_SALES_HIGH    2
+
+/* EEPROM address of the record of a product */
+#define     INVENTORY_RECORD(index) ((unsigned char)(INVENTORY_EEPROM_BASE + (index) * INVENTORY_RECORD_SIZE))
+
+/* Steps of the EEIF writer in a record: sales first, a reset before the stock byte loses an item, never a sale */
+#define     INVENTORY_STEP_LOW      0
+#define     INVENTORY_STEP_HIGH     1
+#define     INVENTORY_STEP_STOCK    2
+
+/* No record being written */
+#define     INVENTORY_NO_PRODUCT    0xFF
+
+/* Sales not flushed: one nibble per product (product i in byte i / 2, low nibble for an even index) */
+#define     INVENTORY_PENDING_MAX   0x0F
+#define     INVENTORY_PENDING_SHIFT(index)  ((unsigned char)(((index) & 1) << 2))
+#define     INVENTORY_PENDING(index)        \
+    ((unsigned char)((gPending[(index) >> 1] >> INVENTORY_PENDING_SHIFT(index)) & INVENTORY_PENDING_MAX))
+
+
+#endif  /* INVENTORY_PRV_H */
@@ -0,0 +1,238 @@
+/**********************************************************************************************************************
+ * Filename:    JOURNAL.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the implementation of the transaction journal (RAM buffer, interrupt-driven EEPROM writes and
+ *              recovery of the newest record at boot).
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <xc.h>
+
+#include "JOURNAL.h"
+#include "JOURNAL_prv.h"
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+static unsigned char gBuffer[JOURNAL_BUFFER][2];            /* Tag and value of the buffered records */
+static volatile unsigned char gHead = 0;                    /* Records appended (main loop)          */
+static volatile unsigned char gCommitted = 0;               /* Records committed (main loop)         */
+static volatile unsigned char gTail = 0;                    /* Records written (ISR)                 */
+static unsigned char gByte = 0;                             /* Byte of the record being written      */
+static unsigned char gSlot = 0;                             /* Next EEPROM slot                      */
+static unsigned char gSeq = 0;                              /* Next sequence number                  */
+static unsigned char gCount = 0;                            /* Valid records in the EEPROM           */
+static unsigned char gDropped = 0;                          /* Records lost, buffer full             */
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : static unsigned char JOURNAL_Read( unsigned char slot,
+                                                        JOURNAL_record_t *record )
+* \Description     : Reads a slot and returns 1 if it passes its check
+                     [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char JOURNAL_Read(unsigned char slot, JOURNAL_record_t *record)
+{
+    unsigned char address = JOURNAL_SLOT(slot);
+
+    record->seq = EEPROM_Read(address + JOURNAL_SEQ);
+    record->tag = EEPROM_Read(address + JOURNAL_TAG);
+    record->value = EEPROM_Read(address + JOURNAL_VALUE);
+    return (unsigned char)(record->seq + record->tag + record->value + EEPROM_Read(address + JOURNAL_CHECK)) ==
+           JOURNAL_CHECK_SUM;
+}
+
+/**********************************************************************************************************************
+ *  FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : unsigned char JOURNAL_Init( void )
+* \Description     : Finds the newest record in the EEPROM (one pass over the
+                     slots), empties the RAM buffer and returns the number of
+                     valid records.
+*******************************************************************************/
+unsigned char JOURNAL_Init(void)
+{
+    JOURNAL_record_t record, previous;
+    unsigned char valid, previous_valid;
+    unsigned char found = 0;
+
+    PIE2bits.EEIE = 0;
+    gHead = gCommitted = gTail = 0;
+    gByte = 0;
+    gDropped = 0;
+    gSlot = 0;
+    gSeq = 0;
+    gCount = 0;
+
+    /* The newest record is a valid slot not followed by its successor; a reset between two writes leaves one such
+       break, a corrupted slot more: the highest sequence number wins */
+    previous_valid = JOURNAL_Read(JOURNAL_RECORDS - 1, &previous);
+    for(unsigned char slot = 0; slot < JOURNAL_RECORDS; slot++)
+    {
+        valid = JOURNAL_Read(slot, &record);
+        if(valid)
+            gCount++;
+        if(previous_valid && (!valid || (record.seq != (unsigned char)(previous.seq + 1))) &&
+           (!found || ((signed char)(previous.seq + 1 - gSeq) > 0)))
+        {
+            found = 1;
+            gSeq = previous.seq + 1;
+            gSlot = slot;
+        }
+        previous = record;
+        previous_valid = valid;
+    }
+    return gCount;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char JOURNAL_Append( unsigned char tag,
+                                                   unsigned char value )
+* \Description     : Buffers a record and returns 1, commits the buffer when
+                     it is full. Returns 0 and counts the record as dropped if
+                     the buffer is still being written [CALLED FROM THE MAIN
+                     LOOP].
+*******************************************************************************/
+unsigned char JOURNAL_Append(unsigned char tag, unsigned char value)
+{
+    unsigned char head = gHead;
+
+    if((unsigned char)(head - gTail) >= JOURNAL_BUFFER)
+    {
+        if(gDropped != 0xFF)
+            gDropped++;
+        return 0;
+    }
+    gBuffer[head & (JOURNAL_BUFFER - 1)][0] = tag;
+    gBuffer[head & (JOURNAL_BUFFER - 1)][1] = value;
+    gHead = ++head;                                 /* Published after the record is written */
+
+    if((unsigned char)(head - gTail) == JOURNAL_BUFFER)
+        JOURNAL_Commit();                           /* Full: no more waiting for an idle period */
+    return 1;
+}
+
+/******************************************************************************
+* \Syntax          : void JOURNAL_Commit( void )
+* \Description     : Queues the buffered records to the EEIF writer and
+                     returns at once [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+void JOURNAL_Commit(void)
+{
+    if(gCommitted == gHead)
+        return;
+    gCommitted = gHead;                 /* Read by the ISR before it stops */
+    EEPROM_WriteStart();
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char JOURNAL_WriteTick( void )
+* \Description     : Starts writing the next byte of the committed records
+                     and returns 1, 0 when they are all written [CALLED FROM
+                     THE EEIF ISR, no write in progress].
+*******************************************************************************/
+unsigned char JOURNAL_WriteTick(void)
+{
+    unsigned char *buffered;
+    unsigned char data;
+
+    if(gTail == gCommitted)             /* All written (until the next JOURNAL_Commit) */
+        return 0;
+
+    buffered = gBuffer[gTail & (JOURNAL_BUFFER - 1)];
+    switch(gByte)
+    {
+        case JOURNAL_SEQ:       data = gSeq;                                                    break;
+        case JOURNAL_TAG:       data = buffered[0];                                             break;
+        case JOURNAL_VALUE:     data = buffered[1];                                             break;
+        default:                data = JOURNAL_CHECK_SUM - gSeq - buffered[0] - buffered[1];    break;
+    }
+    EEPROM_Write(JOURNAL_SLOT(gSlot) + gByte, data);
+
+    /* Record complete: next slot of the ring */
+    if(++gByte == JOURNAL_RECORD_SIZE)
+    {
+        gByte = 0;
+        gSeq++;
+        if(++gSlot == JOURNAL_RECORDS)
+            gSlot = 0;
+        if(gCount < JOURNAL_RECORDS)
+            gCount++;
+        gTail++;
+    }
+    return 1;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char JOURNAL_Busy( void )
+* \Description     : Returns 1 while records are buffered or the EEPROM is
+                     being written.
+*******************************************************************************/
+unsigned char JOURNAL_Busy(void)
+{
+    return (gTail != gHead) || EEPROM_Busy();
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char JOURNAL_Count( void )
+* \Description     : Returns the number of records in the EEPROM (up to
+                     JOURNAL_RECORDS, the oldest are written over).
+*******************************************************************************/
+unsigned char JOURNAL_Count(void)
+{
+    return gCount;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char JOURNAL_Get( unsigned char age,
+                                                JOURNAL_record_t *record )
+* \Description     : Reads a record from the EEPROM (age 0 = newest) and
+                     returns 1, or 0 if there is no such record or it fails
+                     its check [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+unsigned char JOURNAL_Get(unsigned char age, JOURNAL_record_t *record)
+{
+    unsigned char eeie = PIE2bits.EEIE;
+    unsigned char slot, seq, count;
+
+    /* Position of the ring, consistent with the ISR */
+    PIE2bits.EEIE = 0;
+    slot = gSlot;
+    seq = gSeq;
+    count = gCount;
+    if(eeie)
+        PIE2bits.EEIE = 1;
+
+    if(age >= count)
+        return 0;
+    slot = (slot > age) ? slot - 1 - age : slot + JOURNAL_RECORDS - 1 - age;
+    return JOURNAL_Read(slot, record) && (record->seq == (unsigned char)(seq - 1 - age));
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char JOURNAL_Dropped( void )
+* \Description     : Returns the number of records dropped because the buffer
+                     was full (saturates at 255).
+*******************************************************************************/
+unsigned char JOURNAL_Dropped(void)
+{
+    return gDropped;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: JOURNAL.c
+ *********************************************************************************************************************/
@@ -0,0 +1,147 @@
+/**********************************************************************************************************************
+ * Filename:    JOURNAL.h
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the declaration of the transaction journal APIs and essential MACROS: an append-only circular
+ *              log of records (tag, value) at the top of the data EEPROM. JOURNAL_Append() buffers a record in RAM,
+ *              JOURNAL_Commit() queues the buffered records to the EEIF writer (EEPROM_WriteStart), one byte per
+ *              EEIF interrupt, so no caller waits for the 5ms writes.
+ * NOTE:        Every record takes the next slot of the ring (each EEPROM cell is written once per lap) and carries a
+ *              sequence number: JOURNAL_Init() finds the newest record with one pass over the slots and the journal
+ *              continues after it. A record torn by a reset fails its check and is written over next.
+ * NOTE:        The records still buffered in RAM are lost on a reset. The buffer commits itself when it is full.
+ *
+*********************************************************************************************************************/
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "../EEPROM/EEPROM.h"
+
+
+/**********************************************************************************************************************
+ *  Configuration
+ *********************************************************************************************************************/
+
+/* Records in the EEPROM (JOURNAL_RECORD_SIZE bytes each, below 128: sequence numbers are compared mod 256) */
+#ifndef JOURNAL_RECORDS
+#define     JOURNAL_RECORDS         7
+#endif
+
+/* Records buffered in RAM before a commit (power of 2, 2 bytes of RAM each) */
+#ifndef JOURNAL_BUFFER
+#define     JOURNAL_BUFFER          2
+#endif
+
+/* EEPROM address of the first slot (default: the last bytes of the EEPROM) */
+#ifndef JOURNAL_EEPROM_BASE
+#define     JOURNAL_EEPROM_BASE     (EEPROM_SIZE - JOURNAL_RECORDS * JOURNAL_RECORD_SIZE)
+#endif
+
+#if (JOURNAL_RECORDS < 2) || (JOURNAL_RECORDS > 127)
+#error "JOURNAL: JOURNAL_RECORDS must be 2 to 127"
+#endif
+
+#if (JOURNAL_BUFFER & (JOURNAL_BUFFER - 1)) || (JOURNAL_BUFFER > 64)
+#error "JOURNAL: JOURNAL_BUFFER must be a power of 2 up to 64"
+#endif
+
+
+/**********************************************************************************************************************
+ *  GLOBAL CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Bytes of a record in the EEPROM (sequence number, tag, value, check) */
+#define     JOURNAL_RECORD_SIZE     4
+
+#if JOURNAL_EEPROM_BASE + JOURNAL_RECORDS * JOURNAL_RECORD_SIZE > EEPROM_SIZE
+#error "JOURNAL: the journal does not fit in the EEPROM"
+#endif
+
+
+/**********************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *********************************************************************************************************************/
+
+/* Record read back from the EEPROM */
+typedef struct
+{
+    unsigned char seq;              /* Sequence number (mod 256)  */
+    unsigned char tag;              /* Set by the caller          */
+    unsigned char value;            /* Set by the caller          */
+}JOURNAL_record_t;
+
+
+/**********************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : unsigned char JOURNAL_Init( void )
+* \Description     : Finds the newest record in the EEPROM (one pass over the
+                     slots), empties the RAM buffer and returns the number of
+                     valid records. To be called before the interrupts are
+                     enabled.
+*******************************************************************************/
+unsigned char JOURNAL_Init(void);
+
+/******************************************************************************
+* \Syntax          : unsigned char JOURNAL_Append( unsigned char tag,
+                                                   unsigned char value )
+* \Description     : Buffers a record and returns 1, commits the buffer when
+                     it is full. Returns 0 and counts the record as dropped if
+                     the buffer is still being written [CALLED FROM THE MAIN
+                     LOOP].
+*******************************************************************************/
+unsigned char JOURNAL_Append(unsigned char tag, unsigned char value);
+
+/******************************************************************************
+* \Syntax          : void JOURNAL_Commit( void )
+* \Description     : Queues the buffered records to the EEIF writer (PEIE
+                     must be set) and returns at once [CALLED FROM THE MAIN
+                     LOOP].
+*******************************************************************************/
+void JOURNAL_Commit(void);
+
+/******************************************************************************
+* \Syntax          : unsigned char JOURNAL_WriteTick( void )
+* \Description     : Starts writing the next byte of the committed records
+                     and returns 1, 0 when they are all written [CALLED FROM
+                     THE EEIF ISR, no write in progress].
+*******************************************************************************/
+unsigned char JOURNAL_WriteTick(void);
+
+/******************************************************************************
+* \Syntax          : unsigned char JOURNAL_Busy( void )
+* \Description     : Returns 1 while records are buffered or the EEPROM is
+                     being written.
+*******************************************************************************/
+unsigned char JOURNAL_Busy(void);
+
+/******************************************************************************
+* \Syntax          : unsigned char JOURNAL_Count( void )
+* \Description     : Returns the number of records in the EEPROM (up to
+                     JOURNAL_RECORDS, the oldest are written over).
+*******************************************************************************/
+unsigned char JOURNAL_Count(void);
+
+/******************************************************************************
+* \Syntax          : unsigned char JOURNAL_Get( unsigned char age,
+                                                JOURNAL_record_t *record )
+* \Description     : Reads a record from the EEPROM (age 0 = newest) and
+                     returns 1, or 0 if there is no such record or it fails
+                     its check [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+unsigned char JOURNAL_Get(unsigned char age, JOURNAL_record_t *record);
+
+/******************************************************************************
+* \Syntax          : unsigned char JOURNAL_Dropped( void )
+* \Description     : Returns the number of records dropped because the buffer
+                     was full (saturates at 255).
+*******************************************************************************/
+unsigned char JOURNAL_Dropped(void);
+
+
+#endif /* JOURNAL_H */
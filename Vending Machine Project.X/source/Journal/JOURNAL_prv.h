@@ -0,0 +1,35 @@
+/**********************************************************************************************************************
+ * Filename:    JOURNAL_prv.h
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the private MACROs of the transaction journal (EEPROM record layout), which are used internally
+ *
+*********************************************************************************************************************/
+
+#ifndef  JOURNAL_PRV_H
+#define  JOURNAL_PRV_H
+
+
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* EEPROM record (slot i at JOURNAL_EEPROM_BASE + JOURNAL_RECORD_SIZE * i), written in this order:
+    [0]     sequence number (previous record + 1, mod 256)
+    [1]     tag
+    [2]     value
+    [3]     check: the 4 bytes add up to JOURNAL_CHECK_SUM (an erased or all-zero slot fails)
+*/
+#define     JOURNAL_SEQ             0
+#define     JOURNAL_TAG             1
+#define     JOURNAL_VALUE           2
+#define     JOURNAL_CHECK           3
+#define     JOURNAL_CHECK_SUM       0xFF
+
+/* EEPROM address of a slot */
+#define     JOURNAL_SLOT(slot)      ((unsigned char)(JOURNAL_EEPROM_BASE + (slot) * JOURNAL_RECORD_SIZE))
+
+
+#endif  /* JOURNAL_PRV_H */
@@ -19,10 +19,35 @@
 #include <xc.h>
 #include "LCD.h"
 #include "LCD_prv.h"
+#include "../DIO/DIO.h"
 
 /* LCD Struct Object */
+#if LCD_STATIC_PINS == 0
 LCD lcd;
 
+/* DIO port of the LCD struct (set by LCD_Init) */
+static DIO_port_e gPort = DIO_PORTC;
+#endif
+
+#if LCD_USE_FRAME == 1
+/* Frame Buffer */
+static char gFrame[LCD_CELLS];                          /* Wanted display contents            */
+static unsigned char gDirty[(LCD_CELLS + 7) / 8];       /* Cells not sent to the LCD yet      */
+static unsigned char gCursor = 0;                       /* Frame buffer cursor (cell index)   */
+static unsigned char gAddress = LCD_NO_ADDRESS;         /* LCD address counter (cell index)   */
+#endif
+
+#if LCD_USE_QUEUE == 1
+/* Transmit Queue (written by the main loop at the head, sent by the interrupt from the tail) */
+static unsigned char gQueue[LCD_QUEUE_SIZE];            /* Commands and characters            */
+static volatile unsigned char gQueueRs = 0;             /* Bit n: entry n is a character      */
+static volatile unsigned char gQueueHead = 0;           /* Next free entry                    */
+static volatile unsigned char gQueueTail = 0;           /* Entry being sent                   */
+static volatile unsigned char gQueueLow = 0;            /* High nibble of the tail entry sent */
+static volatile unsigned char gQueueWait = 0;           /* Ticks until the LCD is ready       */
+static unsigned char gQueueHighWater = 0;               /* Maximum number of queued entries   */
+#endif
+
 
 /**********************************************************************************************************************
  *  GLOBAL FUNCTIONS
@@ -34,68 +59,328 @@ LCD lcd;
                      [USED INTERNALLY]       
 *******************************************************************************/
 static void LCD_Out ( char c ) {
+#if LCD_STATIC_PINS == 1
+    // D4:D7 in one masked write
+    DIO_WRITE_MASKED(LCD_PORT_ID, LCD_DATA_MASK, (unsigned char)((c & 0x0F) << LCD_D4_PIN));
+#else
+    unsigned char data = 0;
 
-    if ( c & 1 ){
-        *(lcd.PORT) |= 1 << lcd.D4;
+    // D4:D7 in one masked write (the pins are not consecutive in the LCD struct)
+    if ( c & 1 ) {
+        data |= 1 << lcd.D4;
+    }
+    if ( c & 2 ) {
+        data |= 1 << lcd.D5;
+    }
+    if ( c & 4 ) {
+        data |= 1 << lcd.D6;
+    }
+    if ( c & 8 ) {
+        data |= 1 << lcd.D7;
+    }
+    DIO_writePortMasked(gPort, (unsigned char)((1 << lcd.D4) | (1 << lcd.D5) | (1 << lcd.D6) | (1 << lcd.D7)),
+                        data);
+#endif
+}
+
+/******************************************************************************
+* \Syntax          : void LCD_Write(unsigned char a)        
+* \Description     : Write a byte to the LCD           
+*******************************************************************************/
+void LCD_Write ( unsigned char c ) {
+
+    LCD_RS_LOW();      // => RS = 0
+    LCD_Out(c);
+
+    LCD_EN_HIGH();     // => E = 1
+    __delay_ms(4);
+    LCD_EN_LOW();      // => E = 0
+}
+
+#if (LCD_USE_BUSY_FLAG == 1) || (LCD_USE_QUEUE == 1)
+/******************************************************************************
+* \Syntax          : static void LCD_Strobe(void)        
+* \Description     : Private function used to pulse the EN pin [USED INTERNALLY]
+*******************************************************************************/
+static void LCD_Strobe ( void ) {
+
+    LCD_EN_HIGH();     // => E = 1
+    NOP();             // Enable pulse width / data delay time
+    LCD_EN_LOW();      // => E = 0
+}
+#endif
+
+#if LCD_USE_BUSY_FLAG == 1
+/******************************************************************************
+* \Syntax          : static void LCD_DataInput(unsigned char input)        
+* \Description     : Private function used to set the direction of the data
+                     pins D4:D7 (1 = input) [USED INTERNALLY]
+*******************************************************************************/
+static void LCD_DataInput ( unsigned char input ) {
+#if LCD_STATIC_PINS == 1
+    if ( input ) {
+        LCD_TRIS |= LCD_DATA_MASK;
     }
     else {
-         *(lcd.PORT) &= ~(1 << lcd.D4);
+        LCD_TRIS &= (unsigned char)~LCD_DATA_MASK;
     }
+#else
+    volatile unsigned char *tris;
+    unsigned char mask = (unsigned char)((1 << lcd.D4) | (1 << lcd.D5) | (1 << lcd.D6) | (1 << lcd.D7));
 
-    if ( c & 2 ) {
-        *(lcd.PORT) |= 1 << lcd.D5;
+    if ( lcd.PORT == &PORTA ) {
+        tris = &TRISA;
+    }
+    else if ( lcd.PORT == &PORTB ) {
+        tris = &TRISB;
     }
     else {
-        *(lcd.PORT) &= ~(1 << lcd.D5);
+        tris = &TRISC;
     }
 
-    if ( c & 4 ) {
-        *(lcd.PORT) |= 1 << lcd.D6;
+    if ( input ) {
+        *tris |= mask;
     }
     else {
-        *(lcd.PORT) &= ~(1 << lcd.D6);
+        *tris &= (unsigned char)~mask;
     }
+#endif
+}
 
-    if ( c & 8 ) {
-         *(lcd.PORT) |= 1 << lcd.D7;
+/******************************************************************************
+* \Syntax          : static unsigned char LCD_WaitReady(void)        
+* \Description     : Private function used to poll the busy flag until the
+                     LCD can accept the next instruction, returns 0 if it is
+                     still busy after LCD_BUSY_TIMEOUT_US [USED INTERNALLY]
+*******************************************************************************/
+static unsigned char LCD_WaitReady ( void ) {
+
+    unsigned char busy;
+    unsigned char polls = 0;
+
+    LCD_DataInput(1);
+    LCD_RS_LOW();      // => RS = 0
+    LCD_RW_HIGH();     // => RW = 1 (read)
+
+    do {
+        /* High nibble: busy flag on D7 */
+        LCD_EN_HIGH();
+        NOP();
+        busy = LCD_D7_READ();
+        LCD_EN_LOW();
+
+        /* Low nibble: address counter (not used) */
+        LCD_Strobe();
+
+        // Missing or faulty LCD: the worst case execution time has elapsed
+        if ( busy ) {
+            if ( ++polls == LCD_BUSY_POLLS ) {
+                break;
+            }
+            __delay_us(LCD_BUSY_POLL_US - LCD_BUSY_READ_US);
+        }
+    } while ( busy );
+
+    LCD_RW_LOW();      // => RW = 0 (write)
+    LCD_DataInput(0);
+    return !busy;
+}
+#endif
+
+#if LCD_USE_QUEUE == 1
+/******************************************************************************
+* \Syntax          : static void LCD_Enqueue(unsigned char rs, unsigned char c)        
+* \Description     : Private function used to queue a command (rs = 0) or a
+                     character (rs = 1), waits while the queue is full
+                     [USED INTERNALLY]
+*******************************************************************************/
+static void LCD_Enqueue ( unsigned char rs, unsigned char c ) {
+
+    unsigned char next = (gQueueHead + 1) & (LCD_QUEUE_SIZE - 1);
+    unsigned char used;
+
+    // Queue full: the interrupt frees an entry every two ticks
+    while ( next == gQueueTail ) {
+        NOP();
+    }
+
+    gQueue[gQueueHead] = c;
+    if ( rs ) {
+        gQueueRs |= (unsigned char)(1 << gQueueHead);
     }
     else {
-         *(lcd.PORT) &= ~(1 << lcd.D7);
+        gQueueRs &= (unsigned char)~(1 << gQueueHead);
+    }
+    gQueueHead = next;
+
+    // Timer0 ticks only while there is something to send, the first tick
+    // one overflow from now (the flag set while idle is stale)
+    if ( !INTCONbits.TMR0IE ) {
+        INTCONbits.TMR0IF = 0;
+        INTCONbits.TMR0IE = 1;
+    }
+
+    used = (next - gQueueTail) & (LCD_QUEUE_SIZE - 1);
+    if ( used > gQueueHighWater ) {
+        gQueueHighWater = used;
     }
 }
 
 /******************************************************************************
-* \Syntax          : void LCD_Write(unsigned char a)        
-* \Description     : Write a byte to the LCD           
+* \Syntax          : void LCD_QueueTick(void)        
+* \Description     : Sends the next nibble of the transmit queue. The Timer0
+                     interrupt (TMR0IE) is enabled by every queued entry and
+                     disabled here once the queue is empty
+                     [CALLED FROM THE TIMER INTERRUPT, every LCD_QUEUE_TICK_US].
 *******************************************************************************/
-void LCD_Write ( unsigned char c ) {
+void LCD_QueueTick ( void ) {
 
-    *(lcd.PORT) &= ~(1 << lcd.RS); // => RS = 0
-    LCD_Out(c);
+    unsigned char c;
+    unsigned char rs;
 
-    *(lcd.PORT) |= 1 << lcd.EN;    // => E = 1
-    __delay_ms(4);
-    *(lcd.PORT) &= ~(1 << lcd.EN); // => E = 0
+    if ( gQueueWait != 0 ) {
+        gQueueWait--;
+        return;
+    }
+    if ( gQueueTail == gQueueHead ) {
+        // Queue and wait drained: no tick until the next LCD_Enqueue
+        INTCONbits.TMR0IE = 0;
+        return;
+    }
+
+    rs = gQueueRs & (unsigned char)(1 << gQueueTail);
+    if ( rs ) {
+        LCD_RS_HIGH();     // => RS = 1
+    }
+    else {
+        LCD_RS_LOW();      // => RS = 0
+    }
+    c = gQueue[gQueueTail];
+
+    if ( !gQueueLow ) {
+        LCD_Out((c & 0xF0) >> 4);
+        LCD_Strobe();
+        gQueueLow = 1;
+        return;
+    }
+
+    LCD_Out(c & 0x0F);
+    LCD_Strobe();
+    gQueueLow = 0;
+
+    // Clear display / return home: the next ticks would find the LCD busy
+    if ( !rs && ( c <= CMD_LONG_LAST ) ) {
+        gQueueWait = LCD_QUEUE_LONG_TICKS;
+    }
+    gQueueTail = (gQueueTail + 1) & (LCD_QUEUE_SIZE - 1);
+}
+
+/******************************************************************************
+* \Syntax          : void LCD_WaitIdle(void)        
+* \Description     : Waits until the transmit queue is empty and the last
+                     command is executed (interrupts must be enabled).
+*******************************************************************************/
+void LCD_WaitIdle ( void ) {
+
+    while ( ( gQueueTail != gQueueHead ) || ( gQueueWait != 0 ) ) {
+        NOP();
+    }
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char LCD_QueueFree(void)        
+* \Description     : Returns the number of free entries of the transmit queue.
+*******************************************************************************/
+unsigned char LCD_QueueFree ( void ) {
+
+    return (unsigned char)((LCD_QUEUE_SIZE - 1) - ((gQueueHead - gQueueTail) & (LCD_QUEUE_SIZE - 1)));
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char LCD_QueueHighWater(void)        
+* \Description     : Returns the maximum number of entries ever queued.
+*******************************************************************************/
+unsigned char LCD_QueueHighWater ( void ) {
+
+    return gQueueHighWater;
 }
+#endif
+
+#if (LCD_USE_BUSY_FLAG == 1) || (LCD_USE_QUEUE == 1)
+/******************************************************************************
+* \Syntax          : void LCD_Command(unsigned char c)        
+* \Description     : Sends a command to the LCD, as soon as the busy flag is
+                     cleared (fixed delays if the R/W pin is not connected),
+                     or queues it (transmit queue).
+*******************************************************************************/
+void LCD_Command ( unsigned char c ) {
+#if LCD_USE_QUEUE == 1
+    LCD_Enqueue(0, c);
+#else
+    if ( !LCD_HAS_RW() ) {
+        LCD_Write((c & 0xF0) >> 4);
+        LCD_Write(c & 0x0F);
+        return;
+    }
+
+    if ( !LCD_WaitReady() ) {
+        LCD_Write((c & 0xF0) >> 4);
+        LCD_Write(c & 0x0F);
+        return;
+    }
+
+    LCD_RS_LOW();      // => RS = 0
+    LCD_Out((c & 0xF0) >> 4);
+    LCD_Strobe();
+    LCD_Out(c & 0x0F);
+    LCD_Strobe();
+#endif
+}
+#endif
 
 /******************************************************************************
 * \Syntax          : void LCD_Init(LCD display)        
 * \Description     : Initializes the LCD (Based On LCD struct)              
 *******************************************************************************/
 void LCD_Init ( LCD display ) {
+#if LCD_USE_QUEUE == 1
+    /* Drop what is left from a previous initialization, the interrupt stops
+       using the port (the reset sequence resynchronizes the 4-bit interface) */
+    gQueueTail = gQueueHead;
+    gQueueLow = 0;
+#endif
+
+#if LCD_STATIC_PINS == 0
     /* Initialize the LCD struct */
     lcd = display;
+#else
+    (void)display;      /* Build time pins */
+#endif
 
     /* Set the LCD pins as output */
+#if LCD_STATIC_PINS == 1
+    LCD_TRIS = 0x00;
+#else
     if ( lcd.PORT == &PORTA ) {
         TRISA = 0x00;
+        gPort = DIO_PORTA;
     }
     else if ( lcd.PORT == &PORTB ) {
         TRISB = 0x00;
+        gPort = DIO_PORTB;
     }
     else if ( lcd.PORT == &PORTC ) {
         TRISC = 0x00;
+        gPort = DIO_PORTC;
     }
+#endif
+
+#if LCD_USE_BUSY_FLAG == 1
+    // R/W low: the LCD only reads while polling the busy flag
+    if ( LCD_HAS_RW() ) {
+        LCD_RW_LOW();
+    }
+#endif
 
     // Give some time to the LCD to start function properly
     __delay_ms(20);
@@ -110,6 +395,12 @@ void LCD_Init ( LCD display ) {
     // Specify the data lenght to 4 bits
     LCD_Write(0x02);
 
+#if LCD_USE_QUEUE == 1
+    // The following commands are sent by the timer interrupt, one tick
+    // after the function set
+    gQueueWait = 1;
+#endif
+
     // Set interface data length to 8 bits, number of display lines to 2 and font to 5x8 dots
     LCD_Cmd(0x28);
 
@@ -118,6 +409,18 @@ void LCD_Init ( LCD display ) {
     
     /* Turn LCD ON */
     LCD_ON();
+
+#if LCD_USE_FRAME == 1
+    /* Display contents unknown: every cell is sent on the next flush */
+    for ( unsigned char i = 0; i < LCD_CELLS; ++i ) {
+        gFrame[i] = ' ';
+    }
+    for ( unsigned char i = 0; i < sizeof(gDirty); ++i ) {
+        gDirty[i] = 0xFF;
+    }
+    gCursor = 0;
+    gAddress = LCD_NO_ADDRESS;
+#endif
 }
 
 /******************************************************************************
@@ -125,19 +428,33 @@ void LCD_Init ( LCD display ) {
 * \Description     : Prints a character on the LCD                
 *******************************************************************************/
 void LCD_PutChar ( char c ) {
+#if LCD_USE_QUEUE == 1
+    LCD_Enqueue(1, (unsigned char)c);
+#else
+#if LCD_USE_BUSY_FLAG == 1
+    if ( LCD_HAS_RW() && LCD_WaitReady() ) {
+        LCD_RS_HIGH();     // => RS = 1
+        LCD_Out((c & 0xF0) >> 4);
+        LCD_Strobe();
+        LCD_Out(c & 0x0F);
+        LCD_Strobe();
+        return;
+    }
+#endif
     // Set the LCD to write mode
-   *(lcd.PORT) |= 1 << lcd.RS;   // => RS = 1
+    LCD_RS_HIGH();     // => RS = 1
     LCD_Out((c & 0xF0) >> 4);    // Data transfer
     
-    *(lcd.PORT) |= 1 << lcd.EN;
+    LCD_EN_HIGH();
     __delay_us(40);
-    *(lcd.PORT) &= ~(1 << lcd.EN);
+    LCD_EN_LOW();
 
     LCD_Out(c & 0x0F);
 
-    *(lcd.PORT) |= 1 << lcd.EN;
+    LCD_EN_HIGH();
     __delay_us(40);
-    *(lcd.PORT) &= ~(1 << lcd.EN);
+    LCD_EN_LOW();
+#endif
 }
 
 /******************************************************************************
@@ -151,6 +468,144 @@ void LCD_PutString ( char *a ) {
     }
 }
 
+/******************************************************************************
+* \Syntax          : void LCD_BufferClear(void)        
+* \Description     : Clears the display and the frame buffer.
+*******************************************************************************/
+void LCD_BufferClear ( void ) {
+
+    LCD_Clear();
+#if LCD_USE_QUEUE == 0          /* Queue: the interrupt waits for the clear */
+#if LCD_USE_BUSY_FLAG == 1
+    if ( !LCD_HAS_RW() )
+#endif
+    __delay_ms(LCD_CLEAR_TIME_MS);      /* The next write may follow immediately */
+#endif
+
+#if LCD_USE_FRAME == 1
+    for ( unsigned char i = 0; i < LCD_CELLS; ++i ) {
+        gFrame[i] = ' ';
+    }
+    for ( unsigned char i = 0; i < sizeof(gDirty); ++i ) {
+        gDirty[i] = 0;
+    }
+    gCursor = 0;
+    gAddress = 0;       /* Clear returns the cursor home */
+#endif
+}
+
+#if LCD_USE_FRAME == 1
+/******************************************************************************
+* \Syntax          : void LCD_BufferSetCursor(unsigned char x, unsigned char y)        
+* \Description     : Sets the frame buffer cursor (x = row, y = column).
+*******************************************************************************/
+void LCD_BufferSetCursor ( unsigned char x, unsigned char y ) {
+
+    gCursor = (unsigned char)(x * LCD_COLS + y);
+}
+
+/******************************************************************************
+* \Syntax          : void LCD_BufferPutString(char* a)        
+* \Description     : Writes a string in the frame buffer at the cursor,
+                     only the characters that differ are marked dirty.
+                     Characters beyond the end of the row are dropped.
+*******************************************************************************/
+void LCD_BufferPutString ( char *a ) {
+
+    /* End of the row of the cursor */
+    unsigned char end = (unsigned char)((gCursor / LCD_COLS + 1) * LCD_COLS);
+
+    for ( ; *a != '\0'; ++a, ++gCursor ) {
+        if ( gCursor >= end ) {
+            continue;
+        }
+        if ( gFrame[gCursor] != *a ) {
+            gFrame[gCursor] = *a;
+            gDirty[gCursor >> 3] |= (unsigned char)(1 << (gCursor & 7));
+        }
+    }
+    if ( gCursor > end ) {
+        gCursor = end;
+    }
+}
+
+/******************************************************************************
+* \Syntax          : void LCD_Flush(void)        
+* \Description     : Sends the dirty cells of the frame buffer to the LCD,
+                     the cursor is only moved when the next dirty cell is
+                     not reachable by the auto-increment.
+*******************************************************************************/
+void LCD_Flush ( void ) {
+
+    for ( unsigned char i = 0; i < LCD_CELLS; ++i ) {
+
+        /* Skip 8 clean cells at once */
+        if ( ( (i & 7) == 0 ) && ( gDirty[i >> 3] == 0 ) ) {
+            i += 7;
+            continue;
+        }
+        if ( !(gDirty[i >> 3] & (1 << (i & 7))) ) {
+            continue;
+        }
+
+#if LCD_USE_QUEUE == 1
+        /* Queue full: the remaining cells stay dirty for the next flush */
+        if ( LCD_QueueFree() < LCD_FLUSH_MAX_GAP + 2 ) {
+            return;
+        }
+#endif
+
+        /* Close enough on the same row: re-send the clean cells in between */
+        if ( ( gAddress != LCD_NO_ADDRESS ) && ( gAddress < i ) &&
+             ( (unsigned char)(i - gAddress) <= LCD_FLUSH_MAX_GAP ) &&
+             ( gAddress / LCD_COLS == i / LCD_COLS ) ) {
+            while ( gAddress < i ) {
+                LCD_PutChar(gFrame[gAddress]);
+                ++gAddress;
+            }
+        }
+
+        /* Move the cursor */
+        if ( gAddress != i ) {
+            if ( i < LCD_COLS ) {
+                LCD_Cmd(CMD_ROW0_ADDRESS + i);
+            }
+            else {
+                LCD_Cmd(CMD_ROW1_ADDRESS + (i - LCD_COLS));
+            }
+        }
+
+        LCD_PutChar(gFrame[i]);
+        gDirty[i >> 3] &= (unsigned char)~(1 << (i & 7));
+
+        /* The address counter does not wrap to the next row */
+        gAddress = ( (i + 1) % LCD_COLS == 0 ) ? LCD_NO_ADDRESS : (unsigned char)(i + 1);
+    }
+}
+
+#endif
+
+/******************************************************************************
+* \Syntax          : unsigned char LCD_Idle(void)        
+* \Description     : Returns 1 if every cell of the frame buffer was sent and
+                     the transmit queue is empty (nothing left for Timer0).
+*******************************************************************************/
+unsigned char LCD_Idle ( void ) {
+
+#if LCD_USE_FRAME == 1
+    for ( unsigned char i = 0; i < sizeof(gDirty); ++i ) {
+        if ( gDirty[i] != 0 ) {
+            return 0;
+        }
+    }
+#endif
+#if LCD_USE_QUEUE == 1
+    return ( gQueueTail == gQueueHead ) && ( gQueueWait == 0 );
+#else
+    return 1;
+#endif
+}
+
 
 /**********************************************************************************************************************
  *  END OF FILE: LCD.c
@@ -11,6 +11,102 @@
 #ifndef LCD_H
 #define	LCD_H
 
+/**********************************************************************************************************************
+ *  Configuration
+ *********************************************************************************************************************/
+
+/* Frame buffer:
+    1      -->      LCD_BufferXxx write a copy of the display in RAM (LCD_CELLS + 6 bytes), LCD_Flush() sends only the
+                    characters that changed (the host benches build it with the frame buffer)
+    0      -->      LCD_BufferXxx write the LCD right away (every call rewrites its characters), LCD_Flush() is empty:
+                    PIC16F882 build, no RAM and no flash for the copy
+*/
+#ifndef LCD_USE_FRAME
+#define     LCD_USE_FRAME           0
+#endif
+
+/* Size of the frame buffer (visible characters of the display) */
+#define     LCD_ROWS                2
+#define     LCD_COLS                16
+
+/* LCD_Flush(): clean cells between two changed cells of a row that are re-sent instead of moving the cursor
+   (a character costs one data write, a cursor move costs one command write) */
+#define     LCD_FLUSH_MAX_GAP       2
+
+/* Busy flag polling: an LCD whose R/W pin is wired (RW != LCD_NO_PIN) is polled until ready instead of
+   waiting the worst case execution time (0: fixed delays only, the vending machine board ties R/W to GND) */
+#ifndef LCD_USE_BUSY_FLAG
+#define     LCD_USE_BUSY_FLAG       0
+#endif
+
+/* Busy flag polling: one poll every LCD_BUSY_POLL_US (the read strobes take about LCD_BUSY_READ_US at 1 MHz
+   instruction clock, the driver waits the rest), an LCD still busy after LCD_BUSY_TIMEOUT_US (the longest
+   instruction, clear display 1.52 ms) is missing or faulty and the write falls back to the fixed delays */
+#define     LCD_BUSY_POLL_US        20
+#define     LCD_BUSY_READ_US        10
+#define     LCD_BUSY_TIMEOUT_US     2000
+
+/* Transmit queue: commands and characters are queued and sent one nibble per LCD_QueueTick() (timer interrupt),
+   LCD_Cmd/LCD_PutChar/LCD_PutString return right away (they only wait when the queue is full), 14 bytes of RAM.
+   Host only: the PIC16F882 image has no flash to spare for it (a PIC16F882 build with the queue stops with an
+   error, a PIC16F886 has the room), so the PIC writes wait for the LCD; the host benches build it with the queue */
+#ifndef LCD_USE_QUEUE
+#define     LCD_USE_QUEUE           0
+#endif
+
+/* Queue entries (power of 2 up to 8, one entry is kept free), one byte of RAM each and one bit of RS */
+#define     LCD_QUEUE_SIZE          8
+
+/* Period of LCD_QueueTick() in us (Timer0, 1:1 prescaler at 1 MHz instruction clock) */
+#define     LCD_QUEUE_TICK_US       256
+
+/* Pin mapping:
+    1      -->      Build time (LCD_PORT and LCD_xx_PIN below): a nibble is one masked port write and RS/EN/RW
+                    are DIO pin macros without a call, the pins of the LCD struct passed to LCD_Init are unused
+    0      -->      Run time (LCD struct passed to LCD_Init)
+*/
+#ifndef LCD_STATIC_PINS
+#define     LCD_STATIC_PINS         1
+#endif
+
+/* Build time pin mapping (D4:D7 on 4 consecutive pins starting at LCD_D4_PIN) */
+#define     LCD_PORT                PORTC
+#define     LCD_PORT_ID             C                       /* Port letter of LCD_PORT (DIO macros) */
+#define     LCD_TRIS                TRISC
+#ifndef LCD_RS_PIN
+#define     LCD_RS_PIN              0
+#endif
+#ifndef LCD_EN_PIN
+#define     LCD_EN_PIN              3
+#endif
+#ifndef LCD_D4_PIN
+#define     LCD_D4_PIN              4
+#endif
+#ifndef LCD_RW_PIN
+#define     LCD_RW_PIN              LCD_NO_PIN              /* R/W tied to GND */
+#endif
+
+#if (LCD_STATIC_PINS == 1) && (LCD_D4_PIN > 4)
+#error "LCD: D4:D7 do not fit in the port (LCD_D4_PIN > 4)"
+#endif
+
+#if (LCD_BUSY_TIMEOUT_US / LCD_BUSY_POLL_US) > 255
+#error "LCD: more than 255 busy flag polls (LCD_BUSY_TIMEOUT_US / LCD_BUSY_POLL_US)"
+#endif
+
+#if defined(_16F882) && (LCD_USE_QUEUE == 1)
+#error "LCD: the transmit queue does not fit in the PIC16F882 (build it on the host or for the PIC16F886)"
+#endif
+
+#if (LCD_USE_QUEUE == 1) && (LCD_USE_BUSY_FLAG == 1)
+#error "LCD: the transmit queue and the busy flag polling cannot be used together"
+#endif
+
+/* LCD_Flush() needs room for a cursor move, the gap and the character (one RS byte for the queue) */
+#if (LCD_QUEUE_SIZE & (LCD_QUEUE_SIZE - 1)) || (LCD_QUEUE_SIZE < LCD_FLUSH_MAX_GAP + 3) || (LCD_QUEUE_SIZE > 8)
+#error "LCD: LCD_QUEUE_SIZE must be a power of 2 from LCD_FLUSH_MAX_GAP + 3 to 8"
+#endif
+
 /**********************************************************************************************************************
  *  GLOBAL CONSTANT MACROS
  *********************************************************************************************************************/
@@ -26,6 +122,9 @@
 #define LCD_ON()  LCD_Cmd(0x0C)
 #define LCD_OFF() LCD_Cmd(0x08)
 
+/* R/W pin not connected (tied to GND) */
+#define LCD_NO_PIN  8
+
 
 /**********************************************************************************************************************
  *  GLOBAL DATA TYPES AND STRUCTURES
@@ -40,8 +139,11 @@ typedef struct {
     unsigned D5 :3;                 /* The D5 bit of the LCD PORT e.g. 5  */
     unsigned D6 :3;                 /* The D6 bit of the LCD PORT e.g. 6  */
     unsigned D7 :3;                 /* The D7 bit of the LCD PORT e.g. 7  */
+    unsigned RW :4;                 /* The RW bit of the LCD PORT or LCD_NO_PIN */
 } LCD;
+#if LCD_STATIC_PINS == 0
 extern LCD lcd;         /* Global LCD struct */
+#endif
 
 
 /**********************************************************************************************************************
@@ -68,9 +170,13 @@ extern LCD lcd;         /* Global LCD struct */
     } while ( 0 )
 
 /* Sends a command to the LCD */
+#if (LCD_USE_BUSY_FLAG == 1) || (LCD_USE_QUEUE == 1)
+#define LCD_Cmd( c )    LCD_Command(c)
+#else
 #define LCD_Cmd( c )                     \
-        LCD_Write( (c & 0xF0) >> 4 );        \
-        LCD_Write( c & 0x0F);        
+        LCD_Write( ((c) & 0xF0) >> 4 );      \
+        LCD_Write( (c) & 0x0F);        
+#endif
 
 /*                           Functions                                      */
 
@@ -98,5 +204,93 @@ void LCD_PutString ( char *a );
 *******************************************************************************/
 void LCD_Write ( unsigned char c );
 
+#if (LCD_USE_BUSY_FLAG == 1) || (LCD_USE_QUEUE == 1)
+/******************************************************************************
+* \Syntax          : void LCD_Command(unsigned char c)        
+* \Description     : Sends a command to the LCD, as soon as the busy flag is
+                     cleared (fixed delays if the R/W pin is not connected),
+                     or queues it (transmit queue).
+*******************************************************************************/
+void LCD_Command ( unsigned char c );
+#endif
+
+#if LCD_USE_QUEUE == 1
+/*                           Transmit Queue                                 */
+
+/******************************************************************************
+* \Syntax          : void LCD_QueueTick(void)        
+* \Description     : Sends the next nibble of the transmit queue. The Timer0
+                     interrupt (TMR0IE) is enabled by every queued entry and
+                     disabled here once the queue is empty
+                     [CALLED FROM THE TIMER INTERRUPT, every LCD_QUEUE_TICK_US].
+*******************************************************************************/
+void LCD_QueueTick ( void );
+
+/******************************************************************************
+* \Syntax          : void LCD_WaitIdle(void)        
+* \Description     : Waits until the transmit queue is empty and the last
+                     command is executed (interrupts must be enabled).
+*******************************************************************************/
+void LCD_WaitIdle ( void );
+
+/******************************************************************************
+* \Syntax          : unsigned char LCD_QueueFree(void)        
+* \Description     : Returns the number of free entries of the transmit queue.
+*******************************************************************************/
+unsigned char LCD_QueueFree ( void );
+
+/******************************************************************************
+* \Syntax          : unsigned char LCD_QueueHighWater(void)        
+* \Description     : Returns the maximum number of entries ever queued.
+*******************************************************************************/
+unsigned char LCD_QueueHighWater ( void );
+#endif
+
+/*                           Frame Buffer                                   */
+
+/******************************************************************************
+* \Syntax          : void LCD_BufferClear(void)        
+* \Description     : Clears the display and the frame buffer.
+*******************************************************************************/
+void LCD_BufferClear ( void );
+
+#if LCD_USE_FRAME == 1
+
+/******************************************************************************
+* \Syntax          : void LCD_BufferSetCursor(unsigned char x, unsigned char y)        
+* \Description     : Sets the frame buffer cursor (x = row, y = column).
+*******************************************************************************/
+void LCD_BufferSetCursor ( unsigned char x, unsigned char y );
+
+/******************************************************************************
+* \Syntax          : void LCD_BufferPutString(char* a)        
+* \Description     : Writes a string in the frame buffer at the cursor,
+                     only the characters that differ are marked dirty.
+                     Characters beyond the end of the row are dropped.
+*******************************************************************************/
+void LCD_BufferPutString ( char *a );
+
+/******************************************************************************
+* \Syntax          : void LCD_Flush(void)        
+* \Description     : Sends the dirty cells of the frame buffer to the LCD,
+                     the cursor is only moved when the next dirty cell is
+                     not reachable by the auto-increment.
+*******************************************************************************/
+void LCD_Flush ( void );
+
+#else
+/* No frame buffer: the writes go to the LCD */
+#define LCD_BufferSetCursor( x, y )     LCD_SetCursor(x, y)
+#define LCD_BufferPutString( a )        LCD_PutString(a)
+#define LCD_Flush()                     ((void)0)
+#endif
+
+/******************************************************************************
+* \Syntax          : unsigned char LCD_Idle(void)        
+* \Description     : Returns 1 if every cell of the frame buffer was sent and
+                     the transmit queue is empty (nothing left for Timer0).
+*******************************************************************************/
+unsigned char LCD_Idle ( void );
+
 #endif	/* LCD_H */
 
@@ -20,6 +20,61 @@
 /* Display off */
 #define CMD_DISPLAY_OFF     0b00001000
 
+/* Set DDRAM address of the first and the second row */
+#define CMD_ROW0_ADDRESS    0x80
+#define CMD_ROW1_ADDRESS    0xC0
+
+/* Number of cells of the frame buffer */
+#define LCD_CELLS           (LCD_ROWS * LCD_COLS)
+
+/* Execution time of the clear display command (1.52 ms) */
+#define LCD_CLEAR_TIME_MS   2
+
+/* Commands up to this value (clear display, return home) take 1.52 ms */
+#define CMD_LONG_LAST       0x03
+
+/* Transmit queue: ticks to wait after clear display / return home */
+#define LCD_QUEUE_LONG_TICKS    ((1520 + LCD_QUEUE_TICK_US - 1) / LCD_QUEUE_TICK_US)
+
+/* Busy flag polls before giving up */
+#define LCD_BUSY_POLLS      (LCD_BUSY_TIMEOUT_US / LCD_BUSY_POLL_US)
+
+/* Unknown LCD address counter (cursor must be set before writing) */
+#define LCD_NO_ADDRESS      0xFF
+
+
+/* Pin access */
+#if LCD_STATIC_PINS == 1
+#define LCD_DATA_MASK       (unsigned char)(0x0F << LCD_D4_PIN)
+#define LCD_RW_MASK         (unsigned char)(1 << LCD_RW_PIN)       /* 0 without a RW pin */
+#define LCD_RS_IO           LCD_PORT_ID, LCD_RS_PIN                 /* DIO pin descriptors */
+#define LCD_EN_IO           LCD_PORT_ID, LCD_EN_PIN
+#define LCD_HAS_RW()        (LCD_RW_PIN != LCD_NO_PIN)
+#define LCD_RS_HIGH()       DIO_SET(LCD_RS_IO)
+#define LCD_RS_LOW()        DIO_CLEAR(LCD_RS_IO)
+#define LCD_EN_HIGH()       DIO_SET(LCD_EN_IO)
+#define LCD_EN_LOW()        DIO_CLEAR(LCD_EN_IO)
+#define LCD_RW_HIGH()       DIO_WRITE_MASKED(LCD_PORT_ID, LCD_RW_MASK, 0xFF)
+#define LCD_RW_LOW()        DIO_WRITE_MASKED(LCD_PORT_ID, LCD_RW_MASK, 0x00)
+#define LCD_D7_READ()       ((LCD_PORT >> (LCD_D4_PIN + 3)) & 1)
+#else
+/* Port of the LCD struct (the host simulation also observes the accesses through the pointer) */
+#ifdef SIM_SFR_PTR
+#define LCD_RT_PORT         SIM_SFR_PTR(lcd.PORT)
+#else
+#define LCD_RT_PORT         (*(lcd.PORT))
+#endif
+/* Writes go through DIO (port of LCD_Init, shadow latch), reads through the pointer */
+#define LCD_HAS_RW()        (lcd.RW != LCD_NO_PIN)
+#define LCD_RS_HIGH()       DIO_writePortMasked(gPort, (unsigned char)(1 << lcd.RS), 0xFF)
+#define LCD_RS_LOW()        DIO_writePortMasked(gPort, (unsigned char)(1 << lcd.RS), 0x00)
+#define LCD_EN_HIGH()       DIO_writePortMasked(gPort, (unsigned char)(1 << lcd.EN), 0xFF)
+#define LCD_EN_LOW()        DIO_writePortMasked(gPort, (unsigned char)(1 << lcd.EN), 0x00)
+#define LCD_RW_HIGH()       DIO_writePortMasked(gPort, (unsigned char)(1 << lcd.RW), 0xFF)
+#define LCD_RW_LOW()        DIO_writePortMasked(gPort, (unsigned char)(1 << lcd.RW), 0x00)
+#define LCD_D7_READ()       ((LCD_RT_PORT >> lcd.D7) & 1)
+#endif
+
 
 /**********************************************************************************************************************
  *  LOCAL FUNCTIONS
@@ -32,4 +87,39 @@
 *******************************************************************************/
 static void LCD_Out ( char a );
 
+#if (LCD_USE_BUSY_FLAG == 1) || (LCD_USE_QUEUE == 1)
+/******************************************************************************
+* \Syntax          : static void LCD_Strobe(void)        
+* \Description     : Private function used to pulse the EN pin [USED INTERNALLY]
+*******************************************************************************/
+static void LCD_Strobe ( void );
+#endif
+
+#if LCD_USE_BUSY_FLAG == 1
+/******************************************************************************
+* \Syntax          : static void LCD_DataInput(unsigned char input)        
+* \Description     : Private function used to set the direction of the data
+                     pins D4:D7 (1 = input) [USED INTERNALLY]
+*******************************************************************************/
+static void LCD_DataInput ( unsigned char input );
+
+/******************************************************************************
+* \Syntax          : static unsigned char LCD_WaitReady(void)        
+* \Description     : Private function used to poll the busy flag until the
+                     LCD can accept the next instruction, returns 0 if it is
+                     still busy after LCD_BUSY_TIMEOUT_US [USED INTERNALLY]
+*******************************************************************************/
+static unsigned char LCD_WaitReady ( void );
+#endif
+
+#if LCD_USE_QUEUE == 1
+/******************************************************************************
+* \Syntax          : static void LCD_Enqueue(unsigned char rs, unsigned char c)        
+* \Description     : Private function used to queue a command (rs = 0) or a
+                     character (rs = 1), waits while the queue is full
+                     [USED INTERNALLY]
+*******************************************************************************/
+static void LCD_Enqueue ( unsigned char rs, unsigned char c );
+#endif
+
 #endif /* LCD_PRV_H */
\ No newline at end of file
@@ -0,0 +1,72 @@
+/**********************************************************************************************************************
+ * Filename:    POWER.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the implementation of the sleep mode APIs (interrupt-on-change and watchdog wake-up).
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <xc.h>
+
+#include "POWER.h"
+
+/**********************************************************************************************************************
+ *  FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void POWER_Init( unsigned char wake_pins )
+* \Description     : Selects the PORTB pins that wake the device up when they
+                     change (bit n = RBn) and the watchdog period.
+*******************************************************************************/
+void POWER_Init(unsigned char wake_pins)
+{
+    WDTCONbits.SWDTEN = 0;                      /* Only runs while sleeping  */
+    WDTCONbits.WDTPS = POWER_WDT_PRESCALER;     /* Wake-up period            */
+    if(OPTION_REGbits.PSA)
+        OPTION_REGbits.PS = 0;                  /* Prescaler to WDT --> 1:1  */
+
+    IOCB |= wake_pins;                          /* Interrupt-on-change pins  */
+    INTCONbits.RBIE = 0;                        /* Only enabled for sleeping */
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char POWER_Sleep( void )
+* \Description     : Sleeps until a wake pin changes, the watchdog times out
+                     or an enabled interrupt is pending and returns the
+                     wake-up cause (global interrupts disabled by the caller)
+                     [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+unsigned char POWER_Sleep(void)
+{
+    (void)PORTB;                    /* Ends the mismatch condition  */
+    INTCONbits.RBIF = 0;
+    INTCONbits.RBIE = 1;            /* Wake-up on change            */
+    WDTCONbits.SWDTEN = 1;          /* Wake-up on time-out          */
+
+    CLRWDT();                       /* nPD = nTO = 1                */
+    SLEEP();                        /* nPD = 0 unless an interrupt was pending */
+    NOP();                          /* Prefetched before the wake-up */
+
+    WDTCONbits.SWDTEN = 0;
+    INTCONbits.RBIE = 0;
+
+    if(STATUSbits.nPD)
+        return POWER_WAKE_NONE;
+    if(!STATUSbits.nTO)
+        return POWER_WAKE_WATCHDOG;
+    if(INTCONbits.RBIF)
+        return POWER_WAKE_PIN;
+    return POWER_WAKE_INTERRUPT;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: POWER.c
+ *********************************************************************************************************************/
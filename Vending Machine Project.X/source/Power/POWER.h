@@ -0,0 +1,71 @@
+/**********************************************************************************************************************
+ * Filename:    POWER.h
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the declaration of the sleep mode APIs (wake-up on PORTB change and on the software enabled
+ *              watchdog timer) and essential MACROS.
+ * NOTE:        The crystal stops in sleep mode, so do Timer0, Timer1 (internal clock), Timer2 and an ADC conversion
+ *              not clocked by Frc. The watchdog runs on the 31kHz internal oscillator and is the periodic wake-up.
+ *
+*********************************************************************************************************************/
+
+#ifndef POWER_H
+#define POWER_H
+
+
+/**********************************************************************************************************************
+ *  Configuration
+ *********************************************************************************************************************/
+
+/* Watchdog wake-up period, WDTPS prescaler of the 31kHz LFINTOSC (1:32 << POWER_WDT_PRESCALER, 0 .. 11):
+    3      -->      1:256  =  8.3ms
+    4      -->      1:512  = 16.5ms
+    5      -->      1:1024 = 33.0ms
+*/
+#ifndef POWER_WDT_PRESCALER
+#define     POWER_WDT_PRESCALER     4
+#endif
+
+
+/**********************************************************************************************************************
+ *  GLOBAL CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Watchdog wake-up period (us, 31kHz LFINTOSC) */
+#define     POWER_WDT_US            (((32UL << POWER_WDT_PRESCALER) * 1000000UL) / 31000UL)
+
+/* Wake-up causes (POWER_Sleep) */
+#define     POWER_WAKE_NONE         0       /* SLEEP executed as a NOP, an interrupt was pending */
+#define     POWER_WAKE_WATCHDOG     1       /* Watchdog time-out                                 */
+#define     POWER_WAKE_PIN          2       /* Wake pin change (RBIF)                            */
+#define     POWER_WAKE_INTERRUPT    3       /* Another enabled peripheral interrupt              */
+
+
+/**********************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void POWER_Init( unsigned char wake_pins )
+* \Description     : Selects the PORTB pins that wake the device up when they
+                     change (bit n = RBn) and the watchdog period. To be called
+                     after the Timer0 configuration: the shared prescaler is
+                     set to 1:1 when it is assigned to the watchdog.
+*******************************************************************************/
+void POWER_Init(unsigned char wake_pins);
+
+/******************************************************************************
+* \Syntax          : unsigned char POWER_Sleep( void )
+* \Description     : Sleeps until a wake pin changes, the watchdog times out
+                     or an enabled interrupt is pending and returns the
+                     wake-up cause (POWER_WAKE_xxx). To be called with the global
+                     interrupts disabled: the caller checks that nothing is
+                     pending and the interrupts are serviced after it enables
+                     them again [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+unsigned char POWER_Sleep(void);
+
+
+#endif /* POWER_H */
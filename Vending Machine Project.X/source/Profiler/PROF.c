@@ -0,0 +1,152 @@
+/**********************************************************************************************************************
+ * Filename:    PROF.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the implementation of the cycle profiler APIs (Timer1 timestamps, statistics per probe).
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <xc.h>
+
+#include "PROF.h"
+
+#if PROF_ENABLE == 1
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+static PROF_probe_t gProbes[PROF_MAX_PROBES];       /* Statistics table              */
+static uint16_t gStart;                             /* Timer1 at the main loop entry */
+static uint16_t gStartIsr;                          /* Timer1 at the ISR entry       */
+static unsigned char gOverhead = 0;                 /* Cycles of an empty probe      */
+
+/**********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : static uint16_t PROF_Now( void )
+* \Description     : Private function that reads the 16-bit Timer1 while it
+                     counts (TMR1H read again if TMR1L rolled over between the
+                     two bytes) [USED INTERNALLY].
+*******************************************************************************/
+static uint16_t PROF_Now(void)
+{
+    unsigned char high = TMR1H;
+    unsigned char low = TMR1L;
+
+    if(TMR1H != high)
+    {
+        high = TMR1H;
+        low = TMR1L;
+    }
+    return (uint16_t)(((uint16_t)high << 8) | low);
+}
+
+/**********************************************************************************************************************
+ *  FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void PROF_Init( void )
+* \Description     : Starts Timer1 free-running (internal clock, 1:1), measures
+                     the overhead of an empty probe and clears the table (to be
+                     called with the interrupts disabled).
+*******************************************************************************/
+void PROF_Init(void)
+{
+    T1CON = 0x01;               /* Timer 1 on, internal clock (Fosc/4), 1:1 prescaler */
+
+    /* Empty probe: the cycles between the two timestamps */
+    gOverhead = 0;
+    PROF_Clear();
+    PROF_Begin(0);
+    PROF_End(0);
+    gOverhead = (unsigned char)gProbes[0].min;
+    PROF_Clear();
+}
+
+/******************************************************************************
+* \Syntax          : void PROF_Begin( unsigned char id )
+* \Description     : Timestamps the entry of a probe (one timestamp per
+                     context).
+*******************************************************************************/
+void PROF_Begin(unsigned char id)
+{
+    if(id < PROF_ISR_PROBES)
+        gStartIsr = PROF_Now();
+    else
+        gStart = PROF_Now();
+}
+
+/******************************************************************************
+* \Syntax          : void PROF_End( unsigned char id )
+* \Description     : Timestamps the exit of a probe and updates its statistics.
+                     A sum about to overflow is halved with the count: the mean
+                     is kept and the older sections weigh less and less.
+*******************************************************************************/
+void PROF_End(unsigned char id)
+{
+    uint16_t cycles = (uint16_t)(PROF_Now() - ((id < PROF_ISR_PROBES) ? gStartIsr : gStart));
+    PROF_probe_t *probe = &gProbes[id];
+
+    cycles = (cycles > (uint16_t)gOverhead) ? (uint16_t)(cycles - (uint16_t)gOverhead) : 0;
+    if((probe->count == 0) || (cycles < probe->min))
+        probe->min = cycles;
+    if(cycles > probe->max)
+        probe->max = cycles;
+    if(probe->sum > (uint32_t)0xFFFFFFFF - cycles)
+    {
+        probe->sum >>= 1;
+        probe->count >>= 1;
+    }
+    probe->sum += cycles;
+    probe->count++;
+}
+
+/******************************************************************************
+* \Syntax          : void PROF_Clear( void )
+* \Description     : Clears the statistics of every probe.
+*******************************************************************************/
+void PROF_Clear(void)
+{
+    for(unsigned char i = 0; i < PROF_MAX_PROBES; i++)
+    {
+        gProbes[i].min = 0;
+        gProbes[i].max = 0;
+        gProbes[i].count = 0;
+        gProbes[i].sum = 0;
+    }
+}
+
+/******************************************************************************
+* \Syntax          : const PROF_probe_t *PROF_Get( unsigned char id )
+* \Description     : Returns the statistics of a probe.
+*******************************************************************************/
+const PROF_probe_t *PROF_Get(unsigned char id)
+{
+    return &gProbes[id];
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char PROF_Overhead( void )
+* \Description     : Returns the cycles of an empty probe.
+*******************************************************************************/
+unsigned char PROF_Overhead(void)
+{
+    return gOverhead;
+}
+
+#endif
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: PROF.c
+ *********************************************************************************************************************/
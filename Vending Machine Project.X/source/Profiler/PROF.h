@@ -0,0 +1,141 @@
+/**********************************************************************************************************************
+ * Filename:    PROF.h
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the declaration of the cycle profiler APIs: PROF_BEGIN / PROF_END timestamp a code section
+ *              with the free-running Timer1 (1 count = 1 instruction cycle) and keep its min / max / sum / count.
+ * NOTE:        The probes are compiled out with PROF_ENABLE = 0. Timer1 must not be used by anything else, and it
+ *              stops in sleep mode: a probe must not span a SLEEP. A probe longer than 65535 cycles wraps.
+ * NOTE:        The record has fixed-width fields, so the host build has the same table layout as the PIC (int is
+ *              32-bit on the host). Each probe takes 12 bytes of RAM: the entry timestamp is kept once for the main
+ *              loop and once for the ISR (a probe does not nest in another probe of the same context), count and sum
+ *              are 32-bit (days of sections), a sum about to overflow is halved with the count, so the mean keeps
+ *              following the sections instead of stopping.
+ *
+*********************************************************************************************************************/
+
+#ifndef PROF_H
+#define PROF_H
+
+#include <stdint.h>
+
+
+/**********************************************************************************************************************
+ *  Configuration
+ *********************************************************************************************************************/
+
+/* Profiler:
+    1      -->      Probes compiled in, Timer1 free-running
+    0      -->      Probes compiled out (no code, no RAM)
+*/
+#ifndef PROF_ENABLE
+#define     PROF_ENABLE             0
+#endif
+
+/* Number of probes in the table (12 bytes of RAM each), the application checks that its probe IDs are below it: the
+   vending machine times 9 (VM_PROBES) */
+#ifndef PROF_MAX_PROBES
+#define     PROF_MAX_PROBES         9
+#endif
+
+/* Probes timed in the ISR: IDs 0 .. PROF_ISR_PROBES - 1, the others are timed in the main loop */
+#ifndef PROF_ISR_PROBES
+#define     PROF_ISR_PROBES         3
+#endif
+
+/* RAM set aside for the profiler (bytes: table, timestamps and overhead). The PIC16F882 has none left beside the
+   application and its compiled stack: a profiled build runs on the PIC16F886 (same pins, 368 bytes of RAM) */
+#ifndef PROF_RAM_BUDGET
+#if defined(_16F882)
+#define     PROF_RAM_BUDGET         0
+#else
+#define     PROF_RAM_BUDGET         128
+#endif
+#endif
+
+
+/**********************************************************************************************************************
+ *  GLOBAL CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* RAM of the profiler: PROF_probe_t (no sizeof in #if), two timestamps and the overhead */
+#define     PROF_PROBE_SIZE         12
+#define     PROF_RAM                ((PROF_MAX_PROBES * PROF_PROBE_SIZE) + 5)
+
+#if (PROF_ENABLE == 1) && (PROF_RAM > PROF_RAM_BUDGET)
+#error "PROF: PROF_MAX_PROBES does not fit in PROF_RAM_BUDGET (profile on the PIC16F886, not the PIC16F882)"
+#endif
+
+/* Probe entry and exit (id: 0 .. PROF_MAX_PROBES - 1) */
+#if PROF_ENABLE == 1
+#define     PROF_BEGIN(id)          PROF_Begin(id)
+#define     PROF_END(id)            PROF_End(id)
+#else
+#define     PROF_BEGIN(id)
+#define     PROF_END(id)
+#endif
+
+
+/**********************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *********************************************************************************************************************/
+
+/* Statistics of one probe (cycles, probe overhead subtracted) */
+typedef struct
+{
+    uint16_t min;                   /* Shortest section                 */
+    uint16_t max;                   /* Longest section                  */
+    uint32_t count;                 /* Counted sections                 */
+    uint32_t sum;                   /* Total of the counted sections    */
+}PROF_probe_t;
+
+
+/**********************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *********************************************************************************************************************/
+
+#if PROF_ENABLE == 1
+/******************************************************************************
+* \Syntax          : void PROF_Init( void )
+* \Description     : Starts Timer1 free-running (internal clock, 1:1), measures
+                     the overhead of an empty probe and clears the table.
+*******************************************************************************/
+void PROF_Init(void);
+
+/******************************************************************************
+* \Syntax          : void PROF_Begin( unsigned char id )
+* \Description     : Timestamps the entry of a probe (use PROF_BEGIN).
+*******************************************************************************/
+void PROF_Begin(unsigned char id);
+
+/******************************************************************************
+* \Syntax          : void PROF_End( unsigned char id )
+* \Description     : Timestamps the exit of a probe and updates its statistics
+                     (use PROF_END).
+*******************************************************************************/
+void PROF_End(unsigned char id);
+
+/******************************************************************************
+* \Syntax          : void PROF_Clear( void )
+* \Description     : Clears the statistics of every probe.
+*******************************************************************************/
+void PROF_Clear(void);
+
+/******************************************************************************
+* \Syntax          : const PROF_probe_t *PROF_Get( unsigned char id )
+* \Description     : Returns the statistics of a probe.
+*******************************************************************************/
+const PROF_probe_t *PROF_Get(unsigned char id);
+
+/******************************************************************************
+* \Syntax          : unsigned char PROF_Overhead( void )
+* \Description     : Returns the cycles of an empty probe (subtracted from
+                     every section).
+*******************************************************************************/
+unsigned char PROF_Overhead(void);
+#endif
+
+
+#endif /* PROF_H */
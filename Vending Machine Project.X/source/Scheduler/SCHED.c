@@ -0,0 +1,134 @@
+/**********************************************************************************************************************
+ * Filename:    SCHED.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the implementation of the tick-driven cooperative task scheduler.
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include "SCHED.h"
+
+/**********************************************************************************************************************
+ *  LOCAL DATA TYPES AND STRUCTURES
+ *********************************************************************************************************************/
+
+/* Task Control Block */
+typedef struct
+{
+    SCHED_task_t task;              /* Task function (NULL = free slot)  */
+    SCHED_tick_t deadline;          /* Tick at which the task is ready   */
+}SCHED_tcb_t;
+
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+static SCHED_tcb_t gTasks[SCHED_MAX_TASKS];                 /* Task table                 */
+static volatile SCHED_tick_t gTicks = 0;                    /* Incremented by the ISR     */
+static unsigned char gRunningTask = SCHED_NO_TASK;          /* Task currently being run   */
+
+
+/**********************************************************************************************************************
+ *  FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void SCHED_Init( void )
+* \Description     : Removes all the tasks and resets the tick counter.
+*******************************************************************************/
+void SCHED_Init(void)
+{
+    for(unsigned char i = 0 ; i < SCHED_MAX_TASKS ; i++)
+        gTasks[i].task = 0;
+    gTicks = 0;
+    gRunningTask = SCHED_NO_TASK;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char SCHED_AddTask( SCHED_task_t task )
+* \Description     : Adds a task that is ready to run, returns its ID
+                     (SCHED_NO_TASK if the task table is full).
+*******************************************************************************/
+unsigned char SCHED_AddTask(SCHED_task_t task)
+{
+    for(unsigned char i = 0 ; i < SCHED_MAX_TASKS ; i++)
+    {
+        if(gTasks[i].task == 0)
+        {
+            gTasks[i].task = task;
+            gTasks[i].deadline = SCHED_Now();
+            return i;
+        }
+    }
+    return SCHED_NO_TASK;
+}
+
+/******************************************************************************
+* \Syntax          : void SCHED_Tick( void )
+* \Description     : Advances the scheduler time by one tick
+                     [CALLED FROM THE TIMER INTERRUPT].
+*******************************************************************************/
+void SCHED_Tick(void)
+{
+    gTicks++;
+}
+
+/******************************************************************************
+* \Syntax          : SCHED_tick_t SCHED_Now( void )
+* \Description     : Returns the current tick count.
+*******************************************************************************/
+SCHED_tick_t SCHED_Now(void)
+{
+    SCHED_tick_t now;
+
+    /* The 16-bit counter is updated by the ISR: read until both bytes are consistent */
+    do
+    {
+        now = gTicks;
+    } while(now != gTicks);
+    return now;
+}
+
+/******************************************************************************
+* \Syntax          : void SCHED_Sleep( SCHED_tick_t ticks )
+* \Description     : The running task will not be called again before the
+                     given number of ticks has elapsed (deadline).
+*******************************************************************************/
+void SCHED_Sleep(SCHED_tick_t ticks)
+{
+    if(gRunningTask != SCHED_NO_TASK)
+        gTasks[gRunningTask].deadline = SCHED_Now() + ticks;
+}
+
+/******************************************************************************
+* \Syntax          : void SCHED_Run( void )
+* \Description     : Runs every task whose deadline has expired once.
+                     To be called from the main loop.
+*******************************************************************************/
+void SCHED_Run(void)
+{
+    SCHED_tick_t now = SCHED_Now();
+
+    for(unsigned char i = 0 ; i < SCHED_MAX_TASKS ; i++)
+    {
+        /* Deadline reached (wrap-around safe) */
+        if((gTasks[i].task != 0) && ((signed int)(now - gTasks[i].deadline) >= 0))
+        {
+            gRunningTask = i;
+            gTasks[i].task();
+            gRunningTask = SCHED_NO_TASK;
+        }
+    }
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: SCHED.c
+ *********************************************************************************************************************/
@@ -0,0 +1,97 @@
+/**********************************************************************************************************************
+ * Filename:    SCHED.h
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the declaration of the cooperative task scheduler APIs and essential MACROS.
+ * NOTE:        The scheduler has no timer of its own, SCHED_Tick() must be called from a periodic interrupt
+ *              (Timer2 in the vending machine). Tasks are run to completion and yield by returning.
+ *
+*********************************************************************************************************************/
+
+#ifndef SCHED_H
+#define SCHED_H
+
+
+/**********************************************************************************************************************
+ *  Configuration
+ *********************************************************************************************************************/
+
+/* Maximum number of tasks (the vending machine runs one, 4 bytes of RAM each) */
+#ifndef SCHED_MAX_TASKS
+#define     SCHED_MAX_TASKS         1
+#endif
+
+/* Tick period in us (Timer2: period 143 x prescaler 16 x postscaler 10 at 1 MHz instruction clock) */
+#define     SCHED_TICK_US           22880UL
+
+
+/**********************************************************************************************************************
+ *  GLOBAL CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Converts a time in ms to a number of ticks (rounded up) */
+#define     SCHED_MS_TO_TICKS(ms)   ((SCHED_tick_t)((((ms) * 1000UL) + SCHED_TICK_US - 1) / SCHED_TICK_US))
+
+/* Invalid task ID */
+#define     SCHED_NO_TASK           0xFF
+
+
+/**********************************************************************************************************************
+ *  GLOBAL DATA TYPES AND STRUCTURES
+ *********************************************************************************************************************/
+
+/* Tick counter type */
+typedef unsigned int SCHED_tick_t;
+
+/* Task function */
+typedef void (*SCHED_task_t)(void);
+
+
+/**********************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void SCHED_Init( void )
+* \Description     : Removes all the tasks and resets the tick counter.
+*******************************************************************************/
+void SCHED_Init(void);
+
+/******************************************************************************
+* \Syntax          : unsigned char SCHED_AddTask( SCHED_task_t task )
+* \Description     : Adds a task that is ready to run, returns its ID
+                     (SCHED_NO_TASK if the task table is full).
+*******************************************************************************/
+unsigned char SCHED_AddTask(SCHED_task_t task);
+
+/******************************************************************************
+* \Syntax          : void SCHED_Tick( void )
+* \Description     : Advances the scheduler time by one tick
+                     [CALLED FROM THE TIMER INTERRUPT].
+*******************************************************************************/
+void SCHED_Tick(void);
+
+/******************************************************************************
+* \Syntax          : SCHED_tick_t SCHED_Now( void )
+* \Description     : Returns the current tick count.
+*******************************************************************************/
+SCHED_tick_t SCHED_Now(void);
+
+/******************************************************************************
+* \Syntax          : void SCHED_Sleep( SCHED_tick_t ticks )
+* \Description     : The running task will not be called again before the
+                     given number of ticks has elapsed (deadline).
+*******************************************************************************/
+void SCHED_Sleep(SCHED_tick_t ticks);
+
+/******************************************************************************
+* \Syntax          : void SCHED_Run( void )
+* \Description     : Runs every task whose deadline has expired once.
+                     To be called from the main loop.
+*******************************************************************************/
+void SCHED_Run(void);
+
+
+#endif /* SCHED_H */
@@ -0,0 +1,152 @@
+/**********************************************************************************************************************
+ * Filename:    UART.c
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the implementation of the EUSART telemetry transmitter (framing and ring buffer).
+ *
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * INCLUDES
+ *********************************************************************************************************************/
+
+#include <xc.h>
+
+#include "UART.h"
+
+/**********************************************************************************************************************
+ *  LOCAL VARIABLES
+ *********************************************************************************************************************/
+
+static unsigned char gTx[UART_TX_SIZE];                     /* Ring buffer                        */
+static volatile unsigned char gTxHead = 0;                  /* Next free byte (main loop)         */
+static volatile unsigned char gTxTail = 0;                  /* Next byte to send (ISR)            */
+static unsigned char gTxDropped = 0;                        /* Frames lost, ring buffer full      */
+static unsigned char gTxHighWater = 0;                      /* Maximum number of queued bytes     */
+
+/**********************************************************************************************************************
+ *  FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void UART_Init( unsigned int spbrg )
+* \Description     : Enables the asynchronous transmitter (8 bits, RC6/TX) at
+                     the baud rate generator value of the current system clock
+                     (UART_SPBRG) and empties the ring buffer.
+*******************************************************************************/
+void UART_Init(unsigned int spbrg)
+{
+    PIE1bits.TXIE = 0;
+    gTxTail = gTxHead;
+    gTxDropped = 0;
+    gTxHighWater = 0;
+
+    BAUDCTLbits.BRG16 = 1;          /* 16-bit baud rate generator */
+    SPBRGH = (unsigned char)(spbrg >> 8);
+    SPBRG = (unsigned char)spbrg;
+    TXSTAbits.SYNC = 0;             /* Asynchronous               */
+    TXSTAbits.BRGH = 1;             /* Fosc / (4 * (n + 1))       */
+    TXSTAbits.TX9 = 0;              /* 8 data bits                */
+    RCSTAbits.SPEN = 1;             /* RC6 --> TX                 */
+    TXSTAbits.TXEN = 1;             /* TXIF set: TXREG empty      */
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char UART_Send( unsigned char type,
+                                              const unsigned char *payload,
+                                              unsigned char length )
+* \Description     : Queues a frame and returns 1, or drops it (and counts it)
+                     and returns 0 if it does not fit in the ring buffer. Never
+                     waits [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+unsigned char UART_Send(unsigned char type, const unsigned char *payload, unsigned char length)
+{
+    unsigned char head = gTxHead;
+    unsigned char used = (head - gTxTail) & (UART_TX_SIZE - 1);
+    unsigned char check = (unsigned char)(type + length);
+
+    if((length > UART_MAX_PAYLOAD) || (used + length + UART_FRAME_OVERHEAD > UART_TX_SIZE - 1))
+    {
+        if(gTxDropped != 0xFF)
+            gTxDropped++;
+        return 0;
+    }
+
+    gTx[head] = UART_SOF;
+    head = (head + 1) & (UART_TX_SIZE - 1);
+    gTx[head] = type;
+    head = (head + 1) & (UART_TX_SIZE - 1);
+    gTx[head] = length;
+    head = (head + 1) & (UART_TX_SIZE - 1);
+    for(unsigned char i = 0; i < length; i++)
+    {
+        gTx[head] = payload[i];
+        check += payload[i];
+        head = (head + 1) & (UART_TX_SIZE - 1);
+    }
+    gTx[head] = (unsigned char)(0 - check);
+    head = (head + 1) & (UART_TX_SIZE - 1);
+
+    gTxHead = head;                     /* Published after the frame is written */
+    PIE1bits.TXIE = 1;                  /* TXIF is set while TXREG is empty     */
+
+    used += length + UART_FRAME_OVERHEAD;
+    if(used > gTxHighWater)
+        gTxHighWater = used;
+    return 1;
+}
+
+/******************************************************************************
+* \Syntax          : void UART_TxTick( void )
+* \Description     : Moves the next queued byte to TXREG, disables the TXIF
+                     interrupt when the ring buffer is empty [CALLED FROM THE
+                     ISR, on TXIF with TXIE set].
+*******************************************************************************/
+void UART_TxTick(void)
+{
+    unsigned char tail = gTxTail;
+
+    if(tail == gTxHead)                 /* Empty: UART_Send enables it again */
+    {
+        PIE1bits.TXIE = 0;
+        return;
+    }
+    TXREG = gTx[tail];                  /* Clears TXIF until the TSR takes it */
+    gTxTail = (tail + 1) & (UART_TX_SIZE - 1);
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char UART_Idle( void )
+* \Description     : Returns 1 if nothing is queued and the last byte left
+                     the shift register (the EUSART stops in sleep mode).
+*******************************************************************************/
+unsigned char UART_Idle(void)
+{
+    return (gTxTail == gTxHead) && TXSTAbits.TRMT;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char UART_Dropped( void )
+* \Description     : Returns the number of frames dropped because the ring
+                     buffer was full (saturates at 255).
+*******************************************************************************/
+unsigned char UART_Dropped(void)
+{
+    return gTxDropped;
+}
+
+/******************************************************************************
+* \Syntax          : unsigned char UART_HighWater( void )
+* \Description     : Returns the maximum number of queued bytes seen.
+*******************************************************************************/
+unsigned char UART_HighWater(void)
+{
+    return gTxHighWater;
+}
+
+
+/**********************************************************************************************************************
+ *  END OF FILE: UART.c
+ *********************************************************************************************************************/
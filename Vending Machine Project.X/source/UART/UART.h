@@ -0,0 +1,114 @@
+/**********************************************************************************************************************
+ * Filename:    UART.h
+ * Version:     1.0
+ * Date:        17/10/2026
+ * Author:      Hosam Mohamed
+ *
+ * Description: Contains the declaration of the EUSART telemetry APIs (asynchronous transmitter only) and essential
+ *              MACROS: UART_Send() copies a frame into the transmit ring buffer and returns, the TXIF interrupt sends
+ *              it one byte at a time.
+ * NOTE:        Frame: UART_SOF, type, length, payload (length bytes), check. The check makes the sum of type, length,
+ *              payload and check 0 (mod 256). A collector resynchronizes on the next UART_SOF whose frame checks.
+ * NOTE:        No interrupt is disabled: the main loop only writes the head index and the ISR only writes the tail
+ *              index, both are single bytes (atomic on the PIC16). The EUSART takes RC6 (TX) over while enabled.
+ *
+*********************************************************************************************************************/
+
+#ifndef UART_H
+#define UART_H
+
+
+/**********************************************************************************************************************
+ *  Configuration
+ *********************************************************************************************************************/
+
+/* Baud rate (16-bit baud rate generator, BRGH = 1: Fosc / (4 * (SPBRG + 1))) */
+#ifndef UART_BAUD
+#define     UART_BAUD               19200UL
+#endif
+
+/* Transmit ring buffer (power of 2, one byte is kept free), a frame that does not fit is dropped */
+#ifndef UART_TX_SIZE
+#define     UART_TX_SIZE            16
+#endif
+
+#if (UART_TX_SIZE & (UART_TX_SIZE - 1)) || (UART_TX_SIZE > 128)
+#error "UART: UART_TX_SIZE must be a power of 2 up to 128"
+#endif
+
+
+/**********************************************************************************************************************
+ *  GLOBAL CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* Start of frame */
+#define     UART_SOF                0x7E
+
+/* Bytes of a frame around the payload (start, type, length, check) */
+#define     UART_FRAME_OVERHEAD     4
+
+/* Longest payload of a frame */
+#define     UART_MAX_PAYLOAD        (UART_TX_SIZE - 1 - UART_FRAME_OVERHEAD)
+
+/* Baud rate generator value at a clock frequency (rounded) and the baud rate it gives */
+#define     UART_SPBRG(hz)          ((((hz) + 2UL * UART_BAUD) / (4UL * UART_BAUD)) - 1UL)
+#define     UART_ACTUAL_BAUD(hz)    ((hz) / (4UL * (UART_SPBRG(hz) + 1UL)))
+
+/* 1 if the baud rate error at a clock frequency is within 2% */
+#define     UART_BAUD_OK(hz)        ((UART_ACTUAL_BAUD(hz) > UART_BAUD ? UART_ACTUAL_BAUD(hz) - UART_BAUD : \
+                                      UART_BAUD - UART_ACTUAL_BAUD(hz)) * 50UL <= UART_BAUD)
+
+
+/**********************************************************************************************************************
+ *  GLOBAL FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : void UART_Init( unsigned int spbrg )
+* \Description     : Enables the asynchronous transmitter (8 bits, RC6/TX) at
+                     the baud rate generator value of the current system clock
+                     (UART_SPBRG) and empties the ring buffer. PEIE must be set
+                     by the caller.
+*******************************************************************************/
+void UART_Init(unsigned int spbrg);
+
+/******************************************************************************
+* \Syntax          : unsigned char UART_Send( unsigned char type,
+                                              const unsigned char *payload,
+                                              unsigned char length )
+* \Description     : Queues a frame and returns 1, or drops it (and counts it)
+                     and returns 0 if it does not fit in the ring buffer. Never
+                     waits [CALLED FROM THE MAIN LOOP].
+*******************************************************************************/
+unsigned char UART_Send(unsigned char type, const unsigned char *payload, unsigned char length);
+
+/******************************************************************************
+* \Syntax          : void UART_TxTick( void )
+* \Description     : Moves the next queued byte to TXREG, disables the TXIF
+                     interrupt when the ring buffer is empty [CALLED FROM THE
+                     ISR, on TXIF with TXIE set].
+*******************************************************************************/
+void UART_TxTick(void);
+
+/******************************************************************************
+* \Syntax          : unsigned char UART_Idle( void )
+* \Description     : Returns 1 if nothing is queued and the last byte left
+                     the shift register (the EUSART stops in sleep mode).
+*******************************************************************************/
+unsigned char UART_Idle(void);
+
+/******************************************************************************
+* \Syntax          : unsigned char UART_Dropped( void )
+* \Description     : Returns the number of frames dropped because the ring
+                     buffer was full (saturates at 255).
+*******************************************************************************/
+unsigned char UART_Dropped(void);
+
+/******************************************************************************
+* \Syntax          : unsigned char UART_HighWater( void )
+* \Description     : Returns the maximum number of queued bytes seen.
+*******************************************************************************/
+unsigned char UART_HighWater(void);
+
+
+#endif /* UART_H */
@@ -20,40 +20,259 @@
 #include "../DIO/DIO.h"
 #include "../ADC/ADC.h"
 #include "../LCD/LCD.h"
+#include "../Scheduler/SCHED.h"
+#include "../Filter/FILTER.h"
+#include "../Event/EVENT.h"
+#include "../Debounce/DEBOUNCE.h"
+#include "../Catalog/CATALOG.h"
+#include "../EEPROM/EEPROM.h"
+#include "../Power/POWER.h"
+#include "../Clock/CLOCK.h"
+#include "../Profiler/PROF.h"
+#include "../UART/UART.h"
+#include "../Journal/JOURNAL.h"
+#include "../Inventory/INVENTORY.h"
+
+/* The blocking dispense delay polls Timer0, which drives the LCD transmit queue otherwise */
+#if (VM_USE_SCHEDULER == 0) && (LCD_USE_QUEUE == 1)
+#error "VM: VM_USE_SCHEDULER = 0 requires LCD_USE_QUEUE = 0"
+#endif
+
+/* The blocking delays need the timers, which stop in sleep mode */
+#if (VM_USE_SCHEDULER == 0) && (VM_USE_SLEEP == 1)
+#error "VM: VM_USE_SCHEDULER = 0 requires VM_USE_SLEEP = 0"
+#endif
+
+/* The blocking delays reload Timer1, the profiler timestamps need it free-running */
+#if (VM_USE_SCHEDULER == 0) && (PROF_ENABLE == 1)
+#error "VM: PROF_ENABLE = 1 requires VM_USE_SCHEDULER = 1"
+#endif
+
+/* The profiler keeps one entry timestamp for the ISR probes and one for the main loop probes */
+#if (PROF_ENABLE == 1) && (PROF_ISR_PROBES != VM_PROBES_ISR)
+#error "VM: PROF_ISR_PROBES must be VM_PROBES_ISR (the probes of the ISR come first)"
+#endif
+
+#if (PROF_ENABLE == 1) && (PROF_MAX_PROBES < VM_PROBES)
+#error "VM: PROF_MAX_PROBES must be at least VM_PROBES (every probe ID is timed)"
+#endif
+
+/* A watchdog wake-up credits at most one Timer2 tick */
+#if (VM_USE_SLEEP == 1) && (POWER_WDT_US > SCHED_TICK_US)
+#error "VM: the watchdog period (POWER_WDT_PRESCALER) must not be longer than the Timer2 tick"
+#endif
+
+/* The idle clock is only selected to sleep */
+#if (VM_USE_SLEEP == 0) && (VM_USE_CLOCK_SCALING == 1)
+#error "VM: VM_USE_CLOCK_SCALING = 1 requires VM_USE_SLEEP = 1"
+#endif
+
+/* The EUSART takes RC6 (and RC7) over: the LCD must be on RC0..RC5 (build time pin mapping) */
+#if (VM_USE_TELEMETRY == 1) && ((LCD_STATIC_PINS == 0) || (LCD_D4_PIN + 3 >= 6) || (LCD_RS_PIN >= 6) || \
+                                (LCD_EN_PIN >= 6))
+#error "VM: VM_USE_TELEMETRY = 1 requires the LCD on RC0..RC5 (LCD_STATIC_PINS = 1, LCD_D4_PIN 0)"
+#endif
+
+/* The baud rate is kept on both clocks */
+#if (VM_USE_TELEMETRY == 1) && (!UART_BAUD_OK(CLOCK_FULL_HZ) || \
+                                ((VM_USE_CLOCK_SCALING == 1) && !UART_BAUD_OK(CLOCK_IDLE_HZ)))
+#error "VM: UART_BAUD is not within 2% at the system clock"
+#endif
+
+/* The input frames carry the scheduler tick of the samples */
+#if (VM_USE_INPUT_TRACE == 1) && ((VM_USE_TELEMETRY == 0) || (VM_USE_SCHEDULER == 0))
+#error "VM: VM_USE_INPUT_TRACE = 1 requires VM_USE_TELEMETRY = 1 and VM_USE_SCHEDULER = 1"
+#endif
+
+/* Host only: no flash left for the journal and the counters in the PIC16F882 image */
+#if defined(_16F882) && (VM_USE_JOURNAL == 1)
+#error "VM: the journal does not fit in the PIC16F882 (build it on the host or for the PIC16F886)"
+#endif
+#if defined(_16F882) && (VM_USE_INVENTORY == 1)
+#error "VM: the inventory counters do not fit in the PIC16F882 (build them on the host or for the PIC16F886)"
+#endif
+
+/* The journal takes the last EEPROM bytes, after the catalog */
+#if (VM_USE_JOURNAL == 1) && (JOURNAL_EEPROM_BASE < CATALOG_EEPROM_SIZE)
+#error "VM: the journal overlaps the drink catalog in the EEPROM"
+#endif
+
+/* The counters take the EEPROM bytes between the catalog and the journal */
+#if (VM_USE_INVENTORY == 1) && ((INVENTORY_EEPROM_BASE < CATALOG_EEPROM_SIZE) || \
+                                (INVENTORY_EEPROM_BASE + INVENTORY_EEPROM_SIZE > EEPROM_SIZE) || \
+                                ((VM_USE_JOURNAL == 1) && (INVENTORY_EEPROM_BASE + INVENTORY_EEPROM_SIZE > \
+                                                           JOURNAL_EEPROM_BASE)))
+#error "VM: the inventory counters overlap the drink catalog or the journal in the EEPROM"
+#endif
 
 
 /**********************************************************************************************************************
  *  CONSTANT MACROS
  *********************************************************************************************************************/
 
-/* Number of overflows with period value = 142 to generate 2 Hz Signal */
-#define         TIMER2_NO_OF_OVERFLOWS_2HZ           (unsigned char) 22
-
-/* 2V VR */
+/* 2V VR (alarm on when the filtered tilt sensor value rises above) */
 #define     TILT_SWITCH_VOLT_ADC        0x199
 
-/* Display Entire space in row (to clear it) */
-#define     _LCD_SPACE_ROW()              ( LCD_PutString("          "))
+/* 1.8V VR (alarm off when the filtered value falls below, hysteresis) */
+#define     TILT_RELEASE_VOLT_ADC       0x170
+
+/* Events of the debounced buttons (data = SW0 bit 0, SW1 bit 1, SW2 bit 2) */
+#define     VM_EVENT_PRESS              1           /* Pressed                            */
+#define     VM_EVENT_RELEASE            2           /* Released                           */
+#define     VM_EVENT_LONG               3           /* Held for DEBOUNCE_LONG_TICKS (once) */
+
+/* Push Buttons RB0, RB1 and RB2 (active low) */
+#define     VM_BUTTONS_MASK             0x07
+
+/* States with a transition on the push buttons (the ISR reads the state byte of the main loop) */
+#define     _VM_TAKES_BUTTONS(state)    (((state) == VM_STATE_DRINK_SELECTION) || ((state) == VM_STATE_COIN_INSERTION))
+
+/* No drink in stock (gCurrentDrink) */
+#define     VM_SOLD_OUT                 0xFE
+
+/* No drink displayed yet */
+#define     VM_NO_DRINK                 0xFF
+
+/* Dispensers of the catalog slots: slot n --> RAn */
+#define     VM_DISPENSER_PORT           DIO_PORTA
+
+/* Fixed pins (compile time descriptors, DIO_SET/DIO_CLEAR without a call) */
+#define     VM_CHANGE_PIN               A, 1        /* Change dispenser (LED RA1)        */
+#define     VM_BUZZER_PIN               A, 2        /* Alarm buzzer                      */
+
+/* Actuators of PORTA, switched off together in one port write (DIO_WRITE_MASKED) */
+#define     VM_LEDS_MASK                0x03        /* RA0 (slot 0) and RA1 (change)     */
+#define     VM_BUZZER_MASK              0x04        /* RA2                               */
+
+/* Ticks the main loop stays awake after a push button woke it up (debounced on Timer2) */
+#define     VM_WAKE_TICKS               (DEBOUNCE_SAMPLES + 1)
+
+/* Index of the tilt sensor (VR2) in the ADC sampler channel list */
+#define     VM_ADC_TILT                 0
+
+/* Display Entire space in row (to clear it, frame buffer) */
+#define     _LCD_SPACE_ROW()              ( LCD_BufferPutString("          "))
+
+/* Display Zero + spaces (frame buffer) */
+#define     _LCD_0_SPACE_ROW()              ( LCD_BufferPutString("0              "))
 
-/* Display Zero + spaces */
-#define     _LCD_0_SPACE_ROW()              ( LCD_PutString("0              "))
+/* Display Progress Bar (frame buffer) */
+#define     _LCD_DISPLAY_PROGRESS()         (LCD_BufferPutString("...."))
 
-/* Display Progress Bar */
-#define     _LCD_DISPLAY_PROGRESS()         (LCD_PutString("...."))
+/* Duration of the Dispense Drink, Dispense Change and Drink Ready modes */
+#define     VM_STAGE_TIME_MS                5000
+
+/* Number of progress bar updates while dispensing the drink */
+#define     VM_DISPENSE_PROGRESS_STEPS      4
+
+/* Filters a tilt sensor sample (ISR), the level is dispatched to the alarm state machine by the main loop. The
+   blocking build stalls the main loop for 5s while dispensing, so the ISR drives the alarm buzzer as well. */
+#if VM_USE_TILT_FILTER == 1
+#define     _VM_TILT_LEVEL(value)           FILTER_Add(&gTilt, (value))
+#else
+#define     _VM_TILT_LEVEL(value)           ((value) > (gTiltInput ? TILT_RELEASE_VOLT_ADC : TILT_SWITCH_VOLT_ADC))
+#endif
+#if VM_USE_INPUT_TRACE == 1
+#define     _VM_TILT_SAMPLE(value)          (gTiltInput = _VM_TILT_LEVEL(gTraceTilt = (value)))
+#elif VM_USE_SCHEDULER == 1
+#define     _VM_TILT_SAMPLE(value)          (gTiltInput = _VM_TILT_LEVEL(value))
+#else
+#define     _VM_TILT_SAMPLE(value)          do { gTiltInput = _VM_TILT_LEVEL(value);                \
+                                                 DIO_WRITE(VM_BUZZER_PIN, gTiltInput); } while(0)
+#endif
 
 /**********************************************************************************************************************
  *  LOCAL VARIABLES
  *********************************************************************************************************************/
 
-static unsigned int adc_val = 0;                                /* ADC Value */
+#if VM_USE_TILT_FILTER == 1
+static FILTER_t gTilt;                                          /* Tilt sensor filter (VR2) */
+#endif
+
+#if ADC_USE_SAMPLER == 1
+/* Channels sampled by the ADC interrupt (index VM_ADC_TILT = VR2) */
+static const ADC_channel_t gAdcChannels[] = { ADC9 };
+#endif
+
+/* Static Global Variables (main loop only, the ISR sends events) */
+static unsigned char gCurrentState = VM_STATE_INITIAL;          /* Current State of the Vending Machine */
+static unsigned char gCurrentDrink = 0;                         /* Current Selected Drink (catalog index) */
+static unsigned char gShownDrink = VM_NO_DRINK;                 /* Drink on the LCD (name read from the EEPROM) */
+static signed char gCurrentDrinkPrice = 0;                      /* Current Selected Drink Price */
 
-/* Temp variable to store the value of deciaml to ASCII */
-static char temp[2] = {0};
+#if VM_USE_SCHEDULER == 1
+static unsigned char gStage = 0;                                /* Resume point of the current mode */
+#endif
 
-/* Static Global Variables */
-static volatile unsigned char gCurrentState = VM_STATE_INITIAL; /* Current State of the Vending Machine */
-static volatile unsigned char gCurrentDrink = 0;                /* Current Selected Drink */
-static volatile signed char gCurrentDrinkPrice = 0;             /* Current Selected Drink Price */
+#if VM_USE_SLEEP == 1
+static SCHED_tick_t gWakeTick = 0;                              /* Last push button wake-up */
+static unsigned int gSleptUs = 0;                               /* Watchdog sleep not credited as a tick yet */
+#endif
+#if (VM_USE_INVENTORY == 1) && (VM_USE_SCHEDULER == 1)
+static SCHED_tick_t gIdleTick = 0;                              /* Drink selection entered (counters flush) */
+#endif
+
+/* Anti-theft alarm, runs beside the transaction on the same transition table */
+static unsigned char gTiltState = VM_STATE_TILT_SENSING;        /* Current State of the alarm */
+#if VM_USE_TELEMETRY == 1
+static unsigned char gReportedState = VM_STATE_INITIAL;         /* Last state sent (telemetry) */
+#endif
+static volatile unsigned char gTiltInput = 0;                   /* Filtered tilt sensor level (ISR) */
+#if VM_USE_INPUT_TRACE == 1
+static volatile SCHED_tick_t gTraceTick = 0;                    /* Tick of the last samples (ISR) */
+static volatile unsigned char gTraceButtons = 0;                /* Last PORTB sample (ISR) */
+static volatile unsigned int gTraceTilt = 0;                    /* Last tilt sensor sample (ISR) */
+static unsigned char gTraceSent[VM_TLM_INPUT_SIZE];             /* Last input frame sent */
+#endif
+
+/* Transition table [state - VM_STATE_INITIAL][event]: { action, next state }, missing entries are ignored. The
+   completion event an action returns is looked up in the state entered, its entry has no action (no chaining). */
+static const VM_transition_t gTransitions[VM_SM_STATES][VM_SM_EVENTS] =
+{
+    [VM_STATE_INITIAL - VM_STATE_INITIAL] =
+    {
+        [VM_SM_RUN]         = { VM_Reset,                   VM_STATE_DRINK_SELECTION },
+    },
+    [VM_STATE_DRINK_SELECTION - VM_STATE_INITIAL] =
+    {
+        [VM_SM_RUN]         = { VM_Mode_DrinkSelection,     VM_STATE_SAME },
+        [VM_SM_SW0]         = { VM_Action_NextDrink,        VM_STATE_SAME },
+        [VM_SM_SW1]         = { VM_Action_SelectDrink,      VM_STATE_SAME },
+        [VM_SM_DONE]        = { 0,                          VM_STATE_COIN_INSERTION },
+    },
+    [VM_STATE_COIN_INSERTION - VM_STATE_INITIAL] =
+    {
+        [VM_SM_RUN]         = { VM_Mode_CoinInsertion,      VM_STATE_SAME },
+        [VM_SM_SW0]         = { VM_Action_Coin10,           VM_STATE_SAME },
+        [VM_SM_SW1]         = { VM_Action_Coin20,           VM_STATE_SAME },
+        [VM_SM_SW2]         = { VM_Action_Coin50,           VM_STATE_SAME },
+        [VM_SM_DONE]        = { 0,                          VM_STATE_DRINK_DISPENSE },
+    },
+    [VM_STATE_DRINK_DISPENSE - VM_STATE_INITIAL] =
+    {
+        [VM_SM_RUN]         = { VM_Mode_DispenseDrink,      VM_STATE_SAME },
+        [VM_SM_DONE]        = { 0,                          VM_STATE_DRINK_READY },
+        [VM_SM_CHANGE]      = { 0,                          VM_STATE_DISPENSE_CHANGE },
+    },
+    [VM_STATE_DRINK_READY - VM_STATE_INITIAL] =
+    {
+        [VM_SM_RUN]         = { VM_Mode_DrinkReady,         VM_STATE_SAME },
+        [VM_SM_DONE]        = { 0,                          VM_STATE_INITIAL },
+    },
+    [VM_STATE_DISPENSE_CHANGE - VM_STATE_INITIAL] =
+    {
+        [VM_SM_RUN]         = { VM_Mode_DispenseChange,     VM_STATE_SAME },
+        [VM_SM_DONE]        = { 0,                          VM_STATE_DRINK_READY },
+    },
+    [VM_STATE_TILT_SENSING - VM_STATE_INITIAL] =
+    {
+        [VM_SM_TILT]        = { VM_Action_AlarmOn,          VM_STATE_ALARM },
+    },
+    [VM_STATE_ALARM - VM_STATE_INITIAL] =
+    {
+        [VM_SM_TILT_CLEAR]  = { VM_Action_AlarmOff,         VM_STATE_TILT_SENSING },
+    },
+};
 
 /**********************************************************************************************************************
  *  FUNCTIONS
@@ -62,7 +281,8 @@ static volatile signed char gCurrentDrinkPrice = 0;             /* Current Selec
 /******************************************************************************
 * \Syntax          : void VM_Init( void )       
 * \Description     : initializes system components and enter drink selection mode
-                        --> Push Buttons: interrupt-on-change
+                     (cold start, called once)
+                        --> Push Buttons: inputs debounced on the Timer2 tick
                         --> LCD: 4-bit mode
                         --> LEDs: output simulating dispensers
                         --> Buzzer: output
@@ -70,51 +290,102 @@ static volatile signed char gCurrentDrinkPrice = 0;             /* Current Selec
 *******************************************************************************/
 void VM_Init(void)
 {
-    /* Current State --> Initial State */
+    /* Power-on states, VM_Dispatch() makes every transition from here on */
     gCurrentState = VM_STATE_INITIAL;
+    gTiltState = VM_STATE_TILT_SENSING;
+
+#if VM_USE_CLOCK_SCALING == 1
+    /* Crystal (full speed) until the main loop sleeps */
+    CLOCK_Init();
+#endif
+
+#if PROF_ENABLE == 1
+    /* Profiler time base: Timer1 free-running */
+    PROF_Init();
+#endif
 
-    /* LEDs RA0 and RA1 --> Output and LOW initially */
+    /* LEDs RA0 and RA1, Alarm Buzzer RA2 --> LOW (one write) and Output */
+    DIO_WRITE_MASKED(A, VM_LEDS_MASK | VM_BUZZER_MASK, 0x00);
     DIO_setPinMode(DIO_PORTA, DIO_PIN0, DIO_OUTPUT_MODE);
     DIO_setPinMode(DIO_PORTA, DIO_PIN1, DIO_OUTPUT_MODE);
-    DIO_setPinValue(DIO_PORTA, DIO_PIN0, LOW);
-    DIO_setPinValue(DIO_PORTA, DIO_PIN1, LOW);
-    /* Alarm Buzzer RA2 --> Output and LOW initially */
     DIO_setPinMode(DIO_PORTA, DIO_PIN2, DIO_OUTPUT_MODE);
-    DIO_setPinValue(DIO_PORTA, DIO_PIN0, LOW);
-    /* Push Buttons RB0, RB1 and RB2 interrupt-on-change */
-    DIO_setPinMode(DIO_PORTB, DIO_PIN0, DIO_INTERRUPT_CHANGE_MODE);
-    DIO_setPinMode(DIO_PORTB, DIO_PIN1, DIO_INTERRUPT_CHANGE_MODE);
-    DIO_setPinMode(DIO_PORTB, DIO_PIN2, DIO_INTERRUPT_CHANGE_MODE);
+    /* Push Buttons RB0, RB1 and RB2 --> Input, debounced on the Timer2 tick */
+    DIO_setPinMode(DIO_PORTB, DIO_PIN0, DIO_INPUT_MODE_NOPULL);
+    DIO_setPinMode(DIO_PORTB, DIO_PIN1, DIO_INPUT_MODE_NOPULL);
+    DIO_setPinMode(DIO_PORTB, DIO_PIN2, DIO_INPUT_MODE_NOPULL);
+    DEBOUNCE_Init(0);           /* Nothing pressed */
+    EVENT_Init();               /* Button events from the ISR */
 
-    /* Init ADC to use VR2 (tilt-sensor simulation) */
+    /* Drink catalog (EEPROM) --> RAM, the dispenser of every slot is an output */
+    for(unsigned char i = CATALOG_Init(); i > 0; i--)
+        DIO_setPinMode(VM_DISPENSER_PORT, CATALOG_Slot(i - 1), DIO_OUTPUT_MODE);
+
+#if VM_USE_JOURNAL == 1
+    /* Journal (EEPROM): continues after the newest record */
+    JOURNAL_Init();
+#endif
+#if VM_USE_INVENTORY == 1
+    /* Counters (EEPROM): out of stock products of the catalog */
+    INVENTORY_Init(CATALOG_Count());
+#endif
+
+    /* Init ADC to use VR2 (tilt-sensor simulation), sampled every Timer2 tick and filtered */
     ADC_Init();
+#if VM_USE_TILT_FILTER == 1
+    FILTER_Init(&gTilt, TILT_SWITCH_VOLT_ADC, TILT_RELEASE_VOLT_ADC, 0);
+#endif
+#if ADC_USE_SAMPLER == 1
+    ADC_SamplerInit(gAdcChannels, sizeof(gAdcChannels) / sizeof(gAdcChannels[0]));
+#endif
     
     /* Timer2 Configuration */
     T2CONbits.TMR2ON = 0;       /* Disable Timer2 */
-    T2CONbits.T2CKPS = 3;       /* Prescaler 1:16 */
+    T2CONbits.T2CKPS = CLOCK_T2CKPS(CLOCK_FULL_HZ);  /* Prescaler 1:16 */
     T2CONbits.TOUTPS = 0x9;     /* Postscaler 1:10 */
     PIE1bits.TMR2IE = 1;        /* Enable Timer2 Interrupt */
     PIR1bits.TMR2IF = 0;        /* Clear Timer2 Flag */
     PR2 = 0x8E;                 /* Load Timer2 Period Register */
     T2CONbits.TMR2ON = 1;       /* Enable Timer2 */
     TMR2 = 0;
+
+#if LCD_USE_QUEUE == 1
+    /* Timer0 Configuration: LCD transmit queue, one nibble every 256us */
+    OPTION_REGbits.T0CS = 0;    /* Internal clock (timer mode)   */
+    OPTION_REGbits.PSA = 1;     /* Prescaler to WDT --> 1:1      */
+    INTCONbits.TMR0IF = 0;      /* Clear Timer0 Flag             */
+    INTCONbits.TMR0IE = 0;      /* Enabled while the LCD queue is not empty (LCD_Enqueue) */
+#endif
+
+#if VM_USE_SLEEP == 1
+    /* Sleep mode: the push buttons and the watchdog (16.5ms) wake the main loop up */
+    POWER_Init(VM_BUTTONS_MASK);
+#endif
+
+#if VM_USE_SCHEDULER == 1
+    /* Scheduler ticks on Timer2, the vending machine modes run as a task */
+    SCHED_Init();
+    SCHED_AddTask(VM_Task);
+#endif
     
     /* LCD INIT */
-    LCD lcd = { &PORTC, 0, 3, 4, 5, 6, 7 }; /* PORT, RS, EN, D4, D5, D6, D7 */
+    LCD lcd = { &PORTC, 0, 3, 4, 5, 6, 7, LCD_NO_PIN }; /* PORT, RS, EN, D4, D5, D6, D7, RW */
     LCD_Init(lcd);
-    LCD_Clear();
+    LCD_BufferClear();
+
+#if VM_USE_TELEMETRY == 1
+    /* Telemetry: EUSART transmitter on RC6, frames sent by the TXIF interrupt */
+    UART_Init(UART_SPBRG(CLOCK_FULL_HZ));
+    gReportedState = VM_STATE_INITIAL;
+#endif
     
     _ENABLE_GLOBAL_INTERRUPTS();             /* Enable Global Interrupts (GIE) */
     _ENABLE_PERIPHERAL_INTERRUPTS();         /* Enable peripheral interrupts   */
+#if LCD_USE_QUEUE == 1
+    LCD_WaitIdle();                          /* LCD init sequence and clear sent */
+#endif
     
     /* Enter Drink Selection Mode */
-    /* Current State --> Drink Selection State */
-    gCurrentState = VM_STATE_DRINK_SELECTION;
-    /* Current Drink --> Cola Drink */
-    gCurrentDrink = VM_DRINK_COLA;
-    
-    LCD_SetCursor(0,0);
-    LCD_PutString("Select Drink:");
+    VM_Dispatch(&gCurrentState, VM_SM_RUN);
 }
 
 /******************************************************************************
@@ -123,106 +394,427 @@ void VM_Init(void)
 *******************************************************************************/
 void VM_Running(void)
 {
-    /* If final state reached (Drink Ready) ... reset Vending Machine */
+    VM_HandleEvents();    /* Button presses queued by the ISR, in order, and the tilt sensor */
+
+    /* If final state reached (Drink Ready) ... reset Vending Machine (presses still queued were ignored) */
     if(gCurrentState == VM_STATE_INITIAL)
-        VM_Init();        /* Reset Vending Machine */
-        
-    /* Check Current State and Execute the corresponding function */
-    switch (gCurrentState)
+        VM_Dispatch(&gCurrentState, VM_SM_RUN);       /* Next customer (warm restart) */
+
+#if VM_USE_SCHEDULER == 1
+    SCHED_Run();          /* Run the modes that are due (never blocks) */
+#else
+    VM_Task();
+#endif
+
+#if VM_USE_TELEMETRY == 1
+    /* State changes of this pass (a transient state is not sent) */
+    if(gCurrentState != gReportedState)
     {
-    case VM_STATE_DRINK_SELECTION:
-        VM_Mode_DrinkSelection();
-        break;
-    case VM_STATE_COIN_INSERTION:
-        VM_Mode_CoinInsertion();
-        break;
-    case VM_STATE_DRINK_DISPENSE:
-        VM_Mode_DispenseDrink();
-        break;
-    case VM_STATE_DRINK_READY:
-        LCD_SetCursor(0,0);
-        LCD_PutString("Please Collect    ");
-        LCD_SetCursor(1,0);
-        LCD_PutString("Your Drink!     ");
-        /* Using Timer1 to generate 5s Delay */
-        TIMR1_Delay5s();
-        gCurrentState = VM_STATE_INITIAL;       /* Reset Vending Machine State */
-        break;
-    case VM_STATE_DISPENSE_CHANGE:
-        VM_Mode_DispenseChange();
-        break;
-    default:
-        break;
+        gReportedState = gCurrentState;
+        UART_Send(VM_TLM_STATE, &gReportedState, 1);
+    }
+#endif
+
+#if VM_USE_INPUT_TRACE == 1
+    VM_TraceInputs();     /* Samples of the last tick, if they changed */
+#endif
+
+#if VM_USE_JOURNAL == 1
+    /* Records of the transaction written while the machine waits for the customer (never waits) */
+    if((gCurrentState == VM_STATE_DRINK_SELECTION) || (gCurrentState == VM_STATE_COIN_INSERTION))
+        JOURNAL_Commit();
+#endif
+
+#if VM_USE_INVENTORY == 1
+    /* Sales queued to the EEIF writer once the machine has waited for the next customer, or after INVENTORY_DIRTY_MAX
+       of them (never waits) */
+    if((gCurrentState == VM_STATE_DRINK_SELECTION) && INVENTORY_Dirty() &&
+       ((INVENTORY_Dirty() >= INVENTORY_DIRTY_MAX)
+#if VM_USE_SCHEDULER == 1
+        || ((SCHED_tick_t)(SCHED_Now() - gIdleTick) >= SCHED_MS_TO_TICKS(VM_INVENTORY_IDLE_MS))
+#endif
+       ))
+        INVENTORY_Flush();
+#endif
+
+#if VM_USE_CLOCK_SCALING == 1
+    /* Full speed for the LCD and the timed modes (a watchdog wake-up runs on the idle clock) */
+    if(!LCD_Idle() || ((gCurrentState != VM_STATE_DRINK_SELECTION) && (gCurrentState != VM_STATE_COIN_INSERTION)))
+        CLOCK_Set(CLOCK_FULL);
+#endif
+
+    PROF_BEGIN(VM_PROBE_LCD_FLUSH);
+    LCD_Flush();          /* Send only the characters that changed */
+    PROF_END(VM_PROBE_LCD_FLUSH);
+
+#if VM_USE_SLEEP == 1
+    VM_Sleep();           /* Until the next button change or watchdog time-out */
+#endif
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_Reset( void )       
+* \Description     : Private action that resets the transaction before drink
+                     selection mode (warm restart), the peripherals and the
+                     LCD stay configured and only the changed characters are
+                     redrawn [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_Reset(void)
+{
+    /* Dispensers off (one write) */
+    DIO_WRITE_MASKED(A, VM_LEDS_MASK, 0x00);
+
+    /* Current Drink --> First drink of the catalog (in stock) */
+    gCurrentDrink = VM_FirstInStock(0);
+    gShownDrink = VM_NO_DRINK;      /* The other modes wrote over the drink row */
+    gCurrentDrinkPrice = 0;
+#if VM_USE_SCHEDULER == 1
+    gStage = 0;
+#endif
+#if (VM_USE_INVENTORY == 1) && (VM_USE_SCHEDULER == 1)
+    gIdleTick = SCHED_Now();
+#endif
+
+    /* Whole row: overwrites the previous message in the frame buffer */
+    LCD_BufferSetCursor(0,0);
+    LCD_BufferPutString("Select Drink:   ");
+    return VM_SM_NONE;
+}
+
+/******************************************************************************
+* \Syntax          : static void VM_Task( void )       
+* \Description     : Private function that executes the function of the
+                     current state (scheduler task) [USED INTERNALLY].
+*******************************************************************************/
+static void VM_Task(void)
+{
+#if PROF_ENABLE == 1
+    unsigned char probe = VM_PROBE_MODE(gCurrentState);     /* The mode may change the state */
+#endif
+
+    /* Execute the mode of the current state */
+    PROF_BEGIN(probe);
+    VM_Dispatch(&gCurrentState, VM_SM_RUN);
+    PROF_END(probe);
+}
+
+/******************************************************************************
+* \Syntax          : static void VM_Dispatch( unsigned char *state,
+                                             unsigned char event )
+* \Description     : Private function that looks up (state, event) in the
+                     transition table, executes the action, enters the next
+                     state and dispatches the completion event of the action
+                     (at most two lookups) [USED INTERNALLY].
+*******************************************************************************/
+static void VM_Dispatch(unsigned char *state, unsigned char event)
+{
+    const VM_transition_t *transition;
+
+    do
+    {
+        transition = &gTransitions[*state - VM_STATE_INITIAL][event];
+        event = transition->action ? transition->action() : VM_SM_NONE;
+        if(transition->next != VM_STATE_SAME)
+            *state = transition->next;
+    } while(event != VM_SM_NONE);
+}
+
+
+/******************************************************************************
+* \Syntax          : static void VM_HandleEvents( void )       
+* \Description     : Private function that dispatches the button events queued
+                     by the ISR in order and the tilt sensor level
+                     [USED INTERNALLY].
+*******************************************************************************/
+static void VM_HandleEvents(void)
+{
+    EVENT_t event;
+    unsigned char buttons;
+    unsigned char sm_event;
+
+    while(EVENT_Pop(&event))
+    {
+        if(EVENT_TYPE(event) != VM_EVENT_PRESS)
+            continue;                   /* No transition on a release or a long press */
+        /* Simultaneous presses: every button is applied (SW0, SW1, SW2 order) */
+        buttons = EVENT_DATA(event);
+        for(sm_event = VM_SM_SW0; buttons != 0; sm_event++, buttons >>= 1)
+        {
+            if (buttons & 0x01)     /* If SWx is pressed (RBx was low) */
+                VM_Dispatch(&gCurrentState, sm_event);
+        }
+    }
+
+    /* Level events: TILT is ignored in alarm state, TILT_CLEAR in tilt sensing state */
+    VM_Dispatch(&gTiltState, gTiltInput ? VM_SM_TILT : VM_SM_TILT_CLEAR);
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_Action_NextDrink( void )
+* \Description     : Private action that selects the next drink of the
+                     catalog in stock (SW0 in drink selection mode)
+                     [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_Action_NextDrink(void)
+{
+    if(gCurrentDrink < CATALOG_Count())
+        gCurrentDrink = VM_FirstInStock(gCurrentDrink + 1);
+    return VM_SM_NONE;
+}
+
+#if VM_USE_INPUT_TRACE == 1
+/******************************************************************************
+* \Syntax          : static void VM_TraceInputs( void )
+* \Description     : Private function that sends the samples of the last
+                     tick (push buttons, tilt sensor) in a VM_TLM_INPUT frame
+                     if they differ from the last frame sent, a frame dropped
+                     (ring buffer full) is sent again at the next pass with
+                     the samples of that tick [USED INTERNALLY].
+*******************************************************************************/
+static void VM_TraceInputs(void)
+{
+    unsigned char frame[VM_TLM_INPUT_SIZE];
+
+    _DISABLE_GLOBAL_INTERRUPTS();       /* Samples of the same tick */
+    frame[0] = (unsigned char)gTraceTick;
+    frame[1] = (unsigned char)(gTraceTick >> 8);
+    frame[2] = gTraceButtons;
+    frame[3] = (unsigned char)(gTraceTilt >> 8);
+    frame[4] = (unsigned char)gTraceTilt;
+    _ENABLE_GLOBAL_INTERRUPTS();
+
+    if((frame[0] | frame[1]) == 0)      /* No tick yet */
+        return;
+    if((frame[2] == gTraceSent[2]) && (frame[3] == gTraceSent[3]) && (frame[4] == gTraceSent[4]) &&
+       ((gTraceSent[0] | gTraceSent[1]) != 0))
+        return;
+    if(UART_Send(VM_TLM_INPUT, frame, sizeof(frame)))
+    {
+        for(unsigned char i = 0; i < sizeof(frame); i++)
+            gTraceSent[i] = frame[i];
+    }
+}
+#endif
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_FirstInStock( unsigned char from )
+* \Description     : Private function that returns the first drink in stock
+                     from a catalog index on (wraps around to the first
+                     drink), VM_SOLD_OUT if there is none, the stock is read
+                     from RAM [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_FirstInStock(unsigned char from)
+{
+    unsigned char count = CATALOG_Count();
+
+    if(from >= count)
+        from = 0;                                       /* First Drink */
+#if VM_USE_INVENTORY == 1
+    for(unsigned char i = 0; i < count; i++)
+    {
+        if(INVENTORY_Available(from))
+            return from;
+        if(++from >= count)
+            from = 0;
     }
+    return (count == 0) ? 0 : VM_SOLD_OUT;
+#else
+    return from;
+#endif
+}
+
+/******************************************************************************
+* \Syntax          : static void VM_PutDigit( unsigned char digit )
+* \Description     : Private function that writes a decimal digit in the LCD
+                     frame buffer at the cursor [USED INTERNALLY].
+*******************************************************************************/
+static void VM_PutDigit(unsigned char digit)
+{
+    char text[2];           /* Decimal value to ASCII character (stack, not static RAM) */
+
+    text[0] = (char)('0' + digit);
+    text[1] = '\0';
+    LCD_BufferPutString(text);
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_Action_SelectDrink( void )
+* \Description     : Private action that loads the price of the selected
+                     drink, VM_SM_DONE: coin insertion mode (SW1 in drink
+                     selection mode) [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_Action_SelectDrink(void)
+{
+    if(gCurrentDrink >= CATALOG_Count())
+        return VM_SM_NONE;                              /* Empty catalog: nothing to sell */
+    gCurrentDrinkPrice = CATALOG_Price(gCurrentDrink);  /* Update Current Drink Price */
+    return VM_SM_DONE;                                  /* --> Coin Insertion */
 }
 
+/******************************************************************************
+* \Syntax          : static unsigned char VM_Action_Coin10( void )
+* \Description     : Private action that inserts 10p (SW0) [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_Action_Coin10(void)
+{
+    gCurrentDrinkPrice -= 1;      /* Update Current Drink Price */
+    return VM_SM_NONE;
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_Action_Coin20( void )
+* \Description     : Private action that inserts 20p (SW1) [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_Action_Coin20(void)
+{
+    gCurrentDrinkPrice -= 2;      /* Update Current Drink Price */
+    return VM_SM_NONE;
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_Action_Coin50( void )
+* \Description     : Private action that inserts 50p (SW2) [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_Action_Coin50(void)
+{
+    gCurrentDrinkPrice -= 5;      /* Update Current Drink Price */
+    return VM_SM_NONE;
+}
 
 /******************************************************************************
-* \Syntax          : static void VM_Mode_DrinkSelection( void )       
+* \Syntax          : static unsigned char VM_Action_AlarmOn( void )
+* \Description     : Private action that turns the alarm buzzer on (tilt
+                     sensing --> alarm) [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_Action_AlarmOn(void)
+{
+    DIO_SET(VM_BUZZER_PIN);                         /* Alarm Buzzer */
+#if VM_USE_TELEMETRY == 1
+    unsigned char on = 1;
+    UART_Send(VM_TLM_ALARM, &on, 1);
+#endif
+#if VM_USE_JOURNAL == 1
+    JOURNAL_Append(VM_JOURNAL_ALARM, 1);
+#endif
+    return VM_SM_NONE;
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_Action_AlarmOff( void )
+* \Description     : Private action that turns the alarm buzzer off (alarm
+                     --> tilt sensing) [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_Action_AlarmOff(void)
+{
+    DIO_CLEAR(VM_BUZZER_PIN);                       /* Alarm Buzzer */
+#if VM_USE_TELEMETRY == 1
+    unsigned char on = 0;
+    UART_Send(VM_TLM_ALARM, &on, 1);
+#endif
+#if VM_USE_JOURNAL == 1
+    JOURNAL_Append(VM_JOURNAL_ALARM, 0);
+#endif
+    return VM_SM_NONE;
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_Mode_DrinkSelection( void )       
 * \Description     : Private function used to provide a user interface through
                      which the customer can select a drink and view the prices
                      [USED INTERNALLY].
 *******************************************************************************/
-static void VM_Mode_DrinkSelection(void)
+static unsigned char VM_Mode_DrinkSelection(void)
 {
-    /* Display the current selected drink and its price */
-    LCD_SetCursor(1,0);
-    switch (gCurrentDrink)
+    char name[CATALOG_NAME_LENGTH + 1];
+
+    /* Display the current selected drink and its price (the EEPROM is only read when it changed) */
+    if(gCurrentDrink == gShownDrink)
+        return VM_SM_NONE;
+    gShownDrink = gCurrentDrink;
+    LCD_BufferSetCursor(1,0);
+    if(gCurrentDrink == VM_SOLD_OUT)
+    {
+        LCD_BufferPutString("Sold Out        ");      /* Every product out of stock */
+        return VM_SM_NONE;
+    }
+    if(gCurrentDrink >= CATALOG_Count())
     {
-        case VM_DRINK_COLA:
-            LCD_PutString("Cola 80p      ");
-            break;
-        case VM_DRINK_LEMONADE:
-            LCD_PutString("Lemonade 80p");
-            break;
-        case VM_DRINK_ORANGE:
-            LCD_PutString("Orange 60p    ");
-            break;
-        case VM_DRINK_WATER:
-            LCD_PutString("Water 50p     ");
-            break;
+        LCD_BufferPutString("Out of Order    ");      /* No valid catalog in the EEPROM */
+        return VM_SM_NONE;
     }
+    /* "<name> <price>0p" */
+    CATALOG_Name(gCurrentDrink, name);
+    LCD_BufferPutString(name);
+    LCD_BufferPutString(" ");
+    VM_PutDigit(CATALOG_Price(gCurrentDrink));
+    LCD_BufferPutString("0p");
+    _LCD_SPACE_ROW();
+    return VM_SM_NONE;
 }
 
 /******************************************************************************
-* \Syntax          : static void VM_Mode_CoinInsertion( void )       
+* \Syntax          : static unsigned char VM_Mode_CoinInsertion( void )       
 * \Description     : Private function used to simulate the insertion of coins
                      by the customer and the display updates to show the
-                     outstanding balance [USED INTERNALLY].
+                     outstanding balance, VM_SM_DONE once paid
+                     [USED INTERNALLY].
 *******************************************************************************/
-static void VM_Mode_CoinInsertion(void)
+static unsigned char VM_Mode_CoinInsertion(void)
 {
     /* If drink price is not paid yet */
     if(gCurrentDrinkPrice > 0)
     {
-        /* Convert decimal value to ASCII character to be displayed */
-        temp[0] = '0' + (gCurrentDrinkPrice);
-    
         /* Display the following on LCD */
-        LCD_SetCursor(0,0);
-        LCD_PutString("Insert Coins:  ");
-        LCD_SetCursor(1,0);
-        LCD_PutString(temp);
+        LCD_BufferSetCursor(0,0);
+        LCD_BufferPutString("Insert Coins:  ");
+        LCD_BufferSetCursor(1,0);
+        VM_PutDigit((unsigned char)gCurrentDrinkPrice);
         _LCD_0_SPACE_ROW();
+        return VM_SM_NONE;
     }
-    else if (gCurrentDrinkPrice <= 0)               /* Dispense Drink */
-        gCurrentState = VM_STATE_DRINK_DISPENSE;
+    /* Paid: wait for the buttons to be released, a coin pressed with the last one but debounced a tick later is
+       credited before the machine leaves coin insertion */
+    if(DEBOUNCE_State() & VM_BUTTONS_MASK)
+        return VM_SM_NONE;
+    return VM_SM_DONE;                              /* Paid --> Dispense Drink */
 }
 
 /******************************************************************************
-* \Syntax          : static void VM_Mode_DispenseDrink( void )       
+* \Syntax          : static unsigned char VM_Mode_DispenseDrink( void )       
 * \Description     : Private function used to simulate dispensing of the drink
-                     by using LED and update LCD display [USED INTERNALLY].
+                     by using LED and update LCD display, VM_SM_DONE (no
+                     change) or VM_SM_CHANGE once dispensed [USED INTERNALLY].
 *******************************************************************************/
-static void VM_Mode_DispenseDrink(void)
+static unsigned char VM_Mode_DispenseDrink(void)
 {
-        DIO_setPinValue(DIO_PORTA, DIO_PIN0, HIGH);     /* RA0 HIGH */
+#if VM_USE_SCHEDULER == 1
+        if(gStage == 0)
+        {
+            DIO_setPinValue(VM_DISPENSER_PORT, CATALOG_Slot(gCurrentDrink), HIGH);  /* RA0 HIGH (slot 0) */
+            /* Display the following on LCD */
+            LCD_BufferSetCursor(0,0);
+            LCD_BufferPutString("Drink Dispensing");
+            LCD_BufferSetCursor(1,0);
+            _LCD_SPACE_ROW();
+            LCD_BufferSetCursor(1,0);
+        }
+        /* Update the progress bar and yield until the next step */
+        if(gStage < VM_DISPENSE_PROGRESS_STEPS)
+        {
+            _LCD_DISPLAY_PROGRESS();
+            gStage++;
+            SCHED_Sleep(SCHED_MS_TO_TICKS(VM_STAGE_TIME_MS / VM_DISPENSE_PROGRESS_STEPS));
+            return VM_SM_NONE;
+        }
+        gStage = 0;
+#else
+        DIO_setPinValue(VM_DISPENSER_PORT, CATALOG_Slot(gCurrentDrink), HIGH);  /* RA0 HIGH (slot 0) */
         /* Display the following on LCD */
-        LCD_SetCursor(0,0);
-        LCD_PutString("Drink Dispensing");
-        LCD_SetCursor(1,0);
+        LCD_BufferSetCursor(0,0);
+        LCD_BufferPutString("Drink Dispensing");
+        LCD_BufferSetCursor(1,0);
         _LCD_SPACE_ROW();
-        LCD_SetCursor(1,0);
+        LCD_BufferSetCursor(1,0);
         /* Using Timer0 to generate 5s Delay */
         OPTION_REGbits.T0CS = 0;    /* Set clock source to internal (timer mode) */
         OPTION_REGbits.PSA = 0;     /* Set prescaler to Timer 0                  */
@@ -238,22 +830,43 @@ static void VM_Mode_DispenseDrink(void)
                     _LCD_DISPLAY_PROGRESS();
             else if(i == 70)
                     _LCD_DISPLAY_PROGRESS();
+            LCD_Flush();
             INTCONbits.TMR0IF = 0;  /* Reset overflow flag, TMR0IF */
         }
-        DIO_setPinValue(DIO_PORTA, DIO_PIN0, LOW);     /* RA0 LOW */
-        if(gCurrentDrinkPrice == 0)         /* No Change */
-            gCurrentState = VM_STATE_DRINK_READY;
-        else                                /* There is change */
-            gCurrentState = VM_STATE_DISPENSE_CHANGE;
+#endif
+        DIO_setPinValue(VM_DISPENSER_PORT, CATALOG_Slot(gCurrentDrink), LOW);   /* RA0 LOW (slot 0) */
+#if VM_USE_TELEMETRY == 1
+        unsigned char sale[3] = { gCurrentDrink, CATALOG_Price(gCurrentDrink), (unsigned char)-gCurrentDrinkPrice };
+        UART_Send(VM_TLM_SALE, sale, sizeof(sale));
+#endif
+#if VM_USE_JOURNAL == 1
+        JOURNAL_Append(VM_JOURNAL_SALE(gCurrentDrink), CATALOG_Price(gCurrentDrink));
+#endif
+#if VM_USE_INVENTORY == 1
+        INVENTORY_Sold(gCurrentDrink);
+#endif
+        if(gCurrentDrinkPrice == 0)         /* No Change --> Drink Ready */
+            return VM_SM_DONE;
+        return VM_SM_CHANGE;                /* There is change --> Dispense Change */
 }
 
 /******************************************************************************
-* \Syntax          : static void VM_Mode_DispenseChange( void )       
+* \Syntax          : static unsigned char VM_Mode_DispenseChange( void )       
 * \Description     : Private function used to simulate dispensing of the change
-                     by using LED and update LCD display [USED INTERNALLY].
+                     by using LED and update LCD display, VM_SM_DONE after 5s
+                     [USED INTERNALLY].
 *******************************************************************************/
-static void VM_Mode_DispenseChange(void)
+static unsigned char VM_Mode_DispenseChange(void)
 {
+#if VM_USE_SCHEDULER == 1
+    /* Second stage: change dispensed */
+    if(gStage != 0)
+    {
+        gStage = 0;
+        DIO_CLEAR(VM_CHANGE_PIN);                      /* RA1 LOW */
+        return VM_SM_DONE;                             /* --> Drink Ready */
+    }
+#endif
     /* Calculate the number of coins to be dispensed */
     char change_count = 0;
     while(gCurrentDrinkPrice != 0)    /* While there is still change */
@@ -261,21 +874,137 @@ static void VM_Mode_DispenseChange(void)
             gCurrentDrinkPrice++;
             change_count++;
         }
-        /* Convert decimal value to ASCII character to be displayed */
-        temp[0] = '0' + (change_count);
-
-        DIO_setPinValue(DIO_PORTA, DIO_PIN1, HIGH);     /* RA1 HIGH */
-        LCD_SetCursor(0,0);
-        LCD_PutString("Change due:     ");
-        LCD_SetCursor(1,0);
-        LCD_PutString(temp);
+#if VM_USE_JOURNAL == 1
+        JOURNAL_Append(VM_JOURNAL_CHANGE, change_count);
+#endif
+
+        DIO_SET(VM_CHANGE_PIN);                         /* RA1 HIGH */
+        LCD_BufferSetCursor(0,0);
+        LCD_BufferPutString("Change due:     ");
+        LCD_BufferSetCursor(1,0);
+        VM_PutDigit((unsigned char)change_count);
         _LCD_0_SPACE_ROW();
+#if VM_USE_SCHEDULER == 1
+        /* Yield for 5s */
+        gStage = 1;
+        SCHED_Sleep(SCHED_MS_TO_TICKS(VM_STAGE_TIME_MS));
+        return VM_SM_NONE;
+#else
         /* Using Timer1 to generate 5s Delay */
+        LCD_Flush();
         TIMR1_Delay5s();
-        DIO_setPinValue(DIO_PORTA, DIO_PIN1, LOW);     /* RA1 LOW */
-        gCurrentState = VM_STATE_DRINK_READY;
+        DIO_CLEAR(VM_CHANGE_PIN);                      /* RA1 LOW */
+        return VM_SM_DONE;                             /* --> Drink Ready */
+#endif
+}
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_Mode_DrinkReady( void )       
+* \Description     : Private function used to ask the customer to collect the
+                     drink for 5s, VM_SM_DONE: reset the vending machine
+                     [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_Mode_DrinkReady(void)
+{
+#if VM_USE_SCHEDULER == 1
+    /* Second stage: 5s elapsed */
+    if(gStage != 0)
+    {
+        gStage = 0;
+        return VM_SM_DONE;                      /* Reset Vending Machine State */
+    }
+#endif
+    LCD_BufferSetCursor(0,0);
+    LCD_BufferPutString("Please Collect    ");
+    LCD_BufferSetCursor(1,0);
+    LCD_BufferPutString("Your Drink!     ");
+#if VM_USE_SCHEDULER == 1
+    /* Yield for 5s */
+    gStage = 1;
+    SCHED_Sleep(SCHED_MS_TO_TICKS(VM_STAGE_TIME_MS));
+    return VM_SM_NONE;
+#else
+    /* Using Timer1 to generate 5s Delay */
+    LCD_Flush();
+    TIMR1_Delay5s();
+    return VM_SM_DONE;                      /* Reset Vending Machine State */
+#endif
+}
+
+#if VM_USE_SLEEP == 1
+/******************************************************************************
+* \Syntax          : static void VM_Sleep( void )
+* \Description     : Private function that sleeps while the machine waits for
+                     the customer and nothing is pending (button event or
+                     press, LCD transfer, tilt sensor conversion). Timer2
+                     stops in sleep mode: the watchdog periods slept are
+                     added up and a wake-up runs the tick at once when they
+                     make one (scheduler time and tilt sensor rate kept, a
+                     16.5ms period ticks on about 5 wake-ups out of 7), a push
+                     button keeps the main loop awake until it is debounced on
+                     the Timer2 ticks. With clock scaling the device sleeps on
+                     the internal oscillator and a push button brings the
+                     crystal back. A queued EEPROM write (journal, counters)
+                     goes on in sleep mode, its EEIF wake-up only runs the ISR
+                     [USED INTERNALLY].
+*******************************************************************************/
+static void VM_Sleep(void)
+{
+    /* The timed modes and the long press need the Timer2 time base */
+    if((gCurrentState != VM_STATE_DRINK_SELECTION) && (gCurrentState != VM_STATE_COIN_INSERTION))
+        return;
+    /* Work left (RAM only, checked again with the interrupts disabled) */
+    if(EVENT_Pending() || !LCD_Idle() || (DEBOUNCE_State() & VM_BUTTONS_MASK) ||
+       ((SCHED_tick_t)(SCHED_Now() - gWakeTick) < VM_WAKE_TICKS))
+        return;
+#if VM_USE_TELEMETRY == 1
+    if(!UART_Idle())                    /* The EUSART stops in sleep mode */
+        return;
+#endif
+
+    _DISABLE_GLOBAL_INTERRUPTS();       /* Nothing may become pending between the checks and SLEEP */
+    if(!EVENT_Pending() && LCD_Idle() && !((~PORTB | DEBOUNCE_State()) & VM_BUTTONS_MASK)
+#if ADC_USE_SAMPLER == 1
+       && !ADC_SamplerBusy()
+#endif
+#if VM_USE_TELEMETRY == 1
+       && UART_Idle()
+#endif
+      )
+    {
+#if LCD_USE_QUEUE == 1
+        INTCONbits.TMR0IF = 0;          /* Queue empty: no tick needed, would wake up at once */
+#endif
+#if VM_USE_CLOCK_SCALING == 1
+        CLOCK_Set(CLOCK_IDLE);          /* Wakes up at once, without the crystal start-up */
+#endif
+        switch(POWER_Sleep())
+        {
+            case POWER_WAKE_WATCHDOG:
+                /* Timer2 stopped for one watchdog period: tick once the periods slept add up to a tick */
+                gSleptUs += POWER_WDT_US;
+                if(gSleptUs >= SCHED_TICK_US)
+                {
+                    gSleptUs -= SCHED_TICK_US;
+                    TMR2 = 0;               /* Next tick one period after this one */
+                    PIR1bits.TMR2IF = 1;    /* Tick now (serviced when enabled)    */
+                }
+                break;
+            case POWER_WAKE_PIN:
+                gWakeTick = SCHED_Now();    /* Bouncing: samples one tick apart */
+#if VM_USE_CLOCK_SCALING == 1
+                CLOCK_Set(CLOCK_FULL);      /* Customer: debouncing and LCD at full speed */
+#endif
+                break;
+            default:
+                break;
+        }
+    }
+    _ENABLE_GLOBAL_INTERRUPTS();
 }
+#endif
 
+#if VM_USE_SCHEDULER == 0
 /******************************************************************************
 * \Syntax          : static void TIMR1_Delay5s( void )       
 * \Description     : Private function used to generate 5s delay using Timer1
@@ -291,89 +1020,95 @@ static void TIMR1_Delay5s(void)
         PIR1bits.TMR1IF = 0;      /* Reset overflow flag */
     }
 }
+#endif
 
 /*************************************************************************************/
 /************************** Interrupt service routine (ISR) **************************/
 /*************************************************************************************/
 void __interrupt() myISR(void)
 {
-    static volatile unsigned char timer_count = 0;
+    DEBOUNCE_events_t buttons;
     
-    if (INTCONbits.RBIF) /* If RB interrupt flag is set */
+    if (PIR1bits.TMR2IF)
     {
-        if (PORTBbits.RB0 == 0) /* If SW0 is pressed (RB0 is low) */
-        {
-           switch (gCurrentState)
-              {
-                case VM_STATE_DRINK_SELECTION:
-                    if(gCurrentDrink < VM_DRINK_WATER)
-                        gCurrentDrink++;                    /* Update Current Drink */
-                    else
-                        gCurrentDrink = VM_DRINK_COLA;      /* First Drink */
-                    break;
-                /* Insert 10 coins */
-                case VM_STATE_COIN_INSERTION:
-                    gCurrentDrinkPrice -= 1;      /* Update Current Drink Price */
-                    break;
-              }
-        }
-        else if (PORTBbits.RB1 == 0) /* If SW1 is pressed (RB1 is low) */
+        PROF_BEGIN(VM_PROBE_ISR_TICK);
+#if VM_USE_SCHEDULER == 1
+        SCHED_Tick();                           /* Scheduler time base */
+#endif
+        /* Debounces the whole PORTB (active low), the presses are handled by the main loop */
+#if VM_USE_INPUT_TRACE == 1
+        gTraceTick = SCHED_Now();
+        gTraceButtons = PORTB;
+        DEBOUNCE_Tick(~gTraceButtons, &buttons);
+        gTraceButtons &= VM_BUTTONS_MASK;       /* Sample sent by VM_TraceInputs() */
+#else
+        DEBOUNCE_Tick(~PORTB, &buttons);
+#endif
+        /* Queued only in the states that take the buttons: the other modes may not drain the queue for 5s */
+        if (_VM_TAKES_BUTTONS(gCurrentState))
         {
-            switch (gCurrentState)
-              {
-                case VM_STATE_DRINK_SELECTION:
-                    gCurrentState = VM_STATE_COIN_INSERTION; /* Update Current State */
-                    switch (gCurrentDrink)
-                    {
-                        case VM_DRINK_COLA:
-                            gCurrentDrinkPrice = VM_COIN_COLA_80;        /* Update Current Drink Price */
-                            break;
-                        case VM_DRINK_LEMONADE:
-                            gCurrentDrinkPrice = VM_COIN_LEMONADE_80;        /* Update Current Drink Price */
-                            break;
-                        case VM_DRINK_ORANGE:
-                            gCurrentDrinkPrice = VM_COIN_ORANGE_60;        /* Update Current Drink Price */
-                            break;
-                        case VM_DRINK_WATER:
-                            gCurrentDrinkPrice = VM_COIN_WATER_50;        /* Update Current Drink Price */
-                            break;
-                    }
-                    break;
-                    /* Insert 20 coins */
-                    case VM_STATE_COIN_INSERTION:
-                    gCurrentDrinkPrice -= 2;      /* Update Current Drink Price */
-                    break;
-              }
+            if (buttons.pressed & VM_BUTTONS_MASK)
+                EVENT_Push(EVENT_MAKE(VM_EVENT_PRESS, buttons.pressed & VM_BUTTONS_MASK));
+            if (buttons.released & VM_BUTTONS_MASK)
+                EVENT_Push(EVENT_MAKE(VM_EVENT_RELEASE, buttons.released & VM_BUTTONS_MASK));
+            if (buttons.long_press & VM_BUTTONS_MASK)
+                EVENT_Push(EVENT_MAKE(VM_EVENT_LONG, buttons.long_press & VM_BUTTONS_MASK));
         }
-        else if (PORTBbits.RB2 == 0) /* If SW2 is pressed (RB2 is low) */
-        {
-            switch (gCurrentState)
-            {
-                /* Inset 50 coins */
-                case VM_STATE_COIN_INSERTION:
-                    gCurrentDrinkPrice -= 5;      /* Update Current Drink Price */
-                    break;
-            }
-        }
-        INTCONbits.RBIF = 0;         /* Clear RB interrupt flag */
+        /* Samples the tilt sensor (VR2) every tick (22.88ms) for anti-theft detection */
+#if ADC_USE_SAMPLER == 1
+        ADC_SamplerStart();                 /* Result collected by the ADC interrupt */
+#else
+        _VM_TILT_SAMPLE(ADC_Read(ADC9));        /* Read ADC Channel 9 (VR2), filtered VR2 > 2V (until < 1.8V) */
+#endif
+        PIR1bits.TMR2IF = 0; /* Reset interrupt flag */
+        PROF_END(VM_PROBE_ISR_TICK);
         return;
     }
-    if (PIR1bits.TMR2IF)
+#if ADC_USE_SAMPLER == 1
+    if (PIR1bits.ADIF)
     {
-        timer_count++;
-        /* Checks every 500ms the tilt sensor (VR2) for anti-theft detection */
-        if(timer_count == TIMER2_NO_OF_OVERFLOWS_2HZ)
-        {
-            timer_count = 0;                            /* Reset Counter */
-            adc_val = ADC_Read(ADC9);           /* Read ADC Channel 9 (VR2) */
-            if(adc_val > TILT_SWITCH_VOLT_ADC)  /* If VR2 > 2V */
-                DIO_setPinValue(DIO_PORTA, DIO_PIN2, HIGH);     /* Turn on Alarm Buzzer */
-            else
-                DIO_setPinValue(DIO_PORTA, DIO_PIN2, LOW);      /* Turn off Alarm Buzzer */
-        }
-        PIR1bits.TMR2IF = 0; /* Reset interrupt flag */
+        PROF_BEGIN(VM_PROBE_ISR_ADC);
+        PIR1bits.ADIF = 0;                      /* Reset interrupt flag */
+        ADC_SamplerComplete();                  /* Latest value cache   */
+        _VM_TILT_SAMPLE(ADC_Latest(VM_ADC_TILT));   /* VR2 filtered: > 2V (until < 1.8V) */
+        PROF_END(VM_PROBE_ISR_ADC);
+        return;
+    }
+#endif
+#if LCD_USE_QUEUE == 1
+    if (INTCONbits.TMR0IE && INTCONbits.TMR0IF)
+    {
+        PROF_BEGIN(VM_PROBE_ISR_LCD);
+        INTCONbits.TMR0IF = 0;                  /* Reset interrupt flag */
+        LCD_QueueTick();                        /* Next LCD nibble      */
+        PROF_END(VM_PROBE_ISR_LCD);
+        return;
+    }
+#endif
+#if (VM_USE_JOURNAL == 1) || (VM_USE_INVENTORY == 1)
+    if (PIE2bits.EEIE && PIR2bits.EEIF)
+    {
+        PIR2bits.EEIF = 0;                      /* Reset interrupt flag */
+        /* Next queued byte: journal records first, then the counters (a write of the main loop: its EEIF follows) */
+        if (!EEPROM_Busy()
+#if VM_USE_JOURNAL == 1
+            && !JOURNAL_WriteTick()
+#endif
+#if VM_USE_INVENTORY == 1
+            && !INVENTORY_WriteTick()
+#endif
+           )
+            PIE2bits.EEIE = 0;                  /* All written: EEPROM_WriteStart() enables it again */
+        return;
+    }
+#endif
+#if VM_USE_TELEMETRY == 1
+    if (PIE1bits.TXIE && PIR1bits.TXIF)
+    {
+        UART_TxTick();                          /* Next telemetry byte  */
         return;
     }
+#endif
 }
 
 
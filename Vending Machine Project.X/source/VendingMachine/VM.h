@@ -12,14 +12,127 @@
 #define VM_H
 
 
+/**********************************************************************************************************************
+ *  Configuration
+ *********************************************************************************************************************/
+
+/* Choose the execution model:
+    1      -->      Non-blocking: every mode is a resumable task of the cooperative scheduler (Timer2 tick), with sleep
+                    and clock scaling by default (the host benches build it with the scheduler)
+    0      -->      Blocking: 5s delays by polling Timer0/Timer1 (the main loop stalls while dispensing), PIC16F882
+                    build: the baseline image already took 2047 of the 2048 words of flash
+*/
+#ifndef VM_USE_SCHEDULER
+#define     VM_USE_SCHEDULER        0
+#endif
+
+/* Sleep between events (non-blocking model only):
+    1      -->      The main loop sleeps while the machine waits for the customer, woken by the push buttons
+                    (interrupt-on-change) and by the watchdog, which starts the Timer2 tick in software
+    0      -->      The main loop runs continuously
+*/
+#ifndef VM_USE_SLEEP
+#define     VM_USE_SLEEP            VM_USE_SCHEDULER
+#endif
+
+/* Clock scaling (sleep mode only):
+    1      -->      The main loop sleeps on the internal oscillator (CLOCK_IDLE_IRCF): the watchdog wake-ups sample the
+                    tilt sensor without the crystal start-up, the crystal is back for the customer, the LCD and the
+                    timed modes
+    0      -->      Crystal only
+*/
+#ifndef VM_USE_CLOCK_SCALING
+#define     VM_USE_CLOCK_SCALING    VM_USE_SLEEP
+#endif
+
+/* Tilt sensor filter (VR2):
+    1      -->      Moving average of FILTER_SIZE samples with hysteresis, decimated (FILTER_DECIMATION)
+    0      -->      Every sample is compared with the hysteresis thresholds (no FILTER code, 13 bytes of RAM less), a
+                    noisy sensor raises false alarms
+*/
+#ifndef VM_USE_TILT_FILTER
+#define     VM_USE_TILT_FILTER      1
+#endif
+
+/* Telemetry (EUSART, UART_BAUD):
+    1      -->      State changes, sales and alarms are sent as frames on RC6/TX (the LCD must be wired to RC0..RC5:
+                    LCD_D4_PIN 0, LCD_RS_PIN 4, LCD_EN_PIN 5)
+    0      -->      No telemetry (the vending machine board wires the LCD D6/D7 to RC6/RC7)
+*/
+#ifndef VM_USE_TELEMETRY
+#define     VM_USE_TELEMETRY        0
+#endif
+
+/* Input trace (telemetry, VM_USE_TELEMETRY = 1 and VM_USE_SCHEDULER = 1):
+    1      -->      The inputs the ISR consumes (push buttons sample of PORTB and tilt sensor sample) are sent in a
+                    VM_TLM_INPUT frame whenever they change, with the Timer2 tick they were sampled at: a collector
+                    rebuilds an input trace the host replays (tlmdump -t, tracereplay)
+    0      -->      No input frames
+*/
+#ifndef VM_USE_INPUT_TRACE
+#define     VM_USE_INPUT_TRACE      0
+#endif
+
+/* Transaction journal (data EEPROM, the last JOURNAL_RECORDS slots):
+    1      -->      Sales, change and alarms are buffered in RAM and written while the machine waits for the customer
+                    (EEIF interrupt), they survive a reset, 12 bytes of RAM. Host only: the PIC16F882 image has no
+                    flash to spare for it (a PIC16F886 has)
+    0      -->      No journal (PIC16F882 build)
+*/
+#ifndef VM_USE_JOURNAL
+#define     VM_USE_JOURNAL          0
+#endif
+
+/* Sales and inventory counters (data EEPROM, after the catalog):
+    1      -->      Sales are counted in RAM and flushed to the EEPROM while the machine waits for the customer, the
+                    drink selection skips the products out of stock, 18 bytes of RAM with CATALOG_MAX_PRODUCTS = 8.
+                    Host only: the PIC16F882 image has no flash to spare for them (a PIC16F886 has)
+    0      -->      No counters (PIC16F882 build)
+*/
+#ifndef VM_USE_INVENTORY
+#define     VM_USE_INVENTORY        0
+#endif
+
+/* Time the machine waits in drink selection before the counters are flushed (sales of back-to-back customers are
+   written together), the blocking build flushes after INVENTORY_DIRTY_MAX sales only */
+#ifndef VM_INVENTORY_IDLE_MS
+#define     VM_INVENTORY_IDLE_MS    10000
+#endif
+
 
 /**********************************************************************************************************************
  *  CONSTANT MACROS
  *********************************************************************************************************************/
 
 #define     _ENABLE_GLOBAL_INTERRUPTS()       (INTCONbits.GIE = 1)
+#define     _DISABLE_GLOBAL_INTERRUPTS()      (INTCONbits.GIE = 0)
 #define     _ENABLE_PERIPHERAL_INTERRUPTS()   (INTCONbits.PEIE = 1)
 
+/* Profiler probes (PROF_ENABLE = 1): every interrupt source first (PROF_ISR_PROBES), then the LCD flush and the mode
+   of every timed state, PROF_MAX_PROBES must cover all of them */
+#define     VM_PROBE_ISR_TICK       0       /* Timer2 tick: debounce, ADC start              */
+#define     VM_PROBE_ISR_ADC        1       /* ADC complete: tilt sensor filter              */
+#define     VM_PROBE_ISR_LCD        2       /* Timer0: LCD transmit queue                    */
+#define     VM_PROBE_LCD_FLUSH      3       /* LCD_Flush() in the main loop                  */
+#define     VM_PROBE_MODE(state)    ((unsigned char)((state) - VM_STATE_DRINK_SELECTION + 4))  /* 4 .. 8, modes */
+#define     VM_PROBES_ISR           3
+#define     VM_PROBES               9
+
+/* Telemetry frame types (VM_USE_TELEMETRY = 1) and their payload */
+#define     VM_TLM_STATE            1       /* State entered (VM_STATE_xxx)                          */
+#define     VM_TLM_SALE             2       /* Drink (catalog index), price, change (10p units)      */
+#define     VM_TLM_ALARM            3       /* Tilt alarm: 1 = on, 0 = off                           */
+#define     VM_TLM_INPUT            4       /* Tick (low, high), SW0..SW2 (PORTB bits 0..2, 0 = pressed),
+                                               tilt sensor (10-bit, high, low)                       */
+#define     VM_TLM_INPUT_SIZE       5
+
+/* Journal record tags (VM_USE_JOURNAL = 1): type (high nibble) and drink (low nibble), the value follows */
+#define     VM_JOURNAL_SALE(drink)  ((unsigned char)(0x10 | (drink)))   /* Price of the drink (10p units)   */
+#define     VM_JOURNAL_CHANGE       0x20                                /* Change given (10p units)         */
+#define     VM_JOURNAL_ALARM        0x30                                /* Tilt alarm: 1 = on, 0 = off      */
+#define     VM_JOURNAL_TYPE(tag)    ((tag) & 0xF0)
+#define     VM_JOURNAL_DRINK(tag)   ((tag) & 0x0F)
+
 /**********************************************************************************************************************
  *  GLOBAL DATA TYPES AND STRUCTURES
  *********************************************************************************************************************/
@@ -37,24 +150,7 @@ typedef enum
     VM_STATE_ALARM
 }VM_state_e;
 
-/* Vending Machine Drinks */
-typedef enum
-{
-    VM_DRINK_COLA = 0,
-    VM_DRINK_LEMONADE,
-    VM_DRINK_ORANGE,
-    VM_DRINK_WATER
-}VM_drink_e;
-
-/* Vending Machine Coins */
-/* NOTE: Coins are divided by 10 here so that it wouldn't take program memory to make division. */
-typedef enum
-{
-    VM_COIN_COLA_80         = 8,
-    VM_COIN_LEMONADE_80     = 8,
-    VM_COIN_ORANGE_60       = 6,
-    VM_COIN_WATER_50        = 5,
-}VM_coin_e;
+/* NOTE: The drinks and their prices (divided by 10, no division needed) are data of the drink catalog (EEPROM). */
 
 /**********************************************************************************************************************
  *  GLOBAL FUNCTIONS
@@ -63,7 +159,7 @@ typedef enum
 /******************************************************************************
 * \Syntax          : void VM_Init( void )       
 * \Description     : initializes system components and enter drink selection mode
-                        --> Push Buttons: interrupt-on-change
+                        --> Push Buttons: inputs debounced on the Timer2 tick
                         --> LCD: 4-bit mode
                         --> LEDs: output simulating dispensers
                         --> Buzzer: output
@@ -11,42 +11,212 @@
 #ifndef  VM_PRV_H
 #define  VM_PRV_H
 
+/**********************************************************************************************************************
+ *  CONSTANT MACROS
+ *********************************************************************************************************************/
+
+/* State machine events (columns of the transition table) */
+#define     VM_SM_RUN               0       /* Mode of the current state is due (scheduler task / main loop) */
+#define     VM_SM_SW0               1       /* SW0 pressed (debounced)                                        */
+#define     VM_SM_SW1               2       /* SW1 pressed (debounced)                                        */
+#define     VM_SM_SW2               3       /* SW2 pressed (debounced)                                        */
+#define     VM_SM_TILT              4       /* Filtered tilt sensor above 2V                                  */
+#define     VM_SM_TILT_CLEAR        5       /* Filtered tilt sensor below 1.8V                                */
+#define     VM_SM_DONE              6       /* Completion: drink selected, paid, dispensed or 5s elapsed       */
+#define     VM_SM_CHANGE            7       /* Completion: drink dispensed with change due                    */
+#define     VM_SM_EVENTS            8
+
+/* Result of an action that completes nothing (no completion event) */
+#define     VM_SM_NONE              0xFF
+
+/* Number of states (rows of the transition table) */
+#define     VM_SM_STATES            (VM_STATE_ALARM - VM_STATE_INITIAL + 1)
+
+/* Next state of a transition that keeps the state */
+#define     VM_STATE_SAME           0
+
+/**********************************************************************************************************************
+ *  LOCAL DATA TYPES AND STRUCTURES
+ *********************************************************************************************************************/
+
+/* Transition of the state machine (const --> program memory) */
+typedef struct
+{
+    unsigned char (*action)(void);          /* Executed first, returns a completion event or VM_SM_NONE  */
+    unsigned char next;                     /* Next state, VM_STATE_SAME: unchanged                      */
+}VM_transition_t;
+
+/**********************************************************************************************************************
+ *  PRIVATE FUNCTIONS
+ *********************************************************************************************************************/
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_Reset( void )       
+* \Description     : Private action that resets the transaction before drink
+                     selection mode (warm restart), the peripherals and the
+                     LCD stay configured and only the changed characters are
+                     redrawn [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_Reset(void);
+
+/******************************************************************************
+* \Syntax          : static void VM_Task( void )       
+* \Description     : Private function that dispatches VM_SM_RUN to the
+                     current state (scheduler task) [USED INTERNALLY].
+*******************************************************************************/
+static void VM_Task(void);
+
 /******************************************************************************
-* \Syntax          : static void VM_Mode_DrinkSelection( void )       
+* \Syntax          : static void VM_HandleEvents( void )       
+* \Description     : Private function that dispatches the button events queued
+                     by the ISR in order and the tilt sensor level
+                     [USED INTERNALLY].
+*******************************************************************************/
+static void VM_HandleEvents(void);
+
+/******************************************************************************
+* \Syntax          : static void VM_Dispatch( unsigned char *state,
+                                             unsigned char event )
+* \Description     : Private function that looks up (state, event) in the
+                     transition table, executes the action, enters the next
+                     state and dispatches the completion event of the action
+                     (at most two lookups) [USED INTERNALLY].
+*******************************************************************************/
+static void VM_Dispatch(unsigned char *state, unsigned char event);
+
+#if VM_USE_INPUT_TRACE == 1
+/******************************************************************************
+* \Syntax          : static void VM_TraceInputs( void )
+* \Description     : Private function that sends the samples of the last
+                     tick in a VM_TLM_INPUT frame if they changed
+                     [USED INTERNALLY].
+*******************************************************************************/
+static void VM_TraceInputs(void);
+#endif
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_FirstInStock( unsigned char from )
+* \Description     : Private function that returns the first drink in stock
+                     from a catalog index on (wraps around to the first
+                     drink), VM_SOLD_OUT if there is none, the stock is read
+                     from RAM [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_FirstInStock(unsigned char from);
+
+/******************************************************************************
+* \Syntax          : static void VM_PutDigit( unsigned char digit )
+* \Description     : Private function that writes a decimal digit in the LCD
+                     frame buffer at the cursor [USED INTERNALLY].
+*******************************************************************************/
+static void VM_PutDigit(unsigned char digit);
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_Action_NextDrink( void )
+* \Description     : Private action that selects the next drink of the
+                     catalog in stock (SW0 in drink selection mode)
+                     [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_Action_NextDrink(void);
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_Action_SelectDrink( void )
+* \Description     : Private action that loads the price of the selected
+                     drink, VM_SM_DONE: coin insertion mode (SW1 in drink
+                     selection mode) [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_Action_SelectDrink(void);
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_Action_Coin10( void )
+* \Description     : Private action that inserts 10p (SW0) [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_Action_Coin10(void);
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_Action_Coin20( void )
+* \Description     : Private action that inserts 20p (SW1) [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_Action_Coin20(void);
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_Action_Coin50( void )
+* \Description     : Private action that inserts 50p (SW2) [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_Action_Coin50(void);
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_Action_AlarmOn( void )
+* \Description     : Private action that turns the alarm buzzer on (tilt
+                     sensing --> alarm) [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_Action_AlarmOn(void);
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_Action_AlarmOff( void )
+* \Description     : Private action that turns the alarm buzzer off (alarm
+                     --> tilt sensing) [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_Action_AlarmOff(void);
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_Mode_DrinkSelection( void )       
 * \Description     : Private function used to provide a user interface through
                      which the customer can select a drink and view the prices
                      [USED INTERNALLY].
 *******************************************************************************/
-static void VM_Mode_DrinkSelection(void);
+static unsigned char VM_Mode_DrinkSelection(void);
 
 /******************************************************************************
-* \Syntax          : static void VM_Mode_CoinInsertion( void )       
+* \Syntax          : static unsigned char VM_Mode_CoinInsertion( void )       
 * \Description     : Private function used to simulate the insertion of coins
                      by the customer and the display updates to show the
-                     outstanding balance [USED INTERNALLY].
+                     outstanding balance, VM_SM_DONE once paid
+                     [USED INTERNALLY].
 *******************************************************************************/
-static void VM_Mode_CoinInsertion(void);
+static unsigned char VM_Mode_CoinInsertion(void);
 
 /******************************************************************************
-* \Syntax          : static void VM_Mode_DispenseDrink( void )       
+* \Syntax          : static unsigned char VM_Mode_DispenseDrink( void )       
 * \Description     : Private function used to simulate dispensing of the drink
-                     by using LED and update LCD display [USED INTERNALLY].
+                     by using LED and update LCD display, VM_SM_DONE (no
+                     change) or VM_SM_CHANGE once dispensed [USED INTERNALLY].
 *******************************************************************************/
-static void VM_Mode_DispenseDrink(void);
+static unsigned char VM_Mode_DispenseDrink(void);
 
 /******************************************************************************
-* \Syntax          : static void VM_Mode_DispenseChange( void )       
+* \Syntax          : static unsigned char VM_Mode_DispenseChange( void )       
 * \Description     : Private function used to simulate dispensing of the change
-                     by using LED and update LCD display [USED INTERNALLY].
+                     by using LED and update LCD display, VM_SM_DONE after 5s
+                     [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_Mode_DispenseChange(void);
+
+/******************************************************************************
+* \Syntax          : static unsigned char VM_Mode_DrinkReady( void )       
+* \Description     : Private function used to ask the customer to collect the
+                     drink for 5s, VM_SM_DONE: reset the vending machine
+                     [USED INTERNALLY].
+*******************************************************************************/
+static unsigned char VM_Mode_DrinkReady(void);
+
+#if VM_USE_SLEEP == 1
+/******************************************************************************
+* \Syntax          : static void VM_Sleep( void )
+* \Description     : Private function that sleeps while the machine waits for
+                     the customer and nothing is pending, a watchdog wake-up
+                     runs a Timer2 tick [USED INTERNALLY].
 *******************************************************************************/
-static void VM_Mode_DispenseChange(void);
+static void VM_Sleep(void);
+#endif
 
+#if VM_USE_SCHEDULER == 0
 /******************************************************************************
 * \Syntax          : static void TIMR1_Delay5s( void )       
 * \Description     : Private function used to generate 5s delay using Timer1
                      (Polling Mode) [USED INTERNALLY].
 *******************************************************************************/
 static void TIMR1_Delay5s(void);
+#endif
 
 
 #endif  /* VM_PRV_H */
\ No newline at end of file